@@ -0,0 +1,23 @@
+/**
+ * @file lv_arena_alloc.h
+ * LVGL allocator hooks for LV_MEM_CUSTOM = 1 (see src/ui_common/screen_arena.h)
+ * Plain C so LVGL's own sources can include it through lv_conf.h.
+ */
+#ifndef LV_ARENA_ALLOC_H
+#define LV_ARENA_ALLOC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void * lv_arena_alloc(size_t size);
+void lv_arena_free(void * ptr);
+void * lv_arena_realloc(void * ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*LV_ARENA_ALLOC_H*/
@@ -30,7 +30,8 @@
    MEMORY SETTINGS
  *=========================*/
 
-/*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`*/
+/*1: use custom malloc/free, 0: use the built-in `lv_mem_alloc()` and `lv_mem_free()`
+ *1 selects the per-screen arena (src/ui_common/screen_arena.h) with the system heap as general pool*/
 #define LV_MEM_CUSTOM 0
 #if LV_MEM_CUSTOM == 0
     /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
@@ -45,10 +46,10 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    #define LV_MEM_CUSTOM_INCLUDE <lv_arena_alloc.h>   /*Header for the dynamic memory function*/
+    #define LV_MEM_CUSTOM_ALLOC   lv_arena_alloc
+    #define LV_MEM_CUSTOM_FREE    lv_arena_free
+    #define LV_MEM_CUSTOM_REALLOC lv_arena_realloc
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing.
@@ -62,15 +63,19 @@
    HAL SETTINGS
  *====================*/
 
-/*Default display refresh period. LVG will redraw changed areas with this period time*/
+/*Default display refresh period. LVG will redraw changed areas with this period time
+ *(RefreshGovernor adjusts it at runtime)*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
-/*Input device read period in milliseconds*/
+/*Input device read period in milliseconds (RefreshGovernor adjusts it at runtime)*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
 /*Use a custom tick source that tells the elapsed time in milliseconds.
- *It removes the need to manually update the tick with `lv_tick_inc()`) */
-#define LV_TICK_CUSTOM 1
+ *It removes the need to manually update the tick with `lv_tick_inc()`)
+ *[env:native_fonts] sets it to 0 - no Arduino on the host*/
+#ifndef LV_TICK_CUSTOM
+    #define LV_TICK_CUSTOM 1
+#endif
 #if LV_TICK_CUSTOM
     #define LV_TICK_CUSTOM_INCLUDE "Arduino.h"         /*Header for the system time function*/
     #define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())    /*Expression evaluating to current system time in ms*/
@@ -310,17 +315,26 @@
  *   FONT USAGE
  *=================*/
 
+/*UI_FONTS_SUBSET is defined by scripts/font_subset.py when it has generated the
+ *subsetted UI fonts (src/ui_common/fonts). Otherwise the UI sizes come from the
+ *built-ins below - see src/ui_common/ui_fonts.h*/
+#ifdef UI_FONTS_SUBSET
+    #define UI_BUILTIN_FONTS 0
+#else
+    #define UI_BUILTIN_FONTS 1
+#endif
+
 /*Montserrat fonts with ASCII range and some symbols using bpp = 4
  *https://fonts.google.com/specimen/Montserrat*/
 #define LV_FONT_MONTSERRAT_8  0
-#define LV_FONT_MONTSERRAT_10 0
-#define LV_FONT_MONTSERRAT_12 0
-#define LV_FONT_MONTSERRAT_14 1
-#define LV_FONT_MONTSERRAT_16 1
-#define LV_FONT_MONTSERRAT_18 0
+#define LV_FONT_MONTSERRAT_10 UI_BUILTIN_FONTS
+#define LV_FONT_MONTSERRAT_12 UI_BUILTIN_FONTS
+#define LV_FONT_MONTSERRAT_14 UI_BUILTIN_FONTS
+#define LV_FONT_MONTSERRAT_16 UI_BUILTIN_FONTS
+#define LV_FONT_MONTSERRAT_18 UI_BUILTIN_FONTS
 #define LV_FONT_MONTSERRAT_20 0
 #define LV_FONT_MONTSERRAT_22 0
-#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_24 0
 #define LV_FONT_MONTSERRAT_26 0
 #define LV_FONT_MONTSERRAT_28 0
 #define LV_FONT_MONTSERRAT_30 0
@@ -347,18 +361,27 @@
 /*Optionally declare custom fonts here.
  *You can use these fonts as default font too and they will be available globally.
  *E.g. #define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(my_font_1) LV_FONT_DECLARE(my_font_2)*/
-#define LV_FONT_CUSTOM_DECLARE
+#if UI_BUILTIN_FONTS
+    #define LV_FONT_CUSTOM_DECLARE
+#else
+    #define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(ui_font_14)
+#endif
 
 /*Always set a default font*/
-#define LV_FONT_DEFAULT &lv_font_montserrat_14
+#if UI_BUILTIN_FONTS
+    #define LV_FONT_DEFAULT &lv_font_montserrat_14
+#else
+    #define LV_FONT_DEFAULT &ui_font_14
+#endif
 
 /*Enable handling large font and/or fonts with a lot of characters.
  *The limit depends on the font size, font face and bpp.
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
-/*Enables/disables support for compressed fonts.*/
-#define LV_USE_FONT_COMPRESSED 0
+/*Enables/disables support for compressed fonts.
+ *The generated UI subsets are RLE compressed.*/
+#define LV_USE_FONT_COMPRESSED 1
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+"""
+UI font subsetting step (PlatformIO pre-script, also runs standalone)
+
+Scans src/ for the UI_FONT_<size> sizes and UI_ICON_* glyphs the UI uses and
+generates one compressed 4 bpp LVGL font per size under src/ui_common/fonts/:
+Montserrat (printable ASCII + any Latin characters found in UI strings) with
+the used Font Awesome icons merged in. On success it defines UI_FONTS_SUBSET,
+which swaps src/ui_common/ui_fonts.h and include/lv_conf.h over from the
+built-in Montserrat fonts.
+
+ASCII stays complete because runtime text (numbers, IPs, MQTT payloads) can
+contain any of it; the saving comes from dropping unused sizes, the ~60
+unused LVGL symbols and from RLE compression.
+
+Emoji in string literals fail the build - they never render on the knob.
+
+It also writes fonts/ui_text.h - every UI_ICON_* and the string literals of
+the sources that draw with the UI fonts - for test/test_ui_fonts, which
+renders them through whichever fonts the build ended up with.
+
+Needs lv_font_conv (npm i -g lv_font_conv, or set LV_FONT_CONV). Fonts are
+taken from the LVGL library's scripts/built_in_font, or FONT_DIR. Without
+either the firmware builds with the built-in fonts.
+
+Usage:
+  pio run                                  (runs automatically)
+  ./scripts/font_subset.py [--check]       (--check: scan and report only)
+"""
+
+import hashlib
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+except NameError:
+    env = None
+
+TEXT_FONT = "Montserrat-Medium.ttf"
+ICON_FONT = "FontAwesome5-Solid+Brands-Regular.woff"
+BPP = 4
+DEFAULT_SIZE = 14               # LV_FONT_DEFAULT, always generated
+ASCII_RANGE = "0x20-0x7E"
+
+FONTS_HEADER = os.path.join("src", "ui_common", "ui_fonts.h")
+OUTPUT_DIR = os.path.join("src", "ui_common", "fonts")
+MANIFEST = "subset.json"
+TEXT_HEADER = "ui_text.h"
+
+SIZE_RE = re.compile(r"\bUI_FONT_(\d+)\b")
+ICON_USE_RE = re.compile(r"\b(UI_ICON_\w+|UI_DOT_\w+)\b")
+ICON_DEF_RE = re.compile(r'#define\s+(UI_ICON_\w+)\s+"((?:\\x[0-9A-Fa-f]{2})+)"')
+
+
+def literals(text):
+    """Yield the contents of string literals, skipping comments and chars"""
+    i, n = 0, len(text)
+    while i < n:
+        c = text[i]
+        if text.startswith("//", i):
+            i = text.find("\n", i)
+            i = n if i < 0 else i
+        elif text.startswith("/*", i):
+            i = text.find("*/", i + 2)
+            i = n if i < 0 else i + 2
+        elif c in "\"'":
+            j = i + 1
+            while j < n and text[j] != c and text[j] != "\n":
+                j += 2 if text[j] == "\\" else 1
+            if c == '"':
+                yield text[i + 1:j]
+            i = j + 1
+        else:
+            i += 1
+
+
+def renderable(cp):
+    """Characters Montserrat has beyond ASCII: Latin-1/Extended-A, punctuation"""
+    return 0xA0 <= cp <= 0x17F or 0x2010 <= cp <= 0x2044
+
+
+def source_files(root):
+    for base, dirs, files in os.walk(os.path.join(root, "src")):
+        dirs[:] = [d for d in dirs if os.path.join(base, d) != os.path.join(root, OUTPUT_DIR)]
+        for name in files:
+            if name.endswith((".cpp", ".h", ".c")):
+                yield os.path.join(base, name)
+
+
+def scan(root):
+    """Return (sizes, extra Latin characters, icon names, errors)"""
+    header = os.path.normpath(os.path.join(root, FONTS_HEADER))
+    sizes, chars, icons, errors = {DEFAULT_SIZE}, set(), set(), []
+    for path in sorted(source_files(root)):
+        with open(path, encoding="utf-8") as f:
+            text = f.read()
+        if os.path.normpath(path) == header:
+            continue
+        sizes.update(int(s) for s in SIZE_RE.findall(text))
+        icons.update(ICON_USE_RE.findall(text))
+        for literal in literals(text):
+            for ch in literal:
+                cp = ord(ch)
+                if cp < 0x80:
+                    continue
+                if renderable(cp):
+                    chars.add(ch)
+                else:
+                    errors.append("%s: U+%04X in \"%s\" - use a UI_ICON_* glyph"
+                                  % (os.path.relpath(path, root), cp, literal))
+                    break
+    if any(name.startswith("UI_DOT_") for name in icons):
+        icons.add("UI_ICON_DOT")
+    return sorted(sizes), "".join(sorted(chars)), sorted(i for i in icons if i.startswith("UI_ICON_")), errors
+
+
+def ui_literals(root):
+    """String literals of the files that draw with the UI fonts, as written"""
+    header = os.path.normpath(os.path.join(root, FONTS_HEADER))
+    found = set()
+    for path in sorted(source_files(root)):
+        if os.path.normpath(path) == header:
+            continue
+        with open(path, encoding="utf-8") as f:
+            text = f.read()
+        if SIZE_RE.search(text) or ICON_USE_RE.search(text):
+            found.update(literal for literal in literals(text) if literal)
+    return sorted(found)
+
+
+def write_text_header(root, sizes, used_icons):
+    """fonts/ui_text.h for test/test_ui_fonts; rewritten only when it changes"""
+    with open(os.path.join(root, FONTS_HEADER), encoding="utf-8") as f:
+        icons = []
+        for name, _ in ICON_DEF_RE.findall(f.read()):
+            if name not in icons:
+                icons.append(name)
+    lines = ["// Generated by scripts/font_subset.py - do not edit",
+             "#pragma once",
+             "",
+             "#define UI_TEXT_FONTS " + ", ".join("UI_FONT_%d" % size for size in sizes),
+             "",
+             "// Unused icons are left out of the subset fonts",
+             "struct UiTextIcon {",
+             "    const char* name;",
+             "    const char* text;",
+             "    bool used;",
+             "};",
+             "",
+             "static const UiTextIcon UI_TEXT_ICONS[] = {"]
+    lines += ['    {"%s", %s, %s},' % (name, name, "true" if name in used_icons else "false")
+              for name in icons]
+    lines += ["};", "", "static const char* const UI_TEXT_LITERALS[] = {"]
+    lines += ['    "%s",' % literal for literal in ui_literals(root)]
+    lines += ["};", ""]
+    content = "\n".join(lines)
+
+    out_dir = os.path.join(root, OUTPUT_DIR)
+    os.makedirs(out_dir, exist_ok=True)
+    path = os.path.join(out_dir, TEXT_HEADER)
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    except OSError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(content)
+
+
+def icon_codepoints(root, names):
+    """Codepoints of the subset UI_ICON_* definitions in ui_fonts.h"""
+    with open(os.path.join(root, FONTS_HEADER), encoding="utf-8") as f:
+        defs = {}
+        for name, escaped in ICON_DEF_RE.findall(f.read()):
+            raw = bytes(int(h, 16) for h in escaped.split("\\x")[1:])
+            defs.setdefault(name, ord(raw.decode("utf-8")))
+    missing = [n for n in names if n not in defs]
+    if missing:
+        raise SystemExit("font_subset: %s not defined in %s" % (", ".join(missing), FONTS_HEADER))
+    return sorted({defs[n] for n in names})
+
+
+def find_tool():
+    tool = os.environ.get("LV_FONT_CONV") or shutil.which("lv_font_conv")
+    return [tool] if tool else None
+
+
+def find_font_dir(root):
+    candidates = [os.environ.get("FONT_DIR")]
+    if env is not None:
+        libdeps = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"))
+        candidates.append(os.path.join(libdeps, "lvgl", "scripts", "built_in_font"))
+    for path in candidates:
+        if path and os.path.isfile(os.path.join(path, TEXT_FONT)) and os.path.isfile(os.path.join(path, ICON_FONT)):
+            return path
+    return None
+
+
+def generate(root, tool, font_dir, sizes, chars, codepoints):
+    out_dir = os.path.join(root, OUTPUT_DIR)
+    os.makedirs(out_dir, exist_ok=True)
+    for size in sizes:
+        name = "ui_font_%d" % size
+        cmd = tool + ["--bpp", str(BPP), "--size", str(size), "--format", "lvgl",
+                      "--lv-font-name", name, "-o", os.path.join(out_dir, name + ".c"),
+                      "--font", os.path.join(font_dir, TEXT_FONT), "--range", ASCII_RANGE]
+        if chars:
+            cmd += ["--symbols", chars]
+        if codepoints:
+            cmd += ["--font", os.path.join(font_dir, ICON_FONT),
+                    "--range", ",".join("0x%X" % cp for cp in codepoints)]
+        subprocess.check_call(cmd)
+    for name in os.listdir(out_dir):
+        m = re.match(r"ui_font_(\d+)\.c$", name)
+        if m and int(m.group(1)) not in sizes:
+            os.remove(os.path.join(out_dir, name))
+
+
+def up_to_date(root, manifest, sizes):
+    path = os.path.join(root, OUTPUT_DIR, MANIFEST)
+    try:
+        with open(path) as f:
+            if json.load(f) != manifest:
+                return False
+    except (OSError, ValueError):
+        return False
+    return all(os.path.isfile(os.path.join(root, OUTPUT_DIR, "ui_font_%d.c" % s)) for s in sizes)
+
+
+def run(root, check_only=False):
+    """Returns True when the subset fonts are current and usable"""
+    sizes, chars, icons, errors = scan(root)
+    if errors:
+        for e in errors:
+            print("font_subset: " + e, file=sys.stderr)
+        raise SystemExit(1)
+    codepoints = icon_codepoints(root, icons)
+    print("font_subset: sizes %s, %d ASCII + %d Latin glyphs, icons %s" % (
+        sizes, 95, len(chars), " ".join("U+%04X" % cp for cp in codepoints)))
+    if check_only:
+        return False
+    write_text_header(root, sizes, icons)
+
+    manifest = {"bpp": BPP, "sizes": sizes, "ascii": ASCII_RANGE, "symbols": chars,
+                "icons": codepoints}
+    manifest["hash"] = hashlib.sha1(json.dumps(manifest, sort_keys=True).encode()).hexdigest()
+    if up_to_date(root, manifest, sizes):
+        return True
+
+    tool, font_dir = find_tool(), find_font_dir(root)
+    if not tool or not font_dir:
+        print("font_subset: %s not found - building with the built-in Montserrat fonts"
+              % ("lv_font_conv" if not tool else TEXT_FONT))
+        return False
+    generate(root, tool, font_dir, sizes, chars, codepoints)
+    with open(os.path.join(root, OUTPUT_DIR, MANIFEST), "w") as f:
+        json.dump(manifest, f, indent=1)
+    return True
+
+
+if env is not None:
+    if run(env.subst("$PROJECT_DIR")):
+        env.Append(CPPDEFINES=["UI_FONTS_SUBSET"])
+elif __name__ == "__main__":
+    project = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    run(project, check_only="--check" in sys.argv[1:])
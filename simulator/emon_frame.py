@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+EmonTX3 combined frame tool
+Packs balance/solar/used/vrms/tariff into the 21-byte binary frame decoded by
+EnergyFrameCodec (src/core/network/energy_frame.h), so one MQTT message
+replaces five ASCII topics.
+
+  <uint8 version=1><uint8 fields><uint16 sequence>
+  <float balance><float solar><float used><float vrms><uint8 tariff>   (little-endian)
+
+Usage:
+  ./emon_frame.py pack <seq> <balance> <solar> <used> <vrms> <tariff> \\
+      | mosquitto_pub -h broker -t emon/emontx3/frame -s
+  mosquitto_sub -h broker -v -t 'emon/emontx3/#' | ./emon_frame.py bridge broker
+      (re-publish per-topic values as frames; needs mosquitto_pub)
+"""
+
+import struct
+import subprocess
+import sys
+
+VERSION = 1
+TOPIC = "emon/emontx3/frame"
+FIELDS = ("balance", "solar", "used", "vrms", "tariff")
+
+
+def pack(sequence, values):
+    """values: dict with any of FIELDS - missing ones are flagged absent"""
+    mask = 0
+    for bit, name in enumerate(FIELDS):
+        if name in values:
+            mask |= 1 << bit
+    return struct.pack("<BBHffffB", VERSION, mask, sequence & 0xFFFF,
+                       values.get("balance", 0.0), values.get("solar", 0.0),
+                       values.get("used", 0.0), values.get("vrms", 0.0),
+                       int(values.get("tariff", 1)))
+
+
+def tariff_band(text):
+    text = text.lower()
+    return 1 if ("low" in text or "off" in text or "night" in text) else 2
+
+
+def bridge(stream_in, broker):
+    """Collect one value per topic and publish a frame on each balance update"""
+    values = {}
+    sequence = 0
+    for line in stream_in:
+        line = line.rstrip("\r\n")
+        if " " not in line:
+            continue
+        topic, payload = line.split(" ", 1)
+        name = topic.rsplit("/", 1)[-1]
+        if name not in FIELDS:
+            continue
+        values[name] = tariff_band(payload) if name == "tariff" else float(payload)
+        if name == "balance":
+            subprocess.run(["mosquitto_pub", "-h", broker, "-t", TOPIC, "-s"],
+                           input=pack(sequence, values), check=False)
+            sequence += 1
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    command = sys.argv[1]
+    if command == "pack" and len(sys.argv) == 8:
+        values = dict(zip(FIELDS, [float(v) for v in sys.argv[3:7]] + [int(sys.argv[7])]))
+        sys.stdout.buffer.write(pack(int(sys.argv[2]), values))
+    elif command == "bridge" and len(sys.argv) == 3:
+        bridge(sys.stdin, sys.argv[2])
+    else:
+        print(__doc__)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+EmonTX3 MQTT trace tool
+Captures emon/emontx3/* traffic and converts traces between the CSV and
+binary formats understood by TraceReplay (src/core/network/trace_replay.h)
+
+  CSV:    <timestamp_ms>,<topic>,<payload>     ('#' lines are comments)
+  Binary: b"EMTR", version 1, then per record
+          <uint32 timestamp_ms><uint8 topic_len><uint8 payload_len><topic><payload>
+
+Usage:
+  mosquitto_sub -h broker -v -t 'emon/emontx3/#' | ./emon_trace.py capture > trace.csv
+  ./emon_trace.py to-binary trace.csv trace.bin
+  ./emon_trace.py to-csv trace.bin trace.csv
+  ./emon_trace.py to-header trace.bin trace.h    (C array to embed in firmware)
+  ./emon_trace.py sample > trace.csv              (synthetic 5 minute trace)
+"""
+
+import math
+import struct
+import sys
+import time
+
+MAGIC = b"EMTR"
+VERSION = 1
+
+
+def capture(stream_in, stream_out):
+    """Timestamp 'topic payload' lines from mosquitto_sub -v"""
+    start = time.monotonic()
+    stream_out.write("# captured %s\n" % time.strftime("%Y-%m-%d %H:%M:%S"))
+    for line in stream_in:
+        line = line.rstrip("\r\n")
+        if " " not in line:
+            continue
+        topic, payload = line.split(" ", 1)
+        timestamp = int((time.monotonic() - start) * 1000)
+        stream_out.write("%d,%s,%s\n" % (timestamp, topic, payload))
+        stream_out.flush()
+
+
+def sample(stream_out, minutes=5, interval_ms=10000):
+    """Deterministic EmonTX3 traffic: a solar ramp under a cycling load"""
+    stream_out.write("# synthetic - emon_trace.py sample\n")
+    stream_out.write("0,emon/emontx3/tariff,1\n")
+    for i in range(minutes * 60000 // interval_ms):
+        t = i * interval_ms
+        solar = 1200 + 800 * math.sin(i / 7.0)
+        used = 650 + (1800 if (i // 6) % 2 else 0) + 40 * math.sin(i * 1.3)
+        vrms = 240.0 + 2.5 * math.sin(i / 3.0)
+        # Readings of one interval arrive a few ms apart, as from emonhub
+        stream_out.write("%d,emon/emontx3/balance,%.0f\n" % (t + 10, used - solar))
+        stream_out.write("%d,emon/emontx3/solar,%.0f\n" % (t + 14, solar))
+        stream_out.write("%d,emon/emontx3/used,%.0f\n" % (t + 18, used))
+        stream_out.write("%d,emon/emontx3/vrms,%.1f\n" % (t + 22, vrms))
+
+
+def read_csv(path):
+    records = []
+    with open(path, "r", encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if not line or line.startswith("#"):
+                continue
+            timestamp, topic, payload = line.split(",", 2)
+            records.append((int(timestamp), topic, payload))
+    return records
+
+
+def write_csv(path, records):
+    with open(path, "w", encoding="utf-8") as f:
+        for timestamp, topic, payload in records:
+            f.write("%d,%s,%s\n" % (timestamp, topic, payload))
+
+
+def read_binary(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != MAGIC or data[4] != VERSION:
+        raise ValueError("not an EMTR v1 trace")
+    records = []
+    pos = 5
+    while pos + 6 <= len(data):
+        timestamp, topic_len, payload_len = struct.unpack_from("<IBB", data, pos)
+        pos += 6
+        topic = data[pos:pos + topic_len].decode("utf-8")
+        pos += topic_len
+        payload = data[pos:pos + payload_len].decode("utf-8")
+        pos += payload_len
+        records.append((timestamp, topic, payload))
+    return records
+
+
+def encode_binary(records):
+    out = bytearray(MAGIC + bytes([VERSION]))
+    for timestamp, topic, payload in records:
+        topic_b = topic.encode("utf-8")
+        payload_b = payload.encode("utf-8")
+        if len(topic_b) >= 64 or len(payload_b) > 64:
+            raise ValueError("record too long for TraceReplay: %s" % topic)
+        out += struct.pack("<IBB", timestamp, len(topic_b), len(payload_b))
+        out += topic_b + payload_b
+    return bytes(out)
+
+
+def write_header(path, data):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("#pragma once\n#include <stdint.h>\n\n")
+        f.write("// Generated by simulator/emon_trace.py\n")
+        f.write("static const uint8_t emon_trace[] = {\n")
+        for i in range(0, len(data), 16):
+            f.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+        f.write("};\n")
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    command = sys.argv[1]
+    if command == "capture":
+        capture(sys.stdin, sys.stdout)
+    elif command == "to-binary":
+        with open(sys.argv[3], "wb") as f:
+            f.write(encode_binary(read_csv(sys.argv[2])))
+    elif command == "to-csv":
+        write_csv(sys.argv[3], read_binary(sys.argv[2]))
+    elif command == "to-header":
+        source = sys.argv[2]
+        records = read_binary(source) if source.endswith(".bin") else read_csv(source)
+        write_header(sys.argv[3], encode_binary(records))
+    elif command == "sample":
+        sample(sys.stdout)
+    else:
+        print(__doc__)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
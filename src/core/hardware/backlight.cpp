@@ -0,0 +1,21 @@
+#include "backlight.h"
+#include <TFT_eSPI.h>  // TFT_BL pin from User_Setup.h
+
+uint8_t Backlight::brightness = 255;
+
+void Backlight::begin() {
+    ledcSetup(PWM_CHANNEL, PWM_FREQUENCY, PWM_RESOLUTION);
+    ledcAttachPin(TFT_BL, PWM_CHANNEL);
+    setBrightness(brightness);
+    
+    Serial.printf("Backlight PWM initialized on GPIO%d\n", TFT_BL);
+}
+
+void Backlight::setBrightness(uint8_t level) {
+    brightness = level;
+    ledcWrite(PWM_CHANNEL, level);
+}
+
+uint8_t Backlight::getBrightness() {
+    return brightness;
+}
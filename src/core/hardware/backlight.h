@@ -0,0 +1,19 @@
+#pragma once
+#include <Arduino.h>
+
+class Backlight {
+public:
+    // Initialize PWM on the TFT_BL pin and switch the backlight fully on
+    static void begin();
+    
+    // Set backlight level (0 = off, 255 = full)
+    static void setBrightness(uint8_t level);
+    static uint8_t getBrightness();
+    
+private:
+    static constexpr int PWM_CHANNEL = 0;
+    static constexpr int PWM_FREQUENCY = 5000;   // 5kHz - above visible flicker
+    static constexpr int PWM_RESOLUTION = 8;     // 8-bit duty (0-255)
+    
+    static uint8_t brightness;
+};
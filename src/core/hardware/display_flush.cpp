@@ -0,0 +1,104 @@
+#include "display_flush.h"
+#include "power_manager.h"
+#include "../network/trace_replay.h"
+#include "../../ui_common/disc_geometry.h"
+#include "../../ui_common/screen_transition.h"
+
+// Start column of every row, baked in at compile time
+static constexpr DiscSpanTable disc_spans = buildDiscSpanTable(MakeRowList<DiscGeometry::HEIGHT>::type());
+
+static_assert(disc_spans.start[DiscGeometry::CENTER_Y] == 0, "Centre row must span the full width");
+static_assert(disc_spans.start[0] == disc_spans.start[DiscGeometry::HEIGHT - 1], "Disc must be symmetric");
+
+TFT_eSPI* DisplayFlush::tft = nullptr;
+FlushStats DisplayFlush::stats;
+
+void DisplayFlush::begin(TFT_eSPI* display) {
+    tft = display;
+    resetStats();
+}
+
+void DisplayFlush::flush(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    unsigned long start_us = micros();
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+    uint32_t sent = 0;
+    
+    tft->startWrite();
+    
+    // Rows whose visible span covers the whole area are batched into a
+    // single address window; trimmed rows get one window each
+    int16_t run_start = -1;
+    for (int16_t y = area->y1; y <= area->y2; y++) {
+        int16_t x1, x2;
+        bool visible = visibleSpan(y, area, x1, x2);
+        
+        if (visible && x1 == area->x1 && x2 == area->x2) {
+            if (run_start < 0) run_start = y;
+            continue;
+        }
+        if (run_start >= 0) {
+            pushRows(area, color_p, run_start, y - 1);
+            sent += (y - run_start) * w;
+            run_start = -1;
+        }
+        if (!visible) continue;
+        
+        uint32_t span = x2 - x1 + 1;
+        tft->setAddrWindow(x1, y, span, 1);
+        tft->pushColors((uint16_t *)&color_p[(y - area->y1) * w + (x1 - area->x1)].full, span, true);
+        stats.address_windows++;
+        sent += span;
+    }
+    if (run_start >= 0) {
+        pushRows(area, color_p, run_start, area->y2);
+        sent += (area->y2 - run_start + 1) * w;
+    }
+    
+    tft->endWrite();
+    
+    uint32_t elapsed_us = micros() - start_us;
+    stats.flushes++;
+    stats.pixels_rendered += w * h;
+    stats.pixels_sent += sent;
+    stats.busy_us += elapsed_us;
+    ScreenTransition::recordFlush(sent, w * h - sent, elapsed_us);
+    PowerManager::notifyFrame();
+    TraceReplay::notifyFrame();
+    
+    lv_disp_flush_ready(disp);
+}
+
+const FlushStats& DisplayFlush::getStats() {
+    return stats;
+}
+
+void DisplayFlush::resetStats() {
+    stats = FlushStats();
+}
+
+bool DisplayFlush::visibleSpan(int16_t y, const lv_area_t* area, int16_t& x1, int16_t& x2) {
+    if (y < 0 || y >= DiscGeometry::HEIGHT) return false;
+    
+    x1 = disc_spans.start[y];
+    x2 = DiscGeometry::WIDTH - 1 - x1;
+    
+    if (ScreenTransition::isClipping()) {
+        int16_t tx1, tx2;
+        if (!ScreenTransition::getRowSpan(y, tx1, tx2)) return false;
+        if (tx1 > x1) x1 = tx1;
+        if (tx2 < x2) x2 = tx2;
+    }
+    
+    if (x1 < area->x1) x1 = area->x1;
+    if (x2 > area->x2) x2 = area->x2;
+    return x1 <= x2;
+}
+
+void DisplayFlush::pushRows(const lv_area_t* area, lv_color_t* color_p, int16_t y1, int16_t y2) {
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t rows = y2 - y1 + 1;
+    tft->setAddrWindow(area->x1, y1, w, rows);
+    tft->pushColors((uint16_t *)&color_p[(y1 - area->y1) * w].full, w * rows, true);
+    stats.address_windows++;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <TFT_eSPI.h>
+#include <lvgl.h>
+
+// Flush counters since the last reset
+struct FlushStats {
+    uint32_t flushes = 0;           // Flush callbacks
+    uint32_t pixels_rendered = 0;   // Pixels LVGL handed to the flush
+    uint32_t pixels_sent = 0;       // Pixels actually pushed over SPI
+    uint32_t address_windows = 0;   // setAddrWindow() calls
+    uint32_t busy_us = 0;           // Time spent in the flush
+};
+
+class DisplayFlush {
+public:
+    static void begin(TFT_eSPI* display);
+    
+    // LVGL flush path: trims every row of the area to the visible circle
+    // (and to a running screen transition's revealed region)
+    static void flush(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p);
+    
+    static const FlushStats& getStats();
+    static void resetStats();
+
+private:
+    static TFT_eSPI* tft;
+    static FlushStats stats;
+    
+    static bool visibleSpan(int16_t y, const lv_area_t* area, int16_t& x1, int16_t& x2);
+    static void pushRows(const lv_area_t* area, lv_color_t* color_p, int16_t y1, int16_t y2);
+};
@@ -87,6 +87,10 @@ void HapticFeedback::writeRegister(uint8_t reg, uint8_t value) {
     Wire.endTransmission();
 }
 
+bool HapticFeedback::probe() {
+    return readRegister(DRV2605_STATUS) != 0xFF;
+}
+
 uint8_t HapticFeedback::readRegister(uint8_t reg) {
     Wire.beginTransmission(DRV2605_ADDR);
     Wire.write(reg);
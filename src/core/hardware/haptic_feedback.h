@@ -19,6 +19,9 @@ public:
     static bool isEnabled();
     static void playEffect(HapticEffect effect);
     
+    // One I2C status read - true if the DRV2605 answers (benchmarks the bus)
+    static bool probe();
+    
     // Convenience functions
     static void click();
     static void screenChange();
@@ -0,0 +1,214 @@
+#include "power_manager.h"
+#include "backlight.h"
+#include "rotary_encoder.h"
+#include <TFT_eSPI.h>  // TOUCH_IRQ pin from User_Setup.h, if wired
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+
+unsigned long (*PowerManager::clock)() = millis;
+std::function<void(bool)> PowerManager::display_power_callback = nullptr;
+std::function<void(bool)> PowerManager::network_power_callback = nullptr;
+PowerState PowerManager::state = POWER_ACTIVE;
+unsigned long PowerManager::last_activity = 0;
+unsigned long PowerManager::state_entered = 0;
+unsigned long PowerManager::wake_time = 0;
+bool PowerManager::awaiting_frame = false;
+bool PowerManager::woken = false;
+uint8_t PowerManager::active_brightness = 255;
+PowerStats PowerManager::stats;
+
+void PowerManager::begin() {
+    state = POWER_ACTIVE;
+    last_activity = clock();
+    state_entered = last_activity;
+    awaiting_frame = false;
+    woken = false;
+    active_brightness = Backlight::getBrightness();
+    stats = PowerStats();
+}
+
+void PowerManager::setClock(unsigned long (*new_clock)()) {
+    clock = new_clock;
+}
+
+void PowerManager::setDisplayPowerCallback(std::function<void(bool)> callback) {
+    display_power_callback = callback;
+}
+
+void PowerManager::setNetworkPowerCallback(std::function<void(bool)> callback) {
+    network_power_callback = callback;
+}
+
+bool PowerManager::notifyActivity() {
+    last_activity = clock();
+    if (state == POWER_ACTIVE) {
+        return false;
+    }
+    
+    // Dimmed still shows the screen, so only off/sleep swallow the event
+    bool was_dark = (state != POWER_DIMMED);
+    enterState(POWER_ACTIVE);
+    return was_dark;
+}
+
+void PowerManager::update() {
+    PowerState target = stateForIdleTime(clock() - last_activity);
+    if (target != state) {
+        enterState(target);
+    }
+    
+    if (state == POWER_LIGHT_SLEEP) {
+        enterLightSleep();
+    }
+}
+
+void PowerManager::notifyFrame() {
+    if (!awaiting_frame) return;
+    awaiting_frame = false;
+    
+    stats.last_wake_to_frame = clock() - wake_time;
+    if (stats.last_wake_to_frame > stats.max_wake_to_frame) {
+        stats.max_wake_to_frame = stats.last_wake_to_frame;
+    }
+    Serial.printf("Power: wake to first frame %lums\n", stats.last_wake_to_frame);
+}
+
+bool PowerManager::hasWoken() {
+    if (woken) {
+        woken = false;
+        return true;
+    }
+    return false;
+}
+
+PowerState PowerManager::getState() {
+    return state;
+}
+
+const char* PowerManager::getStateName(PowerState s) {
+    switch (s) {
+        case POWER_ACTIVE:      return "active";
+        case POWER_DIMMED:      return "dimmed";
+        case POWER_SCREEN_OFF:  return "screen off";
+        case POWER_LIGHT_SLEEP: return "light sleep";
+        default:                return "?";
+    }
+}
+
+bool PowerManager::isDisplayOff() {
+    return state == POWER_SCREEN_OFF || state == POWER_LIGHT_SLEEP;
+}
+
+void PowerManager::setActiveBrightness(uint8_t level) {
+    active_brightness = level;
+    if (state == POWER_ACTIVE) {
+        Backlight::setBrightness(level);
+    } else if (state == POWER_DIMMED) {
+        Backlight::setBrightness(level / 4);
+    }
+}
+
+uint8_t PowerManager::getActiveBrightness() {
+    return active_brightness;
+}
+
+float PowerManager::getDutyCycle(PowerState s) {
+    if (s >= POWER_STATE_COUNT) return 0.0f;
+    
+    unsigned long now = clock();
+    unsigned long total = 0;
+    unsigned long in_state = 0;
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        unsigned long t = stats.time_in_state[i];
+        if (i == state) {
+            t += now - state_entered;  // Include the running period
+        }
+        total += t;
+        if (i == s) in_state = t;
+    }
+    return total > 0 ? (100.0f * in_state) / total : 0.0f;
+}
+
+const PowerStats& PowerManager::getStats() {
+    return stats;
+}
+
+PowerState PowerManager::stateForIdleTime(unsigned long idle_ms) {
+    if (idle_ms >= SLEEP_AFTER_MS) return POWER_LIGHT_SLEEP;
+    if (idle_ms >= SCREEN_OFF_AFTER_MS) return POWER_SCREEN_OFF;
+    if (idle_ms >= DIM_AFTER_MS) return POWER_DIMMED;
+    return POWER_ACTIVE;
+}
+
+void PowerManager::enterState(PowerState new_state) {
+    unsigned long now = clock();
+    stats.time_in_state[state] += now - state_entered;
+    
+    bool was_off = isDisplayOff();
+    PowerState old_state = state;
+    state = new_state;
+    state_entered = now;
+    
+    switch (new_state) {
+        case POWER_ACTIVE:
+            Backlight::setBrightness(active_brightness);
+            break;
+        case POWER_DIMMED:
+            Backlight::setBrightness(active_brightness / 4);
+            break;
+        case POWER_SCREEN_OFF:
+        case POWER_LIGHT_SLEEP:
+            Backlight::setBrightness(0);
+            break;
+        default:
+            break;
+    }
+    
+    if (!was_off && isDisplayOff()) {
+        if (display_power_callback) display_power_callback(false);
+    } else if (was_off && !isDisplayOff()) {
+        // Panel back on - UI must be redrawn and the first frame timed
+        if (display_power_callback) display_power_callback(true);
+        wake_time = now;
+        awaiting_frame = true;
+        woken = true;
+        stats.wakes++;
+    }
+    
+    if (old_state != POWER_LIGHT_SLEEP && new_state == POWER_LIGHT_SLEEP) {
+        if (network_power_callback) network_power_callback(false);
+    } else if (old_state == POWER_LIGHT_SLEEP && new_state != POWER_LIGHT_SLEEP) {
+        if (network_power_callback) network_power_callback(true);
+    }
+    
+    Serial.printf("Power: %s -> %s (active %.1f%%, dimmed %.1f%%, off %.1f%%, sleep %.1f%%)\n",
+                  getStateName(old_state), getStateName(new_state),
+                  getDutyCycle(POWER_ACTIVE), getDutyCycle(POWER_DIMMED),
+                  getDutyCycle(POWER_SCREEN_OFF), getDutyCycle(POWER_LIGHT_SLEEP));
+}
+
+void PowerManager::enterLightSleep() {
+    // Encoder (and touch IRQ if wired) wake us; the timer lets loop() run
+    // scheduled work. WiFi was switched off on entering this state.
+    RotaryEncoder::enableWakeup();
+#ifdef TOUCH_IRQ
+    gpio_wakeup_enable((gpio_num_t)TOUCH_IRQ, GPIO_INTR_LOW_LEVEL);  // Active low pen IRQ
+#endif
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup(TIMER_WAKE_US);
+    
+    Serial.flush();
+    stats.sleep_cycles++;
+    esp_light_sleep_start();
+    
+    // Level-triggered wake replaced the encoder's edge interrupts
+    RotaryEncoder::disableWakeup();
+#ifdef TOUCH_IRQ
+    gpio_wakeup_disable((gpio_num_t)TOUCH_IRQ);
+#endif
+    
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO) {
+        notifyActivity();
+    }
+    // Timer wake: stay asleep, loop() runs once and we sleep again
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+// Power states, in order of increasing idle time
+enum PowerState {
+    POWER_ACTIVE = 0,       // Full backlight
+    POWER_DIMMED,           // Backlight dimmed via PWM
+    POWER_SCREEN_OFF,       // Backlight and panel off, LVGL paused
+    POWER_LIGHT_SLEEP,      // WiFi off, CPU in light sleep, woken by encoder/touch or the wake timer
+    POWER_STATE_COUNT
+};
+
+// Time spent per state and wake latency
+struct PowerStats {
+    unsigned long time_in_state[POWER_STATE_COUNT] = {};   // [ms]
+    uint32_t wakes = 0;
+    uint32_t sleep_cycles = 0;              // Light sleep entries (incl. timer wakes)
+    unsigned long last_wake_to_frame = 0;   // Wake until first flushed frame [ms]
+    unsigned long max_wake_to_frame = 0;
+};
+
+class PowerManager {
+public:
+    static void begin();
+    
+    // Clock source - millis() by default, replaceable with a simulated clock
+    static void setClock(unsigned long (*clock)());
+    
+    // Called with true to power the panel up, false to put it to sleep
+    static void setDisplayPowerCallback(std::function<void(bool)> callback);
+    
+    // Called with false on entering light sleep and true on leaving it.
+    // WiFi cannot stay associated through esp_light_sleep_start(), so the
+    // callback drops it and reconnects it (MQTT then resyncs its session).
+    static void setNetworkPowerCallback(std::function<void(bool)> callback);
+    
+    // Record user activity. Returns true if the device was dimmed or off,
+    // in which case the event only wakes it and should not be acted upon.
+    static bool notifyActivity();
+    
+    // Run the state machine (call at the end of loop)
+    static void update();
+    
+    // Call once a frame has been flushed - closes the wake latency measurement
+    static void notifyFrame();
+    
+    // Get wake event (for UI updates)
+    static bool hasWoken();
+    
+    static PowerState getState();
+    static const char* getStateName(PowerState state);
+    static bool isDisplayOff();
+    
+    // Backlight level used while active
+    static void setActiveBrightness(uint8_t level);
+    static uint8_t getActiveBrightness();
+    
+    // Share of uptime spent in a state (0-100)
+    static float getDutyCycle(PowerState state);
+    static const PowerStats& getStats();
+    
+    // State for a given idle time - pure, so transitions can be checked off-device
+    static PowerState stateForIdleTime(unsigned long idle_ms);
+
+private:
+    static constexpr unsigned long DIM_AFTER_MS = 30000;        // 30s
+    static constexpr unsigned long SCREEN_OFF_AFTER_MS = 120000; // 2min
+    static constexpr unsigned long SLEEP_AFTER_MS = 300000;     // 5min
+    static constexpr uint64_t TIMER_WAKE_US = 60000000;        // Wake every minute for clock-driven work (peak reset)
+    
+    static unsigned long (*clock)();
+    static std::function<void(bool)> display_power_callback;
+    static std::function<void(bool)> network_power_callback;
+    static PowerState state;
+    static unsigned long last_activity;
+    static unsigned long state_entered;
+    static unsigned long wake_time;
+    static bool awaiting_frame;
+    static bool woken;
+    static uint8_t active_brightness;
+    static PowerStats stats;
+    
+    static void enterState(PowerState new_state);
+    static void enterLightSleep();
+};
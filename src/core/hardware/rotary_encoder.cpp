@@ -1,5 +1,6 @@
 #include "rotary_encoder.h"
 #include "haptic_feedback.h"
+#include <driver/gpio.h>
 
 volatile bool RotaryEncoder::encoder_a_state = false;
 volatile bool RotaryEncoder::encoder_b_state = false;
@@ -53,6 +54,29 @@ int RotaryEncoder::getPositionChange() {
     return change;
 }
 
+void RotaryEncoder::enableWakeup() {
+    // GPIO wake is level triggered - wake on the opposite of the resting level
+    // so the first detent in either direction wakes the CPU. This replaces the
+    // pins' CHANGE interrupt type until disableWakeup().
+    gpio_wakeup_enable((gpio_num_t)ENCODER_PIN_A,
+                       digitalRead(ENCODER_PIN_A) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    gpio_wakeup_enable((gpio_num_t)ENCODER_PIN_B,
+                       digitalRead(ENCODER_PIN_B) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+}
+
+void RotaryEncoder::disableWakeup() {
+    // gpio_wakeup_disable() leaves the interrupt type disabled
+    gpio_wakeup_disable((gpio_num_t)ENCODER_PIN_A);
+    gpio_wakeup_disable((gpio_num_t)ENCODER_PIN_B);
+    
+    // The edges that woke us were not seen by the ISR - start from the
+    // current levels so they don't count as a step
+    encoder_a_state = digitalRead(ENCODER_PIN_A);
+    encoder_b_state = digitalRead(ENCODER_PIN_B);
+    attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_A), encoder_isr, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_B), encoder_isr, CHANGE);
+}
+
 void IRAM_ATTR RotaryEncoder::encoder_isr() {
     unsigned long now = millis();
     if (now - last_encoder_time < 2) return; // Simple debouncing
@@ -11,6 +11,12 @@ public:
     // Get encoder position change since last check
     static int getPositionChange();
     
+    // Arm both encoder pins as light sleep wake sources
+    static void enableWakeup();
+    
+    // After waking: disarm them and restore the CHANGE interrupts
+    static void disableWakeup();
+    
 private:
     static constexpr int ENCODER_PIN_A = 8;   // GPIO8
     static constexpr int ENCODER_PIN_B = 7;   // GPIO7
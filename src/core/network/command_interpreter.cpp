@@ -0,0 +1,525 @@
+#include "command_interpreter.h"
+#include "mqtt_manager.h"
+#include "time_sync.h"
+#include "trace_replay.h"
+#include "../hardware/haptic_feedback.h"
+#include "../hardware/power_manager.h"
+#include "../../features/energy/energy_data.h"
+#include "../../features/energy/peak_reset_scheduler.h"
+#include "../../ui_common/refresh_governor.h"
+#include "../../ui_common/memory_monitor.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+static const char* RESPONSE_TOPIC = "home/knob/response";
+
+void (*CommandInterpreter::screen_handler)(int) = nullptr;
+bool (*CommandInterpreter::bench_handler)(int) = nullptr;
+CommandStats CommandInterpreter::stats;
+
+// --- Compile-time dispatch tables ---------------------------------------
+
+typedef void (*CommandHandler)(const CommandToken* args, int argc, CommandReply& reply);
+
+struct CommandEntry {
+    const char* name;
+    uint8_t min_args;       // Not counting the verb
+    uint8_t max_args;
+    CommandHandler handler;
+    const char* usage;
+};
+
+// constexpr (C++11 rules) - the tables must be sorted for the binary search
+static constexpr int compareNames(const char* a, const char* b) {
+    return (*a != *b || *a == '\0') ? (unsigned char)*a - (unsigned char)*b : compareNames(a + 1, b + 1);
+}
+
+template <size_t N>
+static constexpr bool isSorted(const CommandEntry (&table)[N], size_t i = 1) {
+    return i >= N || (compareNames(table[i - 1].name, table[i].name) < 0 && isSorted(table, i + 1));
+}
+
+struct CommandTable {
+    static constexpr CommandEntry commands[] = {
+        {"bench",       0, 1, CommandInterpreter::cmdBench,      "bench [screen]"},
+        {"brightness",  1, 1, CommandInterpreter::cmdBrightness, "brightness <1-100>"},
+        {"channels",    1, 1, CommandInterpreter::cmdChannels,   "channels reset"},
+        {"haptic",      1, 1, CommandInterpreter::cmdHaptic,     "haptic on|off"},
+        {"help",        0, 0, CommandInterpreter::cmdHelp,       "help"},
+        {"mem",         0, 0, CommandInterpreter::cmdMem,        "mem"},
+        {"mock",        1, 1, CommandInterpreter::cmdMock,       "mock on|off"},
+        {"replay",      1, 1, CommandInterpreter::cmdReplay,     "replay realtime|max|stop|<speed>"},
+        {"reset_peaks", 0, 0, CommandInterpreter::cmdResetPeaks, "reset_peaks"},
+        {"screen",      1, 1, CommandInterpreter::cmdScreen,     "screen <0-3|name>"},
+        {"set",         2, 2, CommandInterpreter::cmdSet,        "set <key> <value>"},
+        {"stats",       0, 0, CommandInterpreter::cmdStats,      "stats"},
+    };
+    static constexpr size_t command_count = sizeof(commands) / sizeof(commands[0]);
+};
+
+constexpr CommandEntry CommandTable::commands[];
+static_assert(isSorted(CommandTable::commands), "Command table must be sorted by name");
+
+// Keys for "set <key> <value>"
+static void setNtpServer(const CommandToken& value, CommandReply& reply);
+static void setPeakReset(const CommandToken& value, CommandReply& reply);
+static void setTimezone(const CommandToken& value, CommandReply& reply);
+static void setExportPrice(const CommandToken& value, CommandReply& reply);
+static void setImportPrice(const CommandToken& value, CommandReply& reply);
+
+struct SettingEntry {
+    const char* name;
+    void (*apply)(const CommandToken& value, CommandReply& reply);
+};
+
+template <size_t N>
+static constexpr bool isSorted(const SettingEntry (&table)[N], size_t i = 1) {
+    return i >= N || (compareNames(table[i - 1].name, table[i].name) < 0 && isSorted(table, i + 1));
+}
+
+static constexpr SettingEntry SETTINGS[] = {
+    {"export_price", setExportPrice},
+    {"import_price", setImportPrice},       // Current tariff band
+    {"ntp_server",   setNtpServer},
+    {"peak_reset",   setPeakReset},
+    {"timezone",     setTimezone},
+};
+static constexpr size_t SETTING_COUNT = sizeof(SETTINGS) / sizeof(SETTINGS[0]);
+static_assert(isSorted(SETTINGS), "Settings table must be sorted by name");
+
+// Binary search on a token - no copy, no terminator needed
+template <typename Entry>
+static const Entry* findEntry(const Entry* table, size_t count, const CommandToken& name) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int cmp = strncmp(table[mid].name, name.data, name.length);
+        if (cmp == 0 && table[mid].name[name.length] != '\0') {
+            cmp = 1;    // Table name is longer than the token
+        }
+        if (cmp == 0) return &table[mid];
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
+
+// --- Tokens and replies --------------------------------------------------
+
+bool CommandToken::equals(const char* text) const {
+    return strncmp(text, data, length) == 0 && text[length] == '\0';
+}
+
+bool CommandToken::toInt(long& value) const {
+    if (length == 0) return false;
+    uint8_t i = 0;
+    bool negative = data[0] == '-';
+    if (negative || data[0] == '+') i++;
+    if (i == length) return false;
+    
+    long result = 0;
+    for (; i < length; i++) {
+        if (data[i] < '0' || data[i] > '9') return false;
+        result = result * 10 + (data[i] - '0');
+        if (result > 1000000L) return false;   // No command needs more
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+bool CommandToken::copy(char* out, size_t size) const {
+    if (length >= size) return false;
+    memcpy(out, data, length);
+    out[length] = '\0';
+    return true;
+}
+
+bool CommandToken::toFloat(float& value) const {
+    // strtof needs a terminator - bounded copy on the stack
+    char buffer[24];
+    if (length == 0 || !copy(buffer, sizeof(buffer))) return false;
+    char* end = nullptr;
+    value = strtof(buffer, &end);
+    return end == buffer + length && isfinite(value);
+}
+
+bool CommandToken::toSwitch(bool& value) const {
+    if (equals("on") || equals("1") || equals("true")) {
+        value = true;
+        return true;
+    }
+    if (equals("off") || equals("0") || equals("false")) {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+// Strings in replies are kept free of characters that need JSON escaping
+static void writeQuoted(char* out, int size, const char* format, va_list args) {
+    out[0] = '"';
+    int written = vsnprintf(out + 1, size - 2, format, args);
+    if (written < 0) written = 0;
+    if (written > size - 3) written = size - 3;
+    for (int i = 1; i <= written; i++) {
+        if (out[i] == '"' || out[i] == '\\' || (unsigned char)out[i] < 0x20) out[i] = '\'';
+    }
+    out[written + 1] = '"';
+    out[written + 2] = '\0';
+}
+
+void CommandReply::message(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeQuoted(result, MAX_RESULT, format, args);
+    va_end(args);
+    ok = true;
+}
+
+void CommandReply::json(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(result, MAX_RESULT, format, args);
+    va_end(args);
+    ok = true;
+}
+
+void CommandReply::error(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeQuoted(result, MAX_RESULT, format, args);
+    va_end(args);
+    ok = false;
+}
+
+// --- Interpreter ---------------------------------------------------------
+
+int CommandInterpreter::tokenize(const uint8_t* payload, unsigned int length, CommandToken* tokens, int max_tokens) {
+    if (length > MAX_COMMAND_LENGTH) return -1;
+    
+    int count = 0;
+    unsigned int i = 0;
+    while (i < length) {
+        uint8_t c = payload[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            i++;
+            continue;
+        }
+        if (c < 0x21 || c > 0x7E) return -1;    // Binary or non-ASCII
+        if (count == max_tokens) return -1;
+        
+        unsigned int start = i;
+        while (i < length && payload[i] > 0x20 && payload[i] < 0x7F) {
+            i++;
+        }
+        tokens[count].data = (const char*)payload + start;
+        tokens[count].length = (uint8_t)(i - start);
+        count++;
+    }
+    return count;
+}
+
+bool CommandInterpreter::execute(const uint8_t* payload, unsigned int length, CommandReply& reply) {
+    stats.received++;
+    
+    CommandToken tokens[MAX_TOKENS];
+    int count = tokenize(payload, length, tokens, MAX_TOKENS);
+    if (count <= 0) {
+        stats.rejected++;
+        reply.error(count < 0 ? "malformed command" : "empty command");
+        return false;
+    }
+    
+    const CommandEntry* entry = findEntry(CommandTable::commands, CommandTable::command_count, tokens[0]);
+    if (!entry) {
+        stats.rejected++;
+        reply.error("unknown command - try help");
+        return false;
+    }
+    
+    int argc = count - 1;
+    if (argc < entry->min_args || argc > entry->max_args) {
+        stats.rejected++;
+        reply.error("usage: %s", entry->usage);
+        return false;
+    }
+    
+    entry->handler(tokens, count, reply);
+    if (reply.ok) {
+        stats.executed++;
+    } else {
+        stats.rejected++;
+    }
+    return reply.ok;
+}
+
+void CommandInterpreter::execute(const uint8_t* payload, unsigned int length) {
+    CommandReply reply;
+    execute(payload, length, reply);
+    
+    CommandToken verb;
+    if (tokenize(payload, length, &verb, 1) != 1) {
+        verb = CommandToken();
+    }
+    publishReply(verb, reply);
+}
+
+void CommandInterpreter::publishReply(const CommandToken& verb, const CommandReply& reply) {
+    char response[224];
+    // A verb that failed tokenizing is reported as empty; others are printable ASCII
+    int verb_length = verb.length;
+    for (int i = 0; i < verb_length; i++) {
+        if (verb.data[i] == '"' || verb.data[i] == '\\') {
+            verb_length = i;
+            break;
+        }
+    }
+    snprintf(response, sizeof(response), "{\"cmd\":\"%.*s\",\"ok\":%s,\"result\":%s}",
+             verb_length, verb.data ? verb.data : "", reply.ok ? "true" : "false", reply.result);
+    Serial.printf("Command reply: %s\n", response);
+    MQTTManager::publish(RESPONSE_TOPIC, response, false, false);
+}
+
+void CommandInterpreter::setScreenHandler(void (*handler)(int screen)) {
+    screen_handler = handler;
+}
+
+void CommandInterpreter::setBenchHandler(bool (*handler)(int screen)) {
+    bench_handler = handler;
+}
+
+const CommandStats& CommandInterpreter::getStats() {
+    return stats;
+}
+
+bool CommandInterpreter::parseScreen(const CommandToken& token, int& screen) {
+    static const char* names[SCREEN_COUNT] = {"energy", "weather", "house", "settings"};
+    long index;
+    if (token.toInt(index)) {
+        if (index < 0 || index >= SCREEN_COUNT) return false;
+        screen = (int)index;
+        return true;
+    }
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+        if (token.equals(names[i])) {
+            screen = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Commands ------------------------------------------------------------
+
+void CommandInterpreter::cmdBench(const CommandToken* args, int argc, CommandReply& reply) {
+    int screen = -1;
+    if (argc > 1 && !parseScreen(args[1], screen)) {
+        reply.error("unknown screen");
+        return;
+    }
+    if (!bench_handler) {
+        reply.error("bench not available");
+        return;
+    }
+    if (!bench_handler(screen)) {
+        reply.error("bench already running");
+        return;
+    }
+    reply.message("bench started - results on home/knob/bench");
+}
+
+void CommandInterpreter::cmdBrightness(const CommandToken* args, int, CommandReply& reply) {
+    long percent;
+    if (!args[1].toInt(percent) || percent < 1 || percent > 100) {
+        reply.error("brightness 1-100");
+        return;
+    }
+    uint8_t level = (uint8_t)((percent * 255 + 50) / 100);
+    PowerManager::setActiveBrightness(level);
+    reply.json("%u", level);
+}
+
+void CommandInterpreter::cmdChannels(const CommandToken* args, int, CommandReply& reply) {
+    if (!args[1].equals("reset")) {
+        reply.error("channels reset");
+        return;
+    }
+    // A retained configuration would come back on the next connect
+    MQTTManager::resetChannels();
+    reply.message("%u default channels - clear the retained %s too",
+                  EnergyChannels::getCount(), CHANNEL_CONFIG_TOPIC);
+}
+
+void CommandInterpreter::cmdHaptic(const CommandToken* args, int, CommandReply& reply) {
+    bool enable;
+    if (!args[1].toSwitch(enable)) {
+        reply.error("haptic on|off");
+        return;
+    }
+    HapticFeedback::setEnabled(enable);
+    reply.json(enable ? "true" : "false");
+}
+
+void CommandInterpreter::cmdHelp(const CommandToken*, int, CommandReply& reply) {
+    // Verb names only - the full usage would not fit one reply
+    int written = snprintf(reply.result, CommandReply::MAX_RESULT, "\"");
+    for (size_t i = 0; i < CommandTable::command_count && written < CommandReply::MAX_RESULT; i++) {
+        written += snprintf(reply.result + written, CommandReply::MAX_RESULT - written, "%s%s",
+                            i ? " " : "", CommandTable::commands[i].name);
+    }
+    if (written < CommandReply::MAX_RESULT - 1) {
+        strcat(reply.result, "\"");
+    } else {
+        reply.message("help unavailable");
+    }
+    reply.ok = true;
+}
+
+void CommandInterpreter::cmdMem(const CommandToken*, int, CommandReply& reply) {
+    // Fresh reading rather than the last periodic sample
+    MemorySample now;
+    MemoryMonitor::sample(now);
+    reply.json("{\"used\":%lu,\"total\":%lu,\"peak\":%lu,\"largest_free\":%lu,\"frag\":%u,\"leak\":%s}",
+               (unsigned long)now.used, (unsigned long)now.total, (unsigned long)now.high_water,
+               (unsigned long)now.largest_free, now.frag_pct,
+               MemoryMonitor::isLeakSuspected() ? "true" : "false");
+}
+
+void CommandInterpreter::cmdMock(const CommandToken* args, int, CommandReply& reply) {
+    bool enable;
+    if (!args[1].toSwitch(enable)) {
+        reply.error("mock on|off");
+        return;
+    }
+    EnergyData_Manager::enableMockData(enable);
+    reply.json(enable ? "true" : "false");
+}
+
+void CommandInterpreter::cmdReplay(const CommandToken* args, int, CommandReply& reply) {
+    if (args[1].equals("stop")) {
+        if (!TraceReplay::isRunning()) {
+            reply.error("no replay running");
+            return;
+        }
+        TraceReplay::stop();
+        reply.json("%lu", (unsigned long)TraceReplay::getStats().messages);
+        return;
+    }
+    if (TraceReplay::isRunning()) {
+        reply.error("replay already running");
+        return;
+    }
+    
+    ReplayMode mode = REPLAY_ACCELERATED;
+    float speed = 1.0f;
+    if (args[1].equals("realtime")) {
+        mode = REPLAY_REALTIME;
+    } else if (args[1].equals("max")) {
+        mode = REPLAY_MAX_THROUGHPUT;
+    } else if (!args[1].toFloat(speed) || speed <= 0.0f || speed > 1000.0f) {
+        reply.error("replay realtime|max|stop|<speed>");
+        return;
+    }
+    if (!TraceReplay::startRecorded(mode, speed)) {
+        reply.error("bad built-in trace");
+        return;
+    }
+    reply.message("replay started - results on home/knob/bench");
+}
+
+void CommandInterpreter::cmdResetPeaks(const CommandToken*, int, CommandReply& reply) {
+    EnergyData_Manager::resetDailyPeaks();
+    reply.message("peaks reset");
+}
+
+void CommandInterpreter::cmdScreen(const CommandToken* args, int, CommandReply& reply) {
+    int screen;
+    if (!parseScreen(args[1], screen)) {
+        reply.error("unknown screen");
+        return;
+    }
+    if (!screen_handler) {
+        reply.error("screen switching not available");
+        return;
+    }
+    screen_handler(screen);
+    reply.json("%d", screen);
+}
+
+void CommandInterpreter::cmdSet(const CommandToken* args, int, CommandReply& reply) {
+    const SettingEntry* setting = findEntry(SETTINGS, SETTING_COUNT, args[1]);
+    if (!setting) {
+        reply.error("unknown key");
+        return;
+    }
+    setting->apply(args[2], reply);
+}
+
+void CommandInterpreter::cmdStats(const CommandToken*, int, CommandReply& reply) {
+    const FilterStats& filter = EnergyData_Manager::getFilterStats(FEED_BALANCE);
+    reply.json("{\"uptime\":%lu,\"heap\":%lu,\"power\":\"%s\",\"refresh\":%lu,"
+               "\"queue\":%u,\"frames\":%lu,\"glitches\":%lu,\"commands\":%lu}",
+               millis() / 1000, (unsigned long)ESP.getFreeHeap(),
+               PowerManager::getStateName(PowerManager::getState()),
+               (unsigned long)RefreshGovernor::getRefreshPeriod(),
+               MQTTManager::getQueueDepth(),
+               (unsigned long)EnergyFrameCodec::getStats().frames,
+               (unsigned long)filter.rejected,
+               (unsigned long)stats.executed);
+}
+
+// --- Settings ------------------------------------------------------------
+
+static void setPeakReset(const CommandToken& value, CommandReply& reply) {
+    char hhmm[8];
+    if (!value.copy(hhmm, sizeof(hhmm)) || !PeakResetScheduler::setResetTime(String(hhmm))) {
+        reply.error("expected HH:MM");
+        return;
+    }
+    reply.message("%02d:%02d", PeakResetScheduler::getResetHour(), PeakResetScheduler::getResetMinute());
+}
+
+static void setNtpServer(const CommandToken& value, CommandReply& reply) {
+    char host[64];
+    if (!value.copy(host, sizeof(host)) || !TimeSync::configure(String(host), TimeSync::getTimezone())) {
+        reply.error("invalid server");
+        return;
+    }
+    reply.message("%s", host);
+}
+
+static void setTimezone(const CommandToken& value, CommandReply& reply) {
+    char rule[64];
+    if (!value.copy(rule, sizeof(rule)) || !TimeSync::setTimezone(String(rule))) {
+        reply.error("invalid timezone rule");
+        return;
+    }
+    reply.message("%s", rule);
+}
+
+static void setExportPrice(const CommandToken& value, CommandReply& reply) {
+    float price;
+    if (!value.toFloat(price) || price < 0.0f) {
+        reply.error("expected price per kWh");
+        return;
+    }
+    EnergyData_Manager::setExportPrice(price);
+    reply.json("%.4f", price);
+}
+
+static void setImportPrice(const CommandToken& value, CommandReply& reply) {
+    float price;
+    if (!value.toFloat(price) || price < 0.0f) {
+        reply.error("expected price per kWh");
+        return;
+    }
+    int tariff = EnergyData_Manager::getCurrentData().tariff;
+    EnergyData_Manager::setImportPrice(tariff, price);
+    reply.json("{\"tariff\":%d,\"price\":%.4f}", tariff, price);
+}
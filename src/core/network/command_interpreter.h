@@ -0,0 +1,82 @@
+#pragma once
+#include <Arduino.h>
+
+// View into the command payload - never copied, never NUL-terminated
+struct CommandToken {
+    const char* data = nullptr;
+    uint8_t length = 0;
+    
+    bool equals(const char* text) const;
+    bool toInt(long& value) const;
+    bool toFloat(float& value) const;
+    bool toSwitch(bool& value) const;      // on/off, 1/0, true/false
+    bool copy(char* out, size_t size) const;    // NUL-terminated copy, false if too long
+};
+
+// Reply to one command, published to the response topic as
+// {"cmd":"<verb>","ok":true|false,"result":<value>}
+struct CommandReply {
+    static const int MAX_RESULT = 160;
+    char result[MAX_RESULT] = "null";       // JSON value
+    bool ok = true;
+    
+    void message(const char* format, ...);  // Quoted string result
+    void json(const char* format, ...);     // Raw JSON result
+    void error(const char* format, ...);    // Quoted string, ok = false
+};
+
+struct CommandStats {
+    uint32_t received = 0;
+    uint32_t executed = 0;
+    uint32_t rejected = 0;      // Malformed, unknown verb or bad arguments
+};
+
+// Text commands on home/knob/command, e.g. "screen 2", "set peak_reset 00:00".
+// Tokenised in place; verbs are looked up in a sorted table checked at compile time.
+class CommandInterpreter {
+public:
+    static const int MAX_TOKENS = 4;
+    static const unsigned int MAX_COMMAND_LENGTH = 128;
+    
+    // Parse and run a command; the reply is queued on the response topic
+    static void execute(const uint8_t* payload, unsigned int length);
+    
+    // Same, returning the reply instead of publishing it
+    static bool execute(const uint8_t* payload, unsigned int length, CommandReply& reply);
+    
+    // Split into whitespace separated tokens. Returns the token count, or -1
+    // for control characters, over-long input or too many tokens.
+    static int tokenize(const uint8_t* payload, unsigned int length, CommandToken* tokens, int max_tokens);
+    
+    // Hooks into main.cpp - screen index, and bench run (-1 = all screens,
+    // returns false if one is already running)
+    static void setScreenHandler(void (*handler)(int screen));
+    static void setBenchHandler(bool (*handler)(int screen));
+    
+    static const CommandStats& getStats();
+
+private:
+    static void (*screen_handler)(int);
+    static bool (*bench_handler)(int);
+    static CommandStats stats;
+    
+    static void publishReply(const CommandToken& verb, const CommandReply& reply);
+    
+    // Handlers - args[0] is the verb
+    static void cmdBench(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdBrightness(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdChannels(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdHaptic(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdHelp(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdMem(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdMock(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdReplay(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdResetPeaks(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdScreen(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdSet(const CommandToken* args, int argc, CommandReply& reply);
+    static void cmdStats(const CommandToken* args, int argc, CommandReply& reply);
+    
+    static bool parseScreen(const CommandToken& token, int& screen);
+    
+    friend struct CommandTable;
+};
@@ -0,0 +1,79 @@
+#include "energy_frame.h"
+#include <string.h>
+#include <math.h>
+
+FrameStats EnergyFrameCodec::stats;
+uint16_t EnergyFrameCodec::last_sequence = 0;
+bool EnergyFrameCodec::have_sequence = false;
+
+bool EnergyFrameCodec::decode(const uint8_t* payload, unsigned int length, EnergyFrame& frame) {
+    if (length != FRAME_SIZE || payload[0] != ENERGY_FRAME_VERSION) {
+        stats.malformed++;
+        return false;
+    }
+    
+    frame.fields = payload[1];
+    frame.sequence = (uint16_t)(payload[2] | (payload[3] << 8));
+    frame.balance = readFloat(payload + 4);
+    frame.solar = readFloat(payload + 8);
+    frame.used = readFloat(payload + 12);
+    frame.vrms = readFloat(payload + 16);
+    frame.tariff = payload[20];
+    
+    // NaN/inf would poison the integrators - drop the field, keep the rest
+    if (!isfinite(frame.balance)) frame.fields &= ~ENERGY_FRAME_BALANCE;
+    if (!isfinite(frame.solar)) frame.fields &= ~ENERGY_FRAME_SOLAR;
+    if (!isfinite(frame.used)) frame.fields &= ~ENERGY_FRAME_USED;
+    if (!isfinite(frame.vrms)) frame.fields &= ~ENERGY_FRAME_VRMS;
+    if (frame.tariff < 1 || frame.tariff > 4) frame.fields &= ~ENERGY_FRAME_TARIFF;
+    return true;
+}
+
+unsigned int EnergyFrameCodec::encode(const EnergyFrame& frame, uint8_t* buffer, unsigned int size) {
+    if (size < FRAME_SIZE) return 0;
+    
+    buffer[0] = ENERGY_FRAME_VERSION;
+    buffer[1] = frame.fields;
+    buffer[2] = frame.sequence & 0xFF;
+    buffer[3] = frame.sequence >> 8;
+    writeFloat(buffer + 4, frame.balance);
+    writeFloat(buffer + 8, frame.solar);
+    writeFloat(buffer + 12, frame.used);
+    writeFloat(buffer + 16, frame.vrms);
+    buffer[20] = frame.tariff;
+    return FRAME_SIZE;
+}
+
+bool EnergyFrameCodec::acceptSequence(uint16_t sequence) {
+    if (have_sequence) {
+        // Serial number arithmetic - "ahead" means within half the range
+        int16_t ahead = (int16_t)(sequence - last_sequence);
+        if (ahead <= 0 && ahead > -REORDER_WINDOW) {
+            stats.duplicates++;
+            return false;
+        }
+        // A big jump back is the publisher restarting its count
+        if (ahead > 0) {
+            stats.missed += ahead - 1;
+        }
+    }
+    last_sequence = sequence;
+    have_sequence = true;
+    stats.frames++;
+    return true;
+}
+
+const FrameStats& EnergyFrameCodec::getStats() {
+    return stats;
+}
+
+// ESP32 is little-endian like the wire format; memcpy avoids unaligned access
+float EnergyFrameCodec::readFloat(const uint8_t* p) {
+    float value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void EnergyFrameCodec::writeFloat(uint8_t* p, float value) {
+    memcpy(p, &value, sizeof(value));
+}
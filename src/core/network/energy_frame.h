@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+
+// Combined EmonTX3 update on one topic, instead of one ASCII float per topic.
+// Packed little-endian, 21 bytes:
+//   uint8  version      (ENERGY_FRAME_VERSION)
+//   uint8  fields       (ENERGY_FRAME_* bits - absent fields are left unchanged)
+//   uint16 sequence     (wraps; repeats and reordered frames are dropped)
+//   float  balance [W], solar [W], used [W], vrms [V]
+//   uint8  tariff       (1-4)
+#define ENERGY_FRAME_TOPIC "emon/emontx3/frame"
+#define ENERGY_FRAME_VERSION 1
+
+enum EnergyFrameField {
+    ENERGY_FRAME_BALANCE = 1 << 0,
+    ENERGY_FRAME_SOLAR   = 1 << 1,
+    ENERGY_FRAME_USED    = 1 << 2,
+    ENERGY_FRAME_VRMS    = 1 << 3,
+    ENERGY_FRAME_TARIFF  = 1 << 4
+};
+
+struct EnergyFrame {
+    uint8_t fields = 0;
+    uint16_t sequence = 0;
+    float balance = 0.0f;
+    float solar = 0.0f;
+    float used = 0.0f;
+    float vrms = 0.0f;
+    uint8_t tariff = 1;
+};
+
+struct FrameStats {
+    uint32_t frames = 0;        // Decoded and applied
+    uint32_t malformed = 0;     // Wrong size/version
+    uint32_t duplicates = 0;    // Repeated or older sequence
+    uint32_t missed = 0;        // Sequence gaps
+};
+
+class EnergyFrameCodec {
+public:
+    static const unsigned int FRAME_SIZE = 21;
+    static const int16_t REORDER_WINDOW = 16;   // Further back is a publisher restart
+    
+    // Decode in place - no allocation. False if the payload is not a frame.
+    static bool decode(const uint8_t* payload, unsigned int length, EnergyFrame& frame);
+    
+    // Encode for publishing/tests. Returns bytes written (0 if buffer too small).
+    static unsigned int encode(const EnergyFrame& frame, uint8_t* buffer, unsigned int size);
+    
+    // Sequence check - false for a repeat or reordered frame (counts gaps)
+    static bool acceptSequence(uint16_t sequence);
+    
+    static const FrameStats& getStats();
+
+private:
+    static FrameStats stats;
+    static uint16_t last_sequence;
+    static bool have_sequence;
+    
+    static float readFloat(const uint8_t* p);
+    static void writeFloat(uint8_t* p, float value);
+};
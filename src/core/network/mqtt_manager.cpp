@@ -1,4 +1,11 @@
 #include "mqtt_manager.h"
+#include "time_sync.h"
+#include "energy_frame.h"
+#include "command_interpreter.h"
+#include "../../features/energy/mock_scenario.h"
+#include "../../features/energy/peak_reset_scheduler.h"
+#include "../../features/weather/weather_data.h"
+#include "../../features/house_info/diagnostics_data.h"
 
 // Static member definitions
 WiFiClient MQTTManager::espClient;
@@ -13,14 +20,32 @@ String MQTTManager::mqtt_password = "";
 String MQTTManager::mqtt_client_id = "ESP32-Knob-";
 int MQTTManager::mqtt_port = 1883;
 
-// MQTT Topics to subscribe to (EmonTX3 + control topics)
+bool MQTTManager::persistent_session = true;
+bool MQTTManager::resuming = false;
+unsigned long MQTTManager::connect_time = 0;
+SessionStats MQTTManager::session_stats;
+
+MQTTManager::OutboundMessage MQTTManager::outbound[MQTTManager::QUEUE_SIZE];
+uint8_t MQTTManager::outbound_head = 0;
+uint8_t MQTTManager::outbound_count = 0;
+unsigned long MQTTManager::batch_start = 0;
+PublishStats MQTTManager::publish_stats;
+
+const char* MQTTManager::STATUS_TOPIC = "home/knob/status";
+
+// MQTT Topics to subscribe to - the energy channel topics come from EnergyChannels
 const char* MQTTManager::topics[] = {
     "home/knob/command",        // Device control
-    "emon/emontx3/balance",     // Grid balance (import/export)
-    "emon/emontx3/solar",       // Solar generation
-    "emon/emontx3/vrms",        // Voltage RMS
-    "emon/emontx3/used",        // House usage
-    "emon/emontx3/tariff"       // Tariff information
+    "home/knob/config/peak_reset",  // Daily peak reset time "HH:MM"
+    "home/knob/config/timezone",    // POSIX TZ rule
+    CHANNEL_CONFIG_TOPIC,       // Energy channel set
+    MOCK_SCENARIO_TOPIC,        // Mock data script
+    ENERGY_FRAME_TOPIC,         // All fields in one binary frame
+    TARIFF_TOPIC,               // Tariff information
+    WEATHER_TOPIC_PREFIX "temperature",     // Outside temperature (°C)
+    WEATHER_TOPIC_PREFIX "humidity",        // Relative humidity (%)
+    WEATHER_TOPIC_PREFIX "condition",       // Condition name
+    WEATHER_TOPIC_PREFIX "forecast"         // Today's "high,low,condition"
 };
 
 const int MQTTManager::num_topics = sizeof(MQTTManager::topics) / sizeof(MQTTManager::topics[0]);
@@ -35,6 +60,9 @@ void MQTTManager::begin() {
     
     // Set default callback
     mqtt.setCallback(defaultCallback);
+    
+    // The default 256 bytes can't hold a channel configuration
+    mqtt.setBufferSize(EnergyChannels::MAX_CONFIG_LENGTH + 128);
 }
 
 void MQTTManager::configure(const String& server, int port, const String& username, const String& password) {
@@ -53,21 +81,30 @@ bool MQTTManager::connect() {
     
     Serial.printf("Attempting MQTT connection to %s:%d...", mqtt_server.c_str(), mqtt_port);
     
-    bool connected = false;
-    if (mqtt_username.length() > 0) {
-        connected = mqtt.connect(mqtt_client_id.c_str(), mqtt_username.c_str(), mqtt_password.c_str());
-    } else {
-        connected = mqtt.connect(mqtt_client_id.c_str());
-    }
+    // The client ID is derived from the MAC, so it is stable across reboots -
+    // that is what lets the broker find our session again
+    bool has_credentials = mqtt_username.length() > 0;
+    bool connected = mqtt.connect(mqtt_client_id.c_str(),
+                                  has_credentials ? mqtt_username.c_str() : nullptr,
+                                  has_credentials ? mqtt_password.c_str() : nullptr,
+                                  STATUS_TOPIC, 1, true, "{\"mqtt\":false}",    // Retained will clears our status
+                                  !persistent_session);
     
     if (connected) {
         Serial.println(" connected!");
+        // The sequence carries over - the session redelivers unacked frames
         subscribeToTopics();
+        session_stats.connects++;
+        session_stats.resume_messages = 0;
+        connect_time = millis();
+        resuming = true;
         mqtt_connected = true;
+        publishStatus();
         status_changed = true;
         return true;
     } else {
         Serial.printf(" failed, rc=%d\n", mqtt.state());
+        DiagnosticsData_Manager::recordError("MQTT connect", mqtt.state());
         mqtt_connected = false;
         return false;
     }
@@ -89,21 +126,157 @@ void MQTTManager::process() {
     updateConnectionStatus();
     
     if (mqtt_connected) {
-        mqtt.loop();
+        // After a reconnect the broker replays the queued backlog at once -
+        // drain a bounded number per call instead of one per loop()
+        int handled = 0;
+        do {
+            mqtt.loop();
+            handled++;
+        } while (handled < MAX_MESSAGES_PER_PROCESS && espClient.available() > 0);
+        
+        // Caught up: the receive buffer is empty and live data has resumed
+        if (resuming && espClient.available() == 0 && session_stats.resume_messages > 0) {
+            resuming = false;
+            session_stats.last_resume_ms = millis() - connect_time;
+            if (session_stats.last_resume_ms > session_stats.max_resume_ms) {
+                session_stats.max_resume_ms = session_stats.last_resume_ms;
+            }
+            Serial.printf("MQTT resumed in %lums (%lu messages)\n",
+                          session_stats.last_resume_ms, (unsigned long)session_stats.resume_messages);
+        }
+        
+        flushOutbound();
     }
 }
 
 void MQTTManager::subscribeToTopics() {
     for (int i = 0; i < num_topics; i++) {
-        mqtt.subscribe(topics[i]);
-        Serial.printf("Subscribed to: %s\n", topics[i]);
+        // QoS1 - the broker keeps these for us while disconnected and
+        // redelivers until acknowledged (PubSubClient sends the PUBACK)
+        mqtt.subscribe(topics[i], SUBSCRIBE_QOS);
+        Serial.printf("Subscribed to: %s (QoS%d)\n", topics[i], SUBSCRIBE_QOS);
     }
+    subscribeChannels();
 }
 
 void MQTTManager::setCallback(void (*callback)(char*, byte*, unsigned int)) {
     mqtt.setCallback(callback);
 }
 
+void MQTTManager::injectMessage(char* topic, byte* payload, unsigned int length) {
+    defaultCallback(topic, payload, length);
+}
+
+bool MQTTManager::publish(const char* topic, const char* payload, bool retained, bool coalesce) {
+    size_t topic_length = strlen(topic);
+    size_t payload_length = strlen(payload);
+    if (topic_length >= sizeof(outbound[0].topic) || payload_length >= sizeof(outbound[0].payload)) {
+        publish_stats.dropped++;
+        Serial.printf("MQTT publish too long for queue: %s\n", topic);
+        return false;
+    }
+    // The client builds the whole packet in its buffer and refuses anything larger
+    if (MQTT_MAX_HEADER_SIZE + 2 + topic_length + payload_length > mqtt.getBufferSize()) {
+        publish_stats.dropped++;
+        Serial.printf("MQTT publish too long for client buffer: %s\n", topic);
+        return false;
+    }
+    
+    // Device state: only the latest value matters
+    if (coalesce) {
+        for (uint8_t i = 0; i < outbound_count; i++) {
+            OutboundMessage& pending = outbound[(outbound_head + i) % QUEUE_SIZE];
+            if (strcmp(pending.topic, topic) == 0) {
+                strcpy(pending.payload, payload);
+                pending.retained = retained;
+                pending.attempts = 0;
+                publish_stats.coalesced++;
+                return true;
+            }
+        }
+    }
+    
+    // Full - the oldest message is the least useful one
+    if (outbound_count == QUEUE_SIZE) {
+        outbound_head = (outbound_head + 1) % QUEUE_SIZE;
+        outbound_count--;
+        publish_stats.dropped++;
+    }
+    
+    if (outbound_count == 0) {
+        batch_start = millis();
+    }
+    OutboundMessage& message = outbound[(outbound_head + outbound_count) % QUEUE_SIZE];
+    strcpy(message.topic, topic);
+    strcpy(message.payload, payload);
+    message.retained = retained;
+    message.attempts = 0;
+    outbound_count++;
+    
+    publish_stats.queued++;
+    if (outbound_count > publish_stats.max_depth) {
+        publish_stats.max_depth = outbound_count;
+    }
+    return true;
+}
+
+uint8_t MQTTManager::getQueueDepth() {
+    return outbound_count;
+}
+
+const PublishStats& MQTTManager::getPublishStats() {
+    return publish_stats;
+}
+
+void MQTTManager::flushOutbound() {
+    if (outbound_count == 0) {
+        return;
+    }
+    // Wait for the batch window unless the queue is filling up
+    if (millis() - batch_start < BATCH_WINDOW_MS && outbound_count < QUEUE_SIZE / 2) {
+        return;
+    }
+    
+    for (int sent = 0; sent < MAX_PUBLISH_PER_PROCESS && outbound_count > 0; sent++) {
+        OutboundMessage& message = outbound[outbound_head];
+        if (!mqtt.publish(message.topic, message.payload, message.retained)) {
+            publish_stats.failed++;
+            if (++message.attempts < MAX_PUBLISH_ATTEMPTS) {
+                break;  // Socket busy - keep it queued for the next pass
+            }
+            // Refused every time - don't let it block the messages behind it
+            publish_stats.dropped++;
+            Serial.printf("MQTT publish failed %d times, dropped: %s\n", MAX_PUBLISH_ATTEMPTS, message.topic);
+        } else {
+            publish_stats.published++;
+        }
+        outbound_head = (outbound_head + 1) % QUEUE_SIZE;
+        outbound_count--;
+    }
+    batch_start = millis();
+}
+
+void MQTTManager::publishStatus() {
+    // Retained, so anything subscribing later sees the current state
+    char status[96];
+    snprintf(status, sizeof(status), "{\"wifi\":true,\"mqtt\":true,\"ip\":\"%s\"}",
+             WiFi.localIP().toString().c_str());
+    publish(STATUS_TOPIC, status, true);
+}
+
+void MQTTManager::setPersistentSession(bool persistent) {
+    // Takes effect on the next connect
+    persistent_session = persistent;
+}
+
+bool MQTTManager::isResuming() {
+    return resuming;
+}
+
+const SessionStats& MQTTManager::getSessionStats() {
+    return session_stats;
+}
+
 void MQTTManager::updateConnectionStatus() {
     bool current_status = mqtt.connected();
     
@@ -117,6 +290,54 @@ void MQTTManager::updateConnectionStatus() {
 }
 
 void MQTTManager::defaultCallback(char* topic, byte* payload, unsigned int length) {
+    session_stats.messages++;
+    if (resuming) {
+        session_stats.resume_messages++;
+    }
+    
+    // Binary frame - decoded straight from the receive buffer, all fields applied at once
+    if (strcmp(topic, ENERGY_FRAME_TOPIC) == 0) {
+        EnergyFrame frame;
+        if (EnergyFrameCodec::decode(payload, length, frame) &&
+            EnergyFrameCodec::acceptSequence(frame.sequence)) {
+            EnergyData_Manager::applyFrame(frame);
+        }
+        return;
+    }
+    
+    // Commands are tokenised in place and answered on home/knob/response
+    if (strcmp(topic, "home/knob/command") == 0) {
+        CommandInterpreter::execute(payload, length);
+        return;
+    }
+    
+    // Channel values are parsed straight from the receive buffer
+    int channel = EnergyChannels::findByTopic(topic);
+    if (channel >= 0) {
+        CommandToken value[2];
+        float number;
+        if (CommandInterpreter::tokenize(payload, length, value, 2) == 1 && value[0].toFloat(number)) {
+            EnergyData_Manager::updateChannel(channel, number);
+        }
+        return;
+    }
+    
+    if (strcmp(topic, CHANNEL_CONFIG_TOPIC) == 0) {
+        applyChannelConfig(payload, length);
+        return;
+    }
+    
+    if (strcmp(topic, MOCK_SCENARIO_TOPIC) == 0) {
+        EnergyData_Manager::loadMockScenario(payload, length);
+        return;
+    }
+    
+    // Weather values are parsed straight from the receive buffer
+    if (strncmp(topic, WEATHER_TOPIC_PREFIX, sizeof(WEATHER_TOPIC_PREFIX) - 1) == 0) {
+        WeatherData_Manager::handleMessage(topic, payload, length);
+        return;
+    }
+    
     // Convert payload to string
     String message = "";
     for (int i = 0; i < length; i++) {
@@ -128,18 +349,56 @@ void MQTTManager::defaultCallback(char* topic, byte* payload, unsigned int lengt
     // Route messages to appropriate handlers
     String topic_str = String(topic);
     
-    if (topic_str == "emon/emontx3/balance") {
-        EnergyData_Manager::updateBalance(message.toFloat());
-    } else if (topic_str == "emon/emontx3/solar") {
-        EnergyData_Manager::updateSolar(message.toFloat());
-    } else if (topic_str == "emon/emontx3/vrms") {
-        EnergyData_Manager::updateVrms(message.toFloat());
-    } else if (topic_str == "emon/emontx3/used") {
-        EnergyData_Manager::updateUsed(message.toFloat());
-    } else if (topic_str == "emon/emontx3/tariff") {
+    if (topic_str == TARIFF_TOPIC) {
         EnergyData_Manager::updateTariff(message);
-    } else if (topic_str == "home/knob/command") {
-        // Handle device commands here
-        Serial.printf("Device command received: %s\n", message.c_str());
+    } else if (topic_str == "home/knob/config/peak_reset") {
+        if (!PeakResetScheduler::setResetTime(message)) {
+            Serial.printf("Invalid peak reset time: %s\n", message.c_str());
+        }
+    } else if (topic_str == "home/knob/config/timezone") {
+        TimeSync::setTimezone(message);
+    }
+}
+
+void MQTTManager::subscribeChannels() {
+    for (int i = 0; i < EnergyChannels::getCount(); i++) {
+        const char* topic = EnergyChannels::getConfig(i).topic;
+        mqtt.subscribe(topic, SUBSCRIBE_QOS);
+        Serial.printf("Subscribed to: %s (QoS%d)\n", topic, SUBSCRIBE_QOS);
+    }
+}
+
+void MQTTManager::applyChannelConfig(byte* payload, unsigned int length) {
+    // The old topics are needed after the payload is consumed - unsubscribe
+    // reuses the client's buffer the payload lives in
+    ChannelTopics old;
+    saveChannelTopics(old);
+    
+    uint32_t generation = EnergyChannels::getGeneration();
+    if (!EnergyData_Manager::configureChannels(payload, length) ||
+        EnergyChannels::getGeneration() == generation) {
+        return;
+    }
+    resubscribeChannels(old);
+}
+
+void MQTTManager::resetChannels() {
+    ChannelTopics old;
+    saveChannelTopics(old);
+    EnergyData_Manager::resetChannels();
+    resubscribeChannels(old);
+}
+
+void MQTTManager::saveChannelTopics(ChannelTopics& old) {
+    old.count = EnergyChannels::getCount();
+    for (int i = 0; i < old.count; i++) {
+        strcpy(old.topic[i], EnergyChannels::getConfig(i).topic);
+    }
+}
+
+void MQTTManager::resubscribeChannels(const ChannelTopics& old) {
+    for (int i = 0; i < old.count; i++) {
+        mqtt.unsubscribe(old.topic[i]);
     }
+    subscribeChannels();
 }
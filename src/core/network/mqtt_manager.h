@@ -4,6 +4,25 @@
 #include <PubSubClient.h>
 #include "../../features/energy/energy_data.h"
 
+// Session behaviour across reconnects
+struct SessionStats {
+    uint32_t connects = 0;
+    uint32_t messages = 0;              // All messages received
+    uint32_t resume_messages = 0;       // Delivered in the backlog burst of the last reconnect
+    unsigned long last_resume_ms = 0;   // Connect until the backlog was drained
+    unsigned long max_resume_ms = 0;
+};
+
+// Outbound queue counters
+struct PublishStats {
+    uint32_t queued = 0;
+    uint32_t coalesced = 0;             // Replaced a pending message on the same topic
+    uint32_t published = 0;
+    uint32_t dropped = 0;               // Queue full (oldest dropped), too long, or failed every attempt
+    uint32_t failed = 0;                // Client refused the write - retried next batch
+    uint8_t max_depth = 0;
+};
+
 class MQTTManager {
 public:
     // Initialize MQTT management
@@ -30,6 +49,24 @@ public:
     // Set message callback
     static void setCallback(void (*callback)(char*, byte*, unsigned int));
     
+    // Feed a message through the default handler as if received (trace replay)
+    static void injectMessage(char* topic, byte* payload, unsigned int length);
+    
+    // Queue a message for publishing - never blocks. With coalesce, a pending
+    // message on the same topic is replaced rather than sent twice.
+    static bool publish(const char* topic, const char* payload, bool retained = false, bool coalesce = true);
+    static uint8_t getQueueDepth();
+    static const PublishStats& getPublishStats();
+    
+    // Persistent session: the broker queues QoS1 messages while we are away
+    // and delivers them on reconnect. On by default.
+    static void setPersistentSession(bool persistent);
+    static bool isResuming();
+    static const SessionStats& getSessionStats();
+    
+    // Drop the stored channel configuration for the defaults (`channels reset`)
+    static void resetChannels();
+    
 private:
     static WiFiClient espClient;
     static PubSubClient mqtt;
@@ -48,6 +85,44 @@ private:
     static const char* topics[];
     static const int num_topics;
     
+    static const char* STATUS_TOPIC;
+    static const uint8_t SUBSCRIBE_QOS = 1;
+    static const int MAX_MESSAGES_PER_PROCESS = 8;      // Bounds a backlog burst per loop()
+    static bool persistent_session;
+    static bool resuming;
+    static unsigned long connect_time;
+    static SessionStats session_stats;
+    
+    // Outbound ring - fixed slots, no allocation
+    struct OutboundMessage {
+        char topic[48];
+        char payload[224];     // Fits a full command reply
+        bool retained;
+        uint8_t attempts;      // Failed publishes so far
+    };
+    static const uint8_t QUEUE_SIZE = 16;
+    static const unsigned long BATCH_WINDOW_MS = 100;   // Gather messages before sending
+    static const int MAX_PUBLISH_PER_PROCESS = 4;
+    static const uint8_t MAX_PUBLISH_ATTEMPTS = 5;      // Then the message is dropped, not retried forever
+    static OutboundMessage outbound[QUEUE_SIZE];
+    static uint8_t outbound_head;
+    static uint8_t outbound_count;
+    static unsigned long batch_start;
+    static PublishStats publish_stats;
+    
+    static void flushOutbound();
+    static void publishStatus();
+    
     static void updateConnectionStatus();
     static void defaultCallback(char* topic, byte* payload, unsigned int length);
+    static void subscribeChannels();
+    static void applyChannelConfig(byte* payload, unsigned int length);
+    
+    // Topics of the channel set being replaced
+    struct ChannelTopics {
+        char topic[EnergyChannels::MAX_CHANNELS][sizeof(ChannelConfig::topic)];
+        int count;
+    };
+    static void saveChannelTopics(ChannelTopics& old);
+    static void resubscribeChannels(const ChannelTopics& old);
 };
@@ -0,0 +1,113 @@
+#include "time_sync.h"
+#include <Preferences.h>
+#include <esp_sntp.h>
+
+// Static member definitions
+time_t (*TimeSync::clock)() = TimeSync::systemTime;
+String TimeSync::ntp_server = "pool.ntp.org";
+String TimeSync::timezone = "GMT0BST,M3.5.0/1,M10.5.0";  // UK (EmonTX3 default)
+volatile bool TimeSync::synced = false;
+volatile bool TimeSync::time_changed = false;
+
+void TimeSync::begin() {
+    Preferences prefs;
+    prefs.begin("time", true);
+    ntp_server = prefs.getString("ntp_server", ntp_server);
+    timezone = prefs.getString("timezone", timezone);
+    prefs.end();
+    
+    synced = false;
+    sntp_set_time_sync_notification_cb(onTimeSync);
+    configTzTime(timezone.c_str(), ntp_server.c_str());
+    
+    Serial.printf("NTP sync started: %s, TZ %s\n", ntp_server.c_str(), timezone.c_str());
+}
+
+bool TimeSync::configure(const String& server, const String& tz) {
+    if (server.length() == 0 || tz.length() == 0) {
+        return false;
+    }
+    if (server == ntp_server && tz == timezone) {
+        return true;
+    }
+    ntp_server = server;
+    timezone = tz;
+    store("ntp_server", ntp_server);
+    store("timezone", timezone);
+    
+    // Sets TZ as well - the new rule or server may move the reset
+    configTzTime(timezone.c_str(), ntp_server.c_str());
+    time_changed = true;
+    Serial.printf("NTP server %s, TZ %s\n", ntp_server.c_str(), timezone.c_str());
+    return true;
+}
+
+const String& TimeSync::getServer() {
+    return ntp_server;
+}
+
+bool TimeSync::setTimezone(const String& tz) {
+    if (tz.length() == 0) {
+        return false;
+    }
+    if (tz == timezone) {
+        return true;
+    }
+    timezone = tz;
+    store("timezone", timezone);
+    
+    applyTimezone();
+    Serial.printf("Timezone set: %s\n", timezone.c_str());
+    return true;
+}
+
+const String& TimeSync::getTimezone() {
+    return timezone;
+}
+
+void TimeSync::setClock(time_t (*new_clock)()) {
+    clock = new_clock;
+}
+
+time_t TimeSync::now() {
+    return clock();
+}
+
+bool TimeSync::isSynced() {
+    return synced;
+}
+
+bool TimeSync::hasTimeChanged() {
+    if (time_changed) {
+        time_changed = false;
+        return true;
+    }
+    return false;
+}
+
+void TimeSync::applyTimezone() {
+    setenv("TZ", timezone.c_str(), 1);
+    tzset();
+    time_changed = true;
+}
+
+// NVS pages wear with every write, and retained settings are redelivered
+// on each reconnect - only write values that differ from the stored ones
+void TimeSync::store(const char* key, const String& value) {
+    Preferences prefs;
+    prefs.begin("time", false);
+    if (prefs.getString(key, "") != value) {
+        prefs.putString(key, value);
+    }
+    prefs.end();
+}
+
+time_t TimeSync::systemTime() {
+    return time(nullptr);
+}
+
+void TimeSync::onTimeSync(struct timeval*) {
+    // Runs in the SNTP task - only set flags here
+    synced = true;
+    time_changed = true;
+}
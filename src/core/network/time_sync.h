@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+class TimeSync {
+public:
+    // Start SNTP with the stored (or default) server and timezone
+    static void begin();
+    
+    // Set NTP server and POSIX TZ rule (e.g. "GMT0BST,M3.5.0/1,M10.5.0"),
+    // persisted. Restarts SNTP only if either changed.
+    static bool configure(const String& server, const String& timezone);
+    static const String& getServer();
+    
+    // Change the timezone rule only (persisted). Setting the rule already in
+    // use - e.g. a retained message redelivered - writes nothing.
+    static bool setTimezone(const String& timezone);
+    static const String& getTimezone();
+    
+    // Wall clock source - time() by default, replaceable with a simulated clock
+    static void setClock(time_t (*clock)());
+    static time_t now();
+    
+    // Check if the clock has been set by NTP
+    static bool isSynced();
+    
+    // Get clock change - NTP sync or timezone change (for rescheduling)
+    static bool hasTimeChanged();
+    
+private:
+    static time_t (*clock)();
+    static String ntp_server;
+    static String timezone;
+    static volatile bool synced;
+    static volatile bool time_changed;
+    
+    static void applyTimezone();
+    static void store(const char* key, const String& value);
+    static time_t systemTime();
+    static void onTimeSync(struct timeval* tv);
+};
@@ -0,0 +1,237 @@
+#include "trace_replay.h"
+#include "mqtt_manager.h"
+#include "../../emon_trace.h"
+
+const uint8_t* TraceReplay::trace = nullptr;
+size_t TraceReplay::trace_length = 0;
+size_t TraceReplay::position = 0;
+TraceFormat TraceReplay::format = TRACE_CSV;
+ReplayMode TraceReplay::mode = REPLAY_REALTIME;
+float TraceReplay::speed = 1.0f;
+bool TraceReplay::running = false;
+
+uint32_t TraceReplay::first_timestamp = 0;
+unsigned long TraceReplay::start_time = 0;
+unsigned long TraceReplay::pixel_pending_since = 0;
+ReplayStats TraceReplay::stats;
+
+uint32_t TraceReplay::record_timestamp = 0;
+char TraceReplay::record_topic[TraceReplay::MAX_TOPIC];
+uint8_t TraceReplay::record_payload[TraceReplay::MAX_PAYLOAD];
+unsigned int TraceReplay::record_payload_length = 0;
+bool TraceReplay::record_ready = false;
+
+bool TraceReplay::start(const uint8_t* data, size_t length, TraceFormat trace_format,
+                        ReplayMode replay_mode, float replay_speed) {
+    trace = data;
+    trace_length = length;
+    position = 0;
+    format = trace_format;
+    mode = replay_mode;
+    speed = (replay_speed > 0.0f) ? replay_speed : 1.0f;
+    stats = ReplayStats();
+    pixel_pending_since = 0;
+    record_ready = false;
+    
+    if (format == TRACE_BINARY) {
+        if (length < 5 || memcmp(data, "EMTR", 4) != 0 || data[4] != 1) {
+            Serial.println("Trace replay: bad binary header");
+            return false;
+        }
+        position = 5;
+    }
+    
+    if (!readRecord()) {
+        Serial.println("Trace replay: empty trace");
+        return false;
+    }
+    
+    first_timestamp = record_timestamp;
+    start_time = millis();
+    running = true;
+    Serial.printf("Trace replay started (%s, x%.1f)\n",
+                  mode == REPLAY_MAX_THROUGHPUT ? "max" : (mode == REPLAY_ACCELERATED ? "accelerated" : "realtime"),
+                  speed);
+    return true;
+}
+
+bool TraceReplay::startRecorded(ReplayMode replay_mode, float replay_speed) {
+    return start(emon_trace, sizeof(emon_trace), TRACE_BINARY, replay_mode, replay_speed);
+}
+
+void TraceReplay::stop() {
+    if (running) {
+        finish();
+    }
+}
+
+void TraceReplay::update() {
+    if (!running) return;
+    
+    if (mode == REPLAY_MAX_THROUGHPUT) {
+        // One message per loop pass, so the UI work between messages is included
+        dispatchRecord();
+    } else {
+        unsigned long elapsed = millis() - start_time;
+        float factor = (mode == REPLAY_ACCELERATED) ? speed : 1.0f;
+        
+        while (record_ready) {
+            unsigned long due = (unsigned long)((record_timestamp - first_timestamp) / factor);
+            if (due > elapsed) break;
+            
+            if (elapsed - due > stats.max_lag_ms) {
+                stats.max_lag_ms = elapsed - due;
+            }
+            dispatchRecord();
+        }
+    }
+    
+    if (!record_ready) {
+        finish();
+    }
+}
+
+void TraceReplay::notifyFrame() {
+    if (pixel_pending_since == 0) return;
+    
+    uint32_t latency = micros() - pixel_pending_since;
+    stats.pixel_us_total += latency;
+    if (latency > stats.pixel_us_max) stats.pixel_us_max = latency;
+    stats.frames++;
+    pixel_pending_since = 0;
+}
+
+bool TraceReplay::isRunning() {
+    return running;
+}
+
+const ReplayStats& TraceReplay::getStats() {
+    return stats;
+}
+
+float TraceReplay::getMessageRate() {
+    unsigned long elapsed = running ? millis() - start_time : stats.elapsed_ms;
+    return elapsed > 0 ? stats.messages * 1000.0f / elapsed : 0.0f;
+}
+
+bool TraceReplay::readRecord() {
+    record_ready = (format == TRACE_BINARY) ? readBinaryRecord() : readCsvRecord();
+    return record_ready;
+}
+
+bool TraceReplay::readCsvRecord() {
+    while (position < trace_length) {
+        // Find the end of the line
+        size_t line_start = position;
+        size_t line_end = position;
+        while (line_end < trace_length && trace[line_end] != '\n') line_end++;
+        position = (line_end < trace_length) ? line_end + 1 : line_end;
+        
+        size_t end = line_end;
+        if (end > line_start && trace[end - 1] == '\r') end--;
+        if (end == line_start || trace[line_start] == '#') continue;
+        
+        // <timestamp>,<topic>,<payload> - the payload may itself contain commas
+        const uint8_t* line = trace + line_start;
+        size_t len = end - line_start;
+        size_t comma1 = 0;
+        while (comma1 < len && line[comma1] != ',') comma1++;
+        size_t comma2 = comma1 + 1;
+        while (comma2 < len && line[comma2] != ',') comma2++;
+        
+        size_t topic_len = comma2 - comma1 - 1;
+        size_t payload_len = (comma2 < len) ? len - comma2 - 1 : 0;
+        if (comma1 == 0 || comma2 >= len || topic_len == 0 ||
+            topic_len >= MAX_TOPIC || payload_len > MAX_PAYLOAD) {
+            stats.parse_errors++;
+            continue;
+        }
+        
+        uint32_t timestamp = 0;
+        bool digits_ok = true;
+        for (size_t i = 0; i < comma1; i++) {
+            if (line[i] < '0' || line[i] > '9') { digits_ok = false; break; }
+            timestamp = timestamp * 10 + (line[i] - '0');
+        }
+        if (!digits_ok) {
+            stats.parse_errors++;
+            continue;
+        }
+        
+        record_timestamp = timestamp;
+        memcpy(record_topic, line + comma1 + 1, topic_len);
+        record_topic[topic_len] = '\0';
+        memcpy(record_payload, line + comma2 + 1, payload_len);
+        record_payload_length = payload_len;
+        return true;
+    }
+    return false;
+}
+
+bool TraceReplay::readBinaryRecord() {
+    if (position + 6 > trace_length) return false;
+    
+    const uint8_t* p = trace + position;
+    uint32_t timestamp = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    size_t topic_len = p[4];
+    size_t payload_len = p[5];
+    
+    if (position + 6 + topic_len + payload_len > trace_length ||
+        topic_len == 0 || topic_len >= MAX_TOPIC || payload_len > MAX_PAYLOAD) {
+        stats.parse_errors++;
+        return false;  // Can't resync a corrupt binary stream
+    }
+    
+    record_timestamp = timestamp;
+    memcpy(record_topic, p + 6, topic_len);
+    record_topic[topic_len] = '\0';
+    memcpy(record_payload, p + 6 + topic_len, payload_len);
+    record_payload_length = payload_len;
+    position += 6 + topic_len + payload_len;
+    return true;
+}
+
+void TraceReplay::dispatchRecord() {
+    unsigned long start_us = micros();
+    if (pixel_pending_since == 0) {
+        pixel_pending_since = start_us ? start_us : 1;
+    }
+    
+    MQTTManager::injectMessage(record_topic, record_payload, record_payload_length);
+    
+    uint32_t state_us = micros() - start_us;
+    stats.state_us_total += state_us;
+    if (state_us > stats.state_us_max) stats.state_us_max = state_us;
+    stats.messages++;
+    
+    readRecord();
+}
+
+void TraceReplay::finish() {
+    running = false;
+    stats.elapsed_ms = millis() - start_time;
+    
+    uint32_t messages = stats.messages > 0 ? stats.messages : 1;
+    uint32_t frames = stats.frames > 0 ? stats.frames : 1;
+    bool sustained = (mode == REPLAY_MAX_THROUGHPUT) || stats.max_lag_ms <= LAG_LIMIT_MS;
+    
+    Serial.printf("Trace replay: %lu msgs in %lums (%.1f msg/s%s), parse errors %lu\n",
+                  (unsigned long)stats.messages, stats.elapsed_ms, getMessageRate(),
+                  sustained ? "" : " - NOT sustained", (unsigned long)stats.parse_errors);
+    Serial.printf("  msg->state avg %luus max %luus | msg->pixel avg %luus max %luus | max lag %lums\n",
+                  (unsigned long)(stats.state_us_total / messages), (unsigned long)stats.state_us_max,
+                  (unsigned long)(stats.pixel_us_total / frames), (unsigned long)stats.pixel_us_max,
+                  stats.max_lag_ms);
+    
+    // Alongside the bench cases, for a replay started by the "replay" command
+    char result[224];
+    snprintf(result, sizeof(result),
+             "{\"case\":\"replay\",\"n\":%lu,\"ms\":%lu,\"rate\":%lu,\"sustained\":%s,"
+             "\"state_us\":[%lu,%lu],\"pixel_us\":[%lu,%lu],\"lag_ms\":%lu,\"errors\":%lu}",
+             (unsigned long)stats.messages, stats.elapsed_ms, (unsigned long)getMessageRate(),
+             sustained ? "true" : "false",
+             (unsigned long)(stats.state_us_total / messages), (unsigned long)stats.state_us_max,
+             (unsigned long)(stats.pixel_us_total / frames), (unsigned long)stats.pixel_us_max,
+             stats.max_lag_ms, (unsigned long)stats.parse_errors);
+    MQTTManager::publish("home/knob/bench", result, false, false);
+}
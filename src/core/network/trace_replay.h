@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Recorded emon/emontx3/* traffic, replayed through MQTTManager's message
+// handler exactly as if it had arrived from the broker.
+//
+// CSV format - one message per line, '#' starts a comment:
+//     <timestamp_ms>,<topic>,<payload>
+//
+// Binary format - little endian:
+//     "EMTR" magic, uint8 version (1), then per record:
+//     uint32 timestamp_ms, uint8 topic_len, uint8 payload_len, topic, payload
+//
+// simulator/emon_trace.py captures traces from a broker and converts
+// between the two formats. The trace built into the firmware is
+// src/emon_trace.h - a synthetic sample until replaced with a capture.
+enum TraceFormat {
+    TRACE_CSV = 0,
+    TRACE_BINARY
+};
+
+enum ReplayMode {
+    REPLAY_REALTIME = 0,    // Original spacing
+    REPLAY_ACCELERATED,     // Spacing divided by the speed factor
+    REPLAY_MAX_THROUGHPUT   // One message per update(), as fast as the loop runs
+};
+
+// Replay results
+struct ReplayStats {
+    uint32_t messages = 0;
+    uint32_t frames = 0;                // Flushes that followed a replayed message
+    unsigned long elapsed_ms = 0;
+    uint32_t state_us_total = 0;        // Message handler time (message -> EnergyData)
+    uint32_t state_us_max = 0;
+    uint32_t pixel_us_total = 0;        // Message -> first flushed pixel
+    uint32_t pixel_us_max = 0;
+    unsigned long max_lag_ms = 0;       // Furthest behind schedule
+    uint32_t parse_errors = 0;
+};
+
+class TraceReplay {
+public:
+    // Start replaying a trace held in memory (not copied - must stay valid)
+    static bool start(const uint8_t* data, size_t length, TraceFormat format,
+                      ReplayMode mode, float speed = 1.0f);
+    // Start replaying the trace built into the firmware (src/emon_trace.h)
+    static bool startRecorded(ReplayMode mode, float speed = 1.0f);
+    static void stop();
+    
+    // Dispatch due messages (call in loop)
+    static void update();
+    
+    // Call after a frame has been flushed - closes message-to-pixel measurement
+    static void notifyFrame();
+    
+    static bool isRunning();
+    static const ReplayStats& getStats();
+    
+    // Messages per second achieved (max sustainable rate in REPLAY_MAX_THROUGHPUT)
+    static float getMessageRate();
+    
+private:
+    static constexpr size_t MAX_TOPIC = 64;
+    static constexpr size_t MAX_PAYLOAD = 64;
+    static constexpr unsigned long LAG_LIMIT_MS = 1000;  // Behind by more = not sustainable
+    
+    static const uint8_t* trace;
+    static size_t trace_length;
+    static size_t position;
+    static TraceFormat format;
+    static ReplayMode mode;
+    static float speed;
+    static bool running;
+    
+    static uint32_t first_timestamp;
+    static unsigned long start_time;
+    static unsigned long pixel_pending_since;   // micros() of the oldest undrawn message, 0 if none
+    static ReplayStats stats;
+    
+    // Current record (copied so topic/payload are null-terminated)
+    static uint32_t record_timestamp;
+    static char record_topic[MAX_TOPIC];
+    static uint8_t record_payload[MAX_PAYLOAD];
+    static unsigned int record_payload_length;
+    static bool record_ready;
+    
+    static bool readRecord();
+    static bool readCsvRecord();
+    static bool readBinaryRecord();
+    static void dispatchRecord();
+    static void finish();
+};
@@ -1,10 +1,14 @@
 #include "wifi_manager.h"
+#include "../../features/house_info/diagnostics_data.h"
 
 // Static member definitions
 WiFiManager WiFiManagerWrapper::wm;
 bool WiFiManagerWrapper::wifi_connected = false;
 bool WiFiManagerWrapper::last_wifi_status = false;
 bool WiFiManagerWrapper::status_changed = false;
+bool WiFiManagerWrapper::ever_connected = false;
+bool WiFiManagerWrapper::suspended = false;
+uint32_t WiFiManagerWrapper::reconnect_count = 0;
 
 void WiFiManagerWrapper::begin() {
     wifi_connected = false;
@@ -41,6 +45,8 @@ void WiFiManagerWrapper::setupWiFi() {
     Serial.println(WiFi.localIP());
     
     wifi_connected = true;
+    last_wifi_status = true;
+    ever_connected = true;
     status_changed = true;
 }
 
@@ -53,6 +59,10 @@ bool WiFiManagerWrapper::isConnected() {
     return wifi_connected;
 }
 
+uint32_t WiFiManagerWrapper::getReconnectCount() {
+    return reconnect_count;
+}
+
 bool WiFiManagerWrapper::hasStatusChanged() {
     if (status_changed) {
         status_changed = false;
@@ -68,6 +78,18 @@ void WiFiManagerWrapper::reset() {
     ESP.restart();
 }
 
+void WiFiManagerWrapper::suspend() {
+    suspended = true;
+    WiFi.disconnect(true);  // Radio off, credentials kept
+    Serial.println("WiFi suspended");
+}
+
+void WiFiManagerWrapper::resume() {
+    // Still suspended until the connection is back, so the gap isn't an error
+    WiFi.begin();
+    Serial.println("WiFi resuming");
+}
+
 void WiFiManagerWrapper::updateConnectionStatus() {
     bool current_status = (WiFi.status() == WL_CONNECTED);
     
@@ -75,6 +97,15 @@ void WiFiManagerWrapper::updateConnectionStatus() {
         wifi_connected = current_status;
         last_wifi_status = current_status;
         status_changed = true;
+        if (current_status) {
+            if (ever_connected && !suspended) {
+                reconnect_count++;
+            }
+            ever_connected = true;
+            suspended = false;
+        } else if (!suspended) {
+            DiagnosticsData_Manager::recordError("WiFi lost", WiFi.status());
+        }
         
         Serial.printf("WiFi status changed: %s\n", wifi_connected ? "Connected" : "Disconnected");
     }
@@ -20,14 +20,25 @@ public:
     // Get connection status change (for UI updates)
     static bool hasStatusChanged();
     
+    // Times the connection came back after being lost
+    static uint32_t getReconnectCount();
+    
     // Reset WiFi settings (for settings menu)
     static void reset();
     
+    // Switch the radio off for light sleep / back on with the stored
+    // credentials. The drop is not reported as an error or a reconnect.
+    static void suspend();
+    static void resume();
+    
 private:
     static WiFiManager wm;
     static bool wifi_connected;
     static bool last_wifi_status;
     static bool status_changed;
+    static bool ever_connected;
+    static bool suspended;
+    static uint32_t reconnect_count;
     
     static void updateConnectionStatus();
 };
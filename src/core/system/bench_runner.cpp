@@ -0,0 +1,132 @@
+#include "bench_runner.h"
+#include <stdio.h>
+
+uint32_t (*BenchRunner::clock_us)() = nullptr;
+void (*BenchRunner::report)(const char*) = nullptr;
+BenchCase BenchRunner::cases[BenchRunner::MAX_CASES];
+BenchResult BenchRunner::results[BenchRunner::MAX_CASES];
+int BenchRunner::case_count = 0;
+int BenchRunner::current_case = 0;
+uint32_t BenchRunner::iterations = 0;
+uint32_t BenchRunner::started_us = 0;
+bool BenchRunner::running = false;
+
+void BenchRunner::begin(uint32_t (*clock)(), void (*report_fn)(const char*)) {
+    clock_us = clock;
+    report = report_fn;
+    clear();
+}
+
+void BenchRunner::clear() {
+    case_count = 0;
+    running = false;
+}
+
+bool BenchRunner::addCase(const BenchCase& bench) {
+    if (running || case_count == MAX_CASES || !bench.run) {
+        return false;
+    }
+    cases[case_count++] = bench;
+    return true;
+}
+
+bool BenchRunner::start(uint32_t count) {
+    if (running || case_count == 0 || !clock_us) {
+        return false;
+    }
+    for (int i = 0; i < case_count; i++) {
+        results[i] = BenchResult();
+    }
+    iterations = count > 0 ? count : DEFAULT_ITERATIONS;
+    current_case = 0;
+    started_us = clock_us();
+    running = true;
+    return true;
+}
+
+bool BenchRunner::isRunning() {
+    return running;
+}
+
+bool BenchRunner::update() {
+    if (!running) {
+        return false;
+    }
+    uint32_t step_start = clock_us();
+    while (running && clock_us() - step_start < STEP_BUDGET_US) {
+        runOnce();
+    }
+    return running;
+}
+
+void BenchRunner::runToCompletion() {
+    while (running) {
+        runOnce();
+    }
+}
+
+int BenchRunner::getCaseCount() {
+    return case_count;
+}
+
+const BenchResult& BenchRunner::getResult(int index) {
+    if (index < 0 || index >= case_count) index = 0;
+    return results[index];
+}
+
+int BenchRunner::formatResult(int index, char* out, size_t size) {
+    if (index < 0 || index >= case_count) return 0;
+    const BenchResult& result = results[index];
+    uint32_t avg = result.iterations ? result.total_us / result.iterations : 0;
+    uint32_t aux_avg = result.iterations ? result.aux_us / result.iterations : 0;
+    return snprintf(out, size,
+                    "{\"case\":\"%s\",\"n\":%lu,\"avg_us\":%lu,\"min_us\":%lu,\"max_us\":%lu,"
+                    "\"aux_us\":%lu,\"aux_count\":%lu}",
+                    cases[index].name, (unsigned long)result.iterations, (unsigned long)avg,
+                    (unsigned long)(result.iterations ? result.min_us : 0), (unsigned long)result.max_us,
+                    (unsigned long)aux_avg,
+                    (unsigned long)(result.iterations ? result.aux_count / result.iterations : 0));
+}
+
+void BenchRunner::runOnce() {
+    BenchCase& bench = cases[current_case];
+    BenchResult& result = results[current_case];
+    
+    uint32_t start = clock_us();
+    bench.run(bench.arg);
+    uint32_t elapsed = clock_us() - start;
+    
+    result.iterations++;
+    result.total_us += elapsed;
+    if (elapsed < result.min_us) result.min_us = elapsed;
+    if (elapsed > result.max_us) result.max_us = elapsed;
+    if (bench.aux) {
+        uint32_t aux_us = 0;
+        uint32_t aux_count = 0;
+        bench.aux(aux_us, aux_count);
+        result.aux_us += aux_us;
+        result.aux_count += aux_count;
+    }
+    
+    if (result.iterations >= iterations) {
+        current_case++;
+        if (current_case == case_count) {
+            finish();
+        }
+    }
+}
+
+void BenchRunner::finish() {
+    running = false;
+    if (!report) {
+        return;
+    }
+    char json[192];
+    for (int i = 0; i < case_count; i++) {
+        formatResult(i, json, sizeof(json));
+        report(json);
+    }
+    snprintf(json, sizeof(json), "{\"done\":true,\"cases\":%d,\"iterations\":%lu,\"elapsed_ms\":%lu}",
+             case_count, (unsigned long)iterations, (unsigned long)((clock_us() - started_us) / 1000));
+    report(json);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Platform-neutral benchmark harness - no Arduino or LVGL dependency, so the
+// same code times cases on the knob and in the [env:native] host build.
+
+// One benchmark case. run() is timed once per iteration; aux(), if set, is
+// called after each run to report time/count spent in a sub-stage of it
+// (e.g. the SPI flush inside a render).
+struct BenchCase {
+    const char* name;
+    void (*run)(int arg);
+    int arg;
+    void (*aux)(uint32_t& us, uint32_t& count);
+};
+
+struct BenchResult {
+    uint32_t iterations = 0;
+    uint32_t total_us = 0;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint32_t aux_us = 0;
+    uint32_t aux_count = 0;
+};
+
+class BenchRunner {
+public:
+    static const int MAX_CASES = 20;
+    static const uint32_t DEFAULT_ITERATIONS = 20;
+    static const uint32_t STEP_BUDGET_US = 20000;   // Per update() - the caller's loop keeps running
+    
+    // clock_us: microsecond clock. report: receives one JSON object per case,
+    // then a summary, when the run completes.
+    static void begin(uint32_t (*clock_us)(), void (*report)(const char* json));
+    
+    static void clear();
+    static bool addCase(const BenchCase& bench);
+    
+    static bool start(uint32_t iterations = DEFAULT_ITERATIONS);
+    static bool isRunning();
+    
+    // Run iterations for up to STEP_BUDGET_US. Returns true while running.
+    static bool update();
+    
+    // Run everything now (host build - nothing else needs the CPU)
+    static void runToCompletion();
+    
+    static int getCaseCount();
+    static const BenchResult& getResult(int index);
+    static int formatResult(int index, char* out, size_t size);
+
+private:
+    static uint32_t (*clock_us)();
+    static void (*report)(const char* json);
+    static BenchCase cases[MAX_CASES];
+    static BenchResult results[MAX_CASES];
+    static int case_count;
+    static int current_case;
+    static uint32_t iterations;
+    static uint32_t started_us;
+    static bool running;
+    
+    static void runOnce();
+    static void finish();
+};
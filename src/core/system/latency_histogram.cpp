@@ -0,0 +1,63 @@
+#include "latency_histogram.h"
+#include <string.h>
+
+void LatencyHistogram::record(uint32_t us) {
+    counts[bucketOf(us)]++;
+    count++;
+    if (us > max_us) {
+        max_us = us;
+    }
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t pct) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t target = ((uint64_t)count * pct + 99) / 100;
+    if (target == 0) {
+        target = 1;
+    }
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= target) {
+            uint32_t upper = bucketUpper(b);
+            return upper < max_us ? upper : max_us;
+        }
+    }
+    return max_us;
+}
+
+void LatencyHistogram::decay() {
+    count = 0;
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+        counts[b] >>= 1;
+        count += counts[b];
+    }
+}
+
+void LatencyHistogram::reset() {
+    memset(counts, 0, sizeof(counts));
+    count = 0;
+    max_us = 0;
+}
+
+uint8_t LatencyHistogram::bucketOf(uint32_t us) {
+    if (us < SUB_BUCKETS) {
+        return us;      // 0-3 exact
+    }
+    // Top bit picks the octave, the next two bits the quarter within it
+    uint8_t msb = 31 - __builtin_clz(us);
+    uint8_t sub = (us >> (msb - 2)) & (SUB_BUCKETS - 1);
+    uint32_t bucket = (uint32_t)(msb - 1) * SUB_BUCKETS + sub;
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketUpper(uint8_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    uint8_t msb = bucket / SUB_BUCKETS + 1;
+    uint32_t lower = (uint32_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << (msb - 2);
+    return lower + (1UL << (msb - 2)) - 1;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+
+// Log-linear histogram of durations in microseconds: 4 buckets per power of
+// two (within 25%), 1us to ~8s. record() is a count-leading-zeros and an
+// increment, so it can sit in the main loop; percentiles scan 88 counters.
+// decay() halves every bucket, which turns the totals into a recent window
+// without the jumps of a periodic reset.
+class LatencyHistogram {
+public:
+    static constexpr uint8_t SUB_BUCKETS = 4;
+    static constexpr uint8_t BUCKETS = 88;
+
+    void record(uint32_t us);
+
+    // Upper bound of the bucket holding the pct-th percentile (0 when empty)
+    uint32_t percentile(uint8_t pct) const;
+
+    void decay();
+    void reset();
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMax() const { return max_us; }
+
+private:
+    uint32_t counts[BUCKETS] = {};
+    uint32_t count = 0;
+    uint32_t max_us = 0;        // Since the last reset
+
+    static uint8_t bucketOf(uint32_t us);
+    static uint32_t bucketUpper(uint8_t bucket);
+};
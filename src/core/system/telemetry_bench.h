@@ -0,0 +1,83 @@
+#pragma once
+#include "telemetry_kernels.h"
+#include "bench_runner.h"
+
+// Benchmark cases for the TelemetryKernels paths. Registered both on the
+// knob (UIBench) and in the [env:native] host build. Timing only - the paths
+// are checked against the reference in test/test_telemetry_store.
+class TelemetryBench {
+public:
+    static void addCases() {
+        BenchRunner::addCase({"telemetry_reference", runMinMaxSum, PATH_REFERENCE, nullptr});
+        BenchRunner::addCase({"telemetry_portable", runMinMaxSum, PATH_PORTABLE, nullptr});
+#if TELEMETRY_PIE
+        BenchRunner::addCase({"telemetry_pie", runMinMaxSum, PATH_PIE, nullptr});
+#endif
+        BenchRunner::addCase({"telemetry_trapezoid", runTrapezoid, 0, nullptr});
+    }
+
+private:
+    static const uint32_t SAMPLES = 512;        // One TelemetryStore column
+    static const int PASSES = 64;               // Per iteration, above the clock resolution
+
+    enum Path {
+        PATH_REFERENCE = 0,
+        PATH_PORTABLE,
+        PATH_PIE
+    };
+
+    struct Samples {
+        alignas(16) int16_t values[SAMPLES];
+        alignas(16) uint32_t times[SAMPLES];
+    };
+
+    // Power-like values at irregular ~1s spacing, the same on every build
+    static const Samples& samples() {
+        static Samples s;
+        static bool filled = false;
+        if (!filled) {
+            uint32_t seed = 12345;
+            uint32_t t = 0;
+            for (uint32_t i = 0; i < SAMPLES; i++) {
+                seed = seed * 1103515245u + 12345u;
+                s.values[i] = (int16_t)((int32_t)(seed >> 16) % 8001 - 4000);
+                t += 500 + (seed >> 8) % 1000;
+                s.times[i] = t;
+            }
+            filled = true;
+        }
+        return s;
+    }
+
+    static void runMinMaxSum(int path) {
+        const Samples& s = samples();
+        int64_t total = 0;
+        for (int pass = 0; pass < PASSES; pass++) {
+            KernelResult result;
+            if (path == PATH_REFERENCE) {
+                result = TelemetryKernels::minMaxSumReference(s.values, SAMPLES);
+            } else if (path == PATH_PORTABLE) {
+                result = TelemetryKernels::minMaxSumPortable(s.values, SAMPLES);
+            } else {
+                result = TelemetryKernels::minMaxSum(s.values, SAMPLES);
+            }
+            total += result.min + result.max + result.sum;
+        }
+        sink() = (int32_t)total;
+    }
+
+    static void runTrapezoid(int) {
+        const Samples& s = samples();
+        int64_t total = 0;
+        for (int pass = 0; pass < PASSES; pass++) {
+            total += TelemetryKernels::trapezoid(s.values, s.times, SAMPLES);
+        }
+        sink() = (int32_t)total;
+    }
+
+    // Keeps results alive under optimisation
+    static volatile int32_t& sink() {
+        static volatile int32_t value;
+        return value;
+    }
+};
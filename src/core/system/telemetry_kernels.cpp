@@ -0,0 +1,164 @@
+#include "telemetry_kernels.h"
+
+static void merge(KernelResult& into, const KernelResult& part) {
+    if (part.min < into.min) into.min = part.min;
+    if (part.max > into.max) into.max = part.max;
+    into.sum += part.sum;
+}
+
+KernelResult TelemetryKernels::minMaxSum(const int16_t* v, uint32_t n) {
+#if TELEMETRY_PIE
+    return minMaxSumPie(v, n);
+#else
+    return minMaxSumPortable(v, n);
+#endif
+}
+
+KernelResult TelemetryKernels::minMaxSumReference(const int16_t* v, uint32_t n) {
+    KernelResult result;
+    result.min = v[0];
+    result.max = v[0];
+    for (uint32_t i = 0; i < n; i++) {
+        if (v[i] < result.min) result.min = v[i];
+        if (v[i] > result.max) result.max = v[i];
+        result.sum += v[i];
+    }
+    return result;
+}
+
+KernelResult TelemetryKernels::minMaxSumPortable(const int16_t* v, uint32_t n) {
+    // Independent lanes with no branches - one vector op each on the host
+    int16_t lane_min[LANES];
+    int16_t lane_max[LANES];
+    int32_t lane_sum[LANES];
+    for (int l = 0; l < LANES; l++) {
+        lane_min[l] = v[0];
+        lane_max[l] = v[0];
+        lane_sum[l] = 0;
+    }
+
+    uint32_t blocks = n / LANES;
+    for (uint32_t b = 0; b < blocks; b++) {
+        const int16_t* block = v + b * LANES;
+        for (int l = 0; l < LANES; l++) {
+            int16_t x = block[l];
+            lane_min[l] = x < lane_min[l] ? x : lane_min[l];
+            lane_max[l] = x > lane_max[l] ? x : lane_max[l];
+            lane_sum[l] += x;
+        }
+    }
+
+    KernelResult result;
+    result.min = lane_min[0];
+    result.max = lane_max[0];
+    for (int l = 0; l < LANES; l++) {
+        if (lane_min[l] < result.min) result.min = lane_min[l];
+        if (lane_max[l] > result.max) result.max = lane_max[l];
+        result.sum += lane_sum[l];
+    }
+
+    uint32_t done = blocks * LANES;
+    if (done < n) {
+        merge(result, minMaxSumReference(v + done, n - done));
+    }
+    return result;
+}
+
+#if TELEMETRY_PIE
+alignas(16) static const int16_t ONES[TelemetryKernels::LANES] = {1, 1, 1, 1, 1, 1, 1, 1};
+
+KernelResult TelemetryKernels::minMaxSumPie(const int16_t* v, uint32_t n) {
+    // Scalar up to the first vector boundary (the q loads ignore the low
+    // address bits), then whole vectors, then the scalar tail
+    uint32_t head = (uint32_t)(((ALIGNMENT - (uintptr_t)v % ALIGNMENT) % ALIGNMENT) / sizeof(int16_t));
+    if (head > n) head = n;
+    uint32_t blocks = (n - head) / LANES;
+    if (blocks == 0) {
+        return minMaxSumReference(v, n);
+    }
+    uint32_t tail = head + blocks * LANES;
+
+    alignas(16) int16_t lane_min[LANES];
+    alignas(16) int16_t lane_max[LANES];
+    uint32_t accx_lo;
+    uint32_t accx_hi;
+    const int16_t* p = v + head;
+
+    // q0 data, q1 min, q2 max, q3 ones; the sum is a multiply by one
+    // accumulated in the 40-bit ACCX
+    asm volatile(
+        "ee.zero.accx\n"
+        "ee.vld.128.ip      q1, %[p], 0\n"
+        "ee.vld.128.ip      q2, %[p], 0\n"
+        "ee.vld.128.ip      q3, %[ones], 0\n"
+        "loopnez            %[blocks], 1f\n"
+        "ee.vld.128.ip      q0, %[p], 16\n"
+        "ee.vmin.s16        q1, q1, q0\n"
+        "ee.vmax.s16        q2, q2, q0\n"
+        "ee.vmulas.s16.accx q0, q3\n"
+        "1:\n"
+        "ee.vst.128.ip      q1, %[mn], 0\n"
+        "ee.vst.128.ip      q2, %[mx], 0\n"
+        "rur.accx_0         %[lo]\n"
+        "rur.accx_1         %[hi]\n"
+        : [p] "+r"(p), [lo] "=r"(accx_lo), [hi] "=r"(accx_hi)
+        : [blocks] "r"(blocks), [ones] "r"(ONES), [mn] "r"(lane_min), [mx] "r"(lane_max)
+        : "memory");
+
+    KernelResult result;
+    result.min = lane_min[0];
+    result.max = lane_max[0];
+    for (int l = 1; l < LANES; l++) {
+        if (lane_min[l] < result.min) result.min = lane_min[l];
+        if (lane_max[l] > result.max) result.max = lane_max[l];
+    }
+    // Bits 32-39 of ACCX are the sign-extended top of the sum
+    result.sum = (int64_t)(int8_t)(accx_hi & 0xFF) * 4294967296LL + accx_lo;
+
+    if (head > 0) {
+        merge(result, minMaxSumReference(v, head));
+    }
+    if (tail < n) {
+        merge(result, minMaxSumReference(v + tail, n - tail));
+    }
+    return result;
+}
+#endif
+
+int64_t TelemetryKernels::trapezoid(const int16_t* v, const uint32_t* t, uint32_t n) {
+    return trapezoidPortable(v, t, n);
+}
+
+int64_t TelemetryKernels::trapezoidReference(const int16_t* v, const uint32_t* t, uint32_t n) {
+    int64_t total = 0;
+    for (uint32_t i = 0; i + 1 < n; i++) {
+        total += (int64_t)(v[i] + v[i + 1]) * (int64_t)(t[i + 1] - t[i]);
+    }
+    return total;
+}
+
+int64_t TelemetryKernels::trapezoidPortable(const int16_t* v, const uint32_t* t, uint32_t n) {
+    if (n < 2) {
+        return 0;
+    }
+    uint32_t pairs = n - 1;
+    int64_t lane_total[LANES] = {};
+    uint32_t i = 0;
+    for (; i + LANES <= pairs; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            int32_t height = v[i + l] + v[i + l + 1];
+            uint32_t width = t[i + l + 1] - t[i + l];    // Wraps with millis()
+            lane_total[l] += (int64_t)height * width;
+        }
+    }
+
+    int64_t total = 0;
+    for (int l = 0; l < LANES; l++) {
+        total += lane_total[l];
+    }
+    return total + trapezoidReference(v + i, t + i, n - i);
+}
+
+const char* TelemetryKernels::getPathName() {
+    return TELEMETRY_PIE ? "pie" : "portable";
+}
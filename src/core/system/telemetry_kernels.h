@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#ifdef ESP_PLATFORM
+#include <sdkconfig.h>
+#endif
+
+// ESP32-S3 PIE (128-bit SIMD) kernels - off by default, build with
+// -D TELEMETRY_PIE=1 to add them (ignored on other targets)
+#ifndef TELEMETRY_PIE
+#define TELEMETRY_PIE 0
+#endif
+#if TELEMETRY_PIE && !(defined(CONFIG_IDF_TARGET_ESP32S3) && defined(__XTENSA__))
+#undef TELEMETRY_PIE
+#define TELEMETRY_PIE 0
+#endif
+
+// Reductions over a fixed-point column (int16 counts)
+struct KernelResult {
+    int32_t min = 0;
+    int32_t max = 0;
+    int64_t sum = 0;
+};
+
+// Aggregation kernels for TelemetryStore columns. Three implementations
+// with identical results:
+//   reference - one element at a time, the definition of the result
+//   portable  - 8 independent lanes, which the host compiler vectorises
+//   pie       - the same 8 lanes in one ESP32-S3 q register
+// minMaxSum()/trapezoid() pick the fastest one built. n is at most 2^19
+// (the lanes accumulate in 32 bits).
+class TelemetryKernels {
+public:
+    static constexpr int LANES = 8;                 // int16 per 128-bit vector
+    static constexpr size_t ALIGNMENT = 16;         // Columns start on a vector boundary
+
+    // min/max/sum of v[0..n), n > 0
+    static KernelResult minMaxSum(const int16_t* v, uint32_t n);
+    static KernelResult minMaxSumReference(const int16_t* v, uint32_t n);
+    static KernelResult minMaxSumPortable(const int16_t* v, uint32_t n);
+#if TELEMETRY_PIE
+    static KernelResult minMaxSumPie(const int16_t* v, uint32_t n);
+#endif
+
+    // Twice the trapezoidal integral of v over t: sum of (v[i] + v[i+1]) * (t[i+1] - t[i])
+    // in counts x ms. No PIE version - the widening multiply doesn't map onto it.
+    static int64_t trapezoid(const int16_t* v, const uint32_t* t, uint32_t n);
+    static int64_t trapezoidReference(const int16_t* v, const uint32_t* t, uint32_t n);
+    static int64_t trapezoidPortable(const int16_t* v, const uint32_t* t, uint32_t n);
+
+    // Name of the path minMaxSum() takes
+    static const char* getPathName();
+};
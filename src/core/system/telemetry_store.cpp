@@ -0,0 +1,94 @@
+#include "telemetry_store.h"
+#include <cmath>
+#include <string.h>
+
+void TelemetryStore::begin(uint8_t count, const float* column_lsb) {
+    column_count = count > MAX_COLUMNS ? MAX_COLUMNS : count;
+    for (uint8_t c = 0; c < column_count; c++) {
+        lsb[c] = column_lsb[c] > 0.0f ? column_lsb[c] : 1.0f;
+    }
+    reset();
+}
+
+void TelemetryStore::reset() {
+    memset(columns, 0, sizeof(columns));
+    memset(times, 0, sizeof(times));
+    memset(held, 0, sizeof(held));
+    end = 0;
+}
+
+void TelemetryStore::append(uint32_t time_ms, uint8_t column, float value) {
+    if (column >= column_count) return;
+    held[column] = quantize(value, lsb[column]);
+
+    uint32_t slot = end % CAPACITY;
+    for (uint8_t c = 0; c < column_count; c++) {
+        columns[c][slot] = held[c];
+    }
+    times[slot] = time_ms;
+    end++;
+}
+
+float TelemetryStore::get(uint8_t column, uint32_t row) const {
+    if (column >= column_count || row < getFirst() || row >= end) {
+        return 0.0f;
+    }
+    return columns[column][row % CAPACITY] * lsb[column];
+}
+
+bool TelemetryStore::aggregate(uint8_t column, uint32_t first, uint32_t last, TelemetryWindow& out) const {
+    if (column >= column_count) return false;
+    if (first < getFirst()) first = getFirst();
+    if (last > end) last = end;
+    if (first >= last) return false;
+
+    // At most two runs: up to the end of the ring, then from its start
+    uint32_t n = last - first;
+    uint32_t start = first % CAPACITY;
+    uint32_t run = (n < CAPACITY - start) ? n : CAPACITY - start;
+    const int16_t* v = columns[column];
+
+    KernelResult result = TelemetryKernels::minMaxSum(v + start, run);
+    int64_t twice_area = TelemetryKernels::trapezoid(v + start, times + start, run);
+    if (run < n) {
+        KernelResult wrapped = TelemetryKernels::minMaxSum(v, n - run);
+        if (wrapped.min < result.min) result.min = wrapped.min;
+        if (wrapped.max > result.max) result.max = wrapped.max;
+        result.sum += wrapped.sum;
+        twice_area += TelemetryKernels::trapezoid(v, times, n - run);
+        // The interval that spans the wrap
+        twice_area += (int64_t)(v[CAPACITY - 1] + v[0]) * (int64_t)(uint32_t)(times[0] - times[CAPACITY - 1]);
+    }
+
+    float unit = lsb[column];
+    out.min = result.min * unit;
+    out.max = result.max * unit;
+    out.mean = (float)((double)result.sum / n) * unit;
+    out.integral = (float)((double)twice_area * 0.5 * unit / 1000.0);
+    out.count = n;
+    return true;
+}
+
+bool TelemetryStore::aggregateSince(uint8_t column, uint32_t since_ms, uint32_t now_ms, TelemetryWindow& out) const {
+    // Ages fall with the row number - binary search for the oldest row in the window
+    uint32_t window = now_ms - since_ms;
+    uint32_t low = getFirst();
+    uint32_t high = end;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (now_ms - times[mid % CAPACITY] > window) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return aggregate(column, low, end, out);
+}
+
+int16_t TelemetryStore::quantize(float value, float lsb) {
+    if (std::isnan(value)) return 0;
+    float counts = roundf(value / lsb);
+    if (counts > 32767.0f) return 32767;
+    if (counts < -32768.0f) return -32768;
+    return (int16_t)counts;
+}
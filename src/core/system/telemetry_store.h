@@ -0,0 +1,54 @@
+#pragma once
+#include "telemetry_kernels.h"
+
+// Aggregate of one column over a window, in the column's unit
+struct TelemetryWindow {
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    float integral = 0.0f;      // Trapezoidal, unit x seconds (W -> J)
+    uint32_t count = 0;         // Rows aggregated
+};
+
+// Ring of timestamped rows stored as structure-of-arrays: one aligned
+// int16 column per series, fixed point with a per-column LSB, plus a
+// time column. A window is at most two contiguous runs per column, so the
+// aggregations run as TelemetryKernels over plain arrays.
+//
+// append() writes one column and holds the others at their last value, so
+// series that arrive separately still share rows. Values outside the int16
+// range saturate. No Arduino dependency - also built by [env:native].
+class TelemetryStore {
+public:
+    static constexpr uint8_t MAX_COLUMNS = 4;
+    static constexpr uint32_t CAPACITY = 512;       // Rows - a power of two, whole vectors
+
+    // lsb: value of one count in each column (e.g. 1.0 for whole watts)
+    void begin(uint8_t column_count, const float* lsb);
+    void reset();
+
+    // New row at time_ms with column set to value
+    void append(uint32_t time_ms, uint8_t column, float value);
+
+    // Rows are numbered from 0 since the last reset; [getFirst(), getEnd()) are held
+    uint32_t getEnd() const { return end; }
+    uint32_t getFirst() const { return end > CAPACITY ? end - CAPACITY : 0; }
+    float get(uint8_t column, uint32_t row) const;
+
+    // Aggregate rows [first, end) of a column, clipped to the rows held.
+    // False if no row is left.
+    bool aggregate(uint8_t column, uint32_t first, uint32_t end, TelemetryWindow& out) const;
+
+    // Rows at or after since_ms (by timestamp, millis() wrap safe)
+    bool aggregateSince(uint8_t column, uint32_t since_ms, uint32_t now_ms, TelemetryWindow& out) const;
+
+private:
+    alignas(TelemetryKernels::ALIGNMENT) int16_t columns[MAX_COLUMNS][CAPACITY];
+    alignas(TelemetryKernels::ALIGNMENT) uint32_t times[CAPACITY];
+    float lsb[MAX_COLUMNS] = {};
+    int16_t held[MAX_COLUMNS] = {};
+    uint8_t column_count = 0;
+    uint32_t end = 0;
+
+    static int16_t quantize(float value, float lsb);
+};
@@ -0,0 +1,84 @@
+#include "timer_wheel.h"
+
+TimerWheel::TimerWheel(unsigned long tick_ms) : tick_ms(tick_ms > 0 ? tick_ms : 1) {
+}
+
+void TimerWheel::begin(unsigned long now) {
+    for (uint16_t i = 0; i < SLOTS; i++) {
+        slots[i] = nullptr;
+    }
+    current_tick = 0;
+    last_tick_time = now;
+    stats = WheelStats();
+}
+
+void TimerWheel::schedule(WheelTimer& timer, unsigned long delay_ms) {
+    if (timer.armed) {
+        unlink(timer);
+    }
+    uint32_t ticks = (delay_ms + tick_ms - 1) / tick_ms;
+    if (ticks == 0) ticks = 1;
+    timer.expiry_tick = current_tick + ticks;
+    link(timer);
+    stats.scheduled++;
+}
+
+void TimerWheel::cancel(WheelTimer& timer) {
+    if (timer.armed) {
+        unlink(timer);
+    }
+}
+
+void TimerWheel::advance(unsigned long now) {
+    uint32_t elapsed = (now - last_tick_time) / tick_ms;
+    if (elapsed == 0) return;
+    last_tick_time += elapsed * tick_ms;
+    
+    // After a long stall (light sleep) one pass over every slot is enough -
+    // the due check below catches anything that expired in between
+    uint32_t target = current_tick + elapsed;
+    if (elapsed > SLOTS) {
+        current_tick = target - SLOTS;
+    }
+    while (current_tick != target) {
+        current_tick++;
+        runSlot(current_tick & (SLOTS - 1));
+    }
+}
+
+void TimerWheel::link(WheelTimer& timer) {
+    WheelTimer*& head = slots[timer.expiry_tick & (SLOTS - 1)];
+    timer.prev = nullptr;
+    timer.next = head;
+    if (head) head->prev = &timer;
+    head = &timer;
+    timer.armed = true;
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+    if (timer.prev) {
+        timer.prev->next = timer.next;
+    } else {
+        slots[timer.expiry_tick & (SLOTS - 1)] = timer.next;
+    }
+    if (timer.next) timer.next->prev = timer.prev;
+    timer.next = nullptr;
+    timer.prev = nullptr;
+    timer.armed = false;
+}
+
+void TimerWheel::runSlot(uint16_t slot) {
+    stats.ticks++;
+    WheelTimer* timer = slots[slot];
+    while (timer) {
+        WheelTimer* next = timer->next;
+        if ((int32_t)(timer->expiry_tick - current_tick) <= 0) {
+            // Unlink before the callback so it can re-arm the timer
+            unlink(*timer);
+            stats.fired++;
+            if (timer->callback) timer->callback(timer->context);
+            next = slots[slot];     // Restart - the callback may have changed this slot
+        }
+        timer = next;
+    }
+}
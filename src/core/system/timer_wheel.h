@@ -0,0 +1,52 @@
+#pragma once
+#include <Arduino.h>
+
+// One-shot timer owned by the caller and linked into the wheel (no allocation)
+struct WheelTimer {
+    WheelTimer* next = nullptr;
+    WheelTimer* prev = nullptr;
+    uint32_t expiry_tick = 0;
+    bool armed = false;
+    void (*callback)(void* context) = nullptr;
+    void* context = nullptr;
+};
+
+struct WheelStats {
+    uint32_t scheduled = 0;
+    uint32_t fired = 0;
+    uint32_t ticks = 0;         // Slots visited
+};
+
+// Hashed timer wheel: schedule/cancel are O(1) and each tick looks at one
+// slot, so timers that never fire (re-armed on every sample) cost nothing.
+// Timers further out than one rotation stay in their slot until due.
+class TimerWheel {
+public:
+    static constexpr uint8_t SLOT_BITS = 6;
+    static constexpr uint16_t SLOTS = 1 << SLOT_BITS;
+    
+    explicit TimerWheel(unsigned long tick_ms);
+    
+    void begin(unsigned long now);
+    
+    // (Re)arm a timer to fire after delay_ms (rounded up to whole ticks)
+    void schedule(WheelTimer& timer, unsigned long delay_ms);
+    void cancel(WheelTimer& timer);
+    
+    // Fire everything due by now (call from loop)
+    void advance(unsigned long now);
+    
+    unsigned long getTickMs() const { return tick_ms; }
+    const WheelStats& getStats() const { return stats; }
+
+private:
+    const unsigned long tick_ms;
+    WheelTimer* slots[SLOTS] = {};
+    uint32_t current_tick = 0;
+    unsigned long last_tick_time = 0;
+    WheelStats stats;
+    
+    void link(WheelTimer& timer);
+    void unlink(WheelTimer& timer);
+    void runSlot(uint16_t slot);
+};
@@ -0,0 +1,218 @@
+#pragma once
+#include <stdint.h>
+
+// Generated by simulator/emon_trace.py
+static const uint8_t emon_trace[] = {
+    0x45, 0x4d, 0x54, 0x52, 0x01, 0x00, 0x00, 0x00, 0x00, 0x13, 0x01, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x74, 0x61, 0x72, 0x69, 0x66, 0x66, 0x31, 0x0a,
+    0x00, 0x00, 0x00, 0x14, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x35, 0x35, 0x30, 0x0e, 0x00, 0x00,
+    0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x32, 0x30, 0x30, 0x12, 0x00, 0x00, 0x00, 0x11, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64,
+    0x36, 0x35, 0x30, 0x16, 0x00, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x30, 0x2e, 0x30, 0x1a,
+    0x27, 0x00, 0x00, 0x14, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x36, 0x32, 0x35, 0x1e, 0x27, 0x00,
+    0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x33, 0x31, 0x34, 0x22, 0x27, 0x00, 0x00, 0x11, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64,
+    0x36, 0x38, 0x39, 0x26, 0x27, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x30, 0x2e, 0x38, 0x2a,
+    0x4e, 0x00, 0x00, 0x14, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x37, 0x35, 0x35, 0x2e, 0x4e, 0x00,
+    0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x34, 0x32, 0x35, 0x32, 0x4e, 0x00, 0x00, 0x11, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64,
+    0x36, 0x37, 0x31, 0x36, 0x4e, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x31, 0x2e, 0x35, 0x3a,
+    0x75, 0x00, 0x00, 0x14, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x39, 0x31, 0x30, 0x3e, 0x75, 0x00,
+    0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x35, 0x33, 0x32, 0x42, 0x75, 0x00, 0x00, 0x11, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64,
+    0x36, 0x32, 0x32, 0x46, 0x75, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x31, 0x4a,
+    0x9c, 0x00, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x30, 0x31, 0x38, 0x4e, 0x9c,
+    0x00, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x36, 0x33, 0x33, 0x52, 0x9c, 0x00, 0x00, 0x11, 0x03,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x36, 0x31, 0x35, 0x56, 0x9c, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x34,
+    0x5a, 0xc3, 0x00, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74,
+    0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x30, 0x36, 0x35, 0x5e,
+    0xc3, 0x00, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x37, 0x32, 0x34, 0x62, 0xc3, 0x00, 0x00, 0x11,
+    0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73,
+    0x65, 0x64, 0x36, 0x35, 0x39, 0x66, 0xc3, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e,
+    0x35, 0x6a, 0xea, 0x00, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x36, 0x38, 0x35, 0x6e, 0xea,
+    0x00, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x38, 0x30, 0x35, 0x72, 0xea, 0x00, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x39, 0x30, 0x76, 0xea, 0x00, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e,
+    0x33, 0x7a, 0x11, 0x01, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x35, 0x39, 0x30, 0x7e, 0x11,
+    0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x38, 0x37, 0x33, 0x82, 0x11, 0x01, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x36, 0x33, 0x86, 0x11, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x31, 0x2e,
+    0x38, 0x8a, 0x38, 0x01, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x34, 0x38, 0x39, 0x8e, 0x38,
+    0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x32, 0x38, 0x92, 0x38, 0x01, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x31, 0x37, 0x96, 0x38, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x31, 0x2e,
+    0x31, 0x9a, 0x5f, 0x01, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x34, 0x35, 0x32, 0x9e, 0x5f,
+    0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x36, 0x38, 0xa2, 0x5f, 0x01, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x32, 0x30, 0xa6, 0x5f, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x30, 0x2e,
+    0x34, 0xaa, 0x86, 0x01, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x34, 0x37, 0x35, 0xae, 0x86,
+    0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x39, 0x32, 0xb2, 0x86, 0x01, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x36, 0x37, 0xb6, 0x86, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x33, 0x39, 0x2e,
+    0x35, 0xba, 0xad, 0x01, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x34, 0x38, 0x39, 0xbe, 0xad,
+    0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x32, 0x30, 0x30, 0x30, 0xc2, 0xad, 0x01, 0x00, 0x11, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x32, 0x34, 0x38, 0x39, 0xc6, 0xad, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x33, 0x38, 0x2e,
+    0x37, 0xca, 0xd4, 0x01, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x33, 0x33, 0x37,
+    0xce, 0xd4, 0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74,
+    0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x39, 0x32, 0xd2, 0xd4, 0x01, 0x00,
+    0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75,
+    0x73, 0x65, 0x64, 0x36, 0x35, 0x34, 0xd6, 0xd4, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e,
+    0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x33, 0x38,
+    0x2e, 0x31, 0xda, 0xfb, 0x01, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f,
+    0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x33, 0x35,
+    0x35, 0xde, 0xfb, 0x01, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x36, 0x37, 0xe2, 0xfb, 0x01,
+    0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x75, 0x73, 0x65, 0x64, 0x36, 0x31, 0x33, 0xe6, 0xfb, 0x01, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x33,
+    0x37, 0x2e, 0x37, 0xea, 0x22, 0x02, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x33,
+    0x30, 0x32, 0xee, 0x22, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f,
+    0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x39, 0x32, 0x37, 0xf2, 0x22,
+    0x02, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x32, 0x36, 0xf6, 0x22, 0x02, 0x00, 0x11, 0x05, 0x65, 0x6d,
+    0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32,
+    0x33, 0x37, 0x2e, 0x35, 0xfa, 0x49, 0x02, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31,
+    0x31, 0x39, 0x38, 0xfe, 0x49, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x38, 0x37, 0x33, 0x02,
+    0x4a, 0x02, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x37, 0x34, 0x06, 0x4a, 0x02, 0x00, 0x11, 0x05, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73,
+    0x32, 0x33, 0x37, 0x2e, 0x36, 0x0a, 0x71, 0x02, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d,
+    0x31, 0x31, 0x31, 0x37, 0x0e, 0x71, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x38, 0x30, 0x34,
+    0x12, 0x71, 0x02, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74,
+    0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x38, 0x37, 0x16, 0x71, 0x02, 0x00, 0x11, 0x05,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d,
+    0x73, 0x32, 0x33, 0x38, 0x2e, 0x30, 0x1a, 0x98, 0x02, 0x00, 0x14, 0x05, 0x65, 0x6d, 0x6f, 0x6e,
+    0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65,
+    0x2d, 0x31, 0x30, 0x37, 0x38, 0x1e, 0x98, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x37, 0x32,
+    0x33, 0x22, 0x98, 0x02, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x34, 0x36, 0x26, 0x98, 0x02, 0x00, 0x11,
+    0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72,
+    0x6d, 0x73, 0x32, 0x33, 0x38, 0x2e, 0x36, 0x2a, 0xbf, 0x02, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63,
+    0x65, 0x37, 0x37, 0x39, 0x2e, 0xbf, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x36, 0x33, 0x32,
+    0x32, 0xbf, 0x02, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74,
+    0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x31, 0x31, 0x36, 0xbf, 0x02, 0x00, 0x11,
+    0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72,
+    0x6d, 0x73, 0x32, 0x33, 0x39, 0x2e, 0x33, 0x3a, 0xe6, 0x02, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63,
+    0x65, 0x39, 0x30, 0x32, 0x3e, 0xe6, 0x02, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x35, 0x33, 0x32,
+    0x42, 0xe6, 0x02, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74,
+    0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x33, 0x33, 0x46, 0xe6, 0x02, 0x00, 0x11,
+    0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72,
+    0x6d, 0x73, 0x32, 0x34, 0x30, 0x2e, 0x31, 0x4a, 0x0d, 0x03, 0x00, 0x14, 0x04, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63,
+    0x65, 0x31, 0x30, 0x35, 0x36, 0x4e, 0x0d, 0x03, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x34, 0x32,
+    0x35, 0x52, 0x0d, 0x03, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x38, 0x31, 0x56, 0x0d, 0x03, 0x00,
+    0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76,
+    0x72, 0x6d, 0x73, 0x32, 0x34, 0x30, 0x2e, 0x39, 0x5a, 0x34, 0x03, 0x00, 0x14, 0x04, 0x65, 0x6d,
+    0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e,
+    0x63, 0x65, 0x31, 0x31, 0x37, 0x30, 0x5e, 0x34, 0x03, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f, 0x6e,
+    0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31, 0x33,
+    0x31, 0x33, 0x62, 0x34, 0x03, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f,
+    0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x38, 0x33, 0x66, 0x34, 0x03,
+    0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x31, 0x2e, 0x36, 0x6a, 0x5b, 0x03, 0x00, 0x14, 0x04, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61,
+    0x6e, 0x63, 0x65, 0x31, 0x32, 0x33, 0x38, 0x6e, 0x5b, 0x03, 0x00, 0x12, 0x04, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x31,
+    0x31, 0x39, 0x39, 0x72, 0x5b, 0x03, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x33, 0x37, 0x76, 0x5b,
+    0x03, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x32, 0x7a, 0x82, 0x03, 0x00, 0x14, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c,
+    0x61, 0x6e, 0x63, 0x65, 0x31, 0x33, 0x32, 0x35, 0x7e, 0x82, 0x03, 0x00, 0x12, 0x04, 0x65, 0x6d,
+    0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72,
+    0x31, 0x30, 0x38, 0x35, 0x82, 0x82, 0x03, 0x00, 0x11, 0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x32, 0x34, 0x31, 0x30, 0x86,
+    0x82, 0x03, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x35, 0x8a, 0xa9, 0x03, 0x00, 0x14,
+    0x04, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61,
+    0x6c, 0x61, 0x6e, 0x63, 0x65, 0x2d, 0x33, 0x33, 0x32, 0x8e, 0xa9, 0x03, 0x00, 0x12, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61,
+    0x72, 0x39, 0x37, 0x34, 0x92, 0xa9, 0x03, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x34, 0x31, 0x96, 0xa9,
+    0x03, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33,
+    0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x35, 0x9a, 0xd0, 0x03, 0x00, 0x14, 0x04,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c,
+    0x61, 0x6e, 0x63, 0x65, 0x2d, 0x31, 0x38, 0x31, 0x9e, 0xd0, 0x03, 0x00, 0x12, 0x03, 0x65, 0x6d,
+    0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72,
+    0x38, 0x36, 0x37, 0xa2, 0xd0, 0x03, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d,
+    0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x38, 0x35, 0xa6, 0xd0, 0x03,
+    0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f,
+    0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x32, 0x2e, 0x32, 0xaa, 0xf7, 0x03, 0x00, 0x14, 0x03, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61,
+    0x6e, 0x63, 0x65, 0x2d, 0x38, 0x39, 0xae, 0xf7, 0x03, 0x00, 0x12, 0x03, 0x65, 0x6d, 0x6f, 0x6e,
+    0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x37, 0x36,
+    0x36, 0xb2, 0xf7, 0x03, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x37, 0x37, 0xb6, 0xf7, 0x03, 0x00, 0x11,
+    0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72,
+    0x6d, 0x73, 0x32, 0x34, 0x31, 0x2e, 0x37, 0xba, 0x1e, 0x04, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f,
+    0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63,
+    0x65, 0x2d, 0x34, 0x36, 0xbe, 0x1e, 0x04, 0x00, 0x12, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x36, 0x37, 0x35, 0xc2,
+    0x1e, 0x04, 0x00, 0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x75, 0x73, 0x65, 0x64, 0x36, 0x32, 0x39, 0xc6, 0x1e, 0x04, 0x00, 0x11, 0x05, 0x65,
+    0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73,
+    0x32, 0x34, 0x31, 0x2e, 0x30, 0xca, 0x45, 0x04, 0x00, 0x14, 0x02, 0x65, 0x6d, 0x6f, 0x6e, 0x2f,
+    0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x31,
+    0x37, 0xce, 0x45, 0x04, 0x00, 0x12, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e,
+    0x74, 0x78, 0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x35, 0x39, 0x35, 0xd2, 0x45, 0x04, 0x00,
+    0x11, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75,
+    0x73, 0x65, 0x64, 0x36, 0x31, 0x31, 0xd6, 0x45, 0x04, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e,
+    0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x34, 0x30,
+    0x2e, 0x32, 0xda, 0x6c, 0x04, 0x00, 0x14, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f,
+    0x6e, 0x74, 0x78, 0x33, 0x2f, 0x62, 0x61, 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x31, 0x32, 0x34, 0xde,
+    0x6c, 0x04, 0x00, 0x12, 0x03, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78,
+    0x33, 0x2f, 0x73, 0x6f, 0x6c, 0x61, 0x72, 0x35, 0x32, 0x36, 0xe2, 0x6c, 0x04, 0x00, 0x11, 0x03,
+    0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65, 0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x75, 0x73, 0x65,
+    0x64, 0x36, 0x35, 0x30, 0xe6, 0x6c, 0x04, 0x00, 0x11, 0x05, 0x65, 0x6d, 0x6f, 0x6e, 0x2f, 0x65,
+    0x6d, 0x6f, 0x6e, 0x74, 0x78, 0x33, 0x2f, 0x76, 0x72, 0x6d, 0x73, 0x32, 0x33, 0x39, 0x2e, 0x34,
+};
@@ -0,0 +1,251 @@
+#include "energy_channels.h"
+#include "../../core/network/command_interpreter.h"
+#include "../../core/network/energy_frame.h"
+#include "../weather/weather_data.h"
+#include <Preferences.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ChannelConfig EnergyChannels::configs[EnergyChannels::MAX_CHANNELS];
+uint8_t EnergyChannels::count = 0;
+uint32_t EnergyChannels::generation = 0;
+
+// The single EmonTX3 this knob started with
+const char* EnergyChannels::DEFAULT_CONFIG =
+    "Grid balance emon/emontx3/balance W 1 8000 #f44336\n"
+    "Solar solar emon/emontx3/solar W 1 5000 #ffeb3b\n"
+    "House used emon/emontx3/used W 1 8000 #2196f3\n"
+    "Mains vrms emon/emontx3/vrms V 1 260 #9e9e9e\n";
+
+static const char* ROLE_NAMES[CHANNEL_ROLE_COUNT] = {
+    "balance", "solar", "used", "vrms", "load"
+};
+
+static const int MAX_FIELDS = 7;
+
+// Routed before the channel lookup, or shadowed by it - as a channel these
+// would feed the knob's own config and weather payloads in as values
+static const char* const RESERVED_PREFIXES[] = {
+    "home/knob/",           // Commands, CHANNEL_CONFIG_TOPIC, peak_reset, timezone
+    WEATHER_TOPIC_PREFIX,
+};
+static const char* const RESERVED_TOPICS[] = {
+    TARIFF_TOPIC,
+    ENERGY_FRAME_TOPIC,
+};
+
+void EnergyChannels::begin() {
+    char text[MAX_CONFIG_LENGTH];
+    size_t length = 0;
+
+    Preferences prefs;
+    prefs.begin("channels", true);
+    if (prefs.isKey("config")) {
+        length = prefs.getBytes("config", text, sizeof(text));
+    }
+    prefs.end();
+
+    char error[64];
+    uint8_t loaded = 0;
+    if (length > 0 && parse((const uint8_t*)text, length, configs, loaded, error, sizeof(error))) {
+        count = loaded;
+        Serial.printf("Energy channels: %u configured\n", count);
+    } else {
+        if (length > 0) {
+            Serial.printf("Stored channel configuration rejected (%s) - using defaults\n", error);
+        }
+        parse((const uint8_t*)DEFAULT_CONFIG, strlen(DEFAULT_CONFIG), configs, count, error, sizeof(error));
+    }
+    generation++;
+}
+
+bool EnergyChannels::configure(const uint8_t* text, unsigned int length, char* error, size_t error_size) {
+    ChannelConfig parsed[MAX_CHANNELS];
+    uint8_t parsed_count = 0;
+    if (!parse(text, length, parsed, parsed_count, error, error_size)) {
+        return false;
+    }
+
+    // The retained configuration comes back on every reconnect
+    if (sameAsCurrent(parsed, parsed_count)) {
+        return true;
+    }
+
+    memcpy(configs, parsed, sizeof(parsed));
+    count = parsed_count;
+    generation++;
+
+    Preferences prefs;
+    prefs.begin("channels", false);
+    prefs.putBytes("config", text, length);
+    prefs.end();
+
+    Serial.printf("Energy channels: %u configured\n", count);
+    return true;
+}
+
+void EnergyChannels::resetToDefaults() {
+    Preferences prefs;
+    prefs.begin("channels", false);
+    prefs.remove("config");
+    prefs.end();
+
+    char error[64];
+    parse((const uint8_t*)DEFAULT_CONFIG, strlen(DEFAULT_CONFIG), configs, count, error, sizeof(error));
+    generation++;
+}
+
+uint8_t EnergyChannels::getCount() {
+    return count;
+}
+
+const ChannelConfig& EnergyChannels::getConfig(int channel) {
+    if (channel < 0 || channel >= count) channel = 0;
+    return configs[channel];
+}
+
+uint32_t EnergyChannels::getGeneration() {
+    return generation;
+}
+
+int EnergyChannels::findByTopic(const char* topic) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(configs[i].topic, topic) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int EnergyChannels::findRole(ChannelRole role, int start) {
+    for (int i = start < 0 ? 0 : start; i < count; i++) {
+        if (configs[i].role == role) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* EnergyChannels::getRoleName(ChannelRole role) {
+    return role < CHANNEL_ROLE_COUNT ? ROLE_NAMES[role] : "unknown";
+}
+
+bool EnergyChannels::sameAsCurrent(const ChannelConfig* parsed, uint8_t parsed_count) {
+    if (parsed_count != count) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        const ChannelConfig& a = parsed[i];
+        const ChannelConfig& b = configs[i];
+        if (strcmp(a.name, b.name) != 0 || strcmp(a.topic, b.topic) != 0 || strcmp(a.unit, b.unit) != 0 ||
+            a.role != b.role || a.scale != b.scale || a.full_scale != b.full_scale || a.color != b.color) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EnergyChannels::isReserved(const char* topic) {
+    for (size_t i = 0; i < sizeof(RESERVED_PREFIXES) / sizeof(RESERVED_PREFIXES[0]); i++) {
+        if (strncmp(topic, RESERVED_PREFIXES[i], strlen(RESERVED_PREFIXES[i])) == 0) return true;
+    }
+    for (size_t i = 0; i < sizeof(RESERVED_TOPICS) / sizeof(RESERVED_TOPICS[0]); i++) {
+        if (strcmp(topic, RESERVED_TOPICS[i]) == 0) return true;
+    }
+    return false;
+}
+
+bool EnergyChannels::parse(const uint8_t* text, unsigned int length, ChannelConfig* out, uint8_t& out_count,
+                           char* error, size_t error_size) {
+    if (length > MAX_CONFIG_LENGTH) {
+        snprintf(error, error_size, "longer than %u bytes", MAX_CONFIG_LENGTH);
+        return false;
+    }
+
+    uint8_t parsed = 0;
+    unsigned int line_start = 0;
+    int line_number = 0;
+    while (line_start < length) {
+        unsigned int line_end = line_start;
+        while (line_end < length && text[line_end] != '\n' && text[line_end] != ';') {
+            line_end++;
+        }
+        line_number++;
+
+        CommandToken fields[MAX_FIELDS];
+        int field_count = CommandInterpreter::tokenize(text + line_start, line_end - line_start, fields, MAX_FIELDS);
+        line_start = line_end + 1;
+        if (field_count == 0) {
+            continue;   // Blank line
+        }
+        if (field_count < 0) {
+            snprintf(error, error_size, "line %d: too many fields", line_number);
+            return false;
+        }
+        if (field_count < 3) {
+            snprintf(error, error_size, "line %d: expected name role topic", line_number);
+            return false;
+        }
+        if (parsed == MAX_CHANNELS) {
+            snprintf(error, error_size, "more than %u channels", MAX_CHANNELS);
+            return false;
+        }
+
+        ChannelConfig config;
+        int role = -1;
+        for (int r = 0; r < CHANNEL_ROLE_COUNT; r++) {
+            if (fields[1].equals(ROLE_NAMES[r])) role = r;
+        }
+        if (!fields[0].copy(config.name, sizeof(config.name)) || role < 0 ||
+            !fields[2].copy(config.topic, sizeof(config.topic)) ||
+            strpbrk(config.topic, "+#") != nullptr) {
+            snprintf(error, error_size, "line %d: bad name, role or topic", line_number);
+            return false;
+        }
+        if (isReserved(config.topic)) {
+            snprintf(error, error_size, "line %d: %s is the knob's own topic", line_number, config.topic);
+            return false;
+        }
+        config.role = (ChannelRole)role;
+
+        // Optional fields, in order
+        if (field_count > 3 && !fields[3].copy(config.unit, sizeof(config.unit))) {
+            snprintf(error, error_size, "line %d: unit longer than 3", line_number);
+            return false;
+        }
+        if ((field_count > 4 && (!fields[4].toFloat(config.scale) || config.scale == 0.0f)) ||
+            (field_count > 5 && (!fields[5].toFloat(config.full_scale) || config.full_scale <= 0.0f))) {
+            snprintf(error, error_size, "line %d: bad scale", line_number);
+            return false;
+        }
+        if (field_count > 6) {
+            char color[8];
+            bool valid = fields[6].copy(color, sizeof(color)) && color[0] == '#' && strlen(color) == 7;
+            if (valid) {
+                char* end = nullptr;
+                config.color = strtoul(color + 1, &end, 16);
+                valid = (*end == '\0');
+            }
+            if (!valid) {
+                snprintf(error, error_size, "line %d: colour must be #rrggbb", line_number);
+                return false;
+            }
+        }
+
+        for (int i = 0; i < parsed; i++) {
+            if (strcmp(out[i].topic, config.topic) == 0) {
+                snprintf(error, error_size, "line %d: topic used twice", line_number);
+                return false;
+            }
+        }
+        out[parsed++] = config;
+    }
+
+    if (parsed == 0) {
+        snprintf(error, error_size, "no channels");
+        return false;
+    }
+    out_count = parsed;
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+#include <Arduino.h>
+
+// What a channel's value counts towards
+enum ChannelRole : uint8_t {
+    CHANNEL_BALANCE = 0,    // Grid import(+)/export(-), summed into EnergyData::balance (e.g. one CT per phase)
+    CHANNEL_SOLAR,          // Generation, summed into EnergyData::solar (e.g. one per inverter)
+    CHANNEL_USED,           // House consumption, summed into EnergyData::used
+    CHANNEL_VRMS,           // Mains voltage, averaged into EnergyData::vrms
+    CHANNEL_LOAD,           // Sub-circuit - shown, but not part of any total
+    CHANNEL_ROLE_COUNT
+};
+
+struct ChannelConfig {
+    char name[12] = "";
+    char topic[48] = "";
+    char unit[4] = "W";
+    ChannelRole role = CHANNEL_LOAD;
+    float scale = 1.0f;             // Applied to the MQTT payload (e.g. 1000 for kW)
+    float full_scale = 5000.0f;     // Gauge range, in unit
+    uint32_t color = 0xFFFFFF;      // 0xRRGGBB
+};
+
+// Configured power channels: MQTT topic to value mapping, with units,
+// scaling and colours. Values are kept per channel in EnergyData::channels,
+// history in EnergyHistory. Peaks are tracked on the filtered role totals.
+//
+// Configured by a retained message on CHANNEL_CONFIG_TOPIC, one channel per
+// line (or ';'), persisted in NVS:
+//   <name> <role> <topic> [unit] [scale] [full_scale] [#rrggbb]
+// e.g. "Solar2 solar emon/inverter2/power W 1 3000 #ffc107"
+// Without a configuration the four emon/emontx3 feeds are used.
+// Topics the knob handles itself (home/knob/*, home/weather/*, the tariff
+// and the energy frame) cannot be channels.
+#define CHANNEL_CONFIG_TOPIC "home/knob/config/channels"
+
+// Tariff band (1-4) - EnergyData_Manager::updateTariff, not a channel
+#define TARIFF_TOPIC "emon/emontx3/tariff"
+
+class EnergyChannels {
+public:
+    static constexpr uint8_t MAX_CHANNELS = EnergyData::MAX_CHANNELS;
+    static constexpr unsigned int MAX_CONFIG_LENGTH = 1024;
+
+    // Load the persisted configuration (or the defaults)
+    static void begin();
+
+    // Parse, apply and persist a configuration. On error nothing changes
+    // and a message is written to error; the same set again is a no-op.
+    static bool configure(const uint8_t* text, unsigned int length, char* error, size_t error_size);
+    static void resetToDefaults();
+
+    static uint8_t getCount();
+    static const ChannelConfig& getConfig(int channel);
+
+    // Bumped whenever the channel set changes
+    static uint32_t getGeneration();
+
+    // Channel subscribed to topic, or -1
+    static int findByTopic(const char* topic);
+
+    // First channel with the role at or after start, or -1
+    static int findRole(ChannelRole role, int start = 0);
+
+    static const char* getRoleName(ChannelRole role);
+
+private:
+    static ChannelConfig configs[MAX_CHANNELS];
+    static uint8_t count;
+    static uint32_t generation;
+
+    static const char* DEFAULT_CONFIG;
+
+    static bool sameAsCurrent(const ChannelConfig* parsed, uint8_t parsed_count);
+    static bool isReserved(const char* topic);
+    static bool parse(const uint8_t* text, unsigned int length, ChannelConfig* out, uint8_t& out_count,
+                      char* error, size_t error_size);
+};
@@ -1,4 +1,7 @@
 #include "energy_data.h"
+#include "peak_reset_scheduler.h"
+#include "mock_scenario.h"
+#include "energy_history.h"
 #include "../../core/hardware/haptic_feedback.h"
 #include <cmath>
 
@@ -6,17 +9,62 @@ EnergyData EnergyData_Manager::current_data;
 PeakData EnergyData_Manager::peak_data;
 String EnergyData_Manager::energy_tariff = "";
 bool EnergyData_Manager::mock_data_enabled = false;
+bool EnergyData_Manager::data_changed = false;
+bool EnergyData_Manager::applying_frame = false;
+EnergySnapshot EnergyData_Manager::snapshot;
+bool EnergyData_Manager::snapshot_dirty = false;
+std::atomic<uint32_t> EnergyData_Manager::snapshot_sequence(0);
 unsigned long EnergyData_Manager::mock_start_time = 0;
+uint32_t EnergyData_Manager::mock_sim_time = 0;
 float EnergyData_Manager::mock_time_scale = 0.0f;
+EnergyIntegrator EnergyData_Manager::integrator;
+PowerFilter EnergyData_Manager::filters[FEED_COUNT];
+TelemetryStore EnergyData_Manager::power_store;
+uint32_t EnergyData_Manager::peak_cursor = 0;
 
 void EnergyData_Manager::begin() {
     // Initialize data structures
     current_data = EnergyData();
     peak_data = PeakData();
+    integrator = EnergyIntegrator();
+    
+    // Power feeds: 3-sample median kills single-sample spikes, a jump over
+    // 6kW must persist for 2 samples, display updates at most every 250ms
+    FilterConfig power_filter;
+    power_filter.mode = FILTER_MEDIAN;
+    power_filter.median_window = 3;
+    power_filter.glitch_threshold = 6000.0f;
+    power_filter.glitch_confirm = 2;
+    power_filter.decimate_ms = 250;
+    filters[FEED_BALANCE].configure(power_filter);
+    filters[FEED_SOLAR].configure(power_filter);
+    filters[FEED_USED].configure(power_filter);
+    
+    // Voltage moves slowly - smooth it, reject jumps over 30V
+    FilterConfig vrms_filter;
+    vrms_filter.mode = FILTER_MEDIAN_EMA;
+    vrms_filter.median_window = 3;
+    vrms_filter.ema_alpha = 0.3f;
+    vrms_filter.glitch_threshold = 30.0f;
+    vrms_filter.glitch_confirm = 3;
+    vrms_filter.decimate_ms = 1000;
+    filters[FEED_VRMS].configure(vrms_filter);
+    
+    const float watts[POWER_COLUMNS] = {1.0f, 1.0f, 1.0f};
+    power_store.begin(POWER_COLUMNS, watts);
+    peak_cursor = 0;
+    
+    EnergyChannels::begin();
+    FeedFreshness::begin();
+    EnergyHistory::begin();
+    PeakResetScheduler::begin();
+    MockScenario::load(MockScenario::DEFAULT_SCRIPT);
+    
+    snapshot_dirty = true;
+    publishSnapshot();
     
     if (mock_data_enabled) {
-        mock_start_time = millis();
-        mock_time_scale = 24.0 * 60.0 / 2.0; // 24 hours in 2 minutes
+        enableMockData(true);
         Serial.println("Energy data manager initialized with mock data");
     } else {
         Serial.println("Energy data manager initialized for real data");
@@ -28,27 +76,75 @@ void EnergyData_Manager::update() {
         generateMockData();
     }
     
-    // Check for daily peak reset (noon reset)
-    static unsigned long last_check = 0;
-    unsigned long now = millis();
-    if (now - last_check > 60000) { // Check every minute
-        time_t current_time = time(nullptr);
-        struct tm* time_info = localtime(&current_time);
-        
-        if (time_info->tm_hour == 12 && time_info->tm_min == 0) {
-            static bool reset_today = false;
-            if (!reset_today) {
-                resetDailyPeaks();
-                reset_today = true;
+    // Emit values held back by decimation once their interval has passed
+    flushFilters();
+    
+    // Everything filtered since the last loop in one pass
+    updateDailyPeaks();
+    
+    // Expire quiet feeds; the data is only valid while something is live
+    FeedFreshness::update();
+    if (FeedFreshness::hasStateChanged()) {
+        current_data.valid = FeedFreshness::anyLive();
+        markChanged();
+    }
+    
+    // Daily peak reset (configurable time, NTP/TZ aware)
+    PeakResetScheduler::update();
+    
+    // A closed history bucket is a change too (the Energy screen's ring chart)
+    if (EnergyHistory::update(millis())) {
+        markChanged();
+    }
+    
+    publishSnapshot();
+}
+
+EnergySnapshot EnergyData_Manager::getSnapshot() {
+    // Only a copy taken between two equal, even sequence numbers is returned.
+    // A writer is only ever a few microseconds into a publish; if it was
+    // preempted there by this task, back off so it can finish.
+    EnergySnapshot copy;
+    for (int attempt = 1; ; attempt++) {
+        uint32_t before = snapshot_sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            copy = snapshot;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (snapshot_sequence.load(std::memory_order_relaxed) == before) {
+                return copy;
             }
-        } else {
-            static bool reset_today = false;
-            reset_today = false;
         }
-        last_check = now;
+        if (attempt % SNAPSHOT_SPINS == 0) {
+            delay(1);
+        }
     }
 }
 
+uint32_t EnergyData_Manager::getGeneration() {
+    return snapshot_sequence.load(std::memory_order_acquire) >> 1;
+}
+
+void EnergyData_Manager::markChanged() {
+    data_changed = true;
+    snapshot_dirty = true;
+}
+
+void EnergyData_Manager::publishSnapshot() {
+    // Called once a whole update has been applied, never mid-way
+    if (!snapshot_dirty) {
+        return;
+    }
+    snapshot_dirty = false;
+    
+    uint32_t sequence = snapshot_sequence.load(std::memory_order_relaxed);
+    snapshot_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    snapshot.data = current_data;
+    snapshot.peaks = peak_data;
+    snapshot.generation = (sequence + 2) >> 1;
+    snapshot_sequence.store(sequence + 2, std::memory_order_release);
+}
+
 const EnergyData& EnergyData_Manager::getCurrentData() {
     return current_data;
 }
@@ -57,25 +153,69 @@ const PeakData& EnergyData_Manager::getPeakData() {
     return peak_data;
 }
 
+bool EnergyData_Manager::hasDataChanged() {
+    if (data_changed) {
+        data_changed = false;
+        return true;
+    }
+    return false;
+}
+
+void EnergyData_Manager::updateChannel(int channel, float raw) {
+    if (channel < 0 || channel >= EnergyChannels::getCount()) return;
+    ingestChannel(channel, raw * EnergyChannels::getConfig(channel).scale, millis());
+    publishSnapshot();
+}
+
+bool EnergyData_Manager::configureChannels(const uint8_t* text, unsigned int length) {
+    char error[64];
+    uint32_t generation = EnergyChannels::getGeneration();
+    if (!EnergyChannels::configure(text, length, error, sizeof(error))) {
+        Serial.printf("Channel configuration rejected: %s\n", error);
+        return false;
+    }
+    if (EnergyChannels::getGeneration() == generation) {
+        return true;    // Unchanged
+    }
+    clearChannels();
+    return true;
+}
+
+void EnergyData_Manager::resetChannels() {
+    EnergyChannels::resetToDefaults();
+    clearChannels();
+}
+
+void EnergyData_Manager::clearChannels() {
+    // Indices now name different channels - nothing carries over
+    for (int i = 0; i < EnergyData::MAX_CHANNELS; i++) {
+        current_data.channels[i] = 0.0f;
+    }
+    FeedFreshness::resetChannels();
+    EnergyHistory::clearChannels();
+    markChanged();
+    
+    publishSnapshot();
+}
+
 void EnergyData_Manager::updateBalance(float balance) {
-    current_data.balance = balance;
-    current_data.valid = true;
-    updateDailyPeaks(balance);
+    ingestRole(CHANNEL_BALANCE, balance, millis());
+    publishSnapshot();
 }
 
 void EnergyData_Manager::updateSolar(float solar) {
-    current_data.solar = solar;
-    current_data.valid = true;
+    ingestRole(CHANNEL_SOLAR, solar, millis());
+    publishSnapshot();
 }
 
 void EnergyData_Manager::updateUsed(float used) {
-    current_data.used = used;
-    current_data.valid = true;
+    ingestRole(CHANNEL_USED, used, millis());
+    publishSnapshot();
 }
 
 void EnergyData_Manager::updateVrms(float vrms) {
-    current_data.vrms = vrms;
-    current_data.valid = true;
+    ingestRole(CHANNEL_VRMS, vrms, millis());
+    publishSnapshot();
 }
 
 void EnergyData_Manager::updateTariff(const String& tariff) {
@@ -93,29 +233,61 @@ void EnergyData_Manager::updateTariff(const String& tariff) {
         current_data.tariff = 2;  // High tariff
     }
     current_data.valid = true;
+    markChanged();
+    
+    publishSnapshot();
 }
 
-void EnergyData_Manager::updateDailyPeaks(float balance) {
-    bool peak_reached = isPeakReached(balance);
+void EnergyData_Manager::applyFrame(const EnergyFrame& frame) {
+    // Called from the MQTT callback, so nothing renders between these lines.
+    // Every field is shown from this frame - no glitch hold-back or decimation.
+    unsigned long now = millis();
+    applying_frame = true;
+    if (frame.fields & ENERGY_FRAME_BALANCE) ingestRole(CHANNEL_BALANCE, frame.balance, now);
+    if (frame.fields & ENERGY_FRAME_SOLAR) ingestRole(CHANNEL_SOLAR, frame.solar, now);
+    if (frame.fields & ENERGY_FRAME_USED) ingestRole(CHANNEL_USED, frame.used, now);
+    if (frame.fields & ENERGY_FRAME_VRMS) ingestRole(CHANNEL_VRMS, frame.vrms, now);
+    applying_frame = false;
+    if ((frame.fields & ENERGY_FRAME_TARIFF) && frame.tariff != current_data.tariff) {
+        current_data.tariff = frame.tariff;
+        markChanged();
+    }
+    
+    publishSnapshot();
+}
+
+void EnergyData_Manager::updateDailyPeaks() {
+    // Usually a row or two; a burst (mock steps, a reconnect backlog) is
+    // still one kernel pass. Rows that rolled out of the store are lost.
+    TelemetryWindow window;
+    uint32_t end = power_store.getEnd();
+    if (!power_store.aggregate(FEED_BALANCE, peak_cursor, end, window)) {
+        return;
+    }
+    peak_cursor = end;
     
-    if (balance < 0 && balance < peak_data.daily_export_peak) {
-        peak_data.daily_export_peak = balance;
+    if (window.min < 0 && window.min < peak_data.daily_export_peak) {
+        bool peak_reached = isPeakReached(window.min);
+        peak_data.daily_export_peak = window.min;
         peak_data.last_peak_update = millis();
         if (peak_reached && !peak_data.export_peak_reached_today) {
             peak_data.export_peak_reached_today = true;
             HapticFeedback::peakReached();
-            Serial.printf("New export peak reached: %.0fW\\n", abs(balance));
+            Serial.printf("New export peak reached: %.0fW\n", fabsf(window.min));
         }
+        markChanged();
     }
     
-    if (balance > 0 && balance > peak_data.daily_import_peak) {
-        peak_data.daily_import_peak = balance;
+    if (window.max > 0 && window.max > peak_data.daily_import_peak) {
+        bool peak_reached = isPeakReached(window.max);
+        peak_data.daily_import_peak = window.max;
         peak_data.last_peak_update = millis();
         if (peak_reached && !peak_data.import_peak_reached_today) {
             peak_data.import_peak_reached_today = true;
             HapticFeedback::peakReached();
-            Serial.printf("New import peak reached: %.0fW\\n", balance);
+            Serial.printf("New import peak reached: %.0fW\n", window.max);
         }
+        markChanged();
     }
 }
 
@@ -125,53 +297,247 @@ void EnergyData_Manager::resetDailyPeaks() {
     peak_data.export_peak_reached_today = false;
     peak_data.import_peak_reached_today = false;
     peak_data.last_peak_update = millis();
-    Serial.println("Daily energy peaks reset at noon");
+    peak_cursor = power_store.getEnd();     // Earlier rows belong to yesterday
+    markChanged();
+    Serial.println("Daily energy peaks reset");
+    
+    publishSnapshot();
+}
+
+const EnergyTotals& EnergyData_Manager::getTotals() {
+    return integrator.getTotals();
+}
+
+float EnergyData_Manager::getSelfConsumptionRatio() {
+    return integrator.getSelfConsumptionRatio();
+}
+
+void EnergyData_Manager::resetDailyTotals() {
+    integrator.resetTotals();
+    markChanged();
+    Serial.println("Daily energy totals reset");
+}
+
+void EnergyData_Manager::setImportPrice(int tariff, float price_per_kwh) {
+    integrator.setImportPrice(tariff - 1, price_per_kwh);
+}
+
+void EnergyData_Manager::setExportPrice(float price_per_kwh) {
+    integrator.setExportPrice(price_per_kwh);
+}
+
+int EnergyData_Manager::tariffBand() {
+    int band = current_data.tariff - 1;
+    if (band < 0) band = 0;
+    if (band >= EnergyTotals::TARIFF_BANDS) band = EnergyTotals::TARIFF_BANDS - 1;
+    return band;
 }
 
 void EnergyData_Manager::enableMockData(bool enable) {
     mock_data_enabled = enable;
     if (enable) {
+        // Restart the scenario from its seed - every run is identical
+        MockScenario::reset();
         mock_start_time = millis();
-        Serial.println("Mock data enabled");
+        mock_sim_time = 0;
+        mock_time_scale = MockScenario::getTimeScale();
+        Serial.printf("Mock data enabled (seed %lu)\n", (unsigned long)MockScenario::getSeed());
     } else {
         Serial.println("Mock data disabled");
     }
 }
 
+bool EnergyData_Manager::loadMockScenario(const uint8_t* text, unsigned int length) {
+    // An empty payload is a cleared retained script
+    bool loaded = length ? MockScenario::load(text, length) : MockScenario::load(MockScenario::DEFAULT_SCRIPT);
+    if (loaded && mock_data_enabled) {
+        enableMockData(true);       // Start the new script from its seed at midnight
+    }
+    return loaded;
+}
+
 void EnergyData_Manager::generateMockData() {
+    // Simulated time advances on a fixed grid, so the scenario's PRNG
+    // sequence is the same however fast loop() runs
     unsigned long elapsed = millis() - mock_start_time;
-    float sim_hours = (elapsed / 1000.0) * (mock_time_scale / 60.0);
-    float time_of_day = fmod(sim_hours, 24.0);
+    uint32_t sim_now = (uint32_t)((double)elapsed * mock_time_scale / 1000.0);
     
-    // Solar generation (sunrise ~6am, peak ~noon, sunset ~6pm)
-    if (time_of_day >= 6.0 && time_of_day <= 18.0) {
-        float solar_factor = sin((time_of_day - 6.0) * M_PI / 12.0);
-        current_data.solar = solar_factor * 4500.0;  // Up to 4.5kW peak
-    } else {
-        current_data.solar = 0.0;
+    int steps = 0;
+    while (mock_sim_time + MockScenario::SAMPLE_INTERVAL <= sim_now && steps < MAX_MOCK_STEPS) {
+        mock_sim_time += MockScenario::SAMPLE_INTERVAL;
+        steps++;
+        
+        EnergyData sample = current_data;
+        if (!MockScenario::sample(mock_sim_time, sample)) {
+            continue;  // Scripted MQTT dropout
+        }
+        
+        // Same path as MQTT; integrate on simulated time so totals match the simulated day
+        unsigned long sim_ms = mock_sim_time * 1000UL;
+        ingestRole(CHANNEL_BALANCE, sample.balance, sim_ms);
+        ingestRole(CHANNEL_SOLAR, sample.solar, sim_ms);
+        ingestRole(CHANNEL_USED, sample.used, sim_ms);
+        ingestRole(CHANNEL_VRMS, sample.vrms, sim_ms);
+        if (sample.tariff != current_data.tariff) {
+            current_data.tariff = sample.tariff;
+            markChanged();
+        }
     }
-    
-    // House usage (varies throughout day)
-    float base_usage = 800.0;  // Base load
-    float daily_variation = 200.0 * sin((time_of_day - 6.0) * M_PI / 12.0);
-    if (time_of_day >= 17.0 && time_of_day <= 22.0) {
-        daily_variation += 1000.0;  // Evening peak
+}
+
+void EnergyData_Manager::configureFilter(PowerFeed feed, const FilterConfig& config) {
+    if (feed < 0 || feed >= FEED_COUNT) return;
+    filters[feed].configure(config);
+}
+
+const FilterStats& EnergyData_Manager::getFilterStats(PowerFeed feed) {
+    if (feed < 0 || feed >= FEED_COUNT) feed = FEED_BALANCE;
+    return filters[feed].getStats();
+}
+
+FeedState EnergyData_Manager::getFeedState(PowerFeed feed) {
+    return FeedFreshness::getState(feed);
+}
+
+FeedState EnergyData_Manager::getChannelState(int channel) {
+    return FeedFreshness::getChannelState(channel);
+}
+
+void EnergyData_Manager::ingestBalance(float balance, unsigned long sample_time) {
+    FeedFreshness::notifyUpdate(FEED_BALANCE, millis());
+    // Energy is integrated from the raw feed - a real spike is real energy
+    integrator.addBalance(balance, sample_time, tariffBand());
+    // History keeps the raw samples too - the bucket average smooths them
+    EnergyHistory::addSample(FEED_BALANCE, balance);
+    filterFeed(FEED_BALANCE, balance);
+}
+
+void EnergyData_Manager::ingestSolar(float solar, unsigned long sample_time) {
+    FeedFreshness::notifyUpdate(FEED_SOLAR, millis());
+    integrator.addSolar(solar, sample_time, tariffBand());
+    EnergyHistory::addSample(FEED_SOLAR, solar);
+    filterFeed(FEED_SOLAR, solar);
+}
+
+void EnergyData_Manager::ingestUsed(float used, unsigned long sample_time) {
+    FeedFreshness::notifyUpdate(FEED_USED, millis());
+    integrator.addUsed(used, sample_time, tariffBand());
+    EnergyHistory::addSample(FEED_USED, used);
+    filterFeed(FEED_USED, used);
+}
+
+void EnergyData_Manager::ingestVrms(float vrms) {
+    FeedFreshness::notifyUpdate(FEED_VRMS, millis());
+    filterFeed(FEED_VRMS, vrms);
+}
+
+void EnergyData_Manager::filterFeed(PowerFeed feed, float value) {
+    // Fields of one frame are shown together, so none may be held back
+    if (applying_frame) {
+        applyFiltered(feed, filters[feed].pushUnheld(value, millis()));
+        return;
+    }
+    float filtered;
+    if (filters[feed].push(value, millis(), filtered)) {
+        applyFiltered(feed, filtered);
+    }
+}
+
+void EnergyData_Manager::applyFiltered(PowerFeed feed, float value) {
+    switch (feed) {
+        case FEED_BALANCE:
+            current_data.balance = value;
+            // Peaks follow the filtered value, so a glitch can't set one
+            power_store.append(millis(), feed, value);
+            break;
+        case FEED_SOLAR:
+            current_data.solar = value;
+            power_store.append(millis(), feed, value);
+            break;
+        case FEED_USED:
+            current_data.used = value;
+            power_store.append(millis(), feed, value);
+            break;
+        case FEED_VRMS:
+            current_data.vrms = value;
+            break;
+        default:
+            return;
     }
-    current_data.used = base_usage + daily_variation + (random(-100, 100));
-    
-    // Balance calculation
-    current_data.balance = current_data.used - current_data.solar;
-    
-    // Mock voltage
-    current_data.vrms = 240.0 + random(-5, 5);
-    
-    // Mock tariff (simple day/night)
-    current_data.tariff = (time_of_day >= 22.0 || time_of_day <= 6.0) ? 1 : 2;
-    
     current_data.valid = true;
+    markChanged();
+}
+
+void EnergyData_Manager::flushFilters() {
+    unsigned long now = millis();
+    for (int feed = 0; feed < FEED_COUNT; feed++) {
+        float filtered;
+        if (filters[feed].flush(now, filtered)) {
+            applyFiltered((PowerFeed)feed, filtered);
+        }
+    }
+}
+
+void EnergyData_Manager::ingestChannel(int channel, float value, unsigned long sample_time) {
+    current_data.channels[channel] = value;
+    FeedFreshness::notifyChannel(channel, millis());
+    EnergyHistory::addChannelSample(channel, value);
     
-    // Update peaks
-    updateDailyPeaks(current_data.balance);
+    // Re-total the role, so e.g. two inverters feed one solar value
+    ChannelRole role = EnergyChannels::getConfig(channel).role;
+    if (role != CHANNEL_LOAD) {
+        ingestTotal(role, roleTotal(role), sample_time);
+    }
+    current_data.valid = true;
+    markChanged();
+}
+
+void EnergyData_Manager::ingestRole(ChannelRole role, float value, unsigned long sample_time) {
+    // A total for a role with exactly one channel is that channel's value;
+    // with several it can't be split, so only the total is updated
+    int channel = EnergyChannels::findRole(role);
+    if (channel >= 0 && EnergyChannels::findRole(role, channel + 1) < 0) {
+        ingestChannel(channel, value, sample_time);
+    } else {
+        ingestTotal(role, value, sample_time);
+    }
+}
+
+void EnergyData_Manager::ingestTotal(ChannelRole role, float value, unsigned long sample_time) {
+    switch (role) {
+        case CHANNEL_BALANCE:
+            ingestBalance(value, sample_time);
+            break;
+        case CHANNEL_SOLAR:
+            ingestSolar(value, sample_time);
+            break;
+        case CHANNEL_USED:
+            ingestUsed(value, sample_time);
+            break;
+        case CHANNEL_VRMS:
+            ingestVrms(value);
+            break;
+        default:
+            break;
+    }
+}
+
+float EnergyData_Manager::roleTotal(ChannelRole role) {
+    // Stale channels drop out rather than hold their last value in the total
+    float total = 0.0f;
+    int live = 0;
+    for (int c = EnergyChannels::findRole(role); c >= 0; c = EnergyChannels::findRole(role, c + 1)) {
+        FeedState state = FeedFreshness::getChannelState(c);
+        if (state == FEED_STATE_FRESH || state == FEED_STATE_LATE) {
+            total += current_data.channels[c];
+            live++;
+        }
+    }
+    // Voltages are averaged, not summed
+    if (role == CHANNEL_VRMS && live > 0) {
+        total /= live;
+    }
+    return total;
 }
 
 bool EnergyData_Manager::isPeakReached(float current_balance) {
@@ -1,38 +1,121 @@
 #pragma once
 #include "../../ui_common/data_types.h"
+#include "power_filter.h"
+#include "feed_freshness.h"
+#include "energy_channels.h"
+#include "energy_integrator.h"
+#include "../../core/network/energy_frame.h"
+#include "../../core/system/telemetry_store.h"
 #include <Arduino.h>
+#include <atomic>
 
 class EnergyData_Manager {
 public:
     static void begin();
     static void update();
+    
+    // Consistent EnergyData + PeakData pair, safe from any task/core. The
+    // writer never waits; a reader that overlaps a publish retries, so a
+    // copy is never torn.
+    static EnergySnapshot getSnapshot();
+    static uint32_t getGeneration();
+    
+    // Live working copies - only for code on the loop task that writes them
     static const EnergyData& getCurrentData();
     static const PeakData& getPeakData();
     
-    // MQTT data updates
+    // Get data change (for UI updates)
+    static bool hasDataChanged();
+    
+    // Configured channel (EnergyChannels index), raw MQTT value before scaling
+    static void updateChannel(int channel, float raw);
+    
+    // Replace the channel set - values, peaks, freshness and history restart
+    static bool configureChannels(const uint8_t* text, unsigned int length);
+    static void resetChannels();        // Back to EnergyChannels::DEFAULT_CONFIG
+    
+    // Role totals, e.g. for a source that already sums the channels
     static void updateBalance(float balance);
     static void updateSolar(float solar);
     static void updateUsed(float used);
     static void updateVrms(float vrms);
     static void updateTariff(const String& tariff);
     
-    // Peak tracking
-    static void updateDailyPeaks(float balance);
+    // Combined binary update - every field lands before the UI next reads,
+    // none held back by its filter
+    static void applyFrame(const EnergyFrame& frame);
+    
+    // Per-feed filtering between MQTT and the displayed values
+    static void configureFilter(PowerFeed feed, const FilterConfig& config);
+    static const FilterStats& getFilterStats(PowerFeed feed);
+    
+    // Freshness of each feed (stale feeds are greyed out)
+    static FeedState getFeedState(PowerFeed feed);
+    static FeedState getChannelState(int channel);
+    
+    // Peak tracking - min/max of the balance rows filtered since the last call
+    static void updateDailyPeaks();
     static void resetDailyPeaks();
     
-    // Mock data for testing
+    // Energy accumulation (trapezoidal integration of the power feeds)
+    static const EnergyTotals& getTotals();
+    static float getSelfConsumptionRatio();     // Share of solar used in the house (0-1)
+    static void resetDailyTotals();
+    static void setImportPrice(int tariff, float price_per_kwh);
+    static void setExportPrice(float price_per_kwh);
+    
+    // Mock data for testing (scenario in MockScenario)
     static void enableMockData(bool enable);
     static void generateMockData();
+    static bool loadMockScenario(const uint8_t* text, unsigned int length);    // Empty for the built-in day
 
 private:
     static EnergyData current_data;
     static PeakData peak_data;
     static String energy_tariff;
     static bool mock_data_enabled;
+    static bool data_changed;
+    
+    // Seqlock over the published snapshot: odd while a write is in progress
+    static EnergySnapshot snapshot;
+    static std::atomic<uint32_t> snapshot_sequence;
+    static bool snapshot_dirty;
+    static constexpr int SNAPSHOT_SPINS = 100;     // Reader retries before yielding to the writer
+    static void markChanged();
+    static void publishSnapshot();
+    static void clearChannels();
     
     // Mock data simulation
     static unsigned long mock_start_time;
-    static float mock_time_scale;
+    static uint32_t mock_sim_time;      // Simulated seconds of the last sample
+    static float mock_time_scale;       // Simulated seconds per real second
+    static constexpr int MAX_MOCK_STEPS = 16;   // Samples per update() - falls behind rather than skipping
     
     static bool isPeakReached(float current_balance);
+    
+    // Filtered balance/solar/used as fixed-point columns (1W), one row per sample
+    static constexpr uint8_t POWER_COLUMNS = FEED_USED + 1;
+    static TelemetryStore power_store;
+    static uint32_t peak_cursor;        // First row not yet in the peaks
+    
+    // Raw samples go to the integrators, filtered ones to display and peaks
+    static PowerFilter filters[FEED_COUNT];
+    static void ingestBalance(float balance, unsigned long sample_time);
+    static void ingestSolar(float solar, unsigned long sample_time);
+    static void ingestUsed(float used, unsigned long sample_time);
+    static void ingestVrms(float vrms);
+    static bool applying_frame;         // Frame fields bypass hold-back and decimation
+    static void filterFeed(PowerFeed feed, float value);
+    static void applyFiltered(PowerFeed feed, float value);
+    static void flushFilters();
+    
+    // Channels are unfiltered; their role totals go through the feeds above
+    static void ingestChannel(int channel, float value, unsigned long sample_time);
+    static void ingestRole(ChannelRole role, float value, unsigned long sample_time);
+    static void ingestTotal(ChannelRole role, float value, unsigned long sample_time);
+    static float roleTotal(ChannelRole role);
+    
+    // kWh and cost of the raw feeds, in the current tariff band
+    static EnergyIntegrator integrator;
+    static int tariffBand();
 };
@@ -0,0 +1,112 @@
+#include "energy_history.h"
+
+int16_t EnergyHistory::series[EnergyHistory::SERIES][EnergyHistory::BUCKETS];
+float EnergyHistory::sums[EnergyHistory::SERIES];
+uint16_t EnergyHistory::counts[EnergyHistory::SERIES];
+uint32_t EnergyHistory::count = 0;
+unsigned long EnergyHistory::bucket_start = 0;
+HistoryStats EnergyHistory::stats;
+
+void EnergyHistory::begin() {
+    for (int row = 0; row < SERIES; row++) {
+        clearRow(row);
+    }
+    count = 0;
+    bucket_start = millis();
+    stats = HistoryStats();
+}
+
+bool EnergyHistory::update(unsigned long now) {
+    if (now - bucket_start < BUCKET_MS) return false;
+    
+    // After a long stall (light sleep) only the last ring's worth is filled.
+    // The open bucket is older than that, so its samples go with it.
+    unsigned long elapsed = (now - bucket_start) / BUCKET_MS;
+    if (elapsed > BUCKETS) {
+        count += elapsed - BUCKETS;
+        bucket_start += (elapsed - BUCKETS) * BUCKET_MS;
+        for (int row = 0; row < SERIES; row++) {
+            sums[row] = 0.0f;
+            counts[row] = 0;
+        }
+    }
+    while (now - bucket_start >= BUCKET_MS) {
+        closeBucket();
+        bucket_start += BUCKET_MS;
+    }
+    return true;
+}
+
+void EnergyHistory::addSample(PowerFeed feed, float value) {
+    if (feed < 0 || feed >= FEEDS) return;
+    accumulate(feed, value);
+}
+
+void EnergyHistory::addChannelSample(int channel, float value) {
+    if (channel < 0 || channel >= EnergyData::MAX_CHANNELS) return;
+    accumulate(FEEDS + channel, value);
+}
+
+void EnergyHistory::clearChannels() {
+    for (int row = FEEDS; row < SERIES; row++) {
+        clearRow(row);
+    }
+}
+
+uint32_t EnergyHistory::getCount() {
+    return count;
+}
+
+int16_t EnergyHistory::get(PowerFeed feed, uint32_t bucket) {
+    if (feed < 0 || feed >= FEEDS) return NO_DATA;
+    return read(feed, bucket);
+}
+
+int16_t EnergyHistory::getChannel(int channel, uint32_t bucket) {
+    if (channel < 0 || channel >= EnergyData::MAX_CHANNELS) return NO_DATA;
+    return read(FEEDS + channel, bucket);
+}
+
+const HistoryStats& EnergyHistory::getStats() {
+    return stats;
+}
+
+void EnergyHistory::closeBucket() {
+    uint16_t slot = count % BUCKETS;
+    for (int row = 0; row < SERIES; row++) {
+        if (counts[row] == 0) {
+            series[row][slot] = NO_DATA;
+            stats.gaps++;
+            continue;
+        }
+        float average = sums[row] / counts[row];
+        if (average > INT16_MAX) average = INT16_MAX;
+        if (average < -INT16_MAX) average = -INT16_MAX;
+        series[row][slot] = (int16_t)lroundf(average);
+        sums[row] = 0.0f;
+        counts[row] = 0;
+    }
+    count++;
+    stats.buckets++;
+}
+
+void EnergyHistory::accumulate(int row, float value) {
+    sums[row] += value;
+    counts[row]++;
+    stats.samples++;
+}
+
+int16_t EnergyHistory::read(int row, uint32_t bucket) {
+    if (bucket >= count || count - bucket > BUCKETS) {
+        return NO_DATA;
+    }
+    return series[row][bucket % BUCKETS];
+}
+
+void EnergyHistory::clearRow(int row) {
+    for (int i = 0; i < BUCKETS; i++) {
+        series[row][i] = NO_DATA;
+    }
+    sums[row] = 0.0f;
+    counts[row] = 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+#include <Arduino.h>
+
+// History counters
+struct HistoryStats {
+    uint32_t samples = 0;
+    uint32_t buckets = 0;
+    uint32_t gaps = 0;          // Bucket/feed pairs closed without a sample
+};
+
+// Recent power history: fixed-period buckets holding the average of the
+// raw samples of balance, solar and used, and of every configured
+// channel, one array per series. The newest BUCKETS buckets are kept, in a
+// ring indexed by bucket number.
+class EnergyHistory {
+public:
+    static constexpr uint16_t BUCKETS = 100;
+    static constexpr unsigned long BUCKET_MS = 18000;      // 100 x 18s = last 30 minutes
+    static constexpr uint8_t FEEDS = FEED_USED + 1;         // Power feeds only
+    static constexpr uint8_t SERIES = FEEDS + EnergyData::MAX_CHANNELS;    // Feeds, then channels
+    static constexpr int16_t NO_DATA = INT16_MIN;
+    
+    static void begin();
+    
+    // Close finished buckets. Returns true if at least one was closed.
+    static bool update(unsigned long now);
+    
+    // Raw sample of a power feed, before PowerFilter
+    static void addSample(PowerFeed feed, float value);
+    
+    // Sample of a channel (EnergyChannels index), in its unit
+    static void addChannelSample(int channel, float value);
+    
+    // Drop all channel history (the channel set was reconfigured)
+    static void clearChannels();
+    
+    // Buckets closed since begin(); bucket n is available while n >= getCount() - BUCKETS
+    static uint32_t getCount();
+    static int16_t get(PowerFeed feed, uint32_t bucket);     // Average [W] or NO_DATA
+    static int16_t getChannel(int channel, uint32_t bucket);
+    
+    static const HistoryStats& getStats();
+
+private:
+    static int16_t series[SERIES][BUCKETS];
+    static float sums[SERIES];
+    static uint16_t counts[SERIES];
+    static uint32_t count;
+    static unsigned long bucket_start;
+    static HistoryStats stats;
+    
+    static void closeBucket();
+    static void accumulate(int row, float value);
+    static int16_t read(int row, uint32_t bucket);
+    static void clearRow(int row);
+};
@@ -0,0 +1,117 @@
+#include "energy_integrator.h"
+#include <math.h>
+
+void EnergyIntegrator::addBalance(float watts, unsigned long time_ms, int band) {
+    float previous;
+    unsigned long dt;
+    if (!advance(balance, watts, time_ms, previous, dt)) return;
+    
+    // Positive balance imports, negative exports. If the segment crosses
+    // zero, split it at the crossing so each side gets its own triangle.
+    double import_wms = 0.0;
+    double export_wms = 0.0;
+    if (previous >= 0.0f && watts >= 0.0f) {
+        import_wms = ((double)previous + watts) * 0.5 * dt;
+    } else if (previous <= 0.0f && watts <= 0.0f) {
+        export_wms = -((double)previous + watts) * 0.5 * dt;
+    } else {
+        double t_cross = dt * fabs((double)previous) / (fabs((double)previous) + fabs((double)watts));
+        if (previous > 0.0f) {
+            import_wms = previous * 0.5 * t_cross;
+            export_wms = -watts * 0.5 * (dt - t_cross);
+        } else {
+            export_wms = -previous * 0.5 * t_cross;
+            import_wms = watts * 0.5 * (dt - t_cross);
+        }
+    }
+    
+    band = clampBand(band);
+    double import_kwh = import_wms / WMS_PER_KWH;
+    double export_kwh = export_wms / WMS_PER_KWH;
+    totals.import_kwh[band] += import_kwh;
+    totals.export_kwh[band] += export_kwh;
+    totals.total_import_kwh += import_kwh;
+    totals.total_export_kwh += export_kwh;
+    totals.cost += import_kwh * import_price[band] - export_kwh * export_price;
+}
+
+void EnergyIntegrator::addSolar(float watts, unsigned long time_ms, int band) {
+    float previous;
+    unsigned long dt;
+    if (!advance(solar, watts, time_ms, previous, dt)) return;
+    
+    double kwh = ((double)previous + watts) * 0.5 * dt / WMS_PER_KWH;
+    totals.solar_kwh[clampBand(band)] += kwh;
+    totals.total_solar_kwh += kwh;
+}
+
+void EnergyIntegrator::addUsed(float watts, unsigned long time_ms, int band) {
+    float previous;
+    unsigned long dt;
+    if (!advance(used, watts, time_ms, previous, dt)) return;
+    
+    double kwh = ((double)previous + watts) * 0.5 * dt / WMS_PER_KWH;
+    totals.used_kwh[clampBand(band)] += kwh;
+    totals.total_used_kwh += kwh;
+}
+
+void EnergyIntegrator::resetTotals() {
+    totals = EnergyTotals();
+}
+
+void EnergyIntegrator::setImportPrice(int band, float price_per_kwh) {
+    if (band < 0 || band >= EnergyTotals::TARIFF_BANDS) return;
+    import_price[band] = price_per_kwh;
+}
+
+void EnergyIntegrator::setExportPrice(float price_per_kwh) {
+    export_price = price_per_kwh;
+}
+
+float EnergyIntegrator::getSelfConsumptionRatio() const {
+    if (totals.total_solar_kwh <= 0.0) {
+        return 0.0f;
+    }
+    double ratio = 1.0 - totals.total_export_kwh / totals.total_solar_kwh;
+    return ratio < 0.0 ? 0.0f : (float)ratio;
+}
+
+bool EnergyIntegrator::advance(Feed& feed, float value, unsigned long now,
+                               float& previous, unsigned long& dt) {
+    if (!feed.primed) {
+        feed.last_value = value;
+        feed.last_time = now;
+        feed.primed = true;
+        return false;
+    }
+    
+    dt = now - feed.last_time;
+    previous = feed.last_value;
+    
+    if (dt < DUPLICATE_WINDOW_MS) {
+        // A redelivery, or any burst (e.g. a drained backlog) - keep the
+        // newest value but don't start a new interval. Payloads carry no
+        // sequence number, so the two can't be told apart.
+        if (value == feed.last_value) {
+            totals.duplicates++;
+        }
+        feed.last_value = value;
+        return false;
+    }
+    
+    feed.last_value = value;
+    feed.last_time = now;
+    
+    if (dt > MAX_GAP_MS) {
+        // Nothing known about the gap - restart from this sample
+        totals.gaps++;
+        return false;
+    }
+    return true;
+}
+
+int EnergyIntegrator::clampBand(int band) {
+    if (band < 0) return 0;
+    if (band >= EnergyTotals::TARIFF_BANDS) return EnergyTotals::TARIFF_BANDS - 1;
+    return band;
+}
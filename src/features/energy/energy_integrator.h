@@ -0,0 +1,47 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+
+// Trapezoidal integration of the raw power feeds [W] into the day's kWh,
+// split by tariff band, and the cost. Sums are double: a day of 1s samples
+// adds ~86400 increments of a few mWh each to totals of tens of kWh, which
+// a float would round away (its step at 32 kWh is 4 mWh).
+// No Arduino dependency - the host tests integrate traces with it.
+class EnergyIntegrator {
+public:
+    static constexpr unsigned long DUPLICATE_WINDOW_MS = 100;   // Closer samples replace the last one
+    static constexpr unsigned long MAX_GAP_MS = 60000;          // Longer silences are not integrated
+    
+    // Samples at time_ms (millis()-style, wraps), integrated into band (0-based)
+    void addBalance(float watts, unsigned long time_ms, int band);
+    void addSolar(float watts, unsigned long time_ms, int band);
+    void addUsed(float watts, unsigned long time_ms, int band);
+    
+    // Totals only - the feeds stay primed so the first interval of the new day counts
+    void resetTotals();
+    
+    void setImportPrice(int band, float price_per_kwh);
+    void setExportPrice(float price_per_kwh);
+    
+    const EnergyTotals& getTotals() const { return totals; }
+    float getSelfConsumptionRatio() const;     // Share of solar used in the house (0-1)
+
+private:
+    static constexpr double WMS_PER_KWH = 3.6e9;               // W x ms in one kWh
+    
+    struct Feed {
+        float last_value = 0.0f;
+        unsigned long last_time = 0;
+        bool primed = false;
+    };
+    
+    EnergyTotals totals;
+    Feed balance;
+    Feed solar;
+    Feed used;
+    double import_price[EnergyTotals::TARIFF_BANDS] = {0.15, 0.30, 0.30, 0.30};     // Per kWh
+    double export_price = 0.15;
+    
+    // True if [previous, value] over dt should be integrated
+    bool advance(Feed& feed, float value, unsigned long now, float& previous, unsigned long& dt);
+    static int clampBand(int band);
+};
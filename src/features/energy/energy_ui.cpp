@@ -1,83 +1,159 @@
 #include "energy_ui.h"
 #include "../../core/hardware/haptic_feedback.h"
+#include "../../core/network/mqtt_manager.h"
+#include "../../ui_common/ui_fonts.h"
+#include "history_ring.h"
 #include <cmath>
 
+lv_obj_t* EnergyUI::balance_arc = nullptr;
+lv_obj_t* EnergyUI::balance_caption = nullptr;
+lv_obj_t* EnergyUI::export_dot = nullptr;
+lv_obj_t* EnergyUI::import_dot = nullptr;
+lv_obj_t* EnergyUI::gauge_arcs[EnergyUI::MAX_GAUGES] = {};
+uint8_t EnergyUI::gauge_channels[EnergyUI::MAX_GAUGES] = {};
+uint8_t EnergyUI::gauge_count = 0;
+uint32_t EnergyUI::layout_key = 0;
+uint32_t EnergyUI::layout_channels = 0;
+int EnergyUI::balance_sign = 0;
+
+NumericReadout EnergyUI::balance_readout(5, 36);
+NumericReadout EnergyUI::gauge_readouts[EnergyUI::MAX_GAUGES] = {
+    {4, 14}, {4, 14}, {4, 14}, {4, 14}, {4, 14}, {4, 14}
+};
+NumericReadout EnergyUI::vrms_readout(3, 12);
+
+// Layout key bits - any change needs a rebuild
+static const uint32_t LAYOUT_LOW_TARIFF = 1 << 0;
+static const uint32_t LAYOUT_VALID = 1 << 1;
+static const uint32_t LAYOUT_MQTT = 1 << 2;
+static const uint32_t LAYOUT_VRMS = 1 << 3;
+static const uint32_t LAYOUT_EXPORT_PEAK = 1 << 4;
+static const uint32_t LAYOUT_IMPORT_PEAK = 1 << 5;
+static const uint32_t LAYOUT_STALE_BALANCE = 1 << 6;
+static const uint32_t LAYOUT_GAUGE_SHOWN = 1 << 8;     // Shifted left by the gauge index
+static const uint32_t LAYOUT_GAUGE_STALE = 1 << 16;
+
+// Gauge centres relative to the screen centre: left and right of the
+// balance arc first, then the lower and upper diagonals
+static const lv_coord_t GAUGE_POSITIONS[EnergyUI::MAX_GAUGES][2] = {
+    {-130, 0}, {130, 0}, {-92, 92}, {92, 92}, {-92, -92}, {92, -92}
+};
+
 void EnergyUI::createScreen() {
     // This will be called to create the energy screen
     // Data will be passed separately for updates
 }
 
 void EnergyUI::updateScreen(const EnergyData& data, const PeakData& peaks) {
+    collectGauges();
+    
+    // Last 30 minutes around the bezel, underneath everything else
+    HistoryRing::create(lv_scr_act());
+    
     // Create title with tariff indicator
     lv_obj_t *title = lv_label_create(lv_scr_act());
-    String title_text = "⚡ ENERGY";
+    String title_text = UI_ICON_BOLT " ENERGY";
     
     // Add tariff indicator based on data
     if (data.tariff == 1 || data.tariff == 4) {
-        title_text += " 🟢";  // Green for low tariff (night/off-peak)
+        title_text += " " UI_DOT_GREEN;  // Green for low tariff (night/off-peak)
     } else {
-        title_text += " 🔴";  // Red for high tariff
+        title_text += " " UI_DOT_RED;  // Red for high tariff
     }
     
+    lv_label_set_recolor(title, true);
     lv_label_set_text(title, title_text.c_str());
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(title, UI_FONT_16, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
     
     createMainBalanceArc(data);
     createPeakDots(peaks);
     
-    if (data.solar > 0) {
-        createSolarArc(data);
+    for (int gauge = 0; gauge < gauge_count; gauge++) {
+        gauge_arcs[gauge] = nullptr;
+        if (data.channels[gauge_channels[gauge]] > 0) {
+            createGauge(gauge, data);
+        }
     }
     
-    if (data.used > 0) {
-        createUsageArc(data);
-    }
+    bool mqtt_connected = MQTTManager::isConnected();
+    createStatusDisplay(data, mqtt_connected);
     
-    createStatusDisplay(data, data.valid);
+    layout_key = layoutKey(data, peaks, mqtt_connected);
+    layout_channels = EnergyChannels::getGeneration();
+    lv_obj_add_event_cb(balance_arc, screenDeleted, LV_EVENT_DELETE, NULL);
 }
 
-void EnergyUI::createMainBalanceArc(const EnergyData& data) {
-    const float max_scale_export = 4000.0;  // 4kW export max
-    const float max_scale_import = 8000.0;  // 8kW import max
+bool EnergyUI::refresh(const EnergyData& data, const PeakData& peaks) {
+    if (!balance_arc || layout_channels != EnergyChannels::getGeneration() ||
+        layoutKey(data, peaks, MQTTManager::isConnected()) != layout_key) {
+        return false;
+    }
+    
+    // Only the digits that changed are redrawn
+    bool stale = isStale(FEED_BALANCE);
+    lv_arc_set_value(balance_arc, balanceArcValue(data.balance));
+    if (!stale) {
+        lv_obj_set_style_arc_color(balance_arc, getBalanceColor(data.balance, data.solar), LV_PART_INDICATOR);
+    }
+    int sign = balanceSign(data.balance);
+    if (sign != balance_sign) {
+        balance_sign = sign;
+        lv_label_set_text_static(balance_caption, balanceCaption(sign));
+    }
+    balance_readout.setValue(lroundf(fabsf(data.balance)));
     
-    int arc_value = 0;
-    lv_color_t arc_color = getBalanceColor(data.balance, data.solar);
+    if (export_dot) positionPeakDot(export_dot, fabsf(peaks.daily_export_peak), 4000.0);
+    if (import_dot) positionPeakDot(import_dot, peaks.daily_import_peak, 8000.0);
     
-    if (data.balance < 0) {
-        // Exporting (excess solar)
-        arc_value = calculateArcValue(abs(data.balance), max_scale_export);
-    } else if (data.balance > 0) {
-        // Importing
-        arc_value = calculateArcValue(data.balance, max_scale_import);
+    for (int gauge = 0; gauge < gauge_count; gauge++) {
+        if (!gauge_arcs[gauge]) continue;
+        int channel = gauge_channels[gauge];
+        float value = data.channels[channel];
+        lv_arc_set_value(gauge_arcs[gauge], calculateArcValue(value, EnergyChannels::getConfig(channel).full_scale));
+        gauge_readouts[gauge].setValue(lroundf(value));
+    }
+    if (layout_key & LAYOUT_VRMS) {
+        vrms_readout.setValue(lroundf(data.vrms));
     }
     
+    // New history buckets: just their columns
+    HistoryRing::update();
+    return true;
+}
+
+void EnergyUI::createMainBalanceArc(const EnergyData& data) {
+    bool stale = isStale(FEED_BALANCE);
+    lv_color_t arc_color = stale ? lv_palette_main(LV_PALETTE_GREY) : getBalanceColor(data.balance, data.solar);
+    
     // Create main balance arc
-    lv_obj_t *balance_arc = lv_arc_create(lv_scr_act());
+    balance_arc = lv_arc_create(lv_scr_act());
     lv_obj_set_size(balance_arc, 200, 200);
     lv_obj_center(balance_arc);
     lv_arc_set_rotation(balance_arc, 270);
     lv_arc_set_bg_angles(balance_arc, 0, 360);
-    lv_arc_set_value(balance_arc, arc_value);
+    lv_arc_set_value(balance_arc, balanceArcValue(data.balance));
     lv_obj_remove_style(balance_arc, NULL, LV_PART_KNOB);
     lv_obj_set_style_arc_color(balance_arc, arc_color, LV_PART_INDICATOR);
     
-    // Main balance display (center of main arc)
-    lv_obj_t *balance_label = lv_label_create(lv_scr_act());
-    String balance_text = "";
+    // Main balance display (center of main arc): direction, digits, unit
+    balance_sign = balanceSign(data.balance);
+    balance_caption = lv_label_create(lv_scr_act());
+    lv_label_set_text_static(balance_caption, balanceCaption(balance_sign));
+    lv_obj_set_style_text_font(balance_caption, UI_FONT_14, 0);
+    lv_obj_set_style_text_color(balance_caption, textColor(stale), 0);
+    lv_obj_align(balance_caption, LV_ALIGN_CENTER, 0, -34);
     
-    if (data.balance < 0) {
-        balance_text = "EXPORT\\n" + String(abs(data.balance), 0) + "W";
-    } else if (data.balance > 0) {
-        balance_text = "IMPORT\\n" + String(data.balance, 0) + "W";
-    } else {
-        balance_text = "BALANCED\\n0W";
-    }
+    lv_obj_t *digits = balance_readout.create(lv_scr_act());
+    balance_readout.setColor(textColor(stale));
+    balance_readout.setValue(lroundf(fabsf(data.balance)));
+    lv_obj_align(digits, LV_ALIGN_CENTER, -6, 6);
     
-    lv_label_set_text(balance_label, balance_text.c_str());
-    lv_obj_set_style_text_font(balance_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_align(balance_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_center(balance_label);
+    lv_obj_t *unit = lv_label_create(lv_scr_act());
+    lv_label_set_text_static(unit, "W");
+    lv_obj_set_style_text_font(unit, UI_FONT_14, 0);
+    lv_obj_set_style_text_color(unit, textColor(stale), 0);
+    lv_obj_align_to(unit, digits, LV_ALIGN_OUT_RIGHT_BOTTOM, 3, 0);
 }
 
 void EnergyUI::createPeakDots(const PeakData& peaks) {
@@ -86,19 +162,21 @@ void EnergyUI::createPeakDots(const PeakData& peaks) {
     
     // Export peak dot (green)
     if (peaks.daily_export_peak < 0) {
-        lv_obj_t *export_dot = lv_obj_create(lv_scr_act());
+        export_dot = lv_obj_create(lv_scr_act());
         lv_obj_set_size(export_dot, 8, 8);
         lv_obj_set_style_bg_color(export_dot, lv_palette_main(LV_PALETTE_GREEN), 0);
         lv_obj_set_style_border_width(export_dot, 2, 0);
         lv_obj_set_style_border_color(export_dot, lv_color_white(), 0);
         lv_obj_set_style_radius(export_dot, LV_RADIUS_CIRCLE, 0);
         
-        positionPeakDot(export_dot, abs(peaks.daily_export_peak), max_scale_export);
+        positionPeakDot(export_dot, fabsf(peaks.daily_export_peak), max_scale_export);
+    } else {
+        export_dot = nullptr;
     }
     
     // Import peak dot (red)
     if (peaks.daily_import_peak > 0) {
-        lv_obj_t *import_dot = lv_obj_create(lv_scr_act());
+        import_dot = lv_obj_create(lv_scr_act());
         lv_obj_set_size(import_dot, 8, 8);
         lv_obj_set_style_bg_color(import_dot, lv_palette_main(LV_PALETTE_RED), 0);
         lv_obj_set_style_border_width(import_dot, 2, 0);
@@ -106,75 +184,112 @@ void EnergyUI::createPeakDots(const PeakData& peaks) {
         lv_obj_set_style_radius(import_dot, LV_RADIUS_CIRCLE, 0);
         
         positionPeakDot(import_dot, peaks.daily_import_peak, max_scale_import);
+    } else {
+        import_dot = nullptr;
+    }
+}
+
+void EnergyUI::collectGauges() {
+    // Every channel that isn't the balance or the voltage, in configured order
+    gauge_count = 0;
+    for (int channel = 0; channel < EnergyChannels::getCount() && gauge_count < MAX_GAUGES; channel++) {
+        ChannelRole role = EnergyChannels::getConfig(channel).role;
+        if (role != CHANNEL_BALANCE && role != CHANNEL_VRMS) {
+            gauge_channels[gauge_count++] = channel;
+        }
     }
 }
 
-void EnergyUI::createSolarArc(const EnergyData& data) {
-    lv_obj_t *solar_arc = lv_arc_create(lv_scr_act());
-    lv_obj_set_size(solar_arc, 60, 60);
-    lv_obj_align(solar_arc, LV_ALIGN_LEFT_MID, 20, 0);
-    lv_arc_set_rotation(solar_arc, 270);
-    lv_arc_set_bg_angles(solar_arc, 0, 180);  // Half circle
-    
-    int solar_value = calculateArcValue(data.solar, 5000.0);  // 0-5000W scale
-    lv_arc_set_value(solar_arc, solar_value);
-    lv_obj_remove_style(solar_arc, NULL, LV_PART_KNOB);
-    lv_obj_set_style_arc_color(solar_arc, lv_palette_main(LV_PALETTE_YELLOW), LV_PART_INDICATOR);
-    
-    // Solar label
-    lv_obj_t *solar_label = lv_label_create(lv_scr_act());
-    String solar_text = "☀️\\n" + String(data.solar, 0);
-    lv_label_set_text(solar_label, solar_text.c_str());
-    lv_obj_set_style_text_font(solar_label, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_align(solar_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_align_to(solar_label, solar_arc, LV_ALIGN_CENTER, 0, 0);
-}
-
-void EnergyUI::createUsageArc(const EnergyData& data) {
-    lv_obj_t *usage_arc = lv_arc_create(lv_scr_act());
-    lv_obj_set_size(usage_arc, 60, 60);
-    lv_obj_align(usage_arc, LV_ALIGN_RIGHT_MID, -20, 0);
-    lv_arc_set_rotation(usage_arc, 270);
-    lv_arc_set_bg_angles(usage_arc, 0, 180);  // Half circle
-    
-    int usage_value = calculateArcValue(data.used, 8000.0);  // 0-8000W scale
-    lv_arc_set_value(usage_arc, usage_value);
-    lv_obj_remove_style(usage_arc, NULL, LV_PART_KNOB);
-    lv_obj_set_style_arc_color(usage_arc, lv_palette_main(LV_PALETTE_BLUE), LV_PART_INDICATOR);
-    
-    // Usage label
-    lv_obj_t *usage_label = lv_label_create(lv_scr_act());
-    String usage_text = "🏠\\n" + String(data.used, 0);
-    lv_label_set_text(usage_label, usage_text.c_str());
-    lv_obj_set_style_text_font(usage_label, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_align(usage_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_align_to(usage_label, usage_arc, LV_ALIGN_CENTER, 0, 0);
+void EnergyUI::createGauge(int gauge, const EnergyData& data) {
+    int channel = gauge_channels[gauge];
+    const ChannelConfig& config = EnergyChannels::getConfig(channel);
+    float value = data.channels[channel];
+    
+    lv_obj_t *arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(arc, 60, 60);
+    lv_obj_align(arc, LV_ALIGN_CENTER, GAUGE_POSITIONS[gauge][0], GAUGE_POSITIONS[gauge][1]);
+    lv_arc_set_rotation(arc, 270);
+    lv_arc_set_bg_angles(arc, 0, 180);  // Half circle
+    lv_arc_set_value(arc, calculateArcValue(value, config.full_scale));
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+    lv_color_t color = isChannelStale(channel) ? lv_palette_main(LV_PALETTE_GREY) : lv_color_hex(config.color);
+    lv_obj_set_style_arc_color(arc, color, LV_PART_INDICATOR);
+    gauge_arcs[gauge] = arc;
+    
+    // Role icon and value
+    lv_obj_t *icon = lv_label_create(lv_scr_act());
+    const char* symbol = (config.role == CHANNEL_SOLAR) ? UI_ICON_SUN :
+                         (config.role == CHANNEL_USED) ? UI_ICON_HOME : UI_ICON_BOLT;
+    lv_label_set_text_static(icon, symbol);
+    lv_obj_set_style_text_font(icon, UI_FONT_12, 0);
+    lv_obj_set_style_text_color(icon, color, 0);
+    lv_obj_align_to(icon, arc, LV_ALIGN_CENTER, 0, -8);
+    
+    NumericReadout& readout = gauge_readouts[gauge];
+    lv_obj_t *digits = readout.create(lv_scr_act());
+    readout.setColor(color);
+    readout.setValue(lroundf(value));
+    lv_obj_align_to(digits, arc, LV_ALIGN_CENTER, 0, 8);
 }
 
 void EnergyUI::createStatusDisplay(const EnergyData& data, bool mqtt_connected) {
-    lv_obj_t *status = lv_label_create(lv_scr_act());
-    String status_text = "";
+    // Row: source text, then the mains voltage readout when it is live
+    lv_obj_t *row = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(row);
+    lv_obj_set_size(row, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_column(row, 3, 0);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
     
+    lv_obj_t *status = lv_label_create(row);
+    lv_obj_set_style_text_font(status, UI_FONT_12, 0);
     if (mqtt_connected) {
-        status_text = "📡 EmonTX3";
-        if (data.vrms > 0) {
-            status_text += " | " + String(data.vrms, 0) + "V";
+        if (!data.valid) {
+            lv_label_set_text_static(status, UI_ICON_ANTENNA " EmonTX3 | No data");  // Connected but the emonTx has gone quiet
+        } else if (data.vrms > 0 && !isStale(FEED_VRMS)) {
+            lv_label_set_text_static(status, UI_ICON_ANTENNA " EmonTX3 |");
+            vrms_readout.create(row);
+            vrms_readout.setValue(lroundf(data.vrms));
+            lv_obj_t *unit = lv_label_create(row);
+            lv_label_set_text_static(unit, "V");
+            lv_obj_set_style_text_font(unit, UI_FONT_12, 0);
+        } else {
+            lv_label_set_text_static(status, UI_ICON_ANTENNA " EmonTX3");
         }
     } else {
-        status_text = "📡 Offline";
+        lv_label_set_text_static(status, UI_ICON_ANTENNA " Offline");
     }
     
-    lv_label_set_text(status, status_text.c_str());
-    lv_obj_set_style_text_font(status, &lv_font_montserrat_12, 0);
-    lv_obj_align(status, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_align(row, LV_ALIGN_BOTTOM_MID, 0, -10);
 }
 
 // Helper functions
+bool EnergyUI::isStale(PowerFeed feed) {
+    return EnergyData_Manager::getFeedState(feed) == FEED_STATE_STALE;
+}
+
+bool EnergyUI::isChannelStale(int channel) {
+    return EnergyData_Manager::getChannelState(channel) == FEED_STATE_STALE;
+}
+
 int EnergyUI::calculateArcValue(float value, float max_scale) {
     int arc_value = (int)((value / max_scale) * 100);
     return (arc_value > 100) ? 100 : arc_value;
 }
 
+int EnergyUI::balanceArcValue(float balance) {
+    const float max_scale_export = 4000.0;  // 4kW export max
+    const float max_scale_import = 8000.0;  // 8kW import max
+    
+    if (balance < 0) {
+        return calculateArcValue(fabsf(balance), max_scale_export);  // Exporting (excess solar)
+    } else if (balance > 0) {
+        return calculateArcValue(balance, max_scale_import);         // Importing
+    }
+    return 0;
+}
+
 lv_color_t EnergyUI::getBalanceColor(float balance, float solar) {
     if (balance < 0) {
         // Exporting - color based on solar generation
@@ -200,3 +315,42 @@ void EnergyUI::positionPeakDot(lv_obj_t* dot, float value, float max_scale) {
     int dot_y = 180 + (int)(90 * sin(rad));
     lv_obj_set_pos(dot, dot_x - 4, dot_y - 4);  // Center the dot
 }
+
+int EnergyUI::balanceSign(float balance) {
+    return (balance < 0) ? -1 : (balance > 0) ? 1 : 0;
+}
+
+const char* EnergyUI::balanceCaption(int sign) {
+    return (sign < 0) ? "EXPORT" : (sign > 0) ? "IMPORT" : "BALANCED";
+}
+
+lv_color_t EnergyUI::textColor(bool stale) {
+    return stale ? lv_palette_main(LV_PALETTE_GREY) : lv_obj_get_style_text_color(lv_scr_act(), LV_PART_MAIN);
+}
+
+uint32_t EnergyUI::layoutKey(const EnergyData& data, const PeakData& peaks, bool mqtt_connected) {
+    uint32_t key = 0;
+    if (data.tariff == 1 || data.tariff == 4) key |= LAYOUT_LOW_TARIFF;
+    if (data.valid) key |= LAYOUT_VALID;
+    if (mqtt_connected) key |= LAYOUT_MQTT;
+    if (mqtt_connected && data.valid && data.vrms > 0 && !isStale(FEED_VRMS)) key |= LAYOUT_VRMS;
+    if (peaks.daily_export_peak < 0) key |= LAYOUT_EXPORT_PEAK;
+    if (peaks.daily_import_peak > 0) key |= LAYOUT_IMPORT_PEAK;
+    if (isStale(FEED_BALANCE)) key |= LAYOUT_STALE_BALANCE;
+    for (int gauge = 0; gauge < gauge_count; gauge++) {
+        int channel = gauge_channels[gauge];
+        if (data.channels[channel] > 0) key |= LAYOUT_GAUGE_SHOWN << gauge;
+        if (isChannelStale(channel)) key |= LAYOUT_GAUGE_STALE << gauge;
+    }
+    return key;
+}
+
+void EnergyUI::screenDeleted(lv_event_t* e) {
+    balance_arc = nullptr;
+    balance_caption = nullptr;
+    export_dot = nullptr;
+    import_dot = nullptr;
+    for (int gauge = 0; gauge < MAX_GAUGES; gauge++) {
+        gauge_arcs[gauge] = nullptr;
+    }
+}
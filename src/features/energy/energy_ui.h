@@ -1,21 +1,60 @@
 #pragma once
 #include "energy_data.h"
+#include "../../ui_common/numeric_readout.h"
 #include <lvgl.h>
 
 class EnergyUI {
 public:
     static void createScreen();
     static void updateScreen(const EnergyData& data, const PeakData& peaks);
+    
+    // Update the screen built by updateScreen() in place. Returns false when
+    // the layout has to change (gauges or peak dots appearing, tariff, connection,
+    // staleness, channel set) - rebuild with updateScreen() then
+    static bool refresh(const EnergyData& data, const PeakData& peaks);
+    
+    // In-place updates are cheap enough to follow the data at ~30 Hz
+    static constexpr uint32_t REFRESH_PERIOD_MS = 33;
+    
+    // Small gauges around the balance arc, one per solar/used/load channel
+    static constexpr int MAX_GAUGES = 6;
 
 private:
+    // Widgets of the last built screen - cleared when it is deleted
+    static lv_obj_t* balance_arc;
+    static lv_obj_t* balance_caption;
+    static lv_obj_t* export_dot;
+    static lv_obj_t* import_dot;
+    static lv_obj_t* gauge_arcs[MAX_GAUGES];       // nullptr while the channel is at 0
+    static uint8_t gauge_channels[MAX_GAUGES];     // EnergyChannels index of each gauge
+    static uint8_t gauge_count;
+    static uint32_t layout_key;
+    static uint32_t layout_channels;               // EnergyChannels generation
+    static int balance_sign;
+    
+    // Digit readouts (atlases kept across rebuilds)
+    static NumericReadout balance_readout;
+    static NumericReadout gauge_readouts[MAX_GAUGES];
+    static NumericReadout vrms_readout;
+    
     static void createMainBalanceArc(const EnergyData& data);
     static void createPeakDots(const PeakData& peaks);
-    static void createSolarArc(const EnergyData& data);
-    static void createUsageArc(const EnergyData& data);
+    static void collectGauges();
+    static void createGauge(int gauge, const EnergyData& data);
     static void createStatusDisplay(const EnergyData& data, bool mqtt_connected);
     
     // Arc calculation helpers
     static int calculateArcValue(float value, float max_scale);
+    static int balanceArcValue(float balance);
     static lv_color_t getBalanceColor(float balance, float solar);
     static void positionPeakDot(lv_obj_t* dot, float value, float max_scale);
+    static bool isStale(PowerFeed feed);
+    static bool isChannelStale(int channel);
+    
+    // In-place update helpers
+    static int balanceSign(float balance);
+    static const char* balanceCaption(int sign);
+    static lv_color_t textColor(bool stale);
+    static uint32_t layoutKey(const EnergyData& data, const PeakData& peaks, bool mqtt_connected);
+    static void screenDeleted(lv_event_t* e);
 };
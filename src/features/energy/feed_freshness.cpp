@@ -0,0 +1,155 @@
+#include "feed_freshness.h"
+#include <cmath>
+
+TimerWheel FeedFreshness::wheel(FeedFreshness::TICK_MS);
+WheelTimer FeedFreshness::timers[FeedFreshness::SLOTS];
+FeedInfo FeedFreshness::feeds[FeedFreshness::SLOTS];
+bool FeedFreshness::state_changed = false;
+
+void FeedFreshness::begin() {
+    wheel.begin(millis());
+    for (int i = 0; i < SLOTS; i++) {
+        feeds[i] = FeedInfo();
+        feeds[i].interval_ms = DEFAULT_INTERVAL_MS;
+        timers[i] = WheelTimer();
+        timers[i].callback = onTimer;
+        timers[i].context = &feeds[i];
+    }
+    state_changed = false;
+}
+
+void FeedFreshness::update() {
+    wheel.advance(millis());
+}
+
+void FeedFreshness::notifyUpdate(PowerFeed feed, unsigned long now) {
+    if (feed < 0 || feed >= FEED_COUNT) return;
+    arrive(feed, now);
+}
+
+void FeedFreshness::notifyChannel(int channel, unsigned long now) {
+    if (channel < 0 || channel >= EnergyData::MAX_CHANNELS) return;
+    arrive(FEED_COUNT + channel, now);
+}
+
+void FeedFreshness::resetChannels() {
+    for (int i = FEED_COUNT; i < SLOTS; i++) {
+        wheel.cancel(timers[i]);
+        if (feeds[i].state != FEED_STATE_NONE) {
+            state_changed = true;
+        }
+        feeds[i] = FeedInfo();
+        feeds[i].interval_ms = DEFAULT_INTERVAL_MS;
+    }
+}
+
+void FeedFreshness::arrive(int slot, unsigned long now) {
+    FeedInfo& info = feeds[slot];
+    
+    // Learn the publish interval (smoothed like a TCP RTT estimate). An
+    // outage is not an interval - only spacing under the stale limit counts.
+    if (info.arrivals > 0) {
+        float sample = (float)(now - info.last_update);
+        if (sample >= MIN_INTERVAL_MS && sample < (float)staleDelay(info)) {
+            float deviation = fabsf(sample - info.interval_ms);
+            info.jitter_ms += (deviation - info.jitter_ms) * 0.25f;
+            info.interval_ms += (sample - info.interval_ms) * 0.125f;
+        }
+    }
+    info.last_update = now;
+    info.arrivals++;
+    
+    setState(slot, FEED_STATE_FRESH);
+    wheel.schedule(timers[slot], lateDelay(info));
+}
+
+FeedState FeedFreshness::getState(PowerFeed feed) {
+    if (feed < 0 || feed >= FEED_COUNT) return FEED_STATE_NONE;
+    return feeds[feed].state;
+}
+
+FeedState FeedFreshness::getChannelState(int channel) {
+    if (channel < 0 || channel >= EnergyData::MAX_CHANNELS) return FEED_STATE_NONE;
+    return feeds[FEED_COUNT + channel].state;
+}
+
+const FeedInfo& FeedFreshness::getInfo(PowerFeed feed) {
+    if (feed < 0 || feed >= FEED_COUNT) feed = FEED_BALANCE;
+    return feeds[feed];
+}
+
+unsigned long FeedFreshness::getAge(PowerFeed feed) {
+    if (feed < 0 || feed >= FEED_COUNT || feeds[feed].arrivals == 0) return 0;
+    return millis() - feeds[feed].last_update;
+}
+
+const char* FeedFreshness::getStateName(FeedState state) {
+    switch (state) {
+        case FEED_STATE_NONE: return "none";
+        case FEED_STATE_FRESH: return "fresh";
+        case FEED_STATE_LATE: return "late";
+        case FEED_STATE_STALE: return "stale";
+    }
+    return "unknown";
+}
+
+bool FeedFreshness::anyLive() {
+    for (int i = 0; i < SLOTS; i++) {
+        if (feeds[i].state == FEED_STATE_FRESH || feeds[i].state == FEED_STATE_LATE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FeedFreshness::hasStateChanged() {
+    if (state_changed) {
+        state_changed = false;
+        return true;
+    }
+    return false;
+}
+
+unsigned long FeedFreshness::lateDelay(const FeedInfo& info) {
+    // Overdue once half an interval plus the usual jitter has passed
+    unsigned long delay = (unsigned long)(info.interval_ms * 1.5f + info.jitter_ms * 2.0f);
+    return delay < MIN_LATE_MS ? MIN_LATE_MS : delay;
+}
+
+unsigned long FeedFreshness::staleDelay(const FeedInfo& info) {
+    // Stale after three missed intervals
+    unsigned long delay = (unsigned long)(info.interval_ms * 3.0f + info.jitter_ms * 4.0f);
+    if (delay < MIN_STALE_MS) delay = MIN_STALE_MS;
+    if (delay > MAX_STALE_MS) delay = MAX_STALE_MS;
+    return delay;
+}
+
+void FeedFreshness::onTimer(void* context) {
+    FeedInfo* info = static_cast<FeedInfo*>(context);
+    int feed = info - feeds;
+    
+    // Deadlines count from the last arrival, not from when the wheel got
+    // round to the timer - after light sleep both may have passed
+    unsigned long silent = millis() - info->last_update;
+    if (info->state == FEED_STATE_FRESH) {
+        info->late_count++;
+        setState(feed, FEED_STATE_LATE);
+        unsigned long stale = staleDelay(*info);
+        if (silent < stale) {
+            wheel.schedule(timers[feed], stale - silent);
+            return;
+        }
+    }
+    if (info->state == FEED_STATE_LATE) {
+        info->stale_count++;
+        setState(feed, FEED_STATE_STALE);
+        Serial.printf("Feed %d stale (no data for %lums)\n", feed, millis() - info->last_update);
+    }
+}
+
+void FeedFreshness::setState(int feed, FeedState state) {
+    if (feeds[feed].state != state) {
+        feeds[feed].state = state;
+        state_changed = true;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+#include "../../core/system/timer_wheel.h"
+#include <Arduino.h>
+
+// Arrival statistics of one feed
+struct FeedInfo {
+    unsigned long last_update = 0;      // millis() of the last sample
+    float interval_ms = 0.0f;           // Smoothed publish interval
+    float jitter_ms = 0.0f;             // Smoothed deviation from it
+    uint32_t arrivals = 0;
+    uint32_t late_count = 0;
+    uint32_t stale_count = 0;
+    FeedState state = FEED_STATE_NONE;
+};
+
+// Per-feed freshness. Each arrival re-arms a timer on a wheel; only a feed
+// that goes quiet ever has a timer fire, so there is no per-loop polling.
+// Every configured energy channel is tracked as well, after the feeds.
+class FeedFreshness {
+public:
+    static void begin();
+    
+    // Advance the timer wheel (call from loop)
+    static void update();
+    
+    // Record an arrival on a feed
+    static void notifyUpdate(PowerFeed feed, unsigned long now);
+    
+    // Record an arrival on a channel (EnergyChannels index)
+    static void notifyChannel(int channel, unsigned long now);
+    
+    // Forget all channels (the channel set was reconfigured)
+    static void resetChannels();
+    
+    static FeedState getState(PowerFeed feed);
+    static FeedState getChannelState(int channel);
+    static const FeedInfo& getInfo(PowerFeed feed);
+    static unsigned long getAge(PowerFeed feed);
+    static const char* getStateName(FeedState state);
+    
+    // True if any feed is fresh or late
+    static bool anyLive();
+    
+    // Get state change (for UI updates)
+    static bool hasStateChanged();
+
+private:
+    static constexpr unsigned long TICK_MS = 250;
+    static constexpr float DEFAULT_INTERVAL_MS = 10000.0f;   // EmonTX3 publishes every ~10s
+    static constexpr float MIN_INTERVAL_MS = 50.0f;          // Closer arrivals are duplicates
+    static constexpr unsigned long MIN_LATE_MS = 1000;
+    static constexpr unsigned long MIN_STALE_MS = 5000;
+    static constexpr unsigned long MAX_STALE_MS = 600000;
+    
+    static constexpr int SLOTS = FEED_COUNT + EnergyData::MAX_CHANNELS;    // Feeds, then channels
+    
+    static TimerWheel wheel;
+    static WheelTimer timers[SLOTS];
+    static FeedInfo feeds[SLOTS];
+    static bool state_changed;
+    
+    static unsigned long lateDelay(const FeedInfo& info);
+    static unsigned long staleDelay(const FeedInfo& info);
+    static void onTimer(void* context);
+    static void arrive(int slot, unsigned long now);
+    static void setState(int feed, FeedState state);
+};
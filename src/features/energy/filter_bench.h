@@ -0,0 +1,65 @@
+#pragma once
+#include "power_filter.h"
+#include "../../core/system/bench_runner.h"
+
+// Benchmark cases for PowerFilter with the configurations EnergyData_Manager
+// uses. Registered both on the knob (UIBench) and in the [env:native] host
+// build. One iteration pushes SAMPLES samples, so avg_us / SAMPLES is the
+// per-sample cost.
+class FilterBench {
+public:
+    static const int SAMPLES = 256;
+
+    static void addCases() {
+        BenchRunner::addCase({"filter_power", runFilter, CONFIG_POWER, nullptr});
+        BenchRunner::addCase({"filter_vrms", runFilter, CONFIG_VRMS, nullptr});
+    }
+
+private:
+    enum Config {
+        CONFIG_POWER = 0,   // Median of 3, glitch rejection, 250ms decimation
+        CONFIG_VRMS         // Median of 3 then EMA, 1s decimation
+    };
+
+    static FilterConfig config(int which) {
+        FilterConfig c;
+        c.median_window = 3;
+        if (which == CONFIG_POWER) {
+            c.mode = FILTER_MEDIAN;
+            c.glitch_threshold = 6000.0f;
+            c.decimate_ms = 250;
+        } else {
+            c.mode = FILTER_MEDIAN_EMA;
+            c.ema_alpha = 0.3f;
+            c.glitch_threshold = 30.0f;
+            c.decimate_ms = 1000;
+        }
+        return c;
+    }
+
+    // Noisy load with a glitch every 64 samples, 100ms apart - the same on every build
+    static void runFilter(int which) {
+        PowerFilter filter;
+        filter.configure(config(which));
+        float base = (which == CONFIG_POWER) ? 1500.0f : 240.0f;
+        float glitch = (which == CONFIG_POWER) ? 20000.0f : 100.0f;
+        uint32_t seed = 12345;
+        float total = 0.0f;
+        for (int i = 0; i < SAMPLES; i++) {
+            seed = seed * 1103515245u + 12345u;
+            float raw = base + (float)((seed >> 16) % 200) * 0.01f * base * 0.05f;
+            if (i % 64 == 63) raw += glitch;
+            float filtered;
+            if (filter.push(raw, (unsigned long)i * 100UL, filtered)) {
+                total += filtered;
+            }
+        }
+        sink() = (int32_t)total;
+    }
+
+    // Keeps results alive under optimisation
+    static volatile int32_t& sink() {
+        static volatile int32_t value;
+        return value;
+    }
+};
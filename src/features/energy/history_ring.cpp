@@ -0,0 +1,185 @@
+#include "history_ring.h"
+#include <cmath>
+
+lv_obj_t* HistoryRing::obj = nullptr;
+lv_area_t HistoryRing::column_areas[EnergyHistory::BUCKETS];
+bool HistoryRing::areas_ready = false;
+uint32_t HistoryRing::drawn_count = 0;
+RingStats HistoryRing::stats;
+
+lv_obj_t* HistoryRing::create(lv_obj_t* parent) {
+    if (!areas_ready) {
+        computeAreas();
+    }
+    obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, lv_pct(100), lv_pct(100));
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(obj, drawEvent, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, deleted, LV_EVENT_DELETE, NULL);
+    drawn_count = EnergyHistory::getCount();
+    return obj;
+}
+
+lv_obj_t* HistoryRing::getObj() {
+    return obj;
+}
+
+void HistoryRing::update() {
+    if (!obj) return;
+    uint32_t count = EnergyHistory::getCount();
+    if (count == drawn_count) return;
+    
+    if (count - drawn_count >= EnergyHistory::BUCKETS) {
+        lv_obj_invalidate(obj);
+        stats.full_redraws++;
+    } else {
+        for (uint32_t bucket = drawn_count; bucket < count; bucket++) {
+            invalidateColumn(bucket % EnergyHistory::BUCKETS);
+        }
+        invalidateColumn(count % EnergyHistory::BUCKETS);     // Cursor gap moves on
+    }
+    drawn_count = count;
+}
+
+void HistoryRing::invalidateColumn(uint16_t column) {
+    if (!obj || column >= EnergyHistory::BUCKETS) return;
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_coord_t cx = (coords.x1 + coords.x2) / 2;
+    lv_coord_t cy = (coords.y1 + coords.y2) / 2;
+    
+    lv_area_t area = column_areas[column];
+    area.x1 += cx;
+    area.x2 += cx;
+    area.y1 += cy;
+    area.y2 += cy;
+    lv_obj_invalidate_area(obj, &area);
+    stats.invalidations++;
+}
+
+const RingStats& HistoryRing::getStats() {
+    return stats;
+}
+
+void HistoryRing::computeAreas() {
+    // Bounding box of each annular sector: its four corners plus any axis
+    // extreme it crosses, padded for anti-aliasing
+    const float outer = INNER_RADIUS + THICKNESS;
+    for (uint16_t column = 0; column < EnergyHistory::BUCKETS; column++) {
+        float start = START_ANGLE + column * COLUMN_DEG;
+        float end = start + COLUMN_DEG;
+        float min_x = outer, max_x = -outer, min_y = outer, max_y = -outer;
+        
+        float angles[4];    // Both edges, and a 3 deg column crosses at most one axis
+        int n = 0;
+        angles[n++] = start;
+        angles[n++] = end;
+        for (float axis = ceilf(start / 90.0f) * 90.0f; axis < end; axis += 90.0f) {
+            angles[n++] = axis;
+        }
+        for (int i = 0; i < n; i++) {
+            float rad = angles[i] * (float)M_PI / 180.0f;
+            float c = cosf(rad), s = sinf(rad);
+            for (float r : {(float)INNER_RADIUS, outer}) {
+                min_x = fminf(min_x, r * c);
+                max_x = fmaxf(max_x, r * c);
+                min_y = fminf(min_y, r * s);
+                max_y = fmaxf(max_y, r * s);
+            }
+        }
+        lv_area_t& area = column_areas[column];
+        area.x1 = (lv_coord_t)floorf(min_x) - 1;
+        area.y1 = (lv_coord_t)floorf(min_y) - 1;
+        area.x2 = (lv_coord_t)ceilf(max_x) + 1;
+        area.y2 = (lv_coord_t)ceilf(max_y) + 1;
+    }
+    areas_ready = true;
+}
+
+lv_coord_t HistoryRing::level(float value, float scale, lv_coord_t span) {
+    float share = fabsf(value) / scale;
+    if (share > 1.0f) share = 1.0f;
+    return (lv_coord_t)lroundf(share * span);
+}
+
+void HistoryRing::drawColumn(lv_draw_ctx_t* draw_ctx, const lv_point_t& center, uint16_t column) {
+    uint32_t count = EnergyHistory::getCount();
+    if (count == 0 || column == count % EnergyHistory::BUCKETS) {
+        return;     // Nothing yet / cursor gap
+    }
+    
+    // Newest bucket stored in this column
+    uint32_t newest = count - 1;
+    uint32_t behind = (newest % EnergyHistory::BUCKETS + EnergyHistory::BUCKETS - column) % EnergyHistory::BUCKETS;
+    if (behind > newest) return;
+    uint32_t bucket = newest - behind;
+    
+    uint16_t start = (START_ANGLE + column * COLUMN_DEG) % 360;
+    uint16_t end = (start + COLUMN_DEG) % 360;
+    
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.rounded = 0;
+    
+    // Track
+    dsc.color = lv_palette_main(LV_PALETTE_GREY);
+    dsc.opa = LV_OPA_20;
+    dsc.width = THICKNESS;
+    lv_draw_arc(draw_ctx, &dsc, &center, INNER_RADIUS + THICKNESS, start, end);
+    
+    int16_t balance = EnergyHistory::get(FEED_BALANCE, bucket);
+    if (balance != EnergyHistory::NO_DATA) {
+        lv_coord_t length = 1 + level(balance, balance < 0 ? EXPORT_SCALE : IMPORT_SCALE, THICKNESS - 1);
+        dsc.color = lv_palette_main(balance < 0 ? LV_PALETTE_GREEN : LV_PALETTE_RED);
+        dsc.opa = LV_OPA_COVER;
+        dsc.width = length;
+        lv_draw_arc(draw_ctx, &dsc, &center, INNER_RADIUS + length, start, end);
+    }
+    
+    // Solar and used as 2px marks at their level
+    dsc.opa = LV_OPA_COVER;
+    dsc.width = 2;
+    int16_t solar = EnergyHistory::get(FEED_SOLAR, bucket);
+    if (solar != EnergyHistory::NO_DATA && solar > 0) {
+        dsc.color = lv_palette_main(LV_PALETTE_YELLOW);
+        lv_draw_arc(draw_ctx, &dsc, &center, INNER_RADIUS + 2 + level(solar, POWER_SCALE, THICKNESS - 2), start, end);
+    }
+    int16_t used = EnergyHistory::get(FEED_USED, bucket);
+    if (used != EnergyHistory::NO_DATA && used > 0) {
+        dsc.color = lv_palette_main(LV_PALETTE_BLUE);
+        lv_draw_arc(draw_ctx, &dsc, &center, INNER_RADIUS + 2 + level(used, POWER_SCALE, THICKNESS - 2), start, end);
+    }
+}
+
+void HistoryRing::drawEvent(lv_event_t* e) {
+    lv_draw_ctx_t* draw_ctx = lv_event_get_draw_ctx(e);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_point_t center;
+    center.x = (coords.x1 + coords.x2) / 2;
+    center.y = (coords.y1 + coords.y2) / 2;
+    
+    // Only the columns under the area being redrawn
+    uint32_t start_us = micros();
+    uint32_t drawn = 0;
+    for (uint16_t column = 0; column < EnergyHistory::BUCKETS; column++) {
+        lv_area_t area = column_areas[column];
+        area.x1 += center.x;
+        area.x2 += center.x;
+        area.y1 += center.y;
+        area.y2 += center.y;
+        if (_lv_area_is_on(&area, draw_ctx->clip_area)) {
+            drawColumn(draw_ctx, center, column);
+            drawn++;
+        }
+    }
+    if (drawn) {
+        stats.columns_drawn += drawn;
+        stats.draw_us += micros() - start_us;
+    }
+}
+
+void HistoryRing::deleted(lv_event_t* e) {
+    obj = nullptr;
+}
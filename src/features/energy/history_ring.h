@@ -0,0 +1,53 @@
+#pragma once
+#include "energy_history.h"
+#include <lvgl.h>
+
+// Ring chart counters
+struct RingStats {
+    uint32_t columns_drawn = 0;
+    uint32_t draw_us = 0;           // Time spent drawing columns
+    uint32_t invalidations = 0;     // Column areas invalidated
+    uint32_t full_redraws = 0;      // Fell behind by a whole ring
+};
+
+// Sweep ring chart of EnergyHistory around the Energy screen's bezel.
+// Bucket n always lives in column n % BUCKETS, so a new bucket never moves
+// the others: like an ECG trace the write head moves instead of the data,
+// and only the new column and the blank cursor column ahead of it are
+// invalidated. Balance is a bar (green export / red import), solar and used
+// are thin yellow / blue marks at their level.
+class HistoryRing {
+public:
+    // Full-size object on parent - create it first so it draws underneath
+    static lv_obj_t* create(lv_obj_t* parent);
+    static lv_obj_t* getObj();
+    
+    // Invalidate the columns of buckets closed since the last call
+    static void update();
+    
+    // Redraw one column (bench)
+    static void invalidateColumn(uint16_t column);
+    
+    static const RingStats& getStats();
+
+private:
+    static constexpr lv_coord_t INNER_RADIUS = 164;
+    static constexpr lv_coord_t THICKNESS = 12;
+    static constexpr uint16_t START_ANGLE = 300;    // LVGL angles: 0 = 3 o'clock, clockwise, 270 = top
+    static constexpr uint16_t COLUMN_DEG = 3;       // 100 x 3 deg - the top 60 deg stay clear for the indicator
+    static constexpr float EXPORT_SCALE = 4000.0f;  // Same scales as the main gauge
+    static constexpr float IMPORT_SCALE = 8000.0f;
+    static constexpr float POWER_SCALE = 8000.0f;
+    
+    static lv_obj_t* obj;
+    static lv_area_t column_areas[EnergyHistory::BUCKETS];    // Relative to the centre
+    static bool areas_ready;
+    static uint32_t drawn_count;
+    static RingStats stats;
+    
+    static void computeAreas();
+    static lv_coord_t level(float value, float scale, lv_coord_t span);
+    static void drawColumn(lv_draw_ctx_t* draw_ctx, const lv_point_t& center, uint16_t column);
+    static void drawEvent(lv_event_t* e);
+    static void deleted(lv_event_t* e);
+};
@@ -0,0 +1,248 @@
+#include "mock_scenario.h"
+#include <cmath>
+
+const char* const MockScenario::DEFAULT_SCRIPT =
+    "seed 1\n"
+    "scale 720\n"               // 24 hours in 2 minutes
+    "solar_peak 4500\n"
+    "base_load 800\n"
+    "variation 200\n"
+    "noise 100\n"
+    "vrms 240 5\n"
+    "spike 17:00 5h 1000\n"     // Evening peak
+    "tariff 06:00 2\n"
+    "tariff 22:00 1\n";
+
+uint32_t MockScenario::seed = 1;
+uint32_t MockScenario::rng_state = 1;
+float MockScenario::time_scale = 720.0f;
+float MockScenario::solar_peak = 4500.0f;
+float MockScenario::base_load = 800.0f;
+float MockScenario::variation = 200.0f;
+float MockScenario::noise = 100.0f;
+float MockScenario::vrms_nominal = 240.0f;
+float MockScenario::vrms_noise = 5.0f;
+MockEvent MockScenario::events[MockScenario::MAX_EVENTS];
+int MockScenario::event_count = 0;
+
+bool MockScenario::load(const char* script) {
+    return load((const uint8_t*)script, strlen(script));
+}
+
+bool MockScenario::load(const uint8_t* text, unsigned int length) {
+    // Parse into locals first so a bad script leaves the current one intact
+    uint32_t new_seed = 1;
+    float new_scale = 720.0f, new_solar = 4500.0f, new_base = 800.0f, new_variation = 200.0f;
+    float new_noise = 100.0f, new_vrms = 240.0f, new_vrms_noise = 5.0f;
+    MockEvent new_events[MAX_EVENTS];
+    int new_count = 0;
+    
+    int line_number = 0;
+    const char* p = (const char*)text;
+    const char* end = p + length;
+    while (p < end) {
+        // Copy one line so it can be tokenized in place
+        char line[MAX_LINE + 1];
+        size_t len = 0;
+        while (p < end && *p != '\n') {
+            if (len == MAX_LINE) {
+                Serial.printf("Mock scenario: line %d longer than %u characters\n",
+                              line_number + 1, (unsigned)MAX_LINE);
+                return false;
+            }
+            line[len++] = *p++;
+        }
+        if (p < end) p++;
+        line[len] = '\0';
+        line_number++;
+        
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        
+        char* save = nullptr;
+        char* keyword = strtok_r(line, " \t\r", &save);
+        if (!keyword) continue;
+        
+        char* args[4] = {};
+        int argc = 0;
+        while (argc < 4 && (args[argc] = strtok_r(nullptr, " \t\r", &save)) != nullptr) argc++;
+        
+        bool ok = true;
+        if (strcmp(keyword, "seed") == 0 && argc == 1) {
+            new_seed = strtoul(args[0], nullptr, 10);
+        } else if (strcmp(keyword, "scale") == 0 && argc == 1) {
+            new_scale = atof(args[0]);
+            ok = new_scale > 0.0f;
+        } else if (strcmp(keyword, "solar_peak") == 0 && argc == 1) {
+            new_solar = atof(args[0]);
+        } else if (strcmp(keyword, "base_load") == 0 && argc == 1) {
+            new_base = atof(args[0]);
+        } else if (strcmp(keyword, "variation") == 0 && argc == 1) {
+            new_variation = atof(args[0]);
+        } else if (strcmp(keyword, "noise") == 0 && argc == 1) {
+            new_noise = atof(args[0]);
+        } else if (strcmp(keyword, "vrms") == 0 && argc == 2) {
+            new_vrms = atof(args[0]);
+            new_vrms_noise = atof(args[1]);
+        } else if (new_count >= MAX_EVENTS) {
+            ok = false;
+        } else {
+            MockEvent& event = new_events[new_count];
+            if (strcmp(keyword, "tariff") == 0 && argc == 2) {
+                event.type = MOCK_EVENT_TARIFF;
+                ok = parseTime(args[0], event.start);
+                event.value = atoi(args[1]);
+            } else if (strcmp(keyword, "dropout") == 0 && argc == 2) {
+                event.type = MOCK_EVENT_DROPOUT;
+                ok = parseTime(args[0], event.start) && parseDuration(args[1], event.duration);
+            } else if (argc == 3 && (strcmp(keyword, "cloud") == 0 || strcmp(keyword, "spike") == 0 ||
+                                     strcmp(keyword, "sag") == 0)) {
+                event.type = (keyword[0] == 'c') ? MOCK_EVENT_CLOUD :
+                             (keyword[0] == 's' && keyword[1] == 'p') ? MOCK_EVENT_SPIKE : MOCK_EVENT_SAG;
+                ok = parseTime(args[0], event.start) && parseDuration(args[1], event.duration);
+                event.value = atof(args[2]);
+            } else {
+                ok = false;
+            }
+            if (ok) new_count++;
+        }
+        
+        if (!ok) {
+            Serial.printf("Mock scenario: error on line %d\n", line_number);
+            return false;
+        }
+    }
+    
+    seed = new_seed;
+    time_scale = new_scale;
+    solar_peak = new_solar;
+    base_load = new_base;
+    variation = new_variation;
+    noise = new_noise;
+    vrms_nominal = new_vrms;
+    vrms_noise = new_vrms_noise;
+    for (int i = 0; i < new_count; i++) events[i] = new_events[i];
+    event_count = new_count;
+    reset();
+    
+    Serial.printf("Mock scenario loaded: %d events, seed %lu, x%.0f\n",
+                  event_count, (unsigned long)seed, time_scale);
+    return true;
+}
+
+void MockScenario::reset() {
+    rng_state = seed ? seed : 1;  // xorshift must not start at 0
+}
+
+bool MockScenario::sample(uint32_t sim_seconds, EnergyData& out) {
+    uint32_t time_of_day = sim_seconds % 86400;
+    float hour = time_of_day / 3600.0f;
+    
+    // Draw noise first so a dropout doesn't shift the rest of the sequence
+    float usage_noise = randomRange(noise);
+    float voltage_noise = randomRange(vrms_noise);
+    
+    float solar = 0.0f;
+    if (hour >= 6.0f && hour <= 18.0f) {
+        solar = sinf((hour - 6.0f) * (float)M_PI / 12.0f) * solar_peak;
+    }
+    float used = base_load + variation * sinf((hour - 6.0f) * (float)M_PI / 12.0f) + usage_noise;
+    float vrms = vrms_nominal + voltage_noise;
+    
+    // Tariff: latest step at or before now, else the last step of the day before
+    int tariff = out.tariff;
+    uint32_t best_start = 0;
+    bool have_tariff = false;
+    bool dropout = false;
+    for (int i = 0; i < event_count; i++) {
+        const MockEvent& event = events[i];
+        if (event.type == MOCK_EVENT_TARIFF) {
+            bool earlier_today = event.start <= time_of_day;
+            uint32_t key = earlier_today ? event.start + 86400 : event.start;  // Today beats yesterday
+            if (!have_tariff || key > best_start) {
+                best_start = key;
+                tariff = (int)event.value;
+                have_tariff = true;
+            }
+            continue;
+        }
+        if (!isActive(event, time_of_day)) continue;
+        
+        switch (event.type) {
+            case MOCK_EVENT_CLOUD:   solar *= event.value; break;
+            case MOCK_EVENT_SPIKE:   used += event.value; break;
+            case MOCK_EVENT_SAG:     vrms = event.value + voltage_noise; break;
+            case MOCK_EVENT_DROPOUT: dropout = true; break;
+            default: break;
+        }
+    }
+    
+    if (dropout) {
+        return false;
+    }
+    
+    out.solar = solar;
+    out.used = used;
+    out.balance = used - solar;
+    out.vrms = vrms;
+    out.tariff = tariff;
+    out.valid = true;
+    return true;
+}
+
+float MockScenario::getTimeScale() {
+    return time_scale;
+}
+
+uint32_t MockScenario::getSeed() {
+    return seed;
+}
+
+int MockScenario::getEventCount() {
+    return event_count;
+}
+
+uint32_t MockScenario::nextRandom() {
+    // xorshift32
+    uint32_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state = x;
+    return x;
+}
+
+float MockScenario::randomRange(float amplitude) {
+    return ((nextRandom() >> 8) / 8388608.0f - 1.0f) * amplitude;  // 24-bit -> [-1, 1)
+}
+
+bool MockScenario::isActive(const MockEvent& event, uint32_t time_of_day) {
+    // Events may run past midnight
+    uint32_t since_start = (time_of_day + 86400 - event.start) % 86400;
+    return since_start < event.duration;
+}
+
+bool MockScenario::parseTime(const char* token, uint32_t& seconds) {
+    int hour, minute;
+    if (sscanf(token, "%d:%d", &hour, &minute) != 2 ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+        return false;
+    }
+    seconds = hour * 3600 + minute * 60;
+    return true;
+}
+
+bool MockScenario::parseDuration(const char* token, uint32_t& seconds) {
+    char* end = nullptr;
+    unsigned long value = strtoul(token, &end, 10);
+    if (end == token) return false;
+    
+    switch (*end) {
+        case '\0':
+        case 's': seconds = value; break;
+        case 'm': seconds = value * 60; break;
+        case 'h': seconds = value * 3600; break;
+        default: return false;
+    }
+    return seconds > 0;
+}
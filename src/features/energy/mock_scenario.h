@@ -0,0 +1,87 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+#include <Arduino.h>
+
+// Deterministic mock energy feed driven by a small scenario script.
+//
+// The script is compiled once into an event table. Samples are produced on
+// a fixed simulated-time grid from a seeded PRNG, so the same script and
+// seed give the same sequence on every run regardless of loop timing.
+//
+// Script lines ('#' starts a comment, times are local HH:MM, durations
+// take s/m/h suffixes; events repeat every simulated day):
+//     seed 42                     PRNG seed
+//     scale 720                   simulated seconds per real second
+//     solar_peak 4500             clear-sky solar peak [W]
+//     base_load 800               house base load [W]
+//     variation 200               daytime load swing [W]
+//     noise 100                   uniform usage noise +/- [W]
+//     vrms 240 5                  nominal voltage and noise +/- [V]
+//     cloud 11:00 20m 0.3         solar scaled by 0.3 while active
+//     spike 07:30 3m 3000         extra load [W] (kettle, EV charger...)
+//     sag 19:00 5m 225            voltage drops to 225V
+//     tariff 22:00 1              tariff band from this time on
+//     dropout 14:00 10m           no samples delivered (MQTT outage)
+//
+// A script published (retained) on MOCK_SCENARIO_TOPIC replaces the built-in
+// one; an empty payload goes back to it.
+#define MOCK_SCENARIO_TOPIC "home/knob/config/scenario"
+
+enum MockEventType {
+    MOCK_EVENT_CLOUD = 0,
+    MOCK_EVENT_SPIKE,
+    MOCK_EVENT_SAG,
+    MOCK_EVENT_TARIFF,
+    MOCK_EVENT_DROPOUT
+};
+
+struct MockEvent {
+    uint8_t type = MOCK_EVENT_CLOUD;
+    uint32_t start = 0;         // Seconds since midnight
+    uint32_t duration = 0;      // Seconds (0 for tariff steps)
+    float value = 0.0f;
+};
+
+class MockScenario {
+public:
+    static constexpr uint32_t SAMPLE_INTERVAL = 10;    // Simulated seconds between samples (EmonTX3 rate)
+    static constexpr int MAX_EVENTS = 32;
+    static constexpr size_t MAX_LINE = 95;
+    
+    // Compile a script into the event table. Returns false (and keeps the
+    // previous scenario) on a syntax error or a line over MAX_LINE.
+    static bool load(const char* script);
+    static bool load(const uint8_t* text, unsigned int length);    // Not NUL-terminated
+    
+    // Restart the PRNG from the scenario seed
+    static void reset();
+    
+    // Produce the sample for a simulated time. Returns false during a dropout.
+    static bool sample(uint32_t sim_seconds, EnergyData& out);
+    
+    static float getTimeScale();
+    static uint32_t getSeed();
+    static int getEventCount();
+    
+    // Built-in day: sine solar, evening peak, night tariff
+    static const char* const DEFAULT_SCRIPT;
+
+private:
+    static uint32_t seed;
+    static uint32_t rng_state;
+    static float time_scale;
+    static float solar_peak;
+    static float base_load;
+    static float variation;
+    static float noise;
+    static float vrms_nominal;
+    static float vrms_noise;
+    static MockEvent events[MAX_EVENTS];
+    static int event_count;
+    
+    static uint32_t nextRandom();
+    static float randomRange(float amplitude);   // Uniform in [-amplitude, amplitude)
+    static bool isActive(const MockEvent& event, uint32_t time_of_day);
+    static bool parseTime(const char* token, uint32_t& seconds);
+    static bool parseDuration(const char* token, uint32_t& seconds);
+};
@@ -0,0 +1,144 @@
+#include "peak_reset_scheduler.h"
+#include "energy_data.h"
+#include "../../core/network/time_sync.h"
+#include <Preferences.h>
+
+uint8_t PeakResetScheduler::reset_hour = 12;    // Noon by default
+uint8_t PeakResetScheduler::reset_minute = 0;
+time_t PeakResetScheduler::last_reset = 0;
+time_t PeakResetScheduler::next_reset = 0;
+unsigned long PeakResetScheduler::reset_deadline = 0;
+bool PeakResetScheduler::scheduled = false;
+
+void PeakResetScheduler::begin() {
+    Preferences prefs;
+    prefs.begin("peaks", true);
+    reset_hour = prefs.getUChar("reset_hour", reset_hour);
+    reset_minute = prefs.getUChar("reset_min", reset_minute);
+    last_reset = (time_t)prefs.getUInt("last_reset", 0);
+    prefs.end();
+    
+    scheduled = false;
+    Serial.printf("Peak reset at %02d:%02d, waiting for NTP\n", reset_hour, reset_minute);
+}
+
+void PeakResetScheduler::update() {
+    // First NTP sync or timezone change - work the deadline out again
+    if (TimeSync::hasTimeChanged()) {
+        schedule(true);
+    }
+    
+    if (!scheduled || (long)(millis() - reset_deadline) < 0) {
+        return;
+    }
+    
+    time_t now = TimeSync::now();
+    if (now < next_reset) {
+        // Clock was stepped since the deadline was armed
+        schedule(true);
+        return;
+    }
+    
+    fire(now);
+}
+
+bool PeakResetScheduler::setResetTime(int hour, int minute) {
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+        return false;
+    }
+    if (hour == reset_hour && minute == reset_minute) {
+        return true;    // Retained topic redelivered - keep the deadline and spare the flash
+    }
+    reset_hour = hour;
+    reset_minute = minute;
+    
+    Preferences prefs;
+    prefs.begin("peaks", false);
+    prefs.putUChar("reset_hour", reset_hour);
+    prefs.putUChar("reset_min", reset_minute);
+    prefs.end();
+    
+    Serial.printf("Peak reset time set to %02d:%02d\n", reset_hour, reset_minute);
+    
+    // A new time applies from now on - it must not count as a missed reset
+    schedule(false);
+    return true;
+}
+
+bool PeakResetScheduler::setResetTime(const String& hhmm) {
+    int hour, minute;
+    if (sscanf(hhmm.c_str(), "%d:%d", &hour, &minute) != 2) {
+        return false;
+    }
+    return setResetTime(hour, minute);
+}
+
+int PeakResetScheduler::getResetHour() {
+    return reset_hour;
+}
+
+int PeakResetScheduler::getResetMinute() {
+    return reset_minute;
+}
+
+time_t PeakResetScheduler::getNextReset() {
+    return scheduled ? next_reset : 0;
+}
+
+void PeakResetScheduler::schedule(bool catch_up) {
+    if (!TimeSync::isSynced()) {
+        scheduled = false;
+        return;
+    }
+    
+    time_t now = TimeSync::now();
+    
+    // After a reboot the reset following the last recorded one may
+    // already have passed - fire straight away in that case
+    time_t from = (catch_up && last_reset != 0 && last_reset < now) ? last_reset : now;
+    next_reset = nextOccurrence(from);
+    
+    unsigned long wait_ms = (next_reset > now) ? (unsigned long)(next_reset - now) * 1000UL : 0;
+    reset_deadline = millis() + wait_ms;
+    scheduled = true;
+    
+    struct tm next_tm;
+    localtime_r(&next_reset, &next_tm);
+    Serial.printf("Next peak reset: %04d-%02d-%02d %02d:%02d (in %lus)\n",
+                  next_tm.tm_year + 1900, next_tm.tm_mon + 1, next_tm.tm_mday,
+                  next_tm.tm_hour, next_tm.tm_min, wait_ms / 1000);
+}
+
+time_t PeakResetScheduler::nextOccurrence(time_t after) {
+    struct tm t;
+    localtime_r(&after, &t);
+    t.tm_hour = reset_hour;
+    t.tm_min = reset_minute;
+    t.tm_sec = 0;
+    t.tm_isdst = -1;  // Let mktime apply the TZ rule for that day
+    
+    time_t candidate = mktime(&t);
+    if (candidate <= after) {
+        // Tomorrow - go via the calendar so DST changes keep the local time
+        t.tm_mday += 1;
+        t.tm_hour = reset_hour;
+        t.tm_min = reset_minute;
+        t.tm_sec = 0;
+        t.tm_isdst = -1;
+        candidate = mktime(&t);
+    }
+    return candidate;
+}
+
+void PeakResetScheduler::fire(time_t now) {
+    EnergyData_Manager::resetDailyPeaks();
+    EnergyData_Manager::resetDailyTotals();
+    last_reset = now;
+    
+    Preferences prefs;
+    prefs.begin("peaks", false);
+    prefs.putUInt("last_reset", (uint32_t)last_reset);
+    prefs.end();
+    
+    schedule(false);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+// Resets the daily peaks and energy totals at a configurable local time of day.
+// Armed as a millis() deadline from the next local occurrence, so it
+// fires on time without polling the clock, follows DST through the TZ
+// rule and catches up on a reset missed while powered off.
+class PeakResetScheduler {
+public:
+    static void begin();
+    static void update();
+    
+    // Set the daily reset time (local, persisted)
+    static bool setResetTime(int hour, int minute);
+    static bool setResetTime(const String& hhmm);   // "HH:MM"
+    static int getResetHour();
+    static int getResetMinute();
+    
+    // Next scheduled reset (0 until the clock is synced)
+    static time_t getNextReset();
+
+private:
+    static uint8_t reset_hour;
+    static uint8_t reset_minute;
+    static time_t last_reset;
+    static time_t next_reset;
+    static unsigned long reset_deadline;
+    static bool scheduled;
+    
+    static void schedule(bool catch_up);
+    static time_t nextOccurrence(time_t after);
+    static void fire(time_t now);
+};
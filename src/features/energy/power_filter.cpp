@@ -0,0 +1,108 @@
+#include "power_filter.h"
+#include <cmath>
+
+void PowerFilter::configure(const FilterConfig& new_config) {
+    config = new_config;
+    if (config.median_window < 1) config.median_window = 1;
+    if (config.median_window > MAX_MEDIAN_WINDOW) config.median_window = MAX_MEDIAN_WINDOW;
+    reset();
+}
+
+void PowerFilter::reset() {
+    window_count = 0;
+    window_head = 0;
+    ema_primed = false;
+    has_accepted = false;
+    outlier_run = 0;
+    held = false;
+    emitted_once = false;
+}
+
+bool PowerFilter::push(float raw, unsigned long now, float& filtered) {
+    uint32_t start_cycles = ESP.getCycleCount();
+    stats.samples++;
+    
+    // Glitch rejection - a lone jump is dropped, a jump that persists for
+    // glitch_confirm samples is a real step (kettle on) and is accepted
+    if (config.glitch_threshold > 0.0f && has_accepted &&
+        fabsf(raw - last_accepted) > config.glitch_threshold) {
+        outlier_run++;
+        if (outlier_run < config.glitch_confirm) {
+            stats.rejected++;
+            stats.cycles += ESP.getCycleCount() - start_cycles;
+            return false;
+        }
+    }
+    held_value = smooth(raw);
+    held = true;
+    bool ready = flush(now, filtered);
+    
+    stats.cycles += ESP.getCycleCount() - start_cycles;
+    return ready;
+}
+
+float PowerFilter::pushUnheld(float raw, unsigned long now) {
+    uint32_t start_cycles = ESP.getCycleCount();
+    stats.samples++;
+    
+    // Anything held back from push() is older than this sample - drop it
+    float value = smooth(raw);
+    held = false;
+    last_emit = now;
+    emitted_once = true;
+    stats.emitted++;
+    
+    stats.cycles += ESP.getCycleCount() - start_cycles;
+    return value;
+}
+
+bool PowerFilter::flush(unsigned long now, float& filtered) {
+    if (!held) return false;
+    if (emitted_once && config.decimate_ms > 0 && now - last_emit < config.decimate_ms) {
+        return false;
+    }
+    
+    filtered = held_value;
+    held = false;
+    last_emit = now;
+    emitted_once = true;
+    stats.emitted++;
+    return true;
+}
+
+float PowerFilter::smooth(float raw) {
+    outlier_run = 0;
+    last_accepted = raw;
+    has_accepted = true;
+    
+    float value = raw;
+    if (config.mode == FILTER_MEDIAN || config.mode == FILTER_MEDIAN_EMA) {
+        window[window_head] = raw;
+        window_head = (window_head + 1) % config.median_window;
+        if (window_count < config.median_window) window_count++;
+        value = median();
+    }
+    if (config.mode == FILTER_EMA || config.mode == FILTER_MEDIAN_EMA) {
+        ema = ema_primed ? ema + config.ema_alpha * (value - ema) : value;
+        ema_primed = true;
+        value = ema;
+    }
+    return value;
+}
+
+float PowerFilter::median() const {
+    // Window is tiny (<= 7) - insertion sort of a copy
+    float sorted[MAX_MEDIAN_WINDOW];
+    for (uint8_t i = 0; i < window_count; i++) {
+        float v = window[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    // Even count (window still filling, or an even window) - mean of the middle two
+    uint8_t mid = window_count / 2;
+    return (window_count % 2) ? sorted[mid] : 0.5f * (sorted[mid - 1] + sorted[mid]);
+}
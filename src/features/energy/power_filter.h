@@ -0,0 +1,72 @@
+#pragma once
+#include <Arduino.h>
+
+enum FilterMode {
+    FILTER_NONE = 0,        // Pass through
+    FILTER_MEDIAN,          // Running median over the window
+    FILTER_EMA,             // Exponential moving average
+    FILTER_MEDIAN_EMA       // Median first, then smoothed
+};
+
+struct FilterConfig {
+    FilterMode mode = FILTER_MEDIAN;
+    uint8_t median_window = 3;          // Samples, up to MAX_MEDIAN_WINDOW (even: mean of the middle two)
+    float ema_alpha = 0.3f;             // Weight of the newest sample
+    float glitch_threshold = 0.0f;      // Jump [W/V] treated as a glitch, 0 = off
+    uint8_t glitch_confirm = 2;         // Consecutive outliers accepted as a real step
+    unsigned long decimate_ms = 0;      // Minimum spacing of displayed values, 0 = every sample
+};
+
+struct FilterStats {
+    uint32_t samples = 0;       // Raw samples in
+    uint32_t rejected = 0;      // Dropped as glitches
+    uint32_t emitted = 0;       // Values passed on for display
+    uint32_t cycles = 0;        // CPU cycles spent filtering
+};
+
+// Streaming filter for one power feed, between MQTT and the displayed value.
+// Glitch rejection -> median/EMA -> decimation to the display rate.
+class PowerFilter {
+public:
+    static constexpr uint8_t MAX_MEDIAN_WINDOW = 7;
+    
+    void configure(const FilterConfig& config);
+    void reset();
+    
+    // Feed a raw sample. Returns true with the filtered value when one is
+    // due for display; otherwise the value is held for flush().
+    bool push(float raw, unsigned long now, float& filtered);
+    
+    // Feed a sample that must be shown now, e.g. one field of a combined
+    // frame: median/EMA only - no glitch hold-back, no decimation
+    float pushUnheld(float raw, unsigned long now);
+    
+    // Emit a held value once the decimation interval has passed
+    bool flush(unsigned long now, float& filtered);
+    
+    const FilterConfig& getConfig() const { return config; }
+    const FilterStats& getStats() const { return stats; }
+
+private:
+    FilterConfig config;
+    FilterStats stats;
+    
+    float window[MAX_MEDIAN_WINDOW] = {};
+    uint8_t window_count = 0;
+    uint8_t window_head = 0;
+    
+    float ema = 0.0f;
+    bool ema_primed = false;
+    
+    float last_accepted = 0.0f;
+    bool has_accepted = false;
+    uint8_t outlier_run = 0;
+    
+    float held_value = 0.0f;
+    bool held = false;
+    unsigned long last_emit = 0;
+    bool emitted_once = false;
+    
+    float smooth(float raw);    // Accept as the new reference, then median/EMA
+    float median() const;
+};
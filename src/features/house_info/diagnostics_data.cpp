@@ -0,0 +1,137 @@
+#include "diagnostics_data.h"
+#include "../../core/network/wifi_manager.h"
+#include "../../core/network/mqtt_manager.h"
+#include "../../ui_common/refresh_governor.h"
+#include "../../ui_common/memory_monitor.h"
+
+DiagnosticsSample DiagnosticsData_Manager::sample;
+LatencyHistogram DiagnosticsData_Manager::loop_times;
+unsigned long DiagnosticsData_Manager::loop_start_us = 0;
+unsigned long DiagnosticsData_Manager::last_sample_ms = 0;
+unsigned long DiagnosticsData_Manager::last_decay_ms = 0;
+uint32_t DiagnosticsData_Manager::last_message_count = 0;
+uint32_t DiagnosticsData_Manager::overhead_us = 0;
+bool DiagnosticsData_Manager::sample_changed = false;
+int8_t DiagnosticsData_Manager::rssi_history[DiagnosticsData_Manager::RSSI_HISTORY] = {};
+uint8_t DiagnosticsData_Manager::rssi_head = 0;
+uint8_t DiagnosticsData_Manager::rssi_count = 0;
+const char* DiagnosticsData_Manager::error_what = nullptr;
+int DiagnosticsData_Manager::error_code = 0;
+unsigned long DiagnosticsData_Manager::error_ms = 0;
+
+void DiagnosticsData_Manager::begin() {
+    sample = DiagnosticsSample();
+    loop_times.reset();
+    rssi_head = 0;
+    rssi_count = 0;
+    overhead_us = 0;
+    last_message_count = MQTTManager::getSessionStats().messages;
+    last_sample_ms = millis();
+    last_decay_ms = last_sample_ms;
+    takeSample(last_sample_ms);
+}
+
+void DiagnosticsData_Manager::loopStart() {
+    loop_start_us = micros();
+}
+
+void DiagnosticsData_Manager::loopEnd() {
+    loop_times.record(micros() - loop_start_us);
+}
+
+void DiagnosticsData_Manager::update() {
+    unsigned long now = millis();
+    if (now - last_sample_ms < SAMPLE_INTERVAL_MS) {
+        return;
+    }
+    takeSample(now);
+
+    // A recent window rather than since boot
+    if (now - last_decay_ms >= DECAY_INTERVAL_MS) {
+        loop_times.decay();
+        last_decay_ms = now;
+    }
+}
+
+bool DiagnosticsData_Manager::hasSampleChanged() {
+    bool changed = sample_changed;
+    sample_changed = false;
+    return changed;
+}
+
+const DiagnosticsSample& DiagnosticsData_Manager::getSample() {
+    return sample;
+}
+
+uint8_t DiagnosticsData_Manager::getRssiCount() {
+    return rssi_count;
+}
+
+int8_t DiagnosticsData_Manager::getRssi(uint8_t index) {
+    if (index >= rssi_count) {
+        return 0;
+    }
+    return rssi_history[(rssi_head + RSSI_HISTORY - rssi_count + index) % RSSI_HISTORY];
+}
+
+void DiagnosticsData_Manager::recordError(const char* what, int code) {
+    error_what = what;
+    error_code = code;
+    error_ms = millis();
+}
+
+void DiagnosticsData_Manager::addOverhead(uint32_t us) {
+    overhead_us += us;
+}
+
+const LatencyHistogram& DiagnosticsData_Manager::getLoopTimes() {
+    return loop_times;
+}
+
+void DiagnosticsData_Manager::takeSample(unsigned long now) {
+    unsigned long start_us = micros();
+    unsigned long elapsed_ms = now - last_sample_ms;
+    last_sample_ms = now;
+
+    sample.uptime_s = now / 1000;
+    sample.wifi_connected = WiFiManagerWrapper::isConnected();
+    sample.mqtt_connected = MQTTManager::isConnected();
+    sample.rssi = sample.wifi_connected ? (int8_t)WiFi.RSSI() : 0;
+    rssi_history[rssi_head] = sample.rssi;
+    rssi_head = (rssi_head + 1) % RSSI_HISTORY;
+    if (rssi_count < RSSI_HISTORY) {
+        rssi_count++;
+    }
+
+    const SessionStats& session = MQTTManager::getSessionStats();
+    uint32_t messages = session.messages - last_message_count;
+    last_message_count = session.messages;
+    sample.mqtt_rate = elapsed_ms ? messages * 1000.0f / elapsed_ms : 0.0f;
+    sample.mqtt_reconnects = session.connects > 0 ? session.connects - 1 : 0;
+    sample.wifi_reconnects = WiFiManagerWrapper::getReconnectCount();
+
+    sample.loop_p50_us = loop_times.percentile(50);
+    sample.loop_p95_us = loop_times.percentile(95);
+    sample.loop_p99_us = loop_times.percentile(99);
+    const LatencyHistogram& frames = RefreshGovernor::getFrameTimes();
+    sample.frame_p50_us = frames.percentile(50);
+    sample.frame_p95_us = frames.percentile(95);
+    sample.frame_p99_us = frames.percentile(99);
+
+    sample.heap_free = ESP.getFreeHeap();
+    sample.heap_min_free = ESP.getMinFreeHeap();
+    MemorySample lvgl;
+    MemoryMonitor::sample(lvgl);
+    sample.lvgl_used = lvgl.used;
+    sample.lvgl_total = lvgl.total;
+    sample.lvgl_frag_pct = lvgl.frag_pct;
+
+    sample.last_error = error_what;
+    sample.last_error_code = error_code;
+    sample.last_error_ms = error_ms;
+
+    // This sample's own cost counts towards the next one
+    sample.overhead_us = overhead_us;
+    overhead_us = micros() - start_us;
+    sample_changed = true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "../../core/system/latency_histogram.h"
+#include <Arduino.h>
+
+// One second's view of the device, as shown on the House Info screen
+struct DiagnosticsSample {
+    unsigned long uptime_s = 0;
+    bool wifi_connected = false;
+    bool mqtt_connected = false;
+    int8_t rssi = 0;                    // dBm, 0 while WiFi is down
+    float mqtt_rate = 0.0f;             // Messages received per second
+    uint32_t loop_p50_us = 0;           // Work per loop(), sleep and delay excluded
+    uint32_t loop_p95_us = 0;
+    uint32_t loop_p99_us = 0;
+    uint32_t frame_p50_us = 0;          // lv_timer_handler() passes that rendered
+    uint32_t frame_p95_us = 0;
+    uint32_t frame_p99_us = 0;
+    uint32_t heap_free = 0;
+    uint32_t heap_min_free = 0;
+    uint32_t lvgl_used = 0;
+    uint32_t lvgl_total = 0;
+    uint8_t lvgl_frag_pct = 0;
+    uint32_t wifi_reconnects = 0;
+    uint32_t mqtt_reconnects = 0;
+    const char* last_error = nullptr;   // Static text, nullptr if none yet
+    int last_error_code = 0;
+    unsigned long last_error_ms = 0;
+    uint32_t overhead_us = 0;           // Sampling and screen updates over the last second
+};
+
+// Live diagnostics for the House Info screen. Loop and frame times go into
+// log-linear histograms (O(1) per record); everything else is sampled once a
+// second, and the cost of doing so is reported back in the sample.
+class DiagnosticsData_Manager {
+public:
+    static constexpr unsigned long SAMPLE_INTERVAL_MS = 1000;
+    static constexpr unsigned long DECAY_INTERVAL_MS = 10000;   // Halves the loop histogram
+    static constexpr uint8_t RSSI_HISTORY = 60;                 // One per sample
+
+    static void begin();
+
+    // Bracket the work of loop() - before delay() and light sleep
+    static void loopStart();
+    static void loopEnd();
+
+    // Take a sample once a second (call from loop)
+    static void update();
+
+    // True once per new sample
+    static bool hasSampleChanged();
+    static const DiagnosticsSample& getSample();
+
+    // RSSI trend, oldest first; 0 where WiFi was down
+    static uint8_t getRssiCount();
+    static int8_t getRssi(uint8_t index);
+
+    // Latest error, kept until the next one. what must be a string literal.
+    static void recordError(const char* what, int code);
+
+    // Time spent presenting the sample (screen updates)
+    static void addOverhead(uint32_t us);
+
+    static const LatencyHistogram& getLoopTimes();
+
+private:
+    static DiagnosticsSample sample;
+    static LatencyHistogram loop_times;
+    static unsigned long loop_start_us;
+    static unsigned long last_sample_ms;
+    static unsigned long last_decay_ms;
+    static uint32_t last_message_count;
+    static uint32_t overhead_us;
+    static bool sample_changed;
+
+    static int8_t rssi_history[RSSI_HISTORY];
+    static uint8_t rssi_head;
+    static uint8_t rssi_count;
+
+    static const char* error_what;
+    static int error_code;
+    static unsigned long error_ms;
+
+    static void takeSample(unsigned long now);
+};
@@ -0,0 +1,219 @@
+#include "house_info_ui.h"
+#include "../../core/network/wifi_manager.h"
+#include "../../core/network/mqtt_manager.h"
+#include "../../ui_common/ui_fonts.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+lv_obj_t* HouseInfoUI::rssi_chart = nullptr;
+lv_chart_series_t* HouseInfoUI::rssi_series = nullptr;
+lv_obj_t* HouseInfoUI::lines[HouseInfoUI::LINE_COUNT] = {};
+lv_obj_t* HouseInfoUI::footer = nullptr;
+uint32_t HouseInfoUI::layout_key = 0;
+
+// Layout key bits - any change needs a rebuild
+static const uint32_t LAYOUT_WIFI = 1 << 0;
+static const uint32_t LAYOUT_MQTT = 1 << 1;
+
+// RSSI chart range [dBm]
+static const lv_coord_t RSSI_MIN = -100;
+static const lv_coord_t RSSI_MAX = -30;
+
+static const lv_coord_t LINE_TOP = 104;
+static const lv_coord_t LINE_HEIGHT = 17;
+static const lv_coord_t LINE_WIDTH = 290;
+
+void HouseInfoUI::updateScreen(const DiagnosticsSample& sample) {
+    createStatusRing(sample);
+
+    // Create title
+    lv_obj_t *title = lv_label_create(lv_scr_act());
+    lv_label_set_text_static(title, UI_ICON_HOME " HOUSE INFO");
+    lv_obj_set_style_text_font(title, UI_FONT_18, 0);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+
+    createRssiChart();
+    createLines();
+
+    footer = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(footer, UI_FONT_10, 0);
+    lv_obj_set_width(footer, 160);
+    lv_obj_set_style_text_align(footer, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text_static(footer, "");
+    lv_obj_align(footer, LV_ALIGN_BOTTOM_MID, 0, -12);
+
+    updateLines(sample);
+
+    layout_key = layoutKey(sample);
+    lv_obj_add_event_cb(rssi_chart, screenDeleted, LV_EVENT_DELETE, NULL);
+}
+
+bool HouseInfoUI::refresh(const DiagnosticsSample& sample) {
+    if (!rssi_chart || layoutKey(sample) != layout_key) {
+        return false;
+    }
+
+    // Counted in the next sample's overhead, so the screen shows its own cost
+    unsigned long start_us = micros();
+    lv_chart_set_next_value(rssi_chart, rssi_series, rssiPoint(sample.rssi));
+    updateLines(sample);
+    DiagnosticsData_Manager::addOverhead(micros() - start_us);
+    return true;
+}
+
+void HouseInfoUI::createStatusRing(const DiagnosticsSample& sample) {
+    // Bezel ring in the connection colour
+    lv_color_t ring_color;
+    if (sample.wifi_connected && sample.mqtt_connected) {
+        ring_color = lv_palette_main(LV_PALETTE_GREEN);
+    } else if (sample.wifi_connected) {
+        ring_color = lv_palette_main(LV_PALETTE_ORANGE);
+    } else {
+        ring_color = lv_palette_main(LV_PALETTE_RED);
+    }
+
+    lv_obj_t *ring = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(ring, 352, 352);
+    lv_obj_center(ring);
+    lv_arc_set_rotation(ring, 270);
+    lv_arc_set_bg_angles(ring, 0, 360);
+    lv_arc_set_value(ring, (sample.wifi_connected ? 50 : 0) + (sample.mqtt_connected ? 50 : 0));
+    lv_obj_remove_style(ring, NULL, LV_PART_KNOB);
+    lv_obj_clear_flag(ring, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_style_arc_width(ring, 4, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(ring, 4, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(ring, ring_color, LV_PART_INDICATOR);
+}
+
+void HouseInfoUI::createRssiChart() {
+    // Last minute of signal strength, one point per sample
+    rssi_chart = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(rssi_chart, 180, 40);
+    lv_obj_align(rssi_chart, LV_ALIGN_TOP_MID, 0, 52);
+    lv_chart_set_type(rssi_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_update_mode(rssi_chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_point_count(rssi_chart, DiagnosticsData_Manager::RSSI_HISTORY);
+    lv_chart_set_range(rssi_chart, LV_CHART_AXIS_PRIMARY_Y, RSSI_MIN, RSSI_MAX);
+    lv_chart_set_div_line_count(rssi_chart, 0, 0);
+    lv_obj_set_style_size(rssi_chart, 0, LV_PART_INDICATOR);    // No point markers
+    lv_obj_set_style_pad_all(rssi_chart, 2, 0);
+    lv_obj_clear_flag(rssi_chart, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    rssi_series = lv_chart_add_series(rssi_chart, lv_palette_main(LV_PALETTE_CYAN), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_all_value(rssi_chart, rssi_series, LV_CHART_POINT_NONE);
+
+    // Back-fill from the history so the trend is there straight away
+    uint8_t count = DiagnosticsData_Manager::getRssiCount();
+    for (uint8_t i = 0; i < count; i++) {
+        lv_chart_set_next_value(rssi_chart, rssi_series, rssiPoint(DiagnosticsData_Manager::getRssi(i)));
+    }
+}
+
+void HouseInfoUI::createLines() {
+    // Fixed-width lines, so a text change only redraws its own line
+    for (int i = 0; i < LINE_COUNT; i++) {
+        lines[i] = lv_label_create(lv_scr_act());
+        lv_obj_set_style_text_font(lines[i], UI_FONT_12, 0);
+        lv_obj_set_width(lines[i], LINE_WIDTH);
+        lv_label_set_long_mode(lines[i], LV_LABEL_LONG_CLIP);
+        lv_obj_set_style_text_align(lines[i], LV_TEXT_ALIGN_CENTER, 0);
+        lv_label_set_text_static(lines[i], "");
+        lv_obj_align(lines[i], LV_ALIGN_TOP_MID, 0, LINE_TOP + i * LINE_HEIGHT);
+    }
+}
+
+void HouseInfoUI::updateLines(const DiagnosticsSample& sample) {
+    char p50[12], p95[12], p99[12];
+
+    if (sample.wifi_connected) {
+        IPAddress ip = WiFi.localIP();
+        setText(lines[LINE_WIFI], "WiFi  %d dBm  %u.%u.%u.%u", sample.rssi, ip[0], ip[1], ip[2], ip[3]);
+    } else {
+        setText(lines[LINE_WIFI], "WiFi  " UI_ICON_FAIL " disconnected");
+    }
+
+    if (sample.mqtt_connected) {
+        setText(lines[LINE_MQTT], "MQTT  %.1f msg/s  queue %u", sample.mqtt_rate, MQTTManager::getQueueDepth());
+    } else {
+        setText(lines[LINE_MQTT], "MQTT  " UI_ICON_FAIL " disconnected");
+    }
+
+    formatDuration(p50, sizeof(p50), sample.loop_p50_us);
+    formatDuration(p95, sizeof(p95), sample.loop_p95_us);
+    formatDuration(p99, sizeof(p99), sample.loop_p99_us);
+    setText(lines[LINE_LOOP], "Loop  p50 %s  p95 %s  p99 %s", p50, p95, p99);
+
+    formatDuration(p50, sizeof(p50), sample.frame_p50_us);
+    formatDuration(p95, sizeof(p95), sample.frame_p95_us);
+    formatDuration(p99, sizeof(p99), sample.frame_p99_us);
+    setText(lines[LINE_FRAME], "Frame  p50 %s  p95 %s  p99 %s", p50, p95, p99);
+
+    setText(lines[LINE_HEAP], "Heap  %luk free  min %luk",
+            (unsigned long)(sample.heap_free / 1024), (unsigned long)(sample.heap_min_free / 1024));
+    setText(lines[LINE_LVGL], "LVGL  %luk / %luk  frag %u%%",
+            (unsigned long)(sample.lvgl_used / 1024), (unsigned long)(sample.lvgl_total / 1024),
+            sample.lvgl_frag_pct);
+
+    unsigned long up = sample.uptime_s;
+    setText(lines[LINE_UPTIME], "Up %lud %02lu:%02lu:%02lu  reconnects W%lu M%lu",
+            up / 86400, (up / 3600) % 24, (up / 60) % 60, up % 60,
+            (unsigned long)sample.wifi_reconnects, (unsigned long)sample.mqtt_reconnects);
+
+    if (sample.last_error) {
+        unsigned long age_min = (millis() - sample.last_error_ms) / 60000;
+        setText(lines[LINE_ERROR], "Last error: %s %d, %lum ago", sample.last_error, sample.last_error_code, age_min);
+    } else {
+        setText(lines[LINE_ERROR], "No errors");
+    }
+
+    setText(footer, "diagnostics %luus/s", (unsigned long)sample.overhead_us);
+}
+
+void HouseInfoUI::setText(lv_obj_t* label, const char* format, ...) {
+    char text[64];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    // Setting the same text would still invalidate the label
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+void HouseInfoUI::formatDuration(char* out, size_t size, uint32_t us) {
+    if (us == 0) {
+        snprintf(out, size, "-");
+    } else if (us < 1000) {
+        snprintf(out, size, "%luus", (unsigned long)us);
+    } else if (us < 10000) {
+        snprintf(out, size, "%.1fms", us / 1000.0f);
+    } else {
+        snprintf(out, size, "%lums", (unsigned long)(us / 1000));
+    }
+}
+
+lv_coord_t HouseInfoUI::rssiPoint(int8_t rssi) {
+    if (rssi == 0) {
+        return LV_CHART_POINT_NONE;     // Gap while disconnected
+    }
+    return (rssi < RSSI_MIN) ? RSSI_MIN : (rssi > RSSI_MAX) ? RSSI_MAX : rssi;
+}
+
+uint32_t HouseInfoUI::layoutKey(const DiagnosticsSample& sample) {
+    uint32_t key = 0;
+    if (sample.wifi_connected) key |= LAYOUT_WIFI;
+    if (sample.mqtt_connected) key |= LAYOUT_MQTT;
+    return key;
+}
+
+void HouseInfoUI::screenDeleted(lv_event_t* e) {
+    rssi_chart = nullptr;
+    rssi_series = nullptr;
+    for (int i = 0; i < LINE_COUNT; i++) {
+        lines[i] = nullptr;
+    }
+    footer = nullptr;
+}
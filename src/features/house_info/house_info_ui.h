@@ -0,0 +1,44 @@
+#pragma once
+#include "diagnostics_data.h"
+#include <lvgl.h>
+
+class HouseInfoUI {
+public:
+    static void updateScreen(const DiagnosticsSample& sample);
+
+    // Update the screen built by updateScreen() in place - one RSSI point and
+    // the lines whose text changed. Returns false when the connection state
+    // changed - rebuild with updateScreen() then
+    static bool refresh(const DiagnosticsSample& sample);
+
+private:
+    enum Line {
+        LINE_WIFI = 0,
+        LINE_MQTT,
+        LINE_LOOP,
+        LINE_FRAME,
+        LINE_HEAP,
+        LINE_LVGL,
+        LINE_UPTIME,
+        LINE_ERROR,
+        LINE_COUNT
+    };
+
+    // Widgets of the last built screen - cleared when it is deleted
+    static lv_obj_t* rssi_chart;
+    static lv_chart_series_t* rssi_series;
+    static lv_obj_t* lines[LINE_COUNT];
+    static lv_obj_t* footer;
+    static uint32_t layout_key;
+
+    static void createRssiChart();
+    static void createLines();
+    static void createStatusRing(const DiagnosticsSample& sample);
+
+    static void updateLines(const DiagnosticsSample& sample);
+    static void setText(lv_obj_t* label, const char* format, ...);
+    static void formatDuration(char* out, size_t size, uint32_t us);
+    static lv_coord_t rssiPoint(int8_t rssi);
+    static uint32_t layoutKey(const DiagnosticsSample& sample);
+    static void screenDeleted(lv_event_t* e);
+};
@@ -1,4 +1,5 @@
 #include "settings_ui.h"
+#include "../../ui_common/ui_fonts.h"
 
 // Static member definitions
 int SettingsUI::selected_item = 0;
@@ -20,7 +21,7 @@ void SettingsUI::handleEncoderRotation(int direction) {
         } else {
             selected_item = (selected_item - 1 + MENU_ITEMS) % MENU_ITEMS;
         }
-        HapticFeedback::menuNavigate();
+        HapticFeedback::click();
         Serial.printf("Settings menu: item %d selected\n", selected_item);
     }
 }
@@ -60,8 +61,8 @@ void SettingsUI::reset() {
 void SettingsUI::createScreen() {
     // Create title
     lv_obj_t *title = lv_label_create(lv_scr_act());
-    lv_label_set_text(title, "⚙️ SETTINGS");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_16, 0);
+    lv_label_set_text(title, UI_ICON_SETTINGS " SETTINGS");
+    lv_obj_set_style_text_font(title, UI_FONT_16, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
     
     // Settings menu with selection indicators
@@ -69,13 +70,13 @@ void SettingsUI::createScreen() {
     String settings_text = "";
     
     // Haptic Feedback setting (item 0)
-    settings_text += (selected_item == 0) ? "▶ " : "  ";
+    settings_text += (selected_item == 0) ? UI_ICON_SELECTED " " : "  ";
     settings_text += "Haptic Feedback: ";
-    settings_text += HapticFeedback::isEnabled() ? "ON 🟢" : "OFF 🔴";
+    settings_text += HapticFeedback::isEnabled() ? "ON " UI_DOT_GREEN : "OFF " UI_DOT_RED;
     settings_text += "\n";
     
     // WiFi Reset setting (item 1)
-    settings_text += (selected_item == 1) ? "▶ " : "  ";
+    settings_text += (selected_item == 1) ? UI_ICON_SELECTED " " : "  ";
     settings_text += "Reset WiFi\n";
     
     // Non-interactive items
@@ -83,8 +84,9 @@ void SettingsUI::createScreen() {
     settings_text += "  Version: 1.0.0\n";
     settings_text += "  Board: ESP32-S3";
     
+    lv_label_set_recolor(menu_label, true);
     lv_label_set_text(menu_label, settings_text.c_str());
-    lv_obj_set_style_text_font(menu_label, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_font(menu_label, UI_FONT_14, 0);
     lv_obj_set_style_text_align(menu_label, LV_TEXT_ALIGN_LEFT, 0);
     lv_obj_center(menu_label);
     
@@ -92,7 +94,7 @@ void SettingsUI::createScreen() {
     lv_obj_t *instructions = lv_label_create(lv_scr_act());
     String inst_text = "Rotate: Navigate  Touch: Select/Toggle";
     if (HapticFeedback::isEnabled()) {
-        inst_text += "\n🎛️ Haptic feedback enabled";
+        inst_text += "\n" UI_ICON_SLIDERS " Haptic feedback enabled";
     }
     lv_label_set_text(instructions, inst_text.c_str());
     lv_obj_align(instructions, LV_ALIGN_BOTTOM_MID, 0, -10);
@@ -107,22 +109,4 @@ void SettingsUI::handleHapticToggle() {
 void SettingsUI::handleWiFiReset() {
     Serial.println("WiFi Reset selected (not implemented)");
     HapticFeedback::error();
-}
-    settings_text += "  Factory Reset\\n";
-    settings_text += "  Display Info";
-    
-    return settings_text;
-}
-
-String SettingsUI::buildInstructionsText(bool mock_enabled, bool haptic_enabled) {
-    String inst_text = "Rotate: Navigate  Touch: Select/Toggle";
-    
-    if (mock_enabled) {
-        inst_text += "\\n\\n🎯 DEMO MODE ACTIVE";
-    }
-    if (haptic_enabled) {
-        inst_text += "\\n🎛️ Haptic feedback enabled";
-    }
-    
-    return inst_text;
 }
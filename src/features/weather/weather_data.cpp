@@ -0,0 +1,262 @@
+#include "weather_data.h"
+#include "../../core/network/command_interpreter.h"
+#include <ctype.h>
+#include <string.h>
+
+WeatherData WeatherData_Manager::current_data;
+bool WeatherData_Manager::data_changed = false;
+unsigned long WeatherData_Manager::last_update = 0;
+unsigned long WeatherData_Manager::field_update[WeatherData_Manager::FIELD_COUNT] = {};
+uint8_t WeatherData_Manager::live_fields = 0;
+WeatherStats WeatherData_Manager::stats;
+
+// Accepted condition names, compared without case, spaces, '-' or '_'
+struct ConditionName {
+    const char* name;
+    WeatherCondition condition;
+};
+
+static const ConditionName CONDITION_NAMES[] = {
+    {"clear", WEATHER_CLEAR},
+    {"clearnight", WEATHER_CLEAR},
+    {"sunny", WEATHER_CLEAR},
+    {"partlycloudy", WEATHER_PARTLY_CLOUDY},
+    {"mostlysunny", WEATHER_PARTLY_CLOUDY},
+    {"fewclouds", WEATHER_PARTLY_CLOUDY},
+    {"scatteredclouds", WEATHER_PARTLY_CLOUDY},
+    {"cloudy", WEATHER_CLOUDY},
+    {"mostlycloudy", WEATHER_CLOUDY},
+    {"brokenclouds", WEATHER_CLOUDY},
+    {"overcast", WEATHER_CLOUDY},
+    {"clouds", WEATHER_CLOUDY},
+    {"windy", WEATHER_CLOUDY},
+    {"fog", WEATHER_FOG},
+    {"mist", WEATHER_FOG},
+    {"haze", WEATHER_FOG},
+    {"rain", WEATHER_RAIN},
+    {"rainy", WEATHER_RAIN},
+    {"pouring", WEATHER_RAIN},
+    {"drizzle", WEATHER_RAIN},
+    {"showers", WEATHER_RAIN},
+    {"storm", WEATHER_STORM},
+    {"thunderstorm", WEATHER_STORM},
+    {"lightning", WEATHER_STORM},
+    {"lightningrainy", WEATHER_STORM},
+    {"snow", WEATHER_SNOW},
+    {"snowy", WEATHER_SNOW},
+    {"snowyrainy", WEATHER_SNOW},
+    {"sleet", WEATHER_SNOW},
+    {"hail", WEATHER_SNOW},
+};
+
+static const char* CONDITION_DISPLAY[WEATHER_CONDITION_COUNT] = {
+    "Unknown",
+    "Clear",
+    "Partly Cloudy",
+    "Cloudy",
+    "Fog",
+    "Rain",
+    "Storm",
+    "Snow"
+};
+
+static bool matchesName(const char* name, const char* text, unsigned int length) {
+    for (unsigned int i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == ' ' || c == '-' || c == '_') continue;
+        if (*name == '\0' || tolower((unsigned char)c) != *name) return false;
+        name++;
+    }
+    return *name == '\0';
+}
+
+// Payload without surrounding whitespace
+static void trim(const char*& text, unsigned int& length) {
+    while (length > 0 && isspace((unsigned char)text[0])) {
+        text++;
+        length--;
+    }
+    while (length > 0 && isspace((unsigned char)text[length - 1])) {
+        length--;
+    }
+}
+
+static bool parseNumber(const char* text, unsigned int length, float& value) {
+    trim(text, length);
+    CommandToken token;
+    token.data = text;
+    token.length = length;
+    return length > 0 && token.toFloat(value);
+}
+
+void WeatherData_Manager::begin() {
+    current_data = WeatherData();
+    data_changed = true;
+    last_update = 0;
+    live_fields = 0;
+    stats = WeatherStats();
+    Serial.println("Weather data manager initialized");
+}
+
+void WeatherData_Manager::update() {
+    if (!live_fields) {
+        return;
+    }
+    // Each field on its own clock - a fresh humidity must not keep an old
+    // temperature on screen
+    unsigned long now = millis();
+    for (int field = 0; field < FIELD_COUNT; field++) {
+        if ((live_fields & (1 << field)) && now - field_update[field] >= STALE_MS) {
+            expire((Field)field);
+        }
+    }
+    if (!live_fields) {
+        current_data.stale = true;
+        current_data.valid = false;
+        stats.stale_count++;
+        Serial.println("Weather data stale");
+    }
+}
+
+const WeatherData& WeatherData_Manager::getCurrentData() {
+    return current_data;
+}
+
+bool WeatherData_Manager::hasDataChanged() {
+    bool changed = data_changed;
+    data_changed = false;
+    return changed;
+}
+
+unsigned long WeatherData_Manager::getAge() {
+    return millis() - last_update;
+}
+
+bool WeatherData_Manager::handleMessage(const char* topic, const uint8_t* payload, unsigned int length) {
+    stats.messages++;
+    const size_t prefix_length = sizeof(WEATHER_TOPIC_PREFIX) - 1;
+    if (strncmp(topic, WEATHER_TOPIC_PREFIX, prefix_length) != 0 || length > MAX_PAYLOAD) {
+        stats.rejected++;
+        return false;
+    }
+    const char* field = topic + prefix_length;
+    const char* text = (const char*)payload;
+    Serial.printf("MQTT [%s]: %.*s\n", topic, (int)length, text);
+
+    float value;
+    if (strcmp(field, "temperature") == 0) {
+        if (parseTemperature(text, length, value)) {
+            updateTemperature(value);
+            return true;
+        }
+    } else if (strcmp(field, "humidity") == 0) {
+        if (parseNumber(text, length, value) && value >= 0.0f && value <= 100.0f) {
+            updateHumidity(value);
+            return true;
+        }
+    } else if (strcmp(field, "condition") == 0) {
+        updateCondition(parseCondition(text, length));
+        return true;
+    } else if (strcmp(field, "forecast") == 0) {
+        // "high,low[,condition]"
+        const char* end = text + length;
+        const char* first = (const char*)memchr(text, ',', length);
+        const char* second = first ? (const char*)memchr(first + 1, ',', end - first - 1) : nullptr;
+        float high, low;
+        if (first && parseTemperature(text, first - text, high) &&
+            parseTemperature(first + 1, (second ? second : end) - first - 1, low) && low <= high) {
+            WeatherCondition condition = second ? parseCondition(second + 1, end - second - 1) : WEATHER_UNKNOWN;
+            updateForecast(high, low, condition);
+            return true;
+        }
+    }
+
+    stats.rejected++;
+    Serial.printf("Weather: rejected %s\n", topic);
+    return false;
+}
+
+void WeatherData_Manager::updateTemperature(float celsius) {
+    if (!current_data.has_temperature || celsius != current_data.temperature) {
+        current_data.temperature = celsius;
+        current_data.has_temperature = true;
+        data_changed = true;
+    }
+    markReceived(FIELD_TEMPERATURE);
+}
+
+void WeatherData_Manager::updateHumidity(float percent) {
+    if (!current_data.has_humidity || percent != current_data.humidity) {
+        current_data.humidity = percent;
+        current_data.has_humidity = true;
+        data_changed = true;
+    }
+    markReceived(FIELD_HUMIDITY);
+}
+
+void WeatherData_Manager::updateCondition(WeatherCondition condition) {
+    if (condition != current_data.condition) {
+        current_data.condition = condition;
+        data_changed = true;
+    }
+    markReceived(FIELD_CONDITION);
+}
+
+void WeatherData_Manager::updateForecast(float high, float low, WeatherCondition condition) {
+    if (!current_data.has_forecast || high != current_data.forecast_high ||
+        low != current_data.forecast_low || condition != current_data.forecast_condition) {
+        current_data.forecast_high = high;
+        current_data.forecast_low = low;
+        current_data.forecast_condition = condition;
+        current_data.has_forecast = true;
+        data_changed = true;
+    }
+    markReceived(FIELD_FORECAST);
+}
+
+WeatherCondition WeatherData_Manager::parseCondition(const char* text, unsigned int length) {
+    trim(text, length);
+    for (size_t i = 0; i < sizeof(CONDITION_NAMES) / sizeof(CONDITION_NAMES[0]); i++) {
+        if (matchesName(CONDITION_NAMES[i].name, text, length)) {
+            return CONDITION_NAMES[i].condition;
+        }
+    }
+    stats.unknown_conditions++;
+    return WEATHER_UNKNOWN;
+}
+
+const char* WeatherData_Manager::getConditionName(WeatherCondition condition) {
+    return (condition >= 0 && condition < WEATHER_CONDITION_COUNT) ? CONDITION_DISPLAY[condition] : CONDITION_DISPLAY[0];
+}
+
+const WeatherStats& WeatherData_Manager::getStats() {
+    return stats;
+}
+
+void WeatherData_Manager::markReceived(Field field) {
+    last_update = millis();
+    field_update[field] = last_update;
+    live_fields |= 1 << field;
+    if (!current_data.valid) {
+        current_data.valid = true;
+        current_data.stale = false;
+        data_changed = true;
+    }
+}
+
+void WeatherData_Manager::expire(Field field) {
+    switch (field) {
+        case FIELD_TEMPERATURE: current_data.has_temperature = false; break;
+        case FIELD_HUMIDITY:    current_data.has_humidity = false; break;
+        case FIELD_CONDITION:   current_data.condition = WEATHER_UNKNOWN; break;
+        case FIELD_FORECAST:    current_data.has_forecast = false; break;
+        default: break;
+    }
+    live_fields &= ~(1 << field);
+    stats.expired++;
+    data_changed = true;
+}
+
+bool WeatherData_Manager::parseTemperature(const char* text, unsigned int length, float& value) {
+    return parseNumber(text, length, value) && value >= -60.0f && value <= 60.0f;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "../../ui_common/data_types.h"
+#include <Arduino.h>
+
+// Weather topics - one value per topic, plain text:
+//   home/weather/temperature   "21.5"          °C
+//   home/weather/humidity      "45"            %
+//   home/weather/condition     "partlycloudy"  Home Assistant / OpenWeather style names
+//   home/weather/forecast      "24,12,rainy"   today's high, low and condition
+#define WEATHER_TOPIC_PREFIX "home/weather/"
+
+struct WeatherStats {
+    uint32_t messages = 0;
+    uint32_t rejected = 0;              // Malformed, out of range or unknown topic
+    uint32_t unknown_conditions = 0;    // Accepted, shown as unknown
+    uint32_t expired = 0;               // Fields dropped after STALE_MS without an update
+    uint32_t stale_count = 0;           // Times every field had expired
+};
+
+class WeatherData_Manager {
+public:
+    static constexpr unsigned long STALE_MS = 2UL * 60 * 60 * 1000;    // Per field - publishers update at least hourly
+    static constexpr unsigned int MAX_PAYLOAD = 48;
+
+    static void begin();
+
+    // Drops fields not updated for STALE_MS (call from loop)
+    static void update();
+
+    static const WeatherData& getCurrentData();
+
+    // Get data change (for UI updates)
+    static bool hasDataChanged();
+
+    // Time since anything was received
+    static unsigned long getAge();
+
+    // Message on a WEATHER_TOPIC_PREFIX topic - parsed straight from the
+    // receive buffer, no heap. Returns false if it was rejected.
+    static bool handleMessage(const char* topic, const uint8_t* payload, unsigned int length);
+
+    static void updateTemperature(float celsius);
+    static void updateHumidity(float percent);
+    static void updateCondition(WeatherCondition condition);
+    static void updateForecast(float high, float low, WeatherCondition condition);
+
+    // Case, spaces, '-' and '_' are ignored: "Partly Cloudy" == "partly_cloudy"
+    static WeatherCondition parseCondition(const char* text, unsigned int length);
+    static const char* getConditionName(WeatherCondition condition);
+
+    static const WeatherStats& getStats();
+
+private:
+    enum Field {
+        FIELD_TEMPERATURE = 0,
+        FIELD_HUMIDITY,
+        FIELD_CONDITION,
+        FIELD_FORECAST,
+        FIELD_COUNT
+    };
+
+    static WeatherData current_data;
+    static bool data_changed;
+    static unsigned long last_update;
+    static unsigned long field_update[FIELD_COUNT];
+    static uint8_t live_fields;         // Bit per Field
+    static WeatherStats stats;
+
+    static void markReceived(Field field);
+    static void expire(Field field);
+    static bool parseTemperature(const char* text, unsigned int length, float& value);
+};
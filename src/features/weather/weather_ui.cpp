@@ -0,0 +1,252 @@
+#include "weather_ui.h"
+#include "../../core/network/mqtt_manager.h"
+#include "../../ui_common/ui_fonts.h"
+#include <cmath>
+
+lv_obj_t* WeatherUI::temperature_arc = nullptr;
+lv_obj_t* WeatherUI::condition_label = nullptr;
+lv_obj_t* WeatherUI::humidity_label = nullptr;
+lv_obj_t* WeatherUI::forecast_label = nullptr;
+uint32_t WeatherUI::layout_key = 0;
+
+int WeatherUI::shown_band = -1;
+int WeatherUI::shown_humidity = -1;
+int WeatherUI::shown_high = 0;
+int WeatherUI::shown_low = 0;
+WeatherCondition WeatherUI::shown_condition = WEATHER_UNKNOWN;
+WeatherCondition WeatherUI::shown_forecast = WEATHER_UNKNOWN;
+
+NumericReadout WeatherUI::temperature_readout(3, 40);
+
+// Layout key bits - any change needs a rebuild
+static const uint32_t LAYOUT_TEMPERATURE = 1 << 0;
+static const uint32_t LAYOUT_HUMIDITY = 1 << 1;
+static const uint32_t LAYOUT_FORECAST = 1 << 2;
+static const uint32_t LAYOUT_VALID = 1 << 3;
+static const uint32_t LAYOUT_STALE = 1 << 4;
+static const uint32_t LAYOUT_MQTT = 1 << 5;
+
+// Arc range
+static const float ARC_MIN_C = -10.0f;
+static const float ARC_MAX_C = 40.0f;
+
+void WeatherUI::updateScreen(const WeatherData& data) {
+    shown_band = -1;
+    shown_humidity = -1;
+    shown_high = INT16_MIN;
+
+    // Create title
+    lv_obj_t *title = lv_label_create(lv_scr_act());
+    lv_label_set_text_static(title, UI_ICON_WEATHER " WEATHER");
+    lv_obj_set_style_text_font(title, UI_FONT_16, 0);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+
+    createTemperatureArc(data);
+    createDetails(data);
+
+    bool mqtt_connected = MQTTManager::isConnected();
+    createStatusDisplay(data, mqtt_connected);
+
+    layout_key = layoutKey(data, mqtt_connected);
+    lv_obj_add_event_cb(temperature_arc, screenDeleted, LV_EVENT_DELETE, NULL);
+}
+
+bool WeatherUI::refresh(const WeatherData& data) {
+    if (!temperature_arc || layoutKey(data, MQTTManager::isConnected()) != layout_key) {
+        return false;
+    }
+
+    if (data.has_temperature) setTemperature(data);
+    setCondition(data.condition);
+    if (data.has_humidity) setHumidity(data.humidity);
+    if (data.has_forecast) setForecast(data);
+    return true;
+}
+
+void WeatherUI::createTemperatureArc(const WeatherData& data) {
+    temperature_arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_size(temperature_arc, 200, 200);
+    lv_obj_center(temperature_arc);
+    lv_arc_set_rotation(temperature_arc, 270);
+    lv_arc_set_bg_angles(temperature_arc, 0, 360);
+    lv_arc_set_value(temperature_arc, 0);
+    lv_obj_remove_style(temperature_arc, NULL, LV_PART_KNOB);
+    lv_obj_set_style_arc_color(temperature_arc, lv_palette_main(LV_PALETTE_GREY), LV_PART_INDICATOR);
+
+    // Whole degrees in the centre, blank until the first reading
+    lv_obj_t *digits = temperature_readout.create(lv_scr_act());
+    lv_obj_align(digits, LV_ALIGN_CENTER, -8, -14);
+
+    lv_obj_t *unit = lv_label_create(lv_scr_act());
+    lv_label_set_text_static(unit, "°C");
+    lv_obj_set_style_text_font(unit, UI_FONT_16, 0);
+    lv_obj_align_to(unit, digits, LV_ALIGN_OUT_RIGHT_TOP, 4, 0);
+
+    if (data.has_temperature) {
+        setTemperature(data);
+    } else {
+        temperature_readout.setColor(lv_palette_main(LV_PALETTE_GREY));
+        temperature_readout.setBlank();
+    }
+    if (data.stale) {
+        lv_color_t grey = lv_palette_main(LV_PALETTE_GREY);
+        lv_obj_set_style_arc_color(temperature_arc, grey, LV_PART_INDICATOR);
+        temperature_readout.setColor(grey);
+        lv_obj_set_style_text_color(unit, grey, 0);
+    }
+}
+
+void WeatherUI::createDetails(const WeatherData& data) {
+    lv_color_t text_color = data.stale ? lv_palette_main(LV_PALETTE_GREY)
+                                       : lv_obj_get_style_text_color(lv_scr_act(), LV_PART_MAIN);
+
+    condition_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(condition_label, UI_FONT_14, 0);
+    lv_obj_set_style_text_color(condition_label, text_color, 0);
+    lv_obj_align(condition_label, LV_ALIGN_CENTER, 0, 26);
+    shown_condition = data.condition;
+    lv_label_set_text_static(condition_label, conditionText(data.condition));
+
+    humidity_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(humidity_label, UI_FONT_12, 0);
+    lv_obj_set_style_text_color(humidity_label, text_color, 0);
+    lv_obj_align(humidity_label, LV_ALIGN_CENTER, 0, 48);
+    if (data.has_humidity) {
+        setHumidity(data.humidity);
+    } else {
+        lv_label_set_text_static(humidity_label, UI_ICON_HUMIDITY " --%");
+    }
+
+    // Today's forecast below the arc
+    forecast_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(forecast_label, UI_FONT_12, 0);
+    lv_obj_set_style_text_color(forecast_label, text_color, 0);
+    lv_obj_align(forecast_label, LV_ALIGN_BOTTOM_MID, 0, -36);
+    if (data.has_forecast) {
+        setForecast(data);
+    } else {
+        lv_label_set_text_static(forecast_label, "No forecast");
+    }
+}
+
+void WeatherUI::createStatusDisplay(const WeatherData& data, bool mqtt_connected) {
+    lv_obj_t *status = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(status, UI_FONT_12, 0);
+    if (!mqtt_connected) {
+        lv_label_set_text_static(status, UI_ICON_ANTENNA " Offline");
+    } else if (data.stale) {
+        lv_label_set_text_static(status, UI_ICON_ANTENNA " Weather | Stale");
+    } else if (!data.valid) {
+        lv_label_set_text_static(status, UI_ICON_ANTENNA " Weather | No data");
+    } else {
+        lv_label_set_text_static(status, UI_ICON_ANTENNA " Live Weather");
+    }
+    lv_obj_align(status, LV_ALIGN_BOTTOM_MID, 0, -10);
+}
+
+void WeatherUI::setTemperature(const WeatherData& data) {
+    lv_arc_set_value(temperature_arc, temperatureArcValue(data.temperature));
+    temperature_readout.setValue(lroundf(data.temperature));
+
+    // Stale colours are fixed by the layout
+    int band = temperatureBand(data.temperature);
+    if (band != shown_band && !data.stale) {
+        shown_band = band;
+        lv_color_t color = bandColor(band);
+        lv_obj_set_style_arc_color(temperature_arc, color, LV_PART_INDICATOR);
+        temperature_readout.setColor(color);
+    }
+}
+
+void WeatherUI::setCondition(WeatherCondition condition) {
+    if (condition == shown_condition) return;
+    shown_condition = condition;
+    lv_label_set_text_static(condition_label, conditionText(condition));
+}
+
+void WeatherUI::setHumidity(float humidity) {
+    int percent = lroundf(humidity);
+    if (percent == shown_humidity) return;
+    shown_humidity = percent;
+    lv_label_set_text_fmt(humidity_label, UI_ICON_HUMIDITY " %d%%", percent);
+}
+
+void WeatherUI::setForecast(const WeatherData& data) {
+    int high = lroundf(data.forecast_high);
+    int low = lroundf(data.forecast_low);
+    if (high == shown_high && low == shown_low && data.forecast_condition == shown_forecast) {
+        return;
+    }
+    shown_high = high;
+    shown_low = low;
+    shown_forecast = data.forecast_condition;
+    lv_label_set_text_fmt(forecast_label, "Today %s  H %d°  L %d°", conditionIcon(shown_forecast), high, low);
+}
+
+// Helper functions
+int WeatherUI::temperatureArcValue(float celsius) {
+    int value = (int)((celsius - ARC_MIN_C) / (ARC_MAX_C - ARC_MIN_C) * 100);
+    return (value < 0) ? 0 : (value > 100) ? 100 : value;
+}
+
+int WeatherUI::temperatureBand(float celsius) {
+    if (celsius < 0.0f) return 0;       // Freezing
+    if (celsius < 10.0f) return 1;      // Cold
+    if (celsius < 20.0f) return 2;      // Mild
+    if (celsius < 28.0f) return 3;      // Warm
+    return 4;                           // Hot
+}
+
+lv_color_t WeatherUI::bandColor(int band) {
+    switch (band) {
+        case 0: return lv_palette_main(LV_PALETTE_BLUE);
+        case 1: return lv_palette_main(LV_PALETTE_CYAN);
+        case 2: return lv_palette_main(LV_PALETTE_GREEN);
+        case 3: return lv_palette_main(LV_PALETTE_ORANGE);
+        default: return lv_palette_main(LV_PALETTE_RED);
+    }
+}
+
+const char* WeatherUI::conditionText(WeatherCondition condition) {
+    switch (condition) {
+        case WEATHER_CLEAR: return UI_ICON_SUN " Clear";
+        case WEATHER_PARTLY_CLOUDY: return UI_ICON_WEATHER " Partly Cloudy";
+        case WEATHER_CLOUDY: return UI_ICON_CLOUD " Cloudy";
+        case WEATHER_FOG: return UI_ICON_FOG " Fog";
+        case WEATHER_RAIN: return UI_ICON_RAIN " Rain";
+        case WEATHER_STORM: return UI_ICON_STORM " Storm";
+        case WEATHER_SNOW: return UI_ICON_SNOW " Snow";
+        default: return "";
+    }
+}
+
+const char* WeatherUI::conditionIcon(WeatherCondition condition) {
+    switch (condition) {
+        case WEATHER_CLEAR: return UI_ICON_SUN;
+        case WEATHER_PARTLY_CLOUDY: return UI_ICON_WEATHER;
+        case WEATHER_CLOUDY: return UI_ICON_CLOUD;
+        case WEATHER_FOG: return UI_ICON_FOG;
+        case WEATHER_RAIN: return UI_ICON_RAIN;
+        case WEATHER_STORM: return UI_ICON_STORM;
+        case WEATHER_SNOW: return UI_ICON_SNOW;
+        default: return "";
+    }
+}
+
+uint32_t WeatherUI::layoutKey(const WeatherData& data, bool mqtt_connected) {
+    uint32_t key = 0;
+    if (data.has_temperature) key |= LAYOUT_TEMPERATURE;
+    if (data.has_humidity) key |= LAYOUT_HUMIDITY;
+    if (data.has_forecast) key |= LAYOUT_FORECAST;
+    if (data.valid) key |= LAYOUT_VALID;
+    if (data.stale) key |= LAYOUT_STALE;
+    if (mqtt_connected) key |= LAYOUT_MQTT;
+    return key;
+}
+
+void WeatherUI::screenDeleted(lv_event_t* e) {
+    temperature_arc = nullptr;
+    condition_label = nullptr;
+    humidity_label = nullptr;
+    forecast_label = nullptr;
+}
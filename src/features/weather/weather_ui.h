@@ -0,0 +1,50 @@
+#pragma once
+#include "weather_data.h"
+#include "../../ui_common/numeric_readout.h"
+#include <lvgl.h>
+
+class WeatherUI {
+public:
+    static void updateScreen(const WeatherData& data);
+
+    // Update the screen built by updateScreen() in place - only widgets whose
+    // value changed are touched. Returns false when the layout has to change
+    // (a field appearing, staleness, connection) - rebuild with updateScreen() then
+    static bool refresh(const WeatherData& data);
+
+private:
+    // Widgets of the last built screen - cleared when it is deleted
+    static lv_obj_t* temperature_arc;
+    static lv_obj_t* condition_label;
+    static lv_obj_t* humidity_label;
+    static lv_obj_t* forecast_label;
+    static uint32_t layout_key;
+
+    // Values on screen, so unchanged labels are not re-laid out
+    static int shown_band;
+    static int shown_humidity;
+    static int shown_high;
+    static int shown_low;
+    static WeatherCondition shown_condition;
+    static WeatherCondition shown_forecast;
+
+    // Whole degrees (atlas kept across rebuilds)
+    static NumericReadout temperature_readout;
+
+    static void createTemperatureArc(const WeatherData& data);
+    static void createDetails(const WeatherData& data);
+    static void createStatusDisplay(const WeatherData& data, bool mqtt_connected);
+
+    static void setTemperature(const WeatherData& data);
+    static void setCondition(WeatherCondition condition);
+    static void setHumidity(float humidity);
+    static void setForecast(const WeatherData& data);
+
+    static int temperatureArcValue(float celsius);
+    static int temperatureBand(float celsius);
+    static lv_color_t bandColor(int band);
+    static const char* conditionText(WeatherCondition condition);
+    static const char* conditionIcon(WeatherCondition condition);
+    static uint32_t layoutKey(const WeatherData& data, bool mqtt_connected);
+    static void screenDeleted(lv_event_t* e);
+};
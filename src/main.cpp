@@ -10,11 +10,27 @@
 // Refactored components
 #include "core/hardware/haptic_feedback.h"
 #include "core/hardware/rotary_encoder.h"
+#include "core/hardware/backlight.h"
+#include "core/hardware/display_flush.h"
+#include "core/hardware/power_manager.h"
 #include "core/network/wifi_manager.h"
 #include "core/network/mqtt_manager.h"
+#include "core/network/time_sync.h"
+#include "core/network/trace_replay.h"
+#include "core/network/command_interpreter.h"
 #include "features/energy/energy_ui.h"
 #include "features/energy/energy_data.h"
+#include "features/weather/weather_ui.h"
+#include "features/weather/weather_data.h"
+#include "features/house_info/house_info_ui.h"
+#include "features/house_info/diagnostics_data.h"
 #include "features/settings/settings_ui.h"
+#include "ui_common/screen_transition.h"
+#include "ui_common/refresh_governor.h"
+#include "ui_common/ui_bench.h"
+#include "ui_common/memory_monitor.h"
+#include "ui_common/screen_arena.h"
+#include "ui_common/ui_fonts.h"
 
 // Display and LVGL setup
 TFT_eSPI tft = TFT_eSPI();
@@ -35,8 +51,9 @@ const char* screen_names[] = {
 };
 
 // Navigation state
-unsigned long last_interaction = 0;
 bool screen_changed = true;
+bool transition_pending = false;    // Next UI update is a screen switch
+int transition_direction = 1;       // +1 next, -1 previous
 
 // Forward declarations
 void next_screen();
@@ -44,6 +61,11 @@ void previous_screen();
 
 // Navigation callback for rotary encoder
 void on_navigation_change(int direction) {
+    RefreshGovernor::notifyInput();
+    if (PowerManager::notifyActivity()) {
+        return;  // Rotation only woke the screen
+    }
+    
     if (current_screen == SCREEN_SETTINGS && SettingsUI::isMenuActive()) {
         // Navigate settings menu
         SettingsUI::handleEncoderRotation(direction);
@@ -70,18 +92,10 @@ bool touch_touched(void);
 bool touch_released(void);
 void touch_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data);
 
-// Display flushing
+// Display flushing - trimmed to the visible circle of the round panel
 void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
-    uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
-
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t *)&color_p->full, w * h, true);
-    tft.endWrite();
-
-    lv_disp_flush_ready(disp);
+    DisplayFlush::flush(disp, area, color_p);
 }
 
 // Touch input reading
@@ -101,112 +115,8 @@ void touch_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data)
 
 // Screen creation functions
 // Energy screen functionality moved to features/energy/energy_ui.h
-
-void create_weather_screen(void)
-{
-    // Create title
-    lv_obj_t *title = lv_label_create(lv_scr_act());
-    lv_label_set_text(title, "🌤️ WEATHER");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_16, 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
-    
-    // Temperature arc
-    lv_obj_t *arc = lv_arc_create(lv_scr_act());
-    lv_obj_set_size(arc, 180, 180);
-    lv_obj_center(arc);
-    lv_arc_set_rotation(arc, 270);
-    lv_arc_set_bg_angles(arc, 0, 360);
-    lv_arc_set_value(arc, 72);  // Example: 72% of temp range
-    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
-    
-    // Weather info
-    lv_obj_t *weather_label = lv_label_create(lv_scr_act());
-    lv_label_set_text(weather_label, "22°C\nPartly Cloudy\n45% Humidity");
-    lv_obj_set_style_text_font(weather_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_align(weather_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_center(weather_label);
-    
-    // Data source
-    lv_obj_t *source = lv_label_create(lv_scr_act());
-    String source_text = MQTTManager::isConnected() ? "📡 Live Weather" : "📡 Offline";
-    lv_label_set_text(source, source_text.c_str());
-    lv_obj_align(source, LV_ALIGN_BOTTOM_MID, 0, -10);
-    
-    // Arc color for temperature
-    lv_color_t arc_color = lv_palette_main(LV_PALETTE_ORANGE);
-    lv_obj_set_style_arc_color(arc, arc_color, LV_PART_INDICATOR);
-}
-    lv_arc_set_rotation(arc, 270);
-    lv_arc_set_bg_angles(arc, 0, 360);
-    lv_arc_set_value(arc, 72);  // Example: 72% of temp range
-    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
-    
-    // Weather info
-    lv_obj_t *weather_label = lv_label_create(lv_scr_act());
-    lv_label_set_text(weather_label, "22°C\nPartly Cloudy\n45% Humidity");
-    lv_obj_set_style_text_font(weather_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_align(weather_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_center(weather_label);
-    
-    // Data source
-    lv_obj_t *source = lv_label_create(lv_scr_act());
-    String source_text = MQTTManager::isConnected() ? "📡 Live Weather" : "📡 Offline";
-    lv_label_set_text(source, source_text.c_str());
-    lv_obj_align(source, LV_ALIGN_BOTTOM_MID, 0, -10);
-    
-    // Arc color for temperature
-    lv_color_t arc_color = lv_palette_main(LV_PALETTE_ORANGE);
-    lv_obj_set_style_arc_color(arc, arc_color, LV_PART_INDICATOR);
-}
-
-void create_house_info_screen(void)
-{
-    // Create title
-    lv_obj_t *title = lv_label_create(lv_scr_act());
-    lv_label_set_text(title, "🏠 HOUSE INFO");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_18, 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
-    
-    // Connection status arc
-    lv_obj_t *arc = lv_arc_create(lv_scr_act());
-    lv_obj_set_size(arc, 180, 180);
-    lv_obj_center(arc);
-    lv_arc_set_rotation(arc, 270);
-    lv_arc_set_bg_angles(arc, 0, 360);
-    int connection_pct = (wifiManager.isConnected() ? 50 : 0) + (mqttManager.isConnected() ? 50 : 0);
-    lv_arc_set_value(arc, connection_pct);
-    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
-    
-    // House systems info
-    lv_obj_t *info_label = lv_label_create(lv_scr_act());
-    String info_text = "WiFi: ";
-    info_text += wifiManager.isConnected() ? "✅" : "❌";
-    info_text += "\nMQTT: ";
-    info_text += mqttManager.isConnected() ? "✅" : "❌";
-    if (wifiManager.isConnected()) {
-        info_text += "\nIP: " + WiFi.localIP().toString();
-    }
-    lv_label_set_text(info_label, info_text.c_str());
-    lv_obj_set_style_text_font(info_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_align(info_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_center(info_label);
-    
-    // Device info
-    lv_obj_t *device = lv_label_create(lv_scr_act());
-    lv_label_set_text(device, "ESP32-C3 Knob");
-    lv_obj_align(device, LV_ALIGN_BOTTOM_MID, 0, -10);
-    
-    // Arc color based on connection
-    lv_color_t arc_color;
-    if (wifiManager.isConnected() && mqttManager.isConnected()) {
-        arc_color = lv_palette_main(LV_PALETTE_GREEN);
-    } else if (wifiManager.isConnected()) {
-        arc_color = lv_palette_main(LV_PALETTE_ORANGE);
-    } else {
-        arc_color = lv_palette_main(LV_PALETTE_RED);
-    }
-    lv_obj_set_style_arc_color(arc, arc_color, LV_PART_INDICATOR);
-}
+// Weather screen functionality moved to features/weather/weather_ui.h
+// House Info screen functionality moved to features/house_info/house_info_ui.h
 
 // Navigation functions
 void switch_to_screen(Screen new_screen)
@@ -220,7 +130,7 @@ void switch_to_screen(Screen new_screen)
         current_screen = new_screen;
         screen_changed = true;
         ui_needs_update = true;
-        last_interaction = millis();
+        transition_pending = true;
         
         Serial.printf("Switched to screen: %s\n", screen_names[current_screen]);
     }
@@ -229,12 +139,14 @@ void switch_to_screen(Screen new_screen)
 void next_screen()
 {
     Screen next = (Screen)((current_screen + 1) % SCREEN_COUNT);
+    transition_direction = 1;
     switch_to_screen(next);
 }
 
 void previous_screen()
 {
     Screen prev = (Screen)((current_screen - 1 + SCREEN_COUNT) % SCREEN_COUNT);
+    transition_direction = -1;
     switch_to_screen(prev);
 }
 
@@ -243,17 +155,21 @@ void update_current_screen(void)
 {
     // Clear screen
     lv_obj_clean(lv_scr_act());
+    MemoryMonitor::beginScreenBuild();
+    ScreenArena::beginScreen();     // Only used with LV_MEM_CUSTOM 1
     
     // Create the appropriate screen
     switch (current_screen) {
-        case SCREEN_ENERGY:
-            EnergyUI::updateScreen(EnergyData_Manager::getCurrentData(), EnergyData_Manager::getPeakData());
+        case SCREEN_ENERGY: {
+            EnergySnapshot snapshot = EnergyData_Manager::getSnapshot();
+            EnergyUI::updateScreen(snapshot.data, snapshot.peaks);
             break;
+        }
         case SCREEN_WEATHER:
-            create_weather_screen();
+            WeatherUI::updateScreen(WeatherData_Manager::getCurrentData());
             break;
         case SCREEN_HOUSE_INFO:
-            create_house_info_screen();
+            HouseInfoUI::updateScreen(DiagnosticsData_Manager::getSample());
             break;
         case SCREEN_SETTINGS:
             SettingsUI::updateScreen();
@@ -264,8 +180,11 @@ void update_current_screen(void)
     lv_obj_t *indicator = lv_label_create(lv_scr_act());
     String indicator_text = String(current_screen + 1) + "/" + String(SCREEN_COUNT) + " - Rotate to change";
     lv_label_set_text(indicator, indicator_text.c_str());
-    lv_obj_set_style_text_font(indicator, &lv_font_montserrat_10, 0);
+    lv_obj_set_style_text_font(indicator, UI_FONT_10, 0);
     lv_obj_align(indicator, LV_ALIGN_TOP_MID, 0, 5);
+    
+    ScreenArena::endScreen();
+    MemoryMonitor::endScreenBuild(current_screen);
 }
 
 // Legacy function - now calls update_current_screen
@@ -286,6 +205,9 @@ void setup()
     // Setup WiFi with configuration portal
     WiFiManagerWrapper::setupWiFi();
     
+    // Start NTP (needed for the daily peak reset)
+    TimeSync::begin();
+    
     // Configure MQTT (using default settings)
     MQTTManager::configure("192.168.1.100", 1883, "", "");
 
@@ -293,6 +215,22 @@ void setup()
     tft.init();
     tft.setRotation(0);
     tft.fillScreen(TFT_BLACK);
+    Backlight::begin();
+    DisplayFlush::begin(&tft);
+    
+    // Idle dimming / screen off / light sleep
+    PowerManager::begin();
+    PowerManager::setDisplayPowerCallback([](bool on) {
+        tft.writecommand(on ? TFT_SLPOUT : TFT_SLPIN);
+        delay(5);  // ST7789 needs 5ms after sleep in/out before the next command
+    });
+    PowerManager::setNetworkPowerCallback([](bool on) {
+        if (on) {
+            WiFiManagerWrapper::resume();
+        } else {
+            WiFiManagerWrapper::suspend();
+        }
+    });
 
     // Initialize touch calibration
     uint16_t calData[5] = {275, 3620, 264, 3532, 1};
@@ -311,18 +249,36 @@ void setup()
     disp_drv.ver_res = screenHeight;
     disp_drv.flush_cb = my_disp_flush;
     disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
 
     // Initialize input device driver
     static lv_indev_drv_t indev_drv;
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_POINTER;
     indev_drv.read_cb = touch_read;
-    lv_indev_drv_register(&indev_drv);
+    lv_indev_t *touch_indev = lv_indev_drv_register(&indev_drv);
+    
+    // Adaptive refresh/input rates (overrides the lv_conf.h defaults)
+    RefreshGovernor::begin(disp, touch_indev);
 
     // Initialize rotary encoder
     RotaryEncoder::begin();
     RotaryEncoder::setNavigationCallback(on_navigation_change);
+    
+    // Remote "bench [screen]" command - builds screens directly, no transition
+    UIBench::begin([](int screen) {
+        Screen shown = current_screen;
+        current_screen = (Screen)screen;
+        update_current_screen();
+        current_screen = shown;
+    });
+    CommandInterpreter::setBenchHandler(UIBench::start);
+    
+    // Remote "screen <n>" command
+    CommandInterpreter::setScreenHandler([](int screen) {
+        transition_direction = (screen >= current_screen) ? 1 : -1;
+        switch_to_screen((Screen)screen);
+    });
 
     // Initialize haptic feedback
     HapticFeedback::begin();
@@ -330,9 +286,21 @@ void setup()
     // Initialize energy data manager
     EnergyData_Manager::begin();
     
+    // Initialize weather data manager
+    WeatherData_Manager::begin();
+    
+    // Live diagnostics (House Info screen)
+    DiagnosticsData_Manager::begin();
+    
     // Initialize settings UI
     SettingsUI::begin();
     
+    // Initialize screen transitions
+    ScreenTransition::begin();
+    
+    // LVGL heap leak/fragmentation tracking
+    MemoryMonitor::begin();
+    
     // Play startup confirmation
     HapticFeedback::confirmation();
 
@@ -347,11 +315,18 @@ void setup()
 
 void loop()
 {
+    DiagnosticsData_Manager::loopStart();
+    
     // Update energy data
     EnergyData_Manager::update();
     
-    // Handle LVGL tasks
-    lv_timer_handler();
+    // Weather staleness
+    WeatherData_Manager::update();
+    
+    // Handle LVGL tasks at the governor's current rate (paused while the screen is off)
+    if (!PowerManager::isDisplayOff()) {
+        RefreshGovernor::handleTimers();
+    }
     
     // Handle WiFiManager portal
     WiFiManagerWrapper::process();
@@ -375,7 +350,10 @@ void loop()
         
         // Touch acts as "button press" - could be used for settings or actions
         if (touch_pressed && !touch_was_pressed && (now - last_touch_time > 400)) {
-            if (current_screen == SCREEN_SETTINGS) {
+            RefreshGovernor::notifyInput();
+            if (PowerManager::notifyActivity()) {
+                // Touch only woke the screen
+            } else if (current_screen == SCREEN_SETTINGS) {
                 SettingsUI::handleSelection();
                 screen_changed = true;
             } else {
@@ -396,6 +374,59 @@ void loop()
         ui_needs_update = true;
     }
     
+    // Data may have moved on while the screen was off
+    if (PowerManager::hasWoken()) {
+        ui_needs_update = true;
+    }
+    
+    // New data on the energy screen: updated in place at up to ~30 Hz, or
+    // rebuilt (paced to the refresh rate) when its layout has to change
+    static bool data_pending = false;
+    static unsigned long last_data_redraw = 0;
+    if (EnergyData_Manager::hasDataChanged()) {
+        RefreshGovernor::notifyDataChanged();
+        data_pending = (current_screen == SCREEN_ENERGY);
+    }
+    if (data_pending && !ScreenTransition::isActive() && !PowerManager::isDisplayOff() &&
+        !UIBench::isRunning()) {
+        unsigned long since_redraw = millis() - last_data_redraw;
+        if (since_redraw >= EnergyUI::REFRESH_PERIOD_MS) {
+            EnergySnapshot snapshot = EnergyData_Manager::getSnapshot();
+            if (EnergyUI::refresh(snapshot.data, snapshot.peaks)) {
+                data_pending = false;
+                last_data_redraw = millis();
+            } else if (since_redraw >= RefreshGovernor::getRefreshPeriod()) {
+                data_pending = false;
+                last_data_redraw = millis();
+                ui_needs_update = true;
+            }
+        }
+    }
+    
+    // New weather on the weather screen: a few values a few times an hour,
+    // updated in place or rebuilt when a field appears or goes stale
+    static bool weather_pending = false;
+    if (WeatherData_Manager::hasDataChanged()) {
+        RefreshGovernor::notifyDataChanged();
+        weather_pending = (current_screen == SCREEN_WEATHER);
+    }
+    if (weather_pending && !ScreenTransition::isActive() && !PowerManager::isDisplayOff() &&
+        !UIBench::isRunning()) {
+        weather_pending = false;
+        if (!WeatherUI::refresh(WeatherData_Manager::getCurrentData())) {
+            ui_needs_update = true;
+        }
+    }
+    
+    // Diagnostics sample once a second; the House Info screen follows it in place
+    DiagnosticsData_Manager::update();
+    if (DiagnosticsData_Manager::hasSampleChanged() && current_screen == SCREEN_HOUSE_INFO &&
+        !ScreenTransition::isActive() && !PowerManager::isDisplayOff() && !UIBench::isRunning()) {
+        if (!HouseInfoUI::refresh(DiagnosticsData_Manager::getSample())) {
+            ui_needs_update = true;
+        }
+    }
+    
     // Handle MQTT connection if WiFi is connected
     if (WiFiManagerWrapper::isConnected()) {
         // Attempt to connect/reconnect to MQTT if not connected
@@ -407,12 +438,40 @@ void loop()
         MQTTManager::process();
     }
     
+    // Recorded EmonTX3 traffic (benchmarks), if a replay is running
+    TraceReplay::update();
+    
+    // Remote benchmark - runs in slices once any transition has finished,
+    // then the normal screen is rebuilt
+    if (!ScreenTransition::isActive()) {
+        UIBench::update();
+    }
+    if (UIBench::hasFinished()) {
+        ui_needs_update = true;
+    }
+    
+    // LVGL heap sample (published every minute)
+    MemoryMonitor::update();
+    
     // Update UI if needed (screen changed or connection status changed)
-    if (ui_needs_update || screen_changed) {
+    // Updates wait until a running transition or bench has finished and the screen is on
+    if ((ui_needs_update || screen_changed) && !ScreenTransition::isActive() &&
+        !PowerManager::isDisplayOff() && !UIBench::isRunning()) {
         ui_needs_update = false;
         screen_changed = false;
-        update_current_screen();
+        if (transition_pending) {
+            transition_pending = false;
+            ScreenTransition::start(update_current_screen, transition_direction);
+        } else {
+            update_current_screen();
+        }
     }
     
+    // Loop work ends here - sleep and the delay are not counted
+    DiagnosticsData_Manager::loopEnd();
+    
+    // Dim / switch off / light sleep when idle
+    PowerManager::update();
+    
     delay(10);  // Small delay to prevent watchdog issues
 }
@@ -0,0 +1,65 @@
+// Host entry point for [env:native]: the same BenchRunner and cases as the
+// device, for the parts of the UI pipeline that build without LVGL (the
+// Arduino parts against the fakes in test/host). replay_state runs the
+// built-in trace through the real MQTT message handler.
+#include "../core/system/bench_runner.h"
+#include "../ui_common/disc_bench.h"
+#include "../core/system/telemetry_bench.h"
+#include "../features/energy/filter_bench.h"
+#include "../features/energy/energy_data.h"
+#include "../core/network/mqtt_manager.h"
+#include "../core/network/trace_replay.h"
+#include <chrono>
+#include <stdio.h>
+
+static uint32_t clockMicros() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void printResult(const char* json) {
+    printf("%s\n", json);
+}
+
+// The whole built-in trace, one message per loop pass, through
+// MQTTManager::defaultCallback into EnergyData. The host clock steps 100ms
+// per pass so the filters' decimation lets every sample reach the state.
+static void runReplay(int) {
+    TraceReplay::startRecorded(REPLAY_MAX_THROUGHPUT);
+    while (TraceReplay::isRunning()) {
+        HostTime::advance(100);
+        TraceReplay::update();
+    }
+}
+
+static void replayMessages(uint32_t& us, uint32_t& count) {
+    us = 0;
+    count = TraceReplay::getStats().messages;
+}
+
+// Message-to-state time and the rate the handler sustains on this machine
+static void printReplay(int index) {
+    const BenchResult& result = BenchRunner::getResult(index);
+    if (result.iterations == 0 || result.aux_count == 0) return;
+    double us_per_message = (double)result.total_us / result.aux_count;
+    printf("{\"case\":\"replay\",\"messages\":%lu,\"state_us\":%.2f,\"rate\":%.0f}\n",
+           (unsigned long)(result.aux_count / result.iterations), us_per_message,
+           us_per_message > 0.0 ? 1e6 / us_per_message : 0.0);
+}
+
+int main() {
+    BenchRunner::begin(clockMicros, printResult);
+    DiscBench::addCases();
+    TelemetryBench::addCases();
+    FilterBench::addCases();
+    EnergyData_Manager::begin();
+    MQTTManager::begin();
+    int replay = BenchRunner::getCaseCount();
+    BenchRunner::addCase({"replay_state", runReplay, 0, replayMessages});
+    printf("{\"telemetry_path\":\"%s\"}\n", TelemetryKernels::getPathName());
+
+    BenchRunner::start(1000);
+    BenchRunner::runToCompletion();
+    printReplay(replay);
+    return 0;
+}
@@ -0,0 +1,18 @@
+// [env:native]: the hardware and UI the message handlers report to. The
+// handlers themselves (mqtt_manager.cpp and the energy and weather managers)
+// are the knob's own sources, built against the fakes in test/host.
+#include "../core/hardware/haptic_feedback.h"
+#include "../core/hardware/power_manager.h"
+#include "../features/house_info/diagnostics_data.h"
+#include "../ui_common/memory_monitor.h"
+#include "../ui_common/refresh_governor.h"
+
+void DiagnosticsData_Manager::recordError(const char*, int) {}
+void HapticFeedback::peakReached() {}
+void HapticFeedback::setEnabled(bool) {}
+void PowerManager::setActiveBrightness(uint8_t) {}
+PowerState PowerManager::getState() { return POWER_ACTIVE; }
+const char* PowerManager::getStateName(PowerState) { return "active"; }
+void MemoryMonitor::sample(MemorySample&) {}
+bool MemoryMonitor::isLeakSuspected() { return false; }
+uint32_t RefreshGovernor::getRefreshPeriod() { return 30; }
@@ -0,0 +1,171 @@
+#pragma once
+#include "../core/system/bench_runner.h"
+#include "../core/hardware/display_flush.h"
+#include "../features/energy/energy_ui.h"
+#include "../ui_common/refresh_governor.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <stdio.h>
+
+// The same simulated minute on the energy screen - input, then data only,
+// then idle - with lv_timer_handler() called every loop pass at lv_conf.h's
+// periods (governor_off) and through RefreshGovernor::handleTimers()
+// (governor_on). The loop passes every PASS_MS of simulated time (HostTime
+// and lv_tick_inc()), so only [env:native_ui_bench] can run it.
+// aux_us is the time in the handler, aux_count the passes that flushed.
+class GovernorBench {
+public:
+    static const uint32_t PASS_MS = 5;
+
+    // Builds the energy screen the timeline updates
+    static void begin(uint32_t (*clock)(), lv_indev_t* input) {
+        clock_us() = clock;
+        indev() = input;
+        lv_obj_clean(lv_scr_act());
+        EnergyUI::updateScreen(values(0), peaks());
+        lv_refr_now(NULL);
+    }
+
+    static void addCases() {
+        BenchRunner::addCase({"governor_off", runTimeline, 0, runTotals});
+        BenchRunner::addCase({"governor_on", runTimeline, 1, runTotals});
+    }
+
+    // Per phase, averaged over the runs: loop passes, passes that flushed and
+    // the time in lv_timer_handler() (with the governor's own work when on)
+    static void printSummary() {
+        for (int governed = 0; governed < 2; governed++) {
+            const Totals& t = totals()[governed];
+            uint32_t runs = t.runs ? t.runs : 1;
+            printf("{\"case\":\"%s\",\"passes\":[%lu,%lu,%lu],\"frames\":[%lu,%lu,%lu],"
+                   "\"lvgl_us\":[%lu,%lu,%lu]}\n",
+                   governed ? "governor_on" : "governor_off",
+                   (unsigned long)(t.passes[0] / runs), (unsigned long)(t.passes[1] / runs),
+                   (unsigned long)(t.passes[2] / runs), (unsigned long)(t.frames[0] / runs),
+                   (unsigned long)(t.frames[1] / runs), (unsigned long)(t.frames[2] / runs),
+                   (unsigned long)(t.lvgl_us[0] / runs), (unsigned long)(t.lvgl_us[1] / runs),
+                   (unsigned long)(t.lvgl_us[2] / runs));
+        }
+    }
+
+private:
+    enum Phase {
+        PHASE_ACTIVE = 0,   // Encoder turns and data
+        PHASE_DATA,         // Data only, at the EmonTX3's 10s interval
+        PHASE_IDLE,         // Nothing
+        PHASE_COUNT
+    };
+
+    struct Totals {
+        uint32_t runs = 0;
+        uint32_t passes[PHASE_COUNT] = {};
+        uint32_t frames[PHASE_COUNT] = {};
+        uint32_t lvgl_us[PHASE_COUNT] = {};
+        uint32_t run_us = 0;            // Last run, for aux
+        uint32_t run_frames = 0;
+    };
+
+    // Phase length, and the interval of its updates (0 = none) [ms]
+    static uint32_t phaseMs(int phase) {
+        return (phase == PHASE_ACTIVE) ? 10000 : (phase == PHASE_DATA) ? 30000 : 20000;
+    }
+    static uint32_t eventMs(int phase) {
+        return (phase == PHASE_ACTIVE) ? 250 : (phase == PHASE_DATA) ? 10000 : 0;
+    }
+
+    static void runTimeline(int governed) {
+        lv_disp_t* disp = lv_disp_get_default();
+        if (governed) {
+            RefreshGovernor::begin(disp, indev());
+        } else {
+            // As before the governor: lv_conf.h's periods, never paused
+            lv_timer_set_period(_lv_disp_get_refr_timer(disp), LV_DISP_DEF_REFR_PERIOD);
+            lv_timer_resume(_lv_disp_get_refr_timer(disp));
+            if (indev()) lv_timer_set_period(lv_indev_get_read_timer(indev()), LV_INDEV_DEF_READ_PERIOD);
+        }
+
+        last() = governed;
+        Totals& t = totals()[governed];
+        t.runs++;
+        t.run_us = 0;
+        t.run_frames = 0;
+        uint32_t step = 0;
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            uint32_t every = eventMs(phase);
+            for (uint32_t ms = 0; ms < phaseMs(phase); ms += PASS_MS) {
+                if (every && ms % every == 0) {
+                    if (phase == PHASE_ACTIVE) RefreshGovernor::notifyInput();
+                    RefreshGovernor::notifyDataChanged();
+                    if (!EnergyUI::refresh(values(++step), peaks())) {
+                        lv_obj_clean(lv_scr_act());
+                        EnergyUI::updateScreen(values(step), peaks());
+                    }
+                }
+
+                uint32_t flushes = DisplayFlush::getStats().flushes;
+                uint32_t start_us = clock_us()();
+                if (governed) {
+                    RefreshGovernor::handleTimers();
+                } else {
+                    lv_timer_handler();
+                }
+                uint32_t elapsed_us = clock_us()() - start_us;
+                t.passes[phase]++;
+                t.lvgl_us[phase] += elapsed_us;
+                t.run_us += elapsed_us;
+                if (DisplayFlush::getStats().flushes != flushes) {
+                    t.frames[phase]++;
+                    t.run_frames++;
+                }
+
+                HostTime::advance(PASS_MS);
+                lv_tick_inc(PASS_MS);
+            }
+        }
+    }
+
+    static void runTotals(uint32_t& us, uint32_t& count) {
+        const Totals& t = totals()[last()];
+        us = t.run_us;
+        count = t.run_frames;
+    }
+
+    // Import throughout, so every update stays in place
+    static EnergyData values(uint32_t step) {
+        EnergyData data;
+        data.balance = 400.0f + (float)((step * 37) % 900);
+        data.solar = 1000.0f + (float)((step * 13) % 2000);
+        data.used = data.balance + data.solar;
+        data.vrms = 238.0f + (float)(step % 5);
+        data.tariff = 1;
+        data.valid = true;
+        return data;
+    }
+
+    static PeakData peaks() {
+        PeakData p;
+        p.daily_export_peak = -2200.0f;
+        p.daily_import_peak = 5400.0f;
+        return p;
+    }
+
+    static uint32_t (*&clock_us())() {
+        static uint32_t (*clock)() = nullptr;
+        return clock;
+    }
+
+    static lv_indev_t*& indev() {
+        static lv_indev_t* input = nullptr;
+        return input;
+    }
+
+    static int& last() {
+        static int governed = 0;
+        return governed;
+    }
+
+    static Totals* totals() {
+        static Totals t[2];
+        return t;
+    }
+};
@@ -0,0 +1,145 @@
+// Host entry point for [env:native_ui_bench]: UIBench's cases on real LVGL,
+// flushed through DisplayFlush to the recording TFT_eSPI in test/host.
+// Renders are timed on the host clock. The flush's own busy_us reads the
+// host fake's micros(), which doesn't move, so aux_us is 0 here - aux_count
+// (pixels sent over SPI) is the real figure. haptic_i2c has no I2C to time.
+// Then GovernorBench: a simulated minute with and without RefreshGovernor.
+#include "../core/system/bench_runner.h"
+#include "../core/hardware/display_flush.h"
+#include "../features/energy/energy_history.h"
+#include "../features/energy/energy_ui.h"
+#include "../features/weather/weather_ui.h"
+#include "../features/house_info/house_info_ui.h"
+#include "../features/settings/settings_ui.h"
+#include "../ui_common/ui_bench.h"
+#include "../ui_common/ui_fonts.h"
+#include "governor_bench.h"
+#include <TFT_eSPI.h>
+#include <lvgl.h>
+#include <chrono>
+#include <stdio.h>
+
+static const uint16_t screenWidth = 360;
+static const uint16_t screenHeight = 360;
+
+static TFT_eSPI tft(screenWidth, screenHeight);
+static lv_disp_draw_buf_t draw_buf;
+static lv_color_t buf[screenWidth * 10];       // As on the knob
+
+static uint32_t clockMicros() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void printResult(const char* json) {
+    printf("%s\n", json);
+}
+
+// Nothing touches the panel - the read timer still runs at its period
+static void readTouch(lv_indev_drv_t*, lv_indev_data_t* data) {
+    data->state = LV_INDEV_STATE_REL;
+}
+
+static void flushDisplay(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    DisplayFlush::flush(disp, area, color_p);
+}
+
+// update_current_screen() in main.cpp, with fixed values for the managers
+static void buildScreen(int screen) {
+    lv_obj_clean(lv_scr_act());
+    switch (screen) {
+        case SCREEN_ENERGY: {
+            EnergyData data;
+            data.balance = -1850.0f;
+            data.solar = 3100.0f;
+            data.used = 1250.0f;
+            data.vrms = 240.0f;
+            data.tariff = 1;
+            data.valid = true;
+            PeakData peaks;
+            peaks.daily_export_peak = -2200.0f;
+            peaks.daily_import_peak = 5400.0f;
+            EnergyUI::updateScreen(data, peaks);
+            break;
+        }
+        case SCREEN_WEATHER: {
+            WeatherData data;
+            data.has_temperature = true;
+            data.has_humidity = true;
+            data.has_forecast = true;
+            data.temperature = 14.5f;
+            data.humidity = 72.0f;
+            data.condition = WEATHER_PARTLY_CLOUDY;
+            data.forecast_high = 18.0f;
+            data.forecast_low = 9.0f;
+            data.forecast_condition = WEATHER_RAIN;
+            data.valid = true;
+            WeatherUI::updateScreen(data);
+            break;
+        }
+        case SCREEN_HOUSE_INFO: {
+            DiagnosticsSample sample;
+            sample.uptime_s = 3600;
+            sample.wifi_connected = true;
+            sample.mqtt_connected = true;
+            sample.rssi = -58;
+            sample.mqtt_rate = 1.2f;
+            sample.heap_free = 180000;
+            sample.heap_min_free = 150000;
+            sample.lvgl_used = 21000;
+            sample.lvgl_total = LV_MEM_SIZE;
+            HouseInfoUI::updateScreen(sample);
+            break;
+        }
+        case SCREEN_SETTINGS:
+            SettingsUI::updateScreen();
+            break;
+    }
+    lv_obj_t* indicator = lv_label_create(lv_scr_act());
+    String indicator_text = String((long)(screen + 1)) + "/" + String((long)SCREEN_COUNT) + " - Rotate to change";
+    lv_label_set_text(indicator, indicator_text.c_str());
+    lv_obj_set_style_text_font(indicator, UI_FONT_10, 0);
+    lv_obj_align(indicator, LV_ALIGN_TOP_MID, 0, 5);
+}
+
+int main() {
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * 10);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = screenWidth;
+    disp_drv.ver_res = screenHeight;
+    disp_drv.flush_cb = flushDisplay;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+    static lv_indev_drv_t indev_drv;
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = readTouch;
+    lv_indev_t* touch_indev = lv_indev_drv_register(&indev_drv);
+    DisplayFlush::begin(&tft);
+    EnergyHistory::begin();
+    SettingsUI::begin();
+
+    // UIBench times with micros() - the steady clock instead, and results
+    // straight to stdout (begin() again keeps no cases, start() adds them)
+    UIBench::begin(buildScreen);
+    BenchRunner::begin(clockMicros, printResult);
+    UIBench::start(-1);
+    while (UIBench::isRunning()) {
+        UIBench::update();
+    }
+
+    GovernorBench::begin(clockMicros, touch_indev);
+    BenchRunner::clear();
+    GovernorBench::addCases();
+    BenchRunner::start(3);
+    BenchRunner::runToCompletion();
+    GovernorBench::printSummary();
+
+    printf("{\"flushes\":%lu,\"pixels_sent\":%lu,\"address_windows\":%lu}\n",
+           (unsigned long)DisplayFlush::getStats().flushes,
+           (unsigned long)DisplayFlush::getStats().pixels_sent,
+           (unsigned long)DisplayFlush::getStats().address_windows);
+    return 0;
+}
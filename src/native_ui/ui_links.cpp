@@ -0,0 +1,58 @@
+// [env:native_ui_bench]: the managers and hardware the screen builders and
+// UIBench read, faked with steady values.
+#include "../core/hardware/haptic_feedback.h"
+#include "../core/hardware/power_manager.h"
+#include "../core/network/mqtt_manager.h"
+#include "../core/network/trace_replay.h"
+#include "../features/energy/energy_channels.h"
+#include "../features/energy/energy_data.h"
+#include "../features/house_info/diagnostics_data.h"
+#include "../ui_common/disc_geometry.h"
+#include "../ui_common/screen_transition.h"
+#include <stdio.h>
+
+// Balance and vrms on the arc, six gauges around it
+static const int CHANNELS = 8;
+static ChannelConfig channel_configs[CHANNELS];
+static bool channels_ready = false;
+
+static void setupChannels() {
+    for (int channel = 0; channel < CHANNELS; channel++) {
+        ChannelConfig& config = channel_configs[channel];
+        snprintf(config.name, sizeof(config.name), "Ch%d", channel);
+        snprintf(config.topic, sizeof(config.topic), "site/ch%d", channel);
+        config.role = (channel == 0) ? CHANNEL_BALANCE : (channel == 1) ? CHANNEL_VRMS :
+                      (channel == 2) ? CHANNEL_SOLAR : (channel == 3) ? CHANNEL_USED : CHANNEL_LOAD;
+        config.color = 0x203040u * (uint32_t)channel;
+    }
+    channels_ready = true;
+}
+
+bool MQTTManager::isConnected() { return true; }
+uint8_t MQTTManager::getQueueDepth() { return 0; }
+bool MQTTManager::publish(const char*, const char*, bool, bool) { return true; }
+FeedState EnergyData_Manager::getFeedState(PowerFeed) { return FEED_STATE_FRESH; }
+FeedState EnergyData_Manager::getChannelState(int) { return FEED_STATE_FRESH; }
+uint8_t EnergyChannels::getCount() { return CHANNELS; }
+const ChannelConfig& EnergyChannels::getConfig(int channel) {
+    if (!channels_ready) setupChannels();
+    return channel_configs[channel];
+}
+uint32_t EnergyChannels::getGeneration() { return 1; }
+uint8_t DiagnosticsData_Manager::getRssiCount() { return DiagnosticsData_Manager::RSSI_HISTORY; }
+int8_t DiagnosticsData_Manager::getRssi(uint8_t index) { return (int8_t)(-45 - index % 40); }
+void DiagnosticsData_Manager::addOverhead(uint32_t) {}
+bool HapticFeedback::isEnabled() { return true; }
+void HapticFeedback::setEnabled(bool) {}
+void HapticFeedback::click() {}
+void HapticFeedback::error() {}
+void HapticFeedback::confirmation() {}
+bool HapticFeedback::probe() { return false; }      // No I2C on the host
+bool PowerManager::notifyActivity() { return false; }
+void PowerManager::notifyFrame() {}
+void TraceReplay::notifyFrame() {}
+bool ScreenTransition::isClipping() { return false; }
+bool ScreenTransition::getRowSpan(int16_t y, int16_t& x1, int16_t& x2) {
+    return DiscGeometry::rowSpan(y, DiscGeometry::RADIUS, x1, x2);
+}
+void ScreenTransition::recordFlush(uint32_t, uint32_t, uint32_t) {}
@@ -1,15 +1,38 @@
 #pragma once
+#include <stdint.h>
 
 // Common data structures used across features
 
 // Energy monitoring data
 struct EnergyData {
+    static const int MAX_CHANNELS = 8;
+    
+    // Totals of the channels of each role (EnergyChannels)
     float balance = 0.0f;      // Current energy balance (kW)
     float solar = 0.0f;        // Solar generation (kW)
     float used = 0.0f;         // Energy consumption (kW)
     float vrms = 0.0f;         // RMS voltage
     int tariff = 1;            // Current tariff (1-4)
     bool valid = false;        // Data validity flag
+    
+    float channels[MAX_CHANNELS] = {};     // Each channel in its own unit, indexed as configured
+};
+
+// Incoming power feeds (one MQTT topic each)
+enum PowerFeed {
+    FEED_BALANCE = 0,
+    FEED_SOLAR,
+    FEED_USED,
+    FEED_VRMS,
+    FEED_COUNT
+};
+
+// Freshness of a feed, from its learned publish interval
+enum FeedState {
+    FEED_STATE_NONE = 0,    // Nothing received yet
+    FEED_STATE_FRESH,       // Arriving on schedule
+    FEED_STATE_LATE,        // Overdue - value still shown
+    FEED_STATE_STALE        // Missed several intervals - value greyed out
 };
 
 // Daily peak tracking data
@@ -21,6 +44,61 @@ struct PeakData {
     bool export_peak_reached_today = false;
 };
 
+// Consistent copy of the live data, taken as one unit
+struct EnergySnapshot {
+    EnergyData data;
+    PeakData peaks;
+    uint32_t generation = 0;    // Bumped on every publish - compare to skip redraws
+};
+
+// Energy accumulated since the last daily reset (kWh), per tariff band.
+// double - see EnergyIntegrator.
+struct EnergyTotals {
+    static const int TARIFF_BANDS = 4;      // Tariff 1-4
+    double import_kwh[TARIFF_BANDS] = {};
+    double export_kwh[TARIFF_BANDS] = {};
+    double solar_kwh[TARIFF_BANDS] = {};
+    double used_kwh[TARIFF_BANDS] = {};
+    
+    // Running sums over all bands - kept current so the UI reads them in O(1)
+    double total_import_kwh = 0.0;
+    double total_export_kwh = 0.0;
+    double total_solar_kwh = 0.0;
+    double total_used_kwh = 0.0;
+    double cost = 0.0;                      // Import cost minus export credit
+    
+    unsigned long gaps = 0;                 // Intervals not integrated (feed silent too long)
+    unsigned long duplicates = 0;           // Same value again within the duplicate window (not integrated)
+};
+
+// Weather condition (home/weather/condition and the forecast)
+enum WeatherCondition {
+    WEATHER_UNKNOWN = 0,
+    WEATHER_CLEAR,
+    WEATHER_PARTLY_CLOUDY,
+    WEATHER_CLOUDY,
+    WEATHER_FOG,
+    WEATHER_RAIN,
+    WEATHER_STORM,
+    WEATHER_SNOW,
+    WEATHER_CONDITION_COUNT
+};
+
+// Current weather and today's forecast
+struct WeatherData {
+    float temperature = 0.0f;           // Outside temperature (°C)
+    float humidity = 0.0f;              // Relative humidity (%)
+    WeatherCondition condition = WEATHER_UNKNOWN;
+    float forecast_high = 0.0f;         // Today's high (°C)
+    float forecast_low = 0.0f;          // Today's low (°C)
+    WeatherCondition forecast_condition = WEATHER_UNKNOWN;
+    bool has_temperature = false;       // Each field received within the stale time
+    bool has_humidity = false;
+    bool has_forecast = false;
+    bool stale = false;                 // Every field has expired
+    bool valid = false;                 // At least one field is live
+};
+
 // Connection status
 struct ConnectionStatus {
     bool wifi_connected = false;
@@ -0,0 +1,43 @@
+#pragma once
+#include "disc_geometry.h"
+#include "../core/system/bench_runner.h"
+
+// Benchmark cases for the round-panel clipping maths. Registered both on the
+// knob (UIBench) and in the [env:native] host build, so the two sets of
+// numbers come from the same code.
+class DiscBench {
+public:
+    static void addCases() {
+        BenchRunner::addCase({"wipe_spans_r90", runWipeSpans, 90, nullptr});
+        BenchRunner::addCase({"wipe_spans_r180", runWipeSpans, 180, nullptr});
+        BenchRunner::addCase({"isqrt", runIsqrt, 0, nullptr});
+    }
+
+private:
+    // Row clipping for one full frame of the circular wipe at a given radius
+    static void runWipeSpans(int radius) {
+        int32_t total = 0;
+        for (int16_t y = 0; y < DiscGeometry::HEIGHT; y++) {
+            int16_t x1;
+            int16_t x2;
+            if (DiscGeometry::rowSpan(y, (int16_t)radius, x1, x2)) {
+                total += x2 - x1 + 1;
+            }
+        }
+        sink() = total;
+    }
+    
+    static void runIsqrt(int) {
+        int32_t total = 0;
+        for (int32_t v = 0; v < 129600; v += 7) {
+            total += DiscGeometry::isqrt(v);
+        }
+        sink() = total;
+    }
+    
+    // Keeps results alive under optimisation
+    static volatile int32_t& sink() {
+        static volatile int32_t value;
+        return value;
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <stdint.h>
+
+// Geometry of the 360x360 round panel.
+// Only the inscribed circle is visible - the four corners of the
+// framebuffer are never seen, so anything drawn there is wasted SPI time.
+class DiscGeometry {
+public:
+    static constexpr int16_t WIDTH = 360;
+    static constexpr int16_t HEIGHT = 360;
+    static constexpr int16_t CENTER_X = WIDTH / 2;
+    static constexpr int16_t CENTER_Y = HEIGHT / 2;
+    static constexpr int16_t RADIUS = WIDTH / 2;
+    
+    // Visible pixel span [x1, x2] of row y inside a circle of the given
+    // radius centred on the panel. Returns false if the row misses the circle.
+    // A pixel is inside when its centre is within the radius.
+    static bool rowSpan(int16_t y, int16_t radius, int16_t& x1, int16_t& x2) {
+        // Work in half-pixel units so pixel centres are integers
+        int32_t dy = 2 * (int32_t)y + 1 - 2 * CENTER_Y;
+        int32_t r2 = 4 * (int32_t)radius * radius - dy * dy;
+        if (radius <= 0 || r2 < 0) {
+            return false;
+        }
+        int32_t h = isqrt(r2);
+        x1 = (int16_t)((2 * CENTER_X - 1 - h + 1) / 2);  // ceil
+        x2 = (int16_t)((2 * CENTER_X - 1 + h) / 2);      // floor
+        return x1 <= x2;
+    }
+    
+    // First visible column of row y on the full disc. constexpr (C++11 rules)
+    // so the flush path can bake it into a table at compile time.
+    // The disc is symmetric: the last visible column is WIDTH - 1 - start.
+    static constexpr int16_t discRowStart(int16_t y) {
+        return (int16_t)((2 * CENTER_X - isqrtRange(4 * (int32_t)RADIUS * RADIUS -
+                                                    (2 * (int32_t)y + 1 - 2 * CENTER_Y) *
+                                                    (2 * (int32_t)y + 1 - 2 * CENTER_Y),
+                                                    0, 2 * RADIUS)) / 2);
+    }
+    
+    // Compile-time floor square root by binary search over [lo, hi]
+    static constexpr int32_t isqrtRange(int32_t v, int32_t lo, int32_t hi) {
+        return lo >= hi ? lo
+             : ((lo + hi + 1) / 2) * ((lo + hi + 1) / 2) <= v ? isqrtRange(v, (lo + hi + 1) / 2, hi)
+                                                               : isqrtRange(v, lo, (lo + hi + 1) / 2 - 1);
+    }
+    
+    // Floor of the square root (no floating point - used per flushed row)
+    static int32_t isqrt(int32_t v) {
+        if (v <= 0) return 0;
+        int32_t root = 0;
+        int32_t bit = 1L << 30;
+        while (bit > v) bit >>= 2;
+        while (bit != 0) {
+            if (v >= root + bit) {
+                v -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        return root;
+    }
+};
+
+// Per-row start column of the visible disc, generated at compile time by
+// buildDiscSpanTable(MakeRowList<DiscGeometry::HEIGHT>::type()).
+// RowList/MakeRowList stand in for std::index_sequence (not in C++11).
+template<int... Ys> struct RowList {};
+template<int N, int... Ys> struct MakeRowList : MakeRowList<N - 1, N - 1, Ys...> {};
+template<int... Ys> struct MakeRowList<0, Ys...> { typedef RowList<Ys...> type; };
+
+struct DiscSpanTable {
+    uint16_t start[DiscGeometry::HEIGHT];
+};
+
+template<int... Ys>
+constexpr DiscSpanTable buildDiscSpanTable(RowList<Ys...>) {
+    return DiscSpanTable{{ (uint16_t)DiscGeometry::discRowStart(Ys)... }};
+}
@@ -0,0 +1,152 @@
+#include "memory_monitor.h"
+#include "screen_arena.h"
+#include "../core/network/mqtt_manager.h"
+
+MemorySample MemoryMonitor::last_sample;
+ScreenMemoryStats MemoryMonitor::screens[SCREEN_COUNT];
+MemorySample MemoryMonitor::build_start;
+int MemoryMonitor::built_screen = -1;
+uint32_t MemoryMonitor::built_from = 0;
+uint32_t MemoryMonitor::min_largest_free = UINT32_MAX;
+unsigned long MemoryMonitor::last_sample_time = 0;
+bool MemoryMonitor::leak_suspected = false;
+
+void MemoryMonitor::begin() {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+        screens[i] = ScreenMemoryStats();
+    }
+    built_screen = -1;
+    leak_suspected = false;
+    sample(last_sample);
+    min_largest_free = last_sample.largest_free;
+    last_sample_time = millis();
+}
+
+void MemoryMonitor::beginScreenBuild() {
+    sample(build_start);
+    if (built_screen >= 0) {
+        chargeResidue(built_screen, (int32_t)(build_start.used - built_from));
+    }
+}
+
+void MemoryMonitor::endScreenBuild(int screen) {
+    if (screen < 0 || screen >= SCREEN_COUNT) {
+        built_screen = -1;
+        return;
+    }
+    
+    MemorySample after;
+    sample(after);
+    ScreenMemoryStats& stats = screens[screen];
+    
+    stats.blocks = after.used_blocks - build_start.used_blocks;
+    stats.bytes = after.used - build_start.used;
+    if (stats.bytes > stats.max_bytes) stats.max_bytes = stats.bytes;
+    stats.builds++;
+    built_screen = screen;
+    built_from = build_start.used;
+    
+    if (after.largest_free < min_largest_free) {
+        min_largest_free = after.largest_free;
+    }
+}
+
+// What a screen's build still holds once it has been cleaned
+void MemoryMonitor::chargeResidue(int screen, int32_t left) {
+    ScreenMemoryStats& stats = screens[screen];
+    if (stats.cleans++ == 0) {
+        stats.baseline = left;
+        return;
+    }
+    stats.residue += left;
+    
+    if (stats.residue > (int32_t)LEAK_THRESHOLD) {
+        if (stats.growth_streak < 255) stats.growth_streak++;
+        if (stats.growth_streak == LEAK_STREAK && !leak_suspected) {
+            leak_suspected = true;
+            Serial.printf("LVGL leak suspected: screen %d left %ld bytes behind over %lu cleans\n",
+                          screen, (long)stats.residue, (unsigned long)stats.cleans);
+        }
+    } else {
+        stats.growth_streak = 0;
+    }
+}
+
+void MemoryMonitor::update() {
+    unsigned long now = millis();
+    if (now - last_sample_time < SAMPLE_INTERVAL_MS) {
+        return;
+    }
+    last_sample_time = now;
+    
+    sample(last_sample);
+    if (last_sample.largest_free < min_largest_free) {
+        min_largest_free = last_sample.largest_free;
+    }
+    
+    char report[224];
+    formatReport(report, sizeof(report));
+    MQTTManager::publish("home/knob/lvgl_mem", report);
+}
+
+void MemoryMonitor::sample(MemorySample& out) {
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    out.total = mon.total_size;
+    out.used = mon.total_size - mon.free_size;
+    out.used_blocks = mon.used_cnt;
+    out.free_blocks = mon.free_cnt;
+    out.largest_free = mon.free_biggest_size;
+    out.high_water = mon.max_used;
+    out.frag_pct = mon.frag_pct;
+#else
+    // Screen arena + system heap (the general pool). lv_mem_monitor()
+    // reports nothing with a custom allocator.
+    const ArenaStats& arena = ScreenArena::getStats();
+    uint32_t heap_free = ESP.getFreeHeap();
+    out.total = ESP.getHeapSize() + ScreenArena::ARENA_SIZE;
+    out.used = (ESP.getHeapSize() - heap_free) + arena.arena_used;
+    out.used_blocks = arena.arena_live + arena.general_live;
+    out.free_blocks = 0;
+    out.largest_free = ESP.getMaxAllocHeap();
+    out.high_water = (ESP.getHeapSize() - ESP.getMinFreeHeap()) + arena.arena_peak;
+    out.frag_pct = heap_free ? (uint8_t)(100 - (uint64_t)out.largest_free * 100 / heap_free) : 0;
+#endif
+}
+
+const MemorySample& MemoryMonitor::getLastSample() {
+    return last_sample;
+}
+
+const ScreenMemoryStats& MemoryMonitor::getScreenStats(int screen) {
+    if (screen < 0 || screen >= SCREEN_COUNT) screen = 0;
+    return screens[screen];
+}
+
+bool MemoryMonitor::isLeakSuspected() {
+    return leak_suspected;
+}
+
+uint32_t MemoryMonitor::getMinLargestFree() {
+    return min_largest_free;
+}
+
+int MemoryMonitor::formatReport(char* out, size_t size) {
+    // Per-screen figures: bytes held by the last build / allocations made
+    int written = snprintf(out, size,
+                           "{\"used\":%lu,\"total\":%lu,\"peak\":%lu,\"largest_free\":%lu,"
+                           "\"min_largest_free\":%lu,\"frag\":%u,\"leak\":%s,\"screens\":[",
+                           (unsigned long)last_sample.used, (unsigned long)last_sample.total,
+                           (unsigned long)last_sample.high_water, (unsigned long)last_sample.largest_free,
+                           (unsigned long)min_largest_free, last_sample.frag_pct,
+                           leak_suspected ? "true" : "false");
+    for (int i = 0; i < SCREEN_COUNT && written > 0 && (size_t)written < size; i++) {
+        written += snprintf(out + written, size - written, "%s[%lu,%lu]", i ? "," : "",
+                            (unsigned long)screens[i].bytes, (unsigned long)screens[i].blocks);
+    }
+    if (written > 0 && (size_t)written < size) {
+        written += snprintf(out + written, size - written, "]}");
+    }
+    return written;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "data_types.h"
+
+// One reading of the LVGL heap
+struct MemorySample {
+    uint32_t total = 0;             // Pool size [bytes]
+    uint32_t used = 0;
+    uint32_t used_blocks = 0;
+    uint32_t free_blocks = 0;
+    uint32_t largest_free = 0;      // Biggest single allocation that would still succeed
+    uint32_t high_water = 0;        // Peak usage since boot
+    uint8_t frag_pct = 0;           // 100 - largest free / total free
+};
+
+// Cost of building one screen, and what an empty screen leaves behind
+struct ScreenMemoryStats {
+    uint32_t builds = 0;
+    uint32_t blocks = 0;            // Allocations made by the last build
+    uint32_t bytes = 0;             // Bytes held by the last build
+    uint32_t max_bytes = 0;
+    uint32_t cleans = 0;
+    int32_t baseline = 0;           // Left behind by the first clean (one-off caches)
+    int32_t residue = 0;            // Left behind by every clean since, net [bytes]
+    uint8_t growth_streak = 0;      // Consecutive cleans with residue over the threshold
+};
+
+// Watches the LVGL pool for leaks and fragmentation. Screens are rebuilt on
+// every update, so what each build still holds after lv_obj_clean() is
+// measured each time: if one screen's total keeps growing, it is leaking.
+class MemoryMonitor {
+public:
+    static void begin();
+    
+    // Bracket a screen build: after lv_obj_clean(), and once it is created.
+    // The heap left after the clean is charged to the screen it removed.
+    static void beginScreenBuild();
+    static void endScreenBuild(int screen);
+    
+    // Periodic sample, published on home/knob/lvgl_mem (call from loop)
+    static void update();
+    
+    static void sample(MemorySample& out);
+    static const MemorySample& getLastSample();
+    static const ScreenMemoryStats& getScreenStats(int screen);
+    static bool isLeakSuspected();
+    static uint32_t getMinLargestFree();
+    
+    // JSON summary for MQTT/commands. Returns bytes written.
+    static int formatReport(char* out, size_t size);
+
+private:
+    static constexpr unsigned long SAMPLE_INTERVAL_MS = 60000;
+    static constexpr uint32_t LEAK_THRESHOLD = 256;     // Residue growth [bytes] that counts
+    static constexpr uint8_t LEAK_STREAK = 20;          // Cleans in a row before flagging
+    
+    static MemorySample last_sample;
+    static ScreenMemoryStats screens[SCREEN_COUNT];
+    static MemorySample build_start;
+    static int built_screen;            // On display until the next clean, -1 = none
+    static uint32_t built_from;         // Heap used before it was built
+    static uint32_t min_largest_free;
+    static unsigned long last_sample_time;
+    static bool leak_suspected;
+    
+    static void chargeResidue(int screen, int32_t left);
+};
@@ -0,0 +1,280 @@
+#include "numeric_readout.h"
+#include <Arduino.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Segments a-g, bit 0 = a (top), clockwise, g = middle
+static const uint8_t SEGMENT_MASKS[] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F,  // 0-9
+    0x40                                                        // '-'
+};
+
+// One segment: a hexagon with 45 degree tips along its axis
+struct Segment {
+    bool horizontal;
+    float across;           // Centre line position (y for horizontal, x for vertical)
+    float start;
+    float end;
+};
+
+static bool insideSegment(const Segment& s, float x, float y, float half) {
+    float along = s.horizontal ? x : y;
+    float offset = fabsf((s.horizontal ? y : x) - s.across);
+    return offset < half && along > s.start + offset && along < s.end - offset;
+}
+
+NumericReadout::NumericReadout(uint8_t digit_count, uint8_t height) {
+    digits = digit_count > MAX_DIGITS ? MAX_DIGITS : (digit_count ? digit_count : 1);
+    cell_h = height < 8 ? 8 : height;
+    cell_w = (cell_h * 11 + 10) / 20;
+    thickness = cell_h / 7 < 2 ? 2 : cell_h / 7;
+    spacing = cell_h / 10 < 1 ? 1 : cell_h / 10;
+    color = lv_color_black();
+    memset(&atlas, 0, sizeof(atlas));
+    for (uint8_t i = 0; i < MAX_DIGITS; i++) {
+        slots[i].owner = this;
+        slots[i].obj = nullptr;
+        slots[i].glyph = GLYPH_BLANK;
+        slots[i].pos = 0;
+    }
+}
+
+NumericReadout::~NumericReadout() {
+    if (container) lv_obj_del(container);
+    free(atlas_data);
+}
+
+lv_obj_t* NumericReadout::create(lv_obj_t* parent) {
+    if (!atlas_data) buildAtlas();
+    if (!color_set) {
+        lv_color_t inherited = lv_obj_get_style_text_color(parent, LV_PART_MAIN);
+        if (inherited.full != color.full) {
+            color = inherited;
+            recolorAtlas();
+        }
+    }
+
+    container = lv_obj_create(parent);
+    lv_obj_remove_style_all(container);
+    lv_obj_set_size(container, digits * (cell_w + spacing) - spacing, cell_h);
+    lv_obj_clear_flag(container, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(container, containerDeleted, LV_EVENT_DELETE, this);
+
+    for (uint8_t i = 0; i < digits; i++) {
+        Slot& slot = slots[i];
+        lv_anim_del(&slot, rollStep);
+        if (slot.glyph != GLYPH_BLANK) slot.pos = slot.glyph * POS_ONE;
+
+        slot.obj = lv_obj_create(container);
+        lv_obj_remove_style_all(slot.obj);
+        lv_obj_set_size(slot.obj, cell_w, cell_h);
+        lv_obj_set_pos(slot.obj, i * (cell_w + spacing), 0);
+        lv_obj_clear_flag(slot.obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_event_cb(slot.obj, drawSlot, LV_EVENT_DRAW_MAIN, &slot);
+    }
+    return container;
+}
+
+lv_obj_t* NumericReadout::getObj() {
+    return container;
+}
+
+void NumericReadout::setValue(int32_t value) {
+    stats.updates++;
+
+    bool negative = value < 0 && digits > 1;
+    uint32_t magnitude = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    uint32_t limit = 1;
+    for (uint8_t i = negative ? 1 : 0; i < digits; i++) limit *= 10;
+    if (magnitude >= limit) magnitude = limit - 1;
+
+    uint8_t glyphs[MAX_DIGITS];
+    int i = digits - 1;
+    do {
+        glyphs[i--] = magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude && i >= 0);
+    if (negative && i >= 0) glyphs[i--] = GLYPH_MINUS;
+    while (i >= 0) glyphs[i--] = GLYPH_BLANK;
+
+    for (uint8_t d = 0; d < digits; d++) {
+        setGlyph(slots[d], glyphs[d]);
+    }
+}
+
+void NumericReadout::setBlank() {
+    for (uint8_t d = 0; d < digits; d++) {
+        setGlyph(slots[d], GLYPH_BLANK);
+    }
+}
+
+void NumericReadout::setColor(lv_color_t new_color) {
+    color_set = true;
+    if (new_color.full == color.full) return;
+    color = new_color;
+    recolorAtlas();
+    for (uint8_t d = 0; d < digits; d++) {
+        if (slots[d].glyph != GLYPH_BLANK) invalidateSlot(slots[d]);
+    }
+}
+
+void NumericReadout::setRolling(bool enabled) {
+    rolling = enabled;
+}
+
+const ReadoutStats& NumericReadout::getStats() {
+    return stats;
+}
+
+void NumericReadout::setGlyph(Slot& slot, uint8_t glyph) {
+    if (glyph == slot.glyph) return;
+    uint8_t from = slot.glyph;
+    slot.glyph = glyph;
+    stats.digit_changes++;
+    if (glyph == GLYPH_BLANK) {
+        lv_anim_del(&slot, rollStep);
+        invalidateSlot(slot);
+        return;
+    }
+
+    int16_t target = glyph * POS_ONE;
+    bool roll = rolling && slot.obj && from < GLYPH_MINUS && glyph < GLYPH_MINUS;
+    if (!roll) {
+        lv_anim_del(&slot, rollStep);
+        slot.pos = target;
+        invalidateSlot(slot);
+        return;
+    }
+
+    // Restart from wherever a running roll has got to
+    lv_anim_del(&slot, rollStep);
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &slot);
+    lv_anim_set_exec_cb(&a, rollStep);
+    lv_anim_set_values(&a, slot.pos, target);
+    lv_anim_set_time(&a, ROLL_MS);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_start(&a);
+}
+
+void NumericReadout::invalidateSlot(Slot& slot) {
+    if (!slot.obj) return;
+    lv_obj_invalidate(slot.obj);
+    stats.invalidations++;
+}
+
+void NumericReadout::rollStep(void* var, int32_t pos) {
+    Slot* slot = (Slot*)var;
+    slot->pos = (int16_t)pos;
+    slot->owner->invalidateSlot(*slot);
+}
+
+void NumericReadout::drawSlot(lv_event_t* e) {
+    Slot* slot = (Slot*)lv_event_get_user_data(e);
+    NumericReadout* self = slot->owner;
+    if (slot->glyph == GLYPH_BLANK || !self->atlas_data) return;
+
+    uint32_t start = micros();
+    lv_draw_ctx_t* draw_ctx = lv_event_get_draw_ctx(e);
+    lv_area_t cell;
+    lv_obj_get_coords(slot->obj, &cell);
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &cell, draw_ctx->clip_area)) return;
+
+    // Place the strip so the window offset lands on the cell, clipped to it
+    lv_area_t strip;
+    strip.x1 = cell.x1;
+    strip.x2 = cell.x1 + self->cell_w - 1;
+    strip.y1 = cell.y1 - ((int32_t)slot->pos * self->cell_h) / POS_ONE;
+    strip.y2 = strip.y1 + self->atlas.header.h - 1;
+
+    const lv_area_t* saved_clip = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip;
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    lv_draw_img(draw_ctx, &dsc, &strip, &self->atlas);
+    draw_ctx->clip_area = saved_clip;
+
+    self->stats.draws++;
+    self->stats.draw_us += micros() - start;
+}
+
+void NumericReadout::containerDeleted(lv_event_t* e) {
+    NumericReadout* self = (NumericReadout*)lv_event_get_user_data(e);
+    self->container = nullptr;
+    for (uint8_t i = 0; i < self->digits; i++) {
+        Slot& slot = self->slots[i];
+        lv_anim_del(&slot, rollStep);
+        slot.obj = nullptr;
+        if (slot.glyph != GLYPH_BLANK) slot.pos = slot.glyph * POS_ONE;
+    }
+}
+
+bool NumericReadout::buildAtlas() {
+    const uint32_t cell_px = (uint32_t)cell_w * cell_h;
+    const uint32_t size = cell_px * GLYPH_COUNT * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    atlas_data = (uint8_t*)calloc(1, size);
+    if (!atlas_data) {
+        Serial.printf("NumericReadout: no memory for %u byte atlas\n", (unsigned)size);
+        return false;
+    }
+
+    const float half = thickness / 2.0f;
+    const float gap = thickness / 4.0f;
+    const float left = half, right = cell_w - half;
+    const float top = half, middle = cell_h / 2.0f, bottom = cell_h - half;
+    const Segment segments[7] = {
+        {true,  top,    left + gap,   right - gap},     // a
+        {false, right,  top + gap,    middle - gap},    // b
+        {false, right,  middle + gap, bottom - gap},    // c
+        {true,  bottom, left + gap,   right - gap},     // d
+        {false, left,   middle + gap, bottom - gap},    // e
+        {false, left,   top + gap,    middle - gap},    // f
+        {true,  middle, left + gap,   right - gap},     // g
+    };
+
+    // Segments don't overlap, so each glyph's coverage is the sum of its
+    // lit segments - 4x4 supersampled once per segment
+    const uint8_t alpha_ofs = LV_IMG_PX_SIZE_ALPHA_BYTE - 1;
+    for (uint8_t s = 0; s < 7; s++) {
+        for (uint8_t y = 0; y < cell_h; y++) {
+            for (uint8_t x = 0; x < cell_w; x++) {
+                uint8_t hits = 0;
+                for (uint8_t sy = 0; sy < 4; sy++) {
+                    for (uint8_t sx = 0; sx < 4; sx++) {
+                        if (insideSegment(segments[s], x + (sx + 0.5f) / 4.0f, y + (sy + 0.5f) / 4.0f, half)) hits++;
+                    }
+                }
+                if (!hits) continue;
+                uint8_t alpha = hits * 255 / 16;
+                for (uint8_t g = 0; g < GLYPH_COUNT; g++) {
+                    if (!(SEGMENT_MASKS[g] & (1 << s))) continue;
+                    uint8_t* px = atlas_data + ((uint32_t)g * cell_px + (uint32_t)y * cell_w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                    uint16_t sum = px[alpha_ofs] + alpha;
+                    px[alpha_ofs] = sum > 255 ? 255 : sum;
+                }
+            }
+        }
+    }
+
+    atlas.header.always_zero = 0;
+    atlas.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    atlas.header.w = cell_w;
+    atlas.header.h = cell_h * GLYPH_COUNT;
+    atlas.data_size = size;
+    atlas.data = atlas_data;
+    stats.atlas_builds++;
+    recolorAtlas();
+    return true;
+}
+
+void NumericReadout::recolorAtlas() {
+    if (!atlas_data) return;
+    const uint32_t pixels = (uint32_t)atlas.header.w * atlas.header.h;
+    for (uint32_t i = 0; i < pixels; i++) {
+        memcpy(atlas_data + i * LV_IMG_PX_SIZE_ALPHA_BYTE, &color, sizeof(lv_color_t));
+    }
+    lv_img_cache_invalidate_src(&atlas);
+}
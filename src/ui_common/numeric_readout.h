@@ -0,0 +1,79 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// Readout counters
+struct ReadoutStats {
+    uint32_t updates = 0;           // setValue() calls
+    uint32_t digit_changes = 0;     // Slots whose glyph changed
+    uint32_t invalidations = 0;     // Slot redraws requested, rolling frames included
+    uint32_t draws = 0;             // Slot draw callbacks
+    uint32_t draw_us = 0;           // Time spent in them
+    uint32_t atlas_builds = 0;
+};
+
+// Fixed-width 7-segment numeric readout.
+// The glyphs 0-9 and '-' are rendered once into a vertical strip atlas
+// (RGB565 + alpha). Every digit slot is its own small object that blits the
+// strip through a one-cell clip window, so a new value invalidates only the
+// slots that changed and a redraw is a clipped image copy - no text layout.
+// Rolling slides the window along the strip from the old digit to the new one.
+//
+// The slot objects belong to the screen they were created on and are dropped
+// with it; the atlas is kept across rebuilds and only recoloured by setColor().
+class NumericReadout {
+public:
+    static constexpr uint8_t MAX_DIGITS = 6;
+    static constexpr uint16_t ROLL_MS = 120;
+
+    NumericReadout(uint8_t digits, uint8_t height);
+    ~NumericReadout();
+
+    // Create the slots on a (new) screen; shows the last value set
+    lv_obj_t* create(lv_obj_t* parent);
+    lv_obj_t* getObj();
+
+    // Right-aligned with a leading '-' for negatives, clamped to the slot count
+    void setValue(int32_t value);
+    void setBlank();
+    void setColor(lv_color_t color);
+    void setRolling(bool enabled);
+
+    const ReadoutStats& getStats();
+
+private:
+    static constexpr uint8_t GLYPH_COUNT = 11;      // 0-9 and '-'
+    static constexpr uint8_t GLYPH_MINUS = 10;
+    static constexpr uint8_t GLYPH_BLANK = 0xFF;
+    static constexpr int16_t POS_ONE = 256;         // Window offset of one cell
+
+    struct Slot {
+        NumericReadout* owner;
+        lv_obj_t* obj;
+        uint8_t glyph;
+        int16_t pos;            // Window offset into the strip [1/256 cell]
+    };
+
+    uint8_t digits;
+    uint8_t cell_w;
+    uint8_t cell_h;
+    uint8_t thickness;
+    uint8_t spacing;
+    bool rolling = true;
+    bool color_set = false;
+    lv_color_t color;
+    lv_obj_t* container = nullptr;
+    Slot slots[MAX_DIGITS];
+    uint8_t* atlas_data = nullptr;
+    lv_img_dsc_t atlas;
+    ReadoutStats stats;
+
+    bool buildAtlas();
+    void recolorAtlas();
+    void setGlyph(Slot& slot, uint8_t glyph);
+    void invalidateSlot(Slot& slot);
+
+    static void drawSlot(lv_event_t* e);
+    static void containerDeleted(lv_event_t* e);
+    static void rollStep(void* var, int32_t pos);
+};
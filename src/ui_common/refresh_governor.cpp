@@ -0,0 +1,139 @@
+#include "refresh_governor.h"
+#include "../core/hardware/display_flush.h"
+
+lv_disp_t* RefreshGovernor::disp = nullptr;
+lv_indev_t* RefreshGovernor::indev = nullptr;
+RefreshState RefreshGovernor::state = REFRESH_ACTIVE;
+bool RefreshGovernor::refresh_paused = false;
+uint32_t RefreshGovernor::refresh_period = LV_DISP_DEF_REFR_PERIOD;
+unsigned long RefreshGovernor::last_input = 0;
+unsigned long RefreshGovernor::last_data = 0;
+GovernorStats RefreshGovernor::stats;
+LatencyHistogram RefreshGovernor::frame_times;
+unsigned long RefreshGovernor::last_frame_decay = 0;
+
+void RefreshGovernor::begin(lv_disp_t* display, lv_indev_t* input) {
+    disp = display;
+    indev = input;
+    refresh_paused = false;
+    lv_timer_resume(_lv_disp_get_refr_timer(disp));     // Paused by an earlier begin()'s idle
+    last_input = millis();
+    last_data = 0;
+    stats = GovernorStats();
+    
+    // Start fast so the first screen appears immediately
+    state = REFRESH_IDLE;
+    applyState(REFRESH_ACTIVE);
+}
+
+void RefreshGovernor::notifyInput() {
+    last_input = millis();
+    stats.input_events++;
+}
+
+void RefreshGovernor::notifyDataChanged() {
+    last_data = millis();
+    stats.data_events++;
+}
+
+void RefreshGovernor::handleTimers() {
+    unsigned long now = millis();
+    RefreshState new_state = evaluate(now);
+    if (new_state != state) {
+        applyState(new_state);
+    }
+    
+    // Stop the refresh timer entirely while nothing is dirty
+    lv_timer_t* refr_timer = _lv_disp_get_refr_timer(disp);
+    bool dirty = disp->inv_p > 0 || lv_anim_count_running() > 0;
+    if (dirty && refresh_paused) {
+        lv_timer_resume(refr_timer);
+        refresh_paused = false;
+    } else if (!dirty && !refresh_paused) {
+        lv_timer_pause(refr_timer);
+        refresh_paused = true;
+    }
+    if (refresh_paused) {
+        stats.refresh_paused++;
+    }
+    
+    uint32_t flushes = DisplayFlush::getStats().flushes;
+    unsigned long start_us = micros();
+    lv_timer_handler();
+    uint32_t elapsed_us = micros() - start_us;
+    stats.lvgl_us[state] += elapsed_us;
+    stats.loops[state]++;
+    
+    // A pass that flushed is a frame
+    if (DisplayFlush::getStats().flushes != flushes) {
+        frame_times.record(elapsed_us);
+    }
+    if (now - last_frame_decay >= FRAME_DECAY_MS) {
+        frame_times.decay();
+        last_frame_decay = now;
+    }
+}
+
+uint32_t RefreshGovernor::getRefreshPeriod() {
+    return refresh_period;
+}
+
+RefreshState RefreshGovernor::getState() {
+    return state;
+}
+
+const char* RefreshGovernor::getStateName(RefreshState s) {
+    switch (s) {
+        case REFRESH_ACTIVE: return "active";
+        case REFRESH_DATA:   return "data";
+        case REFRESH_IDLE:   return "idle";
+        default:             return "?";
+    }
+}
+
+const GovernorStats& RefreshGovernor::getStats() {
+    return stats;
+}
+
+void RefreshGovernor::resetStats() {
+    stats = GovernorStats();
+    frame_times.reset();
+}
+
+const LatencyHistogram& RefreshGovernor::getFrameTimes() {
+    return frame_times;
+}
+
+RefreshState RefreshGovernor::evaluate(unsigned long now) {
+    if (lv_anim_count_running() > 0 || now - last_input < ACTIVE_HOLD_MS) {
+        return REFRESH_ACTIVE;
+    }
+    if (last_data != 0 && now - last_data < DATA_HOLD_MS) {
+        return REFRESH_DATA;
+    }
+    return REFRESH_IDLE;
+}
+
+void RefreshGovernor::applyState(RefreshState new_state) {
+    uint32_t refr_period = ACTIVE_REFR_PERIOD;
+    uint32_t read_period = ACTIVE_READ_PERIOD;
+    
+    if (new_state == REFRESH_DATA) {
+        refr_period = DATA_REFR_PERIOD;
+        read_period = DATA_READ_PERIOD;
+    } else if (new_state == REFRESH_IDLE) {
+        refr_period = IDLE_REFR_PERIOD;
+        read_period = IDLE_READ_PERIOD;
+    }
+    
+    lv_timer_set_period(_lv_disp_get_refr_timer(disp), refr_period);
+    if (indev) {
+        lv_timer_set_period(lv_indev_get_read_timer(indev), read_period);
+    }
+    
+    state = new_state;
+    refresh_period = refr_period;
+    stats.state_changes++;
+    Serial.printf("Refresh governor: %s (refresh %lums, input %lums)\n",
+                  getStateName(state), (unsigned long)refr_period, (unsigned long)read_period);
+}
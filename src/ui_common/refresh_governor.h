@@ -0,0 +1,73 @@
+#pragma once
+#include <lvgl.h>
+#include "../core/system/latency_histogram.h"
+
+// Refresh rate states, fastest first
+enum RefreshState {
+    REFRESH_ACTIVE = 0,     // Encoder/touch activity or animation running
+    REFRESH_DATA,           // Only MQTT data changing - slow tick
+    REFRESH_IDLE,           // Nothing happening - refresh timer paused when clean
+    REFRESH_STATE_COUNT
+};
+
+// Governor decisions and LVGL cost per state
+struct GovernorStats {
+    uint32_t loops[REFRESH_STATE_COUNT] = {};       // Loop iterations spent in each state
+    uint32_t lvgl_us[REFRESH_STATE_COUNT] = {};     // Time in lv_timer_handler per state
+    uint32_t state_changes = 0;
+    uint32_t refresh_paused = 0;    // Loops where the refresh timer was paused (nothing dirty)
+    uint32_t input_events = 0;
+    uint32_t data_events = 0;
+};
+
+class RefreshGovernor {
+public:
+    static void begin(lv_disp_t* disp, lv_indev_t* indev);
+    
+    // Activity notifications
+    static void notifyInput();
+    static void notifyDataChanged();
+    
+    // Adjust LVGL timer periods and run lv_timer_handler (call in loop instead of lv_timer_handler)
+    static void handleTimers();
+    
+    // Current refresh period - data-driven redraws are paced to it
+    static uint32_t getRefreshPeriod();
+    
+    static RefreshState getState();
+    static const char* getStateName(RefreshState state);
+    static const GovernorStats& getStats();
+    static void resetStats();
+    
+    // Duration of lv_timer_handler() passes that rendered something (recent window)
+    static const LatencyHistogram& getFrameTimes();
+
+private:
+    // Refresh / input read periods per state [ms]
+    static constexpr uint32_t ACTIVE_REFR_PERIOD = 15;
+    static constexpr uint32_t ACTIVE_READ_PERIOD = 10;
+    static constexpr uint32_t DATA_REFR_PERIOD = 200;
+    static constexpr uint32_t DATA_READ_PERIOD = 50;
+    static constexpr uint32_t IDLE_REFR_PERIOD = 500;
+    static constexpr uint32_t IDLE_READ_PERIOD = 100;
+    
+    // How long activity keeps a state alive [ms]
+    static constexpr unsigned long ACTIVE_HOLD_MS = 2000;
+    static constexpr unsigned long DATA_HOLD_MS = 5000;
+    
+    static constexpr unsigned long FRAME_DECAY_MS = 10000;     // Halves the frame histogram
+    
+    static lv_disp_t* disp;
+    static lv_indev_t* indev;
+    static RefreshState state;
+    static bool refresh_paused;
+    static uint32_t refresh_period;
+    static unsigned long last_input;
+    static unsigned long last_data;
+    static GovernorStats stats;
+    static LatencyHistogram frame_times;
+    static unsigned long last_frame_decay;
+    
+    static RefreshState evaluate(unsigned long now);
+    static void applyState(RefreshState new_state);
+};
@@ -0,0 +1,133 @@
+#include "screen_arena.h"
+#include <lv_arena_alloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Host sanitizer builds (test/) poison arena memory that is not handed out,
+// so a block used after its screen is cleaned is reported like a heap
+// use-after-free. Nothing on the knob.
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#define ARENA_POISON(addr, size) ASAN_POISON_MEMORY_REGION(addr, size)
+#define ARENA_UNPOISON(addr, size) ASAN_UNPOISON_MEMORY_REGION(addr, size)
+#else
+#define ARENA_POISON(addr, size) ((void)(addr), (void)(size))
+#define ARENA_UNPOISON(addr, size) ((void)(addr), (void)(size))
+#endif
+
+alignas(8) uint8_t ScreenArena::arena[ScreenArena::ARENA_SIZE];
+size_t ScreenArena::offset = 0;
+bool ScreenArena::scope_open = false;
+ArenaStats ScreenArena::stats;
+
+void ScreenArena::beginScreen() {
+    if (stats.arena_live > 0) {
+        stats.pinned++;     // Something survived the clean - keep bumping
+    } else if (offset == 0) {
+        ARENA_POISON(arena, ARENA_SIZE);
+    }
+    scope_open = true;
+}
+
+void ScreenArena::endScreen() {
+    scope_open = false;
+}
+
+void* ScreenArena::alloc(size_t size) {
+    if (scope_open) {
+        size_t need = sizeof(BlockHeader) + ((size + ALIGN - 1) & ~(ALIGN - 1));
+        if (offset + need <= ARENA_SIZE) {
+            BlockHeader* header = reinterpret_cast<BlockHeader*>(arena + offset);
+            ARENA_UNPOISON(header, need);
+            header->size = (uint32_t)(need - sizeof(BlockHeader));
+            header->reserved = 0;
+            offset += need;
+            
+            stats.arena_allocs++;
+            stats.arena_live++;
+            stats.arena_used = offset;
+            if (offset > stats.arena_peak) stats.arena_peak = offset;
+            return header + 1;
+        }
+        stats.fallbacks++;
+    }
+    
+    void* ptr = ::malloc(size);
+    if (ptr) {
+        stats.general_allocs++;
+        stats.general_live++;
+    }
+    return ptr;
+}
+
+void ScreenArena::free(void* ptr) {
+    if (!ptr) return;
+    
+    if (contains(ptr)) {
+        // Individual arena blocks are never reused - rewind once all are gone
+        ARENA_POISON(ptr, (reinterpret_cast<BlockHeader*>(ptr) - 1)->size);
+        if (stats.arena_live > 0 && --stats.arena_live == 0) {
+            ARENA_POISON(arena, offset);
+            offset = 0;
+            stats.arena_used = 0;
+            stats.resets++;
+        }
+        return;
+    }
+    
+    ::free(ptr);
+    if (stats.general_live > 0) stats.general_live--;
+}
+
+void* ScreenArena::realloc(void* ptr, size_t size) {
+    if (!ptr) return alloc(size);
+    
+    if (contains(ptr)) {
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(ptr) - 1;
+        if (size <= header->size) {
+            return ptr;
+        }
+        
+        // Last block in the arena: grow in place
+        size_t grown = (size + ALIGN - 1) & ~(ALIGN - 1);
+        uint8_t* end = reinterpret_cast<uint8_t*>(ptr) + header->size;
+        if (end == arena + offset && (size_t)(reinterpret_cast<uint8_t*>(ptr) - arena) + grown <= ARENA_SIZE) {
+            ARENA_UNPOISON(end, grown - header->size);
+            offset += grown - header->size;
+            header->size = (uint32_t)grown;
+            stats.arena_used = offset;
+            if (offset > stats.arena_peak) stats.arena_peak = offset;
+            return ptr;
+        }
+        
+        void* moved = alloc(size);
+        if (!moved) return nullptr;
+        memcpy(moved, ptr, header->size);
+        free(ptr);
+        return moved;
+    }
+    
+    return ::realloc(ptr, size);
+}
+
+bool ScreenArena::contains(const void* ptr) {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return p >= arena && p < arena + ARENA_SIZE;
+}
+
+const ArenaStats& ScreenArena::getStats() {
+    return stats;
+}
+
+// C entry points named in lv_conf.h
+extern "C" void* lv_arena_alloc(size_t size) {
+    return ScreenArena::alloc(size);
+}
+
+extern "C" void lv_arena_free(void* ptr) {
+    ScreenArena::free(ptr);
+}
+
+extern "C" void* lv_arena_realloc(void* ptr, size_t size) {
+    return ScreenArena::realloc(ptr, size);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Allocator counters
+struct ArenaStats {
+    uint32_t arena_allocs = 0;
+    uint32_t general_allocs = 0;
+    uint32_t fallbacks = 0;         // Arena full - served from the general heap
+    uint32_t resets = 0;            // Arena released in one step
+    uint32_t pinned = 0;            // Screen began while old arena blocks were still live
+    uint32_t arena_used = 0;        // Bump offset [bytes]
+    uint32_t arena_peak = 0;
+    uint32_t arena_live = 0;        // Blocks not yet freed
+    uint32_t general_live = 0;
+};
+
+// Allocator behind LVGL when LV_MEM_CUSTOM is 1 (include/lv_conf.h).
+// While a screen is being built, LVGL allocations are bumped out of one
+// static arena; lv_obj_clean() frees them in scattered order, and when the
+// last one goes the arena is rewound in one step - no per-block bookkeeping,
+// no fragmentation. Everything else (render buffers, animations, styles
+// created outside a build) comes from the general heap.
+//
+// If anything from a screen outlives lv_obj_clean(), the arena is not
+// rewound until it is freed; new screens keep bumping and fall back to the
+// general heap when it is full, so correctness never depends on the scope.
+class ScreenArena {
+public:
+    static constexpr size_t ARENA_SIZE = 32 * 1024;
+    
+    // Bracket a screen build (after lv_obj_clean, and once it is created)
+    static void beginScreen();
+    static void endScreen();
+    
+    static void* alloc(size_t size);
+    static void free(void* ptr);
+    static void* realloc(void* ptr, size_t size);
+    
+    static bool contains(const void* ptr);
+    static const ArenaStats& getStats();
+
+private:
+    static constexpr size_t ALIGN = 8;
+    
+    struct BlockHeader {
+        uint32_t size;          // Usable bytes
+        uint32_t reserved;      // Keeps the payload 8-byte aligned
+    };
+    
+    alignas(8) static uint8_t arena[ARENA_SIZE];
+    static size_t offset;
+    static bool scope_open;
+    static ArenaStats stats;
+};
@@ -0,0 +1,254 @@
+#include "screen_transition.h"
+#include "disc_geometry.h"
+#include "../core/hardware/backlight.h"
+#include <TFT_eSPI.h>  // SPI_FREQUENCY for the bandwidth estimate
+
+TransitionMode ScreenTransition::mode = TRANSITION_CIRCULAR_WIPE;
+bool ScreenTransition::active = false;
+bool ScreenTransition::clipping = false;
+int16_t ScreenTransition::clip_radius = DiscGeometry::RADIUS;
+uint8_t ScreenTransition::saved_brightness = 255;
+void (*ScreenTransition::pending_build)() = nullptr;
+unsigned long ScreenTransition::start_time = 0;
+TransitionStats ScreenTransition::stats;
+
+void ScreenTransition::begin() {
+    active = false;
+    clipping = false;
+    clip_radius = DiscGeometry::RADIUS;
+    pending_build = nullptr;
+    stats = TransitionStats();
+}
+
+void ScreenTransition::setMode(TransitionMode new_mode) {
+    if (new_mode >= TRANSITION_COUNT) return;
+    mode = new_mode;
+    Serial.printf("Screen transition: %s\n", getModeName(mode));
+}
+
+TransitionMode ScreenTransition::getMode() {
+    return mode;
+}
+
+const char* ScreenTransition::getModeName(TransitionMode m) {
+    switch (m) {
+        case TRANSITION_NONE:           return "none";
+        case TRANSITION_CIRCULAR_WIPE:  return "wipe";
+        case TRANSITION_BACKLIGHT_FADE: return "fade";
+        case TRANSITION_DISC_SLIDE:     return "slide";
+        default:                        return "?";
+    }
+}
+
+void ScreenTransition::start(void (*build_screen)(), int direction) {
+    if (active) {
+        // Jump the running transition to its end state first
+        lv_anim_del(&stats, NULL);
+        finish();
+    }
+    
+    if (mode == TRANSITION_NONE) {
+        build_screen();
+        return;
+    }
+    
+    stats = TransitionStats();
+    stats.mode = mode;
+    start_time = millis();
+    active = true;
+    clipping = true;
+    
+    switch (mode) {
+        case TRANSITION_CIRCULAR_WIPE:
+            // The panel keeps showing the old screen outside the clip radius,
+            // so each step only has to send the ring the radius grew by
+            clip_radius = 0;
+            build_screen();
+            runAnimation(0, DiscGeometry::RADIUS, WIPE_TIME_MS, wipeStep, transitionDone);
+            break;
+            
+        case TRANSITION_BACKLIGHT_FADE:
+            clip_radius = DiscGeometry::RADIUS;
+            saved_brightness = Backlight::getBrightness();
+            pending_build = build_screen;
+            runAnimation(saved_brightness, 0, FADE_TIME_MS, fadeStep, fadeOutDone);
+            break;
+            
+        case TRANSITION_DISC_SLIDE:
+            clip_radius = DiscGeometry::RADIUS;
+            build_screen();
+            slideStep(NULL, (direction < 0 ? -1 : 1) * DiscGeometry::WIDTH);
+            runAnimation((direction < 0 ? -1 : 1) * DiscGeometry::WIDTH, 0, SLIDE_TIME_MS,
+                         slideStep, transitionDone);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+bool ScreenTransition::isActive() {
+    return active;
+}
+
+bool ScreenTransition::isClipping() {
+    return clipping;
+}
+
+bool ScreenTransition::getRowSpan(int16_t y, int16_t& x1, int16_t& x2) {
+    return DiscGeometry::rowSpan(y, clip_radius, x1, x2);
+}
+
+void ScreenTransition::recordFlush(uint32_t pixels_sent, uint32_t pixels_skipped, uint32_t elapsed_us) {
+    if (!active) return;
+    stats.flushes++;
+    stats.pixels_sent += pixels_sent;
+    stats.pixels_skipped += pixels_skipped;
+    stats.flush_us += elapsed_us;
+}
+
+const TransitionStats& ScreenTransition::getLastStats() {
+    return stats;
+}
+
+void ScreenTransition::runAnimation(int32_t from, int32_t to, uint32_t time_ms,
+                                   lv_anim_exec_xcb_t exec_cb, lv_anim_ready_cb_t ready_cb) {
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &stats);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, from, to);
+    lv_anim_set_time(&a, time_ms);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_start(&a);
+}
+
+void ScreenTransition::invalidateRing(int16_t inner_radius, int16_t outer_radius) {
+    if (outer_radius <= inner_radius) return;
+    
+    lv_obj_t* scr = lv_scr_act();
+    int16_t top = DiscGeometry::CENTER_Y - outer_radius;
+    int16_t bottom = DiscGeometry::CENTER_Y + outer_radius - 1;
+    
+    for (int16_t band_y1 = top; band_y1 <= bottom; band_y1 += RING_BAND_HEIGHT) {
+        int16_t band_y2 = band_y1 + RING_BAND_HEIGHT - 1;
+        if (band_y2 > bottom) band_y2 = bottom;
+        
+        // Widest outer span is on the band row nearest the centre,
+        // narrowest inner span on the row furthest from it
+        int16_t near_y = band_y1;
+        int16_t far_y = band_y2;
+        if (band_y1 < DiscGeometry::CENTER_Y && band_y2 >= DiscGeometry::CENTER_Y) {
+            near_y = DiscGeometry::CENTER_Y;
+            far_y = (DiscGeometry::CENTER_Y - band_y1 > band_y2 - DiscGeometry::CENTER_Y) ? band_y1 : band_y2;
+        } else if (band_y2 < DiscGeometry::CENTER_Y) {
+            near_y = band_y2;
+            far_y = band_y1;
+        }
+        
+        int16_t ox1, ox2;
+        if (!DiscGeometry::rowSpan(near_y, outer_radius, ox1, ox2)) continue;
+        
+        lv_area_t area;
+        area.y1 = band_y1;
+        area.y2 = band_y2;
+        
+        int16_t ix1, ix2;
+        bool inner_covers_band = DiscGeometry::rowSpan(band_y1, inner_radius, ix1, ix2) &&
+                                 DiscGeometry::rowSpan(band_y2, inner_radius, ix1, ix2) &&
+                                 DiscGeometry::rowSpan(far_y, inner_radius, ix1, ix2);
+        if (!inner_covers_band) {
+            area.x1 = ox1;
+            area.x2 = ox2;
+            lv_obj_invalidate_area(scr, &area);
+            continue;
+        }
+        
+        // Left and right segments of the ring - the middle was sent already
+        if (ix1 - 1 >= ox1) {
+            area.x1 = ox1;
+            area.x2 = ix1 - 1;
+            lv_obj_invalidate_area(scr, &area);
+        }
+        if (ix2 + 1 <= ox2) {
+            area.x1 = ix2 + 1;
+            area.x2 = ox2;
+            lv_obj_invalidate_area(scr, &area);
+        }
+    }
+}
+
+void ScreenTransition::finish() {
+    if (pending_build) {
+        // Fade aborted before the new screen was built
+        pending_build();
+        pending_build = nullptr;
+    }
+    if (stats.mode == TRANSITION_BACKLIGHT_FADE) {
+        Backlight::setBrightness(saved_brightness);
+    } else if (stats.mode == TRANSITION_DISC_SLIDE) {
+        slideStep(NULL, 0);
+    } else if (stats.mode == TRANSITION_CIRCULAR_WIPE && clip_radius < DiscGeometry::RADIUS) {
+        int16_t reached = clip_radius;
+        clip_radius = DiscGeometry::RADIUS;
+        invalidateRing(reached, DiscGeometry::RADIUS);
+    }
+    
+    clip_radius = DiscGeometry::RADIUS;
+    clipping = false;
+    active = false;
+    stats.duration_ms = millis() - start_time;
+}
+
+void ScreenTransition::report() {
+    uint32_t frames = stats.frames > 0 ? stats.frames : 1;
+    // RGB565 - 16 bits per pixel on the SPI bus
+    uint32_t spi_us = (uint32_t)((uint64_t)stats.pixels_sent * 16 * 1000000ULL / SPI_FREQUENCY);
+    
+    Serial.printf("Transition %s: %lu ms, %lu frames, %lu px sent (%lu/frame), %lu px skipped, "
+                  "flush %lu us/frame, est. SPI %lu us/frame\n",
+                  getModeName(stats.mode), stats.duration_ms, stats.frames,
+                  stats.pixels_sent, stats.pixels_sent / frames, stats.pixels_skipped,
+                  stats.flush_us / frames, spi_us / frames);
+}
+
+// Animation callbacks
+
+void ScreenTransition::wipeStep(void* var, int32_t radius) {
+    int16_t previous = clip_radius;
+    clip_radius = (int16_t)radius;
+    invalidateRing(previous, clip_radius);
+    stats.frames++;
+}
+
+void ScreenTransition::fadeStep(void* var, int32_t level) {
+    Backlight::setBrightness((uint8_t)level);
+    stats.frames++;
+}
+
+void ScreenTransition::fadeOutDone(lv_anim_t* anim) {
+    // Build and draw the new screen while the backlight is off
+    if (pending_build) {
+        pending_build();
+        pending_build = nullptr;
+    }
+    lv_refr_now(NULL);
+    runAnimation(0, saved_brightness, FADE_TIME_MS, fadeStep, transitionDone);
+}
+
+void ScreenTransition::slideStep(void* var, int32_t offset) {
+    lv_obj_t* scr = lv_scr_act();
+    uint32_t count = lv_obj_get_child_cnt(scr);
+    for (uint32_t i = 0; i < count; i++) {
+        lv_obj_set_style_translate_x(lv_obj_get_child(scr, i), (lv_coord_t)offset, 0);
+    }
+    if (var != NULL) {
+        stats.frames++;
+    }
+}
+
+void ScreenTransition::transitionDone(lv_anim_t* anim) {
+    finish();
+    report();
+}
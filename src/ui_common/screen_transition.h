@@ -0,0 +1,70 @@
+#pragma once
+#include <lvgl.h>
+
+// Screen transition modes - each one chosen to keep SPI traffic low
+enum TransitionMode {
+    TRANSITION_NONE = 0,        // Instant clean + recreate
+    TRANSITION_CIRCULAR_WIPE,   // New screen grows from the centre, only the new ring is sent
+    TRANSITION_BACKLIGHT_FADE,  // Dim TFT_BL, redraw once in the dark, brighten again
+    TRANSITION_DISC_SLIDE,      // New screen slides in, flush limited to the visible disc
+    TRANSITION_COUNT
+};
+
+// Cost of the last transition (printed when it finishes)
+struct TransitionStats {
+    TransitionMode mode = TRANSITION_NONE;
+    uint32_t frames = 0;            // Animation steps
+    uint32_t flushes = 0;           // Flush callbacks while running
+    uint32_t pixels_sent = 0;       // Pixels pushed over SPI
+    uint32_t pixels_skipped = 0;    // Pixels rendered but clipped away
+    uint32_t flush_us = 0;          // Time spent inside the flush callback
+    uint32_t duration_ms = 0;       // Start to finish
+};
+
+class ScreenTransition {
+public:
+    static void begin();
+    static void setMode(TransitionMode mode);
+    static TransitionMode getMode();
+    static const char* getModeName(TransitionMode mode);
+    
+    // Switch screens. build_screen creates the new content on lv_scr_act().
+    // direction: +1 for next screen, -1 for previous (slide direction)
+    static void start(void (*build_screen)(), int direction);
+    static bool isActive();
+    
+    // Flush hooks (DisplayFlush) - while clipping, only the returned row span is sent
+    static bool isClipping();
+    static bool getRowSpan(int16_t y, int16_t& x1, int16_t& x2);
+    static void recordFlush(uint32_t pixels_sent, uint32_t pixels_skipped, uint32_t elapsed_us);
+    
+    static const TransitionStats& getLastStats();
+
+private:
+    static constexpr uint32_t WIPE_TIME_MS = 300;
+    static constexpr uint32_t FADE_TIME_MS = 120;   // Each direction
+    static constexpr uint32_t SLIDE_TIME_MS = 250;
+    static constexpr int16_t RING_BAND_HEIGHT = 24; // Keeps ring invalidation under LV_INV_BUF_SIZE areas
+    
+    static TransitionMode mode;
+    static bool active;
+    static bool clipping;
+    static int16_t clip_radius;
+    static uint8_t saved_brightness;
+    static void (*pending_build)();
+    static unsigned long start_time;
+    static TransitionStats stats;
+    
+    static void runAnimation(int32_t from, int32_t to, uint32_t time_ms,
+                             lv_anim_exec_xcb_t exec_cb, lv_anim_ready_cb_t ready_cb);
+    static void invalidateRing(int16_t inner_radius, int16_t outer_radius);
+    static void finish();
+    static void report();
+    
+    // Animation callbacks
+    static void wipeStep(void* var, int32_t radius);
+    static void fadeStep(void* var, int32_t level);
+    static void fadeOutDone(lv_anim_t* anim);
+    static void slideStep(void* var, int32_t offset);
+    static void transitionDone(lv_anim_t* anim);
+};
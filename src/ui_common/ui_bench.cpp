@@ -0,0 +1,199 @@
+#include "ui_bench.h"
+#include "../core/system/bench_runner.h"
+#include "disc_bench.h"
+#include "../core/system/telemetry_bench.h"
+#include "../features/energy/filter_bench.h"
+#include "../core/hardware/display_flush.h"
+#include "../core/hardware/haptic_feedback.h"
+#include "../core/hardware/power_manager.h"
+#include "../core/network/mqtt_manager.h"
+#include "../features/energy/energy_ui.h"
+#include "../features/energy/history_ring.h"
+#include <lvgl.h>
+
+void (*UIBench::build_screen)(int) = nullptr;
+int UIBench::requested_screen = -1;
+bool UIBench::pending = false;
+bool UIBench::running = false;
+bool UIBench::finished = false;
+uint32_t UIBench::synthetic_step = 0;
+uint32_t UIBench::flush_us_before = 0;
+uint32_t UIBench::flush_pixels_before = 0;
+
+static const char* BENCH_TOPIC = "home/knob/bench";
+static const char* screen_case_names[SCREEN_COUNT] = {
+    "screen_energy",
+    "screen_weather",
+    "screen_house_info",
+    "screen_settings"
+};
+
+// Spread the role totals over the configured channels, so every gauge is drawn
+static void fillChannels(EnergyData& data) {
+    int role_counts[CHANNEL_ROLE_COUNT] = {};
+    for (int c = 0; c < EnergyChannels::getCount(); c++) {
+        role_counts[EnergyChannels::getConfig(c).role]++;
+    }
+    for (int c = 0; c < EnergyChannels::getCount(); c++) {
+        ChannelRole role = EnergyChannels::getConfig(c).role;
+        float total = (role == CHANNEL_BALANCE) ? data.balance :
+                      (role == CHANNEL_SOLAR) ? data.solar :
+                      (role == CHANNEL_USED || role == CHANNEL_LOAD) ? data.used : data.vrms;
+        data.channels[c] = (role == CHANNEL_VRMS) ? total : total / role_counts[role];
+    }
+}
+
+void UIBench::begin(void (*build)(int screen)) {
+    build_screen = build;
+    BenchRunner::begin(clockMicros, publishResult);
+}
+
+bool UIBench::start(int screen) {
+    if (running || pending || !build_screen || screen >= SCREEN_COUNT) {
+        return false;
+    }
+    // Deferred to update() - this is called from inside the MQTT callback
+    requested_screen = screen;
+    pending = true;
+    return true;
+}
+
+void UIBench::update() {
+    if (pending) {
+        pending = false;
+        PowerManager::notifyActivity();     // Wake the panel - render times include the flush
+        configureCases(requested_screen);
+        running = BenchRunner::start();
+        Serial.printf("Bench started (%d cases)\n", BenchRunner::getCaseCount());
+    }
+    if (running && !BenchRunner::update()) {
+        running = false;
+        finished = true;
+    }
+}
+
+bool UIBench::isRunning() {
+    return running || pending;
+}
+
+bool UIBench::hasFinished() {
+    if (finished) {
+        finished = false;
+        return true;
+    }
+    return false;
+}
+
+uint32_t UIBench::clockMicros() {
+    return micros();
+}
+
+void UIBench::publishResult(const char* json) {
+    Serial.printf("Bench: %s\n", json);
+    MQTTManager::publish(BENCH_TOPIC, json, false, false);
+}
+
+void UIBench::configureCases(int screen) {
+    BenchRunner::clear();
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+        if (screen < 0 || screen == i) {
+            BenchRunner::addCase({screen_case_names[i], runScreen, i, flushAux});
+        }
+    }
+    if (screen < 0 || screen == SCREEN_ENERGY) {
+        BenchRunner::addCase({"energy_synthetic", runEnergySynthetic, 0, flushAux});
+        BenchRunner::addCase({"energy_refresh", runEnergyRefresh, 0, flushAux});
+        BenchRunner::addCase({"history_column", runHistoryColumn, 0, flushAux});
+    }
+    BenchRunner::addCase({"lv_timer_handler", runTimerHandler, 0, nullptr});
+    BenchRunner::addCase({"haptic_i2c", runHapticProbe, 0, nullptr});
+    DiscBench::addCases();     // Also run by the [env:native] build
+    TelemetryBench::addCases();
+    FilterBench::addCases();
+}
+
+// Build + draw + flush of one screen. aux = the flush share (us, pixels sent)
+void UIBench::runScreen(int screen) {
+    const FlushStats& flush = DisplayFlush::getStats();
+    flush_us_before = flush.busy_us;
+    flush_pixels_before = flush.pixels_sent;
+    build_screen(screen);
+    lv_refr_now(NULL);
+}
+
+void UIBench::runEnergySynthetic(int) {
+    // Sweep export -> import so every arc colour and label path is drawn
+    EnergyData data;
+    data.balance = -4000.0f + (float)((synthetic_step * 613) % 12000);
+    data.solar = (float)((synthetic_step * 397) % 5000);
+    data.used = (float)((synthetic_step * 251) % 8000);
+    data.vrms = 230.0f + (float)(synthetic_step % 20);
+    data.tariff = 1 + synthetic_step % 4;
+    data.valid = true;
+    fillChannels(data);
+    PeakData peaks;
+    peaks.daily_export_peak = -3500.0f;
+    peaks.daily_import_peak = 7200.0f;
+    synthetic_step++;
+    
+    const FlushStats& flush = DisplayFlush::getStats();
+    flush_us_before = flush.busy_us;
+    flush_pixels_before = flush.pixels_sent;
+    lv_obj_clean(lv_scr_act());
+    EnergyUI::updateScreen(data, peaks);
+    lv_refr_now(NULL);
+}
+
+// In-place update of a built energy screen: only changed digits and arcs redraw
+void UIBench::runEnergyRefresh(int) {
+    EnergyData data;
+    data.balance = -1500.0f + (float)((synthetic_step * 37) % 3000);
+    data.solar = 1000.0f + (float)((synthetic_step * 13) % 3000);
+    data.used = 300.0f + (float)((synthetic_step * 7) % 5000);
+    data.vrms = 230.0f + (float)(synthetic_step % 20);
+    data.tariff = 2;
+    data.valid = true;
+    fillChannels(data);
+    PeakData peaks;
+    peaks.daily_export_peak = -3500.0f;
+    peaks.daily_import_peak = 7200.0f;
+    synthetic_step++;
+    
+    const FlushStats& flush = DisplayFlush::getStats();
+    flush_us_before = flush.busy_us;
+    flush_pixels_before = flush.pixels_sent;
+    if (!EnergyUI::refresh(data, peaks)) {
+        lv_obj_clean(lv_scr_act());
+        EnergyUI::updateScreen(data, peaks);
+    }
+    lv_refr_now(NULL);
+}
+
+// One new history column on a built energy screen (what a closed bucket costs)
+void UIBench::runHistoryColumn(int) {
+    if (!HistoryRing::getObj()) {
+        runEnergyRefresh(0);
+    }
+    synthetic_step++;
+    
+    const FlushStats& flush = DisplayFlush::getStats();
+    flush_us_before = flush.busy_us;
+    flush_pixels_before = flush.pixels_sent;
+    HistoryRing::invalidateColumn(synthetic_step % EnergyHistory::BUCKETS);
+    lv_refr_now(NULL);
+}
+
+void UIBench::runTimerHandler(int) {
+    // Per-loop LVGL overhead with nothing to redraw
+    lv_timer_handler();
+}
+
+void UIBench::runHapticProbe(int) {
+    HapticFeedback::probe();
+}
+
+void UIBench::flushAux(uint32_t& us, uint32_t& count) {
+    const FlushStats& flush = DisplayFlush::getStats();
+    us = flush.busy_us - flush_us_before;
+    count = flush.pixels_sent - flush_pixels_before;
+}
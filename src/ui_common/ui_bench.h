@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+#include "data_types.h"
+
+// On-device benchmark, started with the "bench [screen]" MQTT command.
+// Times screen builds + render + flush, the Energy screen with synthetic
+// data, an idle lv_timer_handler() pass, a haptic I2C round trip and the
+// host-comparable DiscBench cases, then publishes one JSON result per case
+// on home/knob/bench.
+class UIBench {
+public:
+    // build_screen clears the active screen and creates the given one
+    static void begin(void (*build_screen)(int screen));
+    
+    // Queue a run of one screen, or all of them (-1)
+    static bool start(int screen);
+    
+    // Run a slice of the benchmark (call from loop)
+    static void update();
+    
+    static bool isRunning();
+    
+    // Get bench completion (the normal screen needs rebuilding)
+    static bool hasFinished();
+
+private:
+    static void (*build_screen)(int);
+    static int requested_screen;
+    static bool pending;
+    static bool running;
+    static bool finished;
+    static uint32_t synthetic_step;
+    static uint32_t flush_us_before;
+    static uint32_t flush_pixels_before;
+    
+    static uint32_t clockMicros();
+    static void publishResult(const char* json);
+    static void configureCases(int screen);
+    
+    static void runScreen(int screen);
+    static void runEnergySynthetic(int);
+    static void runEnergyRefresh(int);
+    static void runHistoryColumn(int);
+    static void runTimerHandler(int);
+    static void runHapticProbe(int);
+    static void flushAux(uint32_t& us, uint32_t& count);
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <lvgl.h>
+
+// UI fonts and icon glyphs.
+//
+// scripts/font_subset.py runs before every firmware build: it scans src/ for
+// the UI_FONT_<size> sizes and UI_ICON_* glyphs actually used, and generates
+// compressed Montserrat subsets with those icons merged in under
+// src/ui_common/fonts/. When it succeeds it defines UI_FONTS_SUBSET and the
+// built-in Montserrat fonts are compiled out (include/lv_conf.h).
+// Without lv_font_conv the build falls back to the built-ins: icons missing
+// from LVGL's symbol set get the nearest symbol or an ASCII stand-in, and
+// non-ASCII text (the degree sign) renders as nothing.
+// test/test_ui_fonts renders every icon and UI string through either set.
+//
+// Emoji are not available in either case - use UI_ICON_* in UI strings.
+
+#ifdef UI_FONTS_SUBSET
+
+LV_FONT_DECLARE(ui_font_10)
+LV_FONT_DECLARE(ui_font_12)
+LV_FONT_DECLARE(ui_font_14)
+LV_FONT_DECLARE(ui_font_16)
+LV_FONT_DECLARE(ui_font_18)
+
+#define UI_FONT_10 (&ui_font_10)
+#define UI_FONT_12 (&ui_font_12)
+#define UI_FONT_14 (&ui_font_14)
+#define UI_FONT_16 (&ui_font_16)
+#define UI_FONT_18 (&ui_font_18)
+
+// Font Awesome 5 codepoints (UTF-8). font_subset.py reads this block to
+// know which glyphs to merge - keep one literal per line.
+#define UI_ICON_BOLT        "\xEF\x83\xA7"  // U+F0E7
+#define UI_ICON_SUN         "\xEF\x86\x85"  // U+F185
+#define UI_ICON_HOME        "\xEF\x80\x95"  // U+F015
+#define UI_ICON_ANTENNA     "\xEF\x9F\x80"  // U+F7C0 satellite-dish
+#define UI_ICON_DOT         "\xEF\x84\x91"  // U+F111 circle
+#define UI_ICON_SETTINGS    "\xEF\x80\x93"  // U+F013
+#define UI_ICON_SLIDERS     "\xEF\x87\x9E"  // U+F1DE
+#define UI_ICON_TARGET      "\xEF\x85\x80"  // U+F140 bullseye
+#define UI_ICON_WEATHER     "\xEF\x9B\x84"  // U+F6C4 cloud-sun
+#define UI_ICON_CLOUD       "\xEF\x83\x82"  // U+F0C2
+#define UI_ICON_RAIN        "\xEF\x9C\xBD"  // U+F73D cloud-rain
+#define UI_ICON_STORM       "\xEF\x9D\xAC"  // U+F76C cloud-bolt
+#define UI_ICON_SNOW        "\xEF\x8B\x9C"  // U+F2DC snowflake
+#define UI_ICON_FOG         "\xEF\x9D\x9F"  // U+F75F smog
+#define UI_ICON_HUMIDITY    "\xEF\x81\x83"  // U+F043 tint
+#define UI_ICON_OK          "\xEF\x80\x8C"  // U+F00C
+#define UI_ICON_FAIL        "\xEF\x80\x8D"  // U+F00D
+#define UI_ICON_SELECTED    "\xEF\x83\x9A"  // U+F0DA caret-right
+
+#else
+
+#define UI_FONT_10 (&lv_font_montserrat_10)
+#define UI_FONT_12 (&lv_font_montserrat_12)
+#define UI_FONT_14 (&lv_font_montserrat_14)
+#define UI_FONT_16 (&lv_font_montserrat_16)
+#define UI_FONT_18 (&lv_font_montserrat_18)
+
+#define UI_ICON_BOLT        LV_SYMBOL_CHARGE
+#define UI_ICON_SUN         "*"
+#define UI_ICON_HOME        LV_SYMBOL_HOME
+#define UI_ICON_ANTENNA     LV_SYMBOL_WIFI
+#define UI_ICON_DOT         LV_SYMBOL_BULLET
+#define UI_ICON_SETTINGS    LV_SYMBOL_SETTINGS
+#define UI_ICON_SLIDERS     LV_SYMBOL_BARS
+#define UI_ICON_TARGET      LV_SYMBOL_GPS
+#define UI_ICON_WEATHER     LV_SYMBOL_IMAGE
+#define UI_ICON_CLOUD       "~"
+#define UI_ICON_RAIN        LV_SYMBOL_TINT
+#define UI_ICON_STORM       LV_SYMBOL_CHARGE
+#define UI_ICON_SNOW        "+"
+#define UI_ICON_FOG         "="
+#define UI_ICON_HUMIDITY    LV_SYMBOL_TINT
+#define UI_ICON_OK          LV_SYMBOL_OK
+#define UI_ICON_FAIL        LV_SYMBOL_CLOSE
+#define UI_ICON_SELECTED    LV_SYMBOL_RIGHT
+
+#endif
+
+// Label recolor markup for the tariff/state dots (needs lv_label_set_recolor)
+#define UI_DOT_GREEN "#00c853 " UI_ICON_DOT "#"
+#define UI_DOT_RED   "#ff1744 " UI_ICON_DOT "#"
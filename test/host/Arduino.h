@@ -0,0 +1,129 @@
+#pragma once
+// Host fake of the Arduino core: only what the suites in test/ use.
+// Time is simulated - it stands still until a test moves it with HostTime.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <string>
+
+struct HostTime {
+    static unsigned long& micros() {
+        static unsigned long now_us = 0;
+        return now_us;
+    }
+    static void advance(unsigned long ms) { micros() += ms * 1000UL; }
+    static void advanceMicros(unsigned long us) { micros() += us; }
+    static void set(unsigned long ms) { micros() = ms * 1000UL; }
+};
+
+inline unsigned long millis() { return HostTime::micros() / 1000UL; }
+inline unsigned long micros() { return HostTime::micros(); }
+inline void delay(unsigned long ms) { HostTime::advance(ms); }
+
+// Pin levels and interrupt types, as the ESP32 GPIO matrix holds them.
+// driver/gpio.h's wakeup calls act on the same pins.
+#define IRAM_ATTR
+#define INPUT 0x01
+#define INPUT_PULLUP 0x05
+#define LOW 0x0
+#define HIGH 0x1
+#define CHANGE 0x03             // Same value as GPIO_INTR_ANYEDGE
+
+struct HostGpio {
+    static const int PINS = 49;
+    struct Pin {
+        int level;
+        int interrupt_type;     // GPIO_INTR_* - 0 is disabled
+        bool wakeup;
+        void (*isr)();
+    };
+    static Pin& pin(int number) {
+        static Pin pins[PINS];
+        return pins[number];
+    }
+    static void reset() {
+        for (int i = 0; i < PINS; i++) pin(i) = Pin();
+    }
+};
+
+inline void pinMode(int pin, int mode) {
+    if (mode == INPUT_PULLUP) HostGpio::pin(pin).level = HIGH;
+}
+inline int digitalRead(int pin) { return HostGpio::pin(pin).level; }
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int pin, void (*isr)(), int mode) {
+    HostGpio::pin(pin).isr = isr;
+    HostGpio::pin(pin).interrupt_type = mode;
+}
+
+typedef uint8_t byte;
+#define HEX 16
+
+// Arduino String on top of std::string
+class String {
+public:
+    String(const char* text = "") : value(text ? text : "") {}
+    String(const std::string& text) : value(text) {}
+    explicit String(char c) : value(1, c) {}
+    explicit String(long number) : value(std::to_string(number)) {}
+    String(uint32_t number, int base) {
+        char text[12];
+        snprintf(text, sizeof(text), base == HEX ? "%x" : "%u", (unsigned)number);
+        value = text;
+    }
+    
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.size(); }
+    char operator[](unsigned int i) const { return value[i]; }
+    
+    String& operator+=(const String& other) { value += other.value; return *this; }
+    String& operator+=(const char* other) { value += other; return *this; }
+    String& operator+=(char c) { value += c; return *this; }
+    
+    bool operator==(const String& other) const { return value == other.value; }
+    bool operator==(const char* other) const { return value == other; }
+    bool operator!=(const String& other) const { return value != other.value; }
+    bool operator!=(const char* other) const { return value != other; }
+    
+    int indexOf(const char* text) const {
+        size_t at = value.find(text);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+    void toLowerCase() {
+        for (size_t i = 0; i < value.size(); i++) value[i] = (char)tolower((unsigned char)value[i]);
+    }
+        long toInt() const { return atol(value.c_str()); }
+    float toFloat() const { return (float)atof(value.c_str()); }
+
+private:
+    std::string value;
+};
+
+inline String operator+(const String& a, const String& b) { String s(a); s += b; return s; }
+
+// Cycle counter runs off the simulated clock at 240 MHz; the heap is a constant
+class HostEsp {
+public:
+    uint32_t getCycleCount() { return (uint32_t)(HostTime::micros() * 240UL); }
+    uint32_t getFreeHeap() { return 200000; }
+    uint64_t getEfuseMac() { return 0x0000AABBCCDDEEFFULL; }
+};
+
+static HostEsp ESP __attribute__((unused));
+
+// Output is dropped - suites assert on state, not on logs
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    int printf(const char*, ...) { return 0; }
+    void print(const char*) {}
+    void println(const char* = "") {}
+    void flush() {}
+};
+
+static HostSerial Serial __attribute__((unused));
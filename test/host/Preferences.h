@@ -0,0 +1,80 @@
+#pragma once
+// Host fake of the ESP32 Preferences (NVS) library: one in-memory store
+// shared by every instance, with a count of writes to check flash wear.
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+class Preferences {
+public:
+    // Writes since the last reset, including ones that stored the same value
+    static uint32_t& writes() {
+        static uint32_t count = 0;
+        return count;
+    }
+    static void reset() {
+        store().clear();
+        writes() = 0;
+    }
+    
+    bool begin(const char* name, bool read_only = false) {
+        space = name;
+        writable = !read_only;
+        return true;
+    }
+    void end() {}
+    
+    bool isKey(const char* key) { return store().count(path(key)) > 0; }
+    bool remove(const char* key) { return writable && store().erase(path(key)) > 0; }
+    
+    String getString(const char* key, const String& default_value = String()) {
+        return isKey(key) ? String(store()[path(key)]) : default_value;
+    }
+    size_t putString(const char* key, const String& value) {
+        return put(key, std::string(value.c_str()));
+    }
+    
+    size_t getBytesLength(const char* key) { return isKey(key) ? store()[path(key)].size() : 0; }
+    size_t getBytes(const char* key, void* out, size_t size) {
+        if (!isKey(key) || store()[path(key)].size() > size) return 0;
+        const std::string& bytes = store()[path(key)];
+        memcpy(out, bytes.data(), bytes.size());
+        return bytes.size();
+    }
+    size_t putBytes(const char* key, const void* data, size_t size) {
+        return put(key, std::string((const char*)data, size));
+    }
+    
+    uint8_t getUChar(const char* key, uint8_t default_value = 0) { return get(key, default_value); }
+    size_t putUChar(const char* key, uint8_t value) { return putValue(key, value); }
+    uint32_t getUInt(const char* key, uint32_t default_value = 0) { return get(key, default_value); }
+    size_t putUInt(const char* key, uint32_t value) { return putValue(key, value); }
+    float getFloat(const char* key, float default_value = 0.0f) { return get(key, default_value); }
+    size_t putFloat(const char* key, float value) { return putValue(key, value); }
+    bool getBool(const char* key, bool default_value = false) { return get(key, default_value); }
+    size_t putBool(const char* key, bool value) { return putValue(key, value); }
+
+private:
+    std::string space;
+    bool writable = false;
+    
+    static std::map<std::string, std::string>& store() {
+        static std::map<std::string, std::string> entries;
+        return entries;
+    }
+    std::string path(const char* key) const { return space + "/" + key; }
+    
+    size_t put(const char* key, const std::string& bytes) {
+        if (!writable) return 0;
+        store()[path(key)] = bytes;
+        writes()++;
+        return bytes.size() ? bytes.size() : 1;
+    }
+    template <typename T> T get(const char* key, T default_value) {
+        T value;
+        return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : default_value;
+    }
+    template <typename T> size_t putValue(const char* key, T value) {
+        return putBytes(key, &value, sizeof(value));
+    }
+};
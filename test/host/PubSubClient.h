@@ -0,0 +1,79 @@
+#pragma once
+// Host fake of the MQTT client: records subscriptions and publishes, and
+// refuses publishes on request. Packets must fit the buffer, as in 2.8.
+#include <WiFi.h>
+#include <string>
+#include <vector>
+
+#define MQTT_MAX_HEADER_SIZE 5
+
+struct HostMqtt {
+    struct Published {
+        std::string topic;
+        std::string payload;
+        bool retained;
+    };
+    struct State {
+        bool connected = false;
+        uint16_t buffer_size = 256;
+        int refuse_next = 0;            // Publishes to refuse before accepting again
+        std::string refuse_topic;       // Always refused
+        std::vector<Published> published;
+        std::vector<std::string> subscribed;
+    };
+    static State& state() {
+        static State s;
+        return s;
+    }
+    static void reset() { state() = State(); }
+};
+
+class PubSubClient {
+public:
+    explicit PubSubClient(WiFiClient&) {}
+    
+    PubSubClient& setServer(const char*, uint16_t) { return *this; }
+    PubSubClient& setCallback(void (*)(char*, uint8_t*, unsigned int)) { return *this; }
+    bool setBufferSize(uint16_t size) {
+        HostMqtt::state().buffer_size = size;
+        return true;
+    }
+    uint16_t getBufferSize() { return HostMqtt::state().buffer_size; }
+    
+    bool connect(const char*, const char*, const char*, const char*, uint8_t, bool, const char*, bool) {
+        HostMqtt::state().connected = true;
+        return true;
+    }
+    bool connected() { return HostMqtt::state().connected; }
+    int state() { return 0; }
+    bool loop() { return true; }
+    
+    bool subscribe(const char* topic, uint8_t = 0) {
+        HostMqtt::state().subscribed.push_back(topic);
+        return true;
+    }
+    bool unsubscribe(const char* topic) {
+        std::vector<std::string>& subscribed = HostMqtt::state().subscribed;
+        for (size_t i = 0; i < subscribed.size(); i++) {
+            if (subscribed[i] == topic) {
+                subscribed.erase(subscribed.begin() + i);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    bool publish(const char* topic, const char* payload, bool retained = false) {
+        HostMqtt::State& s = HostMqtt::state();
+        if (!s.connected || s.refuse_topic == topic ||
+            MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + strlen(payload) > s.buffer_size) {
+            return false;
+        }
+        if (s.refuse_next > 0) {
+            s.refuse_next--;
+            return false;
+        }
+        s.published.push_back({topic, payload, retained});
+        return true;
+    }
+};
@@ -0,0 +1,57 @@
+#pragma once
+// Host fake: records every address window and writes the pixels pushed into
+// it to a framebuffer, so a suite can check what would reach the panel
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class TFT_eSPI {
+public:
+    struct Window {
+        int32_t x, y, w, h;
+    };
+
+    TFT_eSPI(int16_t w = 360, int16_t h = 360) : width(w), height(h), frame((size_t)w * h, 0) {}
+
+    void startWrite() { writing++; }
+    void endWrite() { writing--; }
+
+    void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+        Window window = {x, y, w, h};
+        windows.push_back(window);
+        cursor = 0;
+    }
+
+    // Fills the last window row by row, as the panel's RAM pointer does
+    void pushColors(uint16_t* data, uint32_t len, bool swap = true) {
+        (void)swap;
+        for (uint32_t i = 0; i < len; i++, cursor++) {
+            if (windows.empty() || writing <= 0) {
+                stray++;
+                continue;
+            }
+            const Window& window = windows.back();
+            int32_t x = window.x + (int32_t)(cursor % window.w);
+            int32_t y = window.y + (int32_t)(cursor / window.w);
+            if (y >= window.y + window.h || x < 0 || x >= width || y < 0 || y >= height) {
+                stray++;
+                continue;
+            }
+            frame[(size_t)y * width + x] = data[i];
+        }
+        pushed += len;
+    }
+
+    uint16_t pixel(int32_t x, int32_t y) const { return frame[(size_t)y * width + x]; }
+
+    int16_t width;
+    int16_t height;
+    std::vector<uint16_t> frame;
+    std::vector<Window> windows;
+    uint32_t pushed = 0;
+    uint32_t stray = 0;         // Pixels outside any open window or off the panel
+    int writing = 0;            // startWrite() depth
+
+private:
+    uint32_t cursor = 0;
+};
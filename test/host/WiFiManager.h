@@ -0,0 +1,3 @@
+#pragma once
+// Host fake: the portal type WiFiManagerWrapper holds
+class WiFiManager {};
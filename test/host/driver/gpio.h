@@ -0,0 +1,27 @@
+#pragma once
+// Host fake of the ESP-IDF GPIO wakeup calls, on the pins in HostGpio
+#include <Arduino.h>
+
+typedef int gpio_num_t;
+typedef int esp_err_t;
+
+enum {
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_ANYEDGE = 3,
+    GPIO_INTR_LOW_LEVEL = 4,
+    GPIO_INTR_HIGH_LEVEL = 5
+};
+
+// As on the chip, wakeup replaces the pin's interrupt type with a level
+inline esp_err_t gpio_wakeup_enable(gpio_num_t pin, int intr_type) {
+    HostGpio::pin(pin).interrupt_type = intr_type;
+    HostGpio::pin(pin).wakeup = true;
+    return 0;
+}
+
+// ...and disabling it leaves the interrupt disabled
+inline esp_err_t gpio_wakeup_disable(gpio_num_t pin) {
+    HostGpio::pin(pin).interrupt_type = GPIO_INTR_DISABLE;
+    HostGpio::pin(pin).wakeup = false;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+// Host fake of ESP-IDF light sleep. esp_light_sleep_start() moves HostTime
+// on to the first wake source: a GPIO wake scheduled with HostSleep, or
+// the timer.
+#include <Arduino.h>
+#include "driver/gpio.h"
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+    ESP_SLEEP_WAKEUP_TIMER = 4,
+    ESP_SLEEP_WAKEUP_GPIO = 7
+} esp_sleep_wakeup_cause_t;
+
+struct HostSleep {
+    struct State {
+        bool gpio_enabled;
+        uint64_t timer_us;              // 0 = no timer wake
+        unsigned long gpio_after_ms;    // 0 = no GPIO wake scheduled
+        esp_sleep_wakeup_cause_t cause;
+        uint32_t sleeps;
+        uint64_t armed_pins;            // Wakeup pins at the last sleep
+    };
+    static State& state() {
+        static State s;
+        return s;
+    }
+    static void reset() { state() = State(); }
+    
+    // The next sleep ends with a GPIO wake after ms, unless the timer is sooner
+    static void scheduleGpioWake(unsigned long ms) { state().gpio_after_ms = ms; }
+};
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup() {
+    HostSleep::state().gpio_enabled = true;
+    return 0;
+}
+
+inline esp_err_t esp_sleep_enable_timer_wakeup(uint64_t us) {
+    HostSleep::state().timer_us = us;
+    return 0;
+}
+
+inline esp_err_t esp_light_sleep_start() {
+    HostSleep::State& s = HostSleep::state();
+    s.sleeps++;
+    s.armed_pins = 0;
+    for (int i = 0; i < HostGpio::PINS; i++) {
+        if (HostGpio::pin(i).wakeup) s.armed_pins |= 1ULL << i;
+    }
+    
+    unsigned long timer_ms = (unsigned long)(s.timer_us / 1000);
+    bool gpio = s.gpio_enabled && s.armed_pins && s.gpio_after_ms > 0 &&
+                (s.timer_us == 0 || s.gpio_after_ms < timer_ms);
+    if (gpio) {
+        HostTime::advance(s.gpio_after_ms);
+        s.gpio_after_ms = 0;
+        s.cause = ESP_SLEEP_WAKEUP_GPIO;
+    } else {
+        HostTime::advance(timer_ms);
+        s.cause = ESP_SLEEP_WAKEUP_TIMER;
+    }
+    return 0;
+}
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+    return HostSleep::state().cause;
+}
@@ -0,0 +1,54 @@
+#pragma once
+// Host fake of the SNTP client, standing in for a local NTP server: a test
+// picks the time the server answers with, and HostSntp::now() is the wall
+// clock the client then keeps (running on HostTime).
+#include <Arduino.h>
+#include <sys/time.h>
+#include <time.h>
+#include <string>
+
+struct HostSntp {
+    struct State {
+        void (*callback)(struct timeval*);
+        std::string server;
+        uint32_t starts;                // configTzTime() calls
+        bool answered;
+        time_t answer;
+        unsigned long answer_ms;
+    };
+    static State& state() {
+        static State s;
+        return s;
+    }
+    static void reset() { state() = State(); }
+    
+    // The server answers with utc: the clock is stepped and the client notified
+    static void answer(time_t utc) {
+        State& s = state();
+        s.answered = true;
+        s.answer = utc;
+        s.answer_ms = millis();
+        if (s.callback) {
+            struct timeval tv = {utc, 0};
+            s.callback(&tv);
+        }
+    }
+    
+    // time(nullptr) on the device: near 0 until the first answer
+    static time_t now() {
+        const State& s = state();
+        return s.answered ? s.answer + (time_t)((millis() - s.answer_ms) / 1000) : 0;
+    }
+};
+
+inline void sntp_set_time_sync_notification_cb(void (*callback)(struct timeval*)) {
+    HostSntp::state().callback = callback;
+}
+
+// Declared by Arduino.h on the device
+inline void configTzTime(const char* tz, const char* server1, const char* = nullptr, const char* = nullptr) {
+    HostSntp::state().server = server1;
+    HostSntp::state().starts++;
+    setenv("TZ", tz, 1);
+    tzset();
+}
@@ -0,0 +1,159 @@
+#pragma once
+// Host fake of the LVGL 8.3 API used by the suites in test/. Timers and
+// displays are plain structs the tests inspect; HostLvgl holds the state
+// that LVGL would keep globally.
+#include <Arduino.h>
+#include <vector>
+
+#define LV_MEM_CUSTOM 0
+#define LV_MEM_SIZE (48U * 1024U)
+
+typedef int16_t lv_coord_t;
+typedef struct { lv_coord_t x1, y1, x2, y2; } lv_area_t;
+typedef union { uint16_t full; } lv_color_t;
+
+typedef struct _lv_timer_t {
+    uint32_t period;
+    bool paused;
+} lv_timer_t;
+
+typedef struct _lv_disp_t {
+    uint16_t inv_p;             // Invalidated areas waiting for a refresh
+    lv_timer_t refr_timer;
+} lv_disp_t;
+
+typedef struct _lv_indev_t {
+    lv_timer_t read_timer;
+} lv_indev_t;
+
+typedef struct _lv_disp_drv_t {
+    bool flushing;              // Cleared by lv_disp_flush_ready()
+} lv_disp_drv_t;
+
+#define LV_DISP_DEF_REFR_PERIOD 30
+
+// Only named in headers (ScreenTransition's animation callbacks)
+typedef struct _lv_anim_t lv_anim_t;
+typedef void (*lv_anim_exec_xcb_t)(void*, int32_t);
+typedef void (*lv_anim_ready_cb_t)(lv_anim_t*);
+
+// Objects hold a share of the LVGL pool until deleted; the pool is a plain
+// counter, so only leaks show up, not fragmentation
+typedef struct _lv_obj_t {
+    struct _lv_obj_t* parent;
+    std::vector<struct _lv_obj_t*> children;
+    uint32_t size;
+} lv_obj_t;
+
+typedef struct {
+    uint32_t total_size;
+    uint32_t free_cnt;
+    uint32_t free_size;
+    uint32_t free_biggest_size;
+    uint32_t used_cnt;
+    uint32_t max_used;
+    uint8_t used_pct;
+    uint8_t frag_pct;
+} lv_mem_monitor_t;
+
+struct HostLvgl {
+    static uint16_t& runningAnimations() {
+        static uint16_t count = 0;
+        return count;
+    }
+    // Called for every lv_timer_handler() pass
+    static void (*&timerHandler())() {
+        static void (*handler)() = nullptr;
+        return handler;
+    }
+
+    struct Pool {
+        uint32_t used = 0;
+        uint32_t blocks = 0;
+        uint32_t max_used = 0;
+    };
+    static Pool& pool() {
+        static Pool p;
+        return p;
+    }
+    static void charge(uint32_t size) {
+        pool().used += size;
+        pool().blocks++;
+        if (pool().used > pool().max_used) pool().max_used = pool().used;
+    }
+    static void release(uint32_t size) {
+        pool().used -= size;
+        pool().blocks--;
+    }
+
+    // Bytes charged for one object - about what a label costs on the knob
+    static const uint32_t OBJ_SIZE = 96;
+    static lv_obj_t& screen() {
+        static lv_obj_t active = {nullptr, std::vector<lv_obj_t*>(), 0};
+        return active;
+    }
+};
+
+inline lv_obj_t* lv_scr_act() { return &HostLvgl::screen(); }
+
+inline lv_obj_t* lv_obj_create(lv_obj_t* parent) {
+    HostLvgl::charge(HostLvgl::OBJ_SIZE);
+    lv_obj_t* obj = new lv_obj_t();
+    obj->parent = parent;
+    obj->size = HostLvgl::OBJ_SIZE;
+    if (parent) parent->children.push_back(obj);
+    return obj;
+}
+
+inline lv_obj_t* lv_label_create(lv_obj_t* parent) { return lv_obj_create(parent); }
+
+inline void lv_obj_clean(lv_obj_t* obj) {
+    for (size_t i = 0; i < obj->children.size(); i++) {
+        lv_obj_t* child = obj->children[i];
+        lv_obj_clean(child);
+        HostLvgl::release(child->size);
+        delete child;
+    }
+    obj->children.clear();
+}
+
+inline void lv_obj_del(lv_obj_t* obj) {
+    lv_obj_clean(obj);
+    if (obj->parent) {
+        std::vector<lv_obj_t*>& siblings = obj->parent->children;
+        for (size_t i = 0; i < siblings.size(); i++) {
+            if (siblings[i] == obj) {
+                siblings.erase(siblings.begin() + i);
+                break;
+            }
+        }
+    }
+    HostLvgl::release(obj->size);
+    delete obj;
+}
+
+inline void lv_mem_monitor(lv_mem_monitor_t* mon) {
+    const HostLvgl::Pool& pool = HostLvgl::pool();
+    mon->total_size = LV_MEM_SIZE;
+    mon->free_cnt = 1;
+    mon->free_size = LV_MEM_SIZE - pool.used;
+    mon->free_biggest_size = mon->free_size;
+    mon->used_cnt = pool.blocks;
+    mon->max_used = pool.max_used;
+    mon->used_pct = (uint8_t)(pool.used * 100 / LV_MEM_SIZE);
+    mon->frag_pct = 0;
+}
+
+inline lv_timer_t* _lv_disp_get_refr_timer(lv_disp_t* disp) { return &disp->refr_timer; }
+inline lv_timer_t* lv_indev_get_read_timer(lv_indev_t* indev) { return &indev->read_timer; }
+inline void lv_timer_set_period(lv_timer_t* timer, uint32_t period) { timer->period = period; }
+inline void lv_timer_pause(lv_timer_t* timer) { timer->paused = true; }
+inline void lv_timer_resume(lv_timer_t* timer) { timer->paused = false; }
+inline uint16_t lv_anim_count_running() { return HostLvgl::runningAnimations(); }
+
+inline void lv_disp_flush_ready(lv_disp_drv_t* drv) { drv->flushing = false; }
+
+inline uint32_t lv_timer_handler() {
+    if (HostLvgl::timerHandler()) HostLvgl::timerHandler()();
+    return 1;
+}
@@ -0,0 +1,281 @@
+// CommandInterpreter under random and mutated payloads: the tokenizer
+// against a reference split, and execute() replies that stay well formed.
+// Payloads are copied to exact-size heap buffers, so the sanitizer build
+// catches any read past the length. The handlers build as on the knob; the
+// hardware they drive is faked below.
+#include <unity.h>
+#include <vector>
+#include "../../src/core/network/command_interpreter.cpp"
+#include "../../src/core/network/energy_frame.cpp"
+#include "../../src/core/network/time_sync.cpp"
+#include "../../src/core/network/trace_replay.cpp"
+#include "../../src/features/energy/energy_data.cpp"
+#include "../../src/features/energy/energy_channels.cpp"
+#include "../../src/features/energy/energy_history.cpp"
+#include "../../src/features/energy/energy_integrator.cpp"
+#include "../../src/features/energy/feed_freshness.cpp"
+#include "../../src/features/energy/mock_scenario.cpp"
+#include "../../src/features/energy/peak_reset_scheduler.cpp"
+#include "../../src/features/energy/power_filter.cpp"
+#include "../../src/core/system/telemetry_kernels.cpp"
+#include "../../src/core/system/telemetry_store.cpp"
+#include "../../src/core/system/timer_wheel.cpp"
+
+void HapticFeedback::peakReached() {}
+void HapticFeedback::setEnabled(bool) {}
+void PowerManager::setActiveBrightness(uint8_t) {}
+PowerState PowerManager::getState() { return POWER_ACTIVE; }
+const char* PowerManager::getStateName(PowerState) { return "active"; }
+void MemoryMonitor::sample(MemorySample&) {}
+bool MemoryMonitor::isLeakSuspected() { return false; }
+uint32_t RefreshGovernor::getRefreshPeriod() { return 30; }
+uint8_t MQTTManager::getQueueDepth() { return 0; }
+void MQTTManager::injectMessage(char*, byte*, unsigned int) {}
+void MQTTManager::resetChannels() { EnergyData_Manager::resetChannels(); }
+
+static std::string response;
+
+bool MQTTManager::publish(const char* topic, const char* payload, bool, bool) {
+    if (strcmp(topic, "home/knob/response") == 0) {
+        response = payload;
+    }
+    return true;
+}
+
+static int screen_shown = -1;
+static void showScreen(int screen) { screen_shown = screen; }
+static bool runBench(int) { return true; }
+
+// Deterministic, so a failure replays the same inputs
+static uint32_t seed;
+static uint32_t nextRandom() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static const char* SEEDS[] = {
+    "help", "stats", "mem", "reset_peaks", "bench", "bench weather",
+    "brightness 50", "channels reset", "haptic on", "mock off", "screen 2", "screen house",
+    "replay max", "set peak_reset 00:00", "set timezone GMT0BST,M3.5.0/1,M10.5.0",
+    "set ntp_server pool.ntp.org", "set export_price 0.15", "set import_price 0.2450",
+};
+static const int SEED_COUNT = sizeof(SEEDS) / sizeof(SEEDS[0]);
+
+// Bytes weighted towards what commands are made of
+static uint8_t randomByte() {
+    uint32_t r = nextRandom();
+    switch (r % 8) {
+        case 0: return ' ';
+        case 1: return "\t\r\n"[(r >> 3) % 3];
+        case 2: return (uint8_t)(r >> 3);                  // Anything, incl. NUL and 0x80+
+        default: return (uint8_t)(0x21 + (r >> 3) % 94);   // Printable
+    }
+}
+
+static std::vector<uint8_t> randomPayload() {
+    std::vector<uint8_t> payload(nextRandom() % 150);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = randomByte();
+    }
+    return payload;
+}
+
+static std::vector<uint8_t> mutatedPayload() {
+    const char* text = SEEDS[nextRandom() % SEED_COUNT];
+    std::vector<uint8_t> payload(text, text + strlen(text));
+    int edits = 1 + nextRandom() % 3;
+    for (int e = 0; e < edits; e++) {
+        size_t at = payload.empty() ? 0 : nextRandom() % payload.size();
+        switch (nextRandom() % 5) {
+            case 0: if (!payload.empty()) payload[at] = randomByte(); break;
+            case 1: payload.insert(payload.begin() + at, randomByte()); break;
+            case 2: if (!payload.empty()) payload.erase(payload.begin() + at); break;
+            case 3: payload.resize(at); break;
+            default: {
+                // Splice in another seed - extra tokens and odd verbs
+                const char* other = SEEDS[nextRandom() % SEED_COUNT];
+                payload.insert(payload.begin() + at, other, other + strlen(other));
+                break;
+            }
+        }
+    }
+    return payload;
+}
+
+// Exact-size copy, so reading one byte past the end is a sanitizer error
+struct ExactBuffer {
+    uint8_t* data;
+    unsigned int length;
+
+    explicit ExactBuffer(const std::vector<uint8_t>& bytes) : length((unsigned int)bytes.size()) {
+        data = new uint8_t[length ? length : 1];
+        if (length) memcpy(data, &bytes[0], length);
+    }
+    ~ExactBuffer() { delete[] data; }
+};
+
+static bool isSpace(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// The tokenizer's contract, written the obvious way
+static int referenceTokenize(const std::vector<uint8_t>& payload, std::vector<std::string>& tokens) {
+    if (payload.size() > CommandInterpreter::MAX_COMMAND_LENGTH) return -1;
+    std::string current;
+    for (size_t i = 0; i <= payload.size(); i++) {
+        if (i == payload.size() || isSpace(payload[i])) {
+            if (!current.empty()) tokens.push_back(current);
+            current.clear();
+        } else if (payload[i] < 0x21 || payload[i] > 0x7E) {
+            return -1;
+        } else {
+            current += (char)payload[i];
+        }
+    }
+    return (int)tokens.size() > CommandInterpreter::MAX_TOKENS ? -1 : (int)tokens.size();
+}
+
+static void checkTokenize(const std::vector<uint8_t>& payload) {
+    ExactBuffer buffer(payload);
+    CommandToken tokens[CommandInterpreter::MAX_TOKENS];
+    int count = CommandInterpreter::tokenize(buffer.data, buffer.length, tokens, CommandInterpreter::MAX_TOKENS);
+
+    std::vector<std::string> expected;
+    TEST_ASSERT_EQUAL(referenceTokenize(payload, expected), count);
+    for (int i = 0; i < count; i++) {
+        // Views into the payload, not copies
+        TEST_ASSERT_TRUE(tokens[i].data >= (const char*)buffer.data);
+        TEST_ASSERT_TRUE(tokens[i].data + tokens[i].length <= (const char*)buffer.data + buffer.length);
+        TEST_ASSERT_EQUAL(expected[i].size(), tokens[i].length);
+        TEST_ASSERT_EQUAL_MEMORY(expected[i].data(), tokens[i].data, tokens[i].length);
+    }
+}
+
+// {"cmd":"<verb>","ok":true|false,"result":<value>} - printable, quotes paired
+static void checkResponse(bool ok) {
+    const char* prefix = "{\"cmd\":\"";
+    TEST_ASSERT_EQUAL_MEMORY(prefix, response.c_str(), strlen(prefix));
+    TEST_ASSERT_EQUAL('}', response[response.size() - 1]);
+    TEST_ASSERT_NOT_NULL(strstr(response.c_str(), ok ? "\",\"ok\":true,\"result\":" : "\",\"ok\":false,\"result\":"));
+    int quotes = 0;
+    for (size_t i = 0; i < response.size(); i++) {
+        TEST_ASSERT_TRUE(response[i] >= 0x20 && response[i] < 0x7F);
+        if (response[i] == '"') quotes++;
+        if (response[i] == '\\') TEST_FAIL_MESSAGE("reply needs escaping");
+    }
+    TEST_ASSERT_EQUAL(0, quotes % 2);
+}
+
+static void checkExecute(const std::vector<uint8_t>& payload) {
+    CommandStats before = CommandInterpreter::getStats();
+    ExactBuffer buffer(payload);
+    CommandReply reply;
+    bool ok = CommandInterpreter::execute(buffer.data, buffer.length, reply);
+
+    TEST_ASSERT_EQUAL(ok, reply.ok);
+    TEST_ASSERT_NOT_NULL(memchr(reply.result, '\0', CommandReply::MAX_RESULT));
+    const CommandStats& after = CommandInterpreter::getStats();
+    TEST_ASSERT_EQUAL(1, (int)(after.received - before.received));
+    TEST_ASSERT_EQUAL(1, (int)((after.executed - before.executed) + (after.rejected - before.rejected)));
+
+    // And the published form of the same command, from the same state
+    TraceReplay::stop();
+    response.clear();
+    CommandInterpreter::execute(buffer.data, buffer.length);
+    checkResponse(ok);
+    TraceReplay::stop();
+}
+
+void setUp() {
+    HostTime::set(1000);
+    Preferences::reset();
+    EnergyData_Manager::begin();
+    CommandInterpreter::setScreenHandler(showScreen);
+    CommandInterpreter::setBenchHandler(runBench);
+    seed = 20240601;
+    screen_shown = -1;
+}
+
+void tearDown() {
+    TraceReplay::stop();
+}
+
+static std::vector<uint8_t> bytes(const char* text) {
+    return std::vector<uint8_t>(text, text + strlen(text));
+}
+
+static bool run(const char* text) {
+    std::vector<uint8_t> payload = bytes(text);
+    ExactBuffer buffer(payload);
+    CommandReply reply;
+    return CommandInterpreter::execute(buffer.data, buffer.length, reply);
+}
+
+static void test_tokenize_edges() {
+    checkTokenize(bytes(""));
+    checkTokenize(bytes(" \t\r\n"));
+    checkTokenize(bytes("set  timezone\tCET-1,M3.5.0\r\n"));
+    checkTokenize(bytes("a b c d"));
+    checkTokenize(bytes("a b c d e"));                  // One token too many
+    checkTokenize(bytes("screen\x7f" "2"));             // DEL
+    checkTokenize(bytes("screen \xc3\xa9"));            // UTF-8
+
+    std::vector<uint8_t> longest(CommandInterpreter::MAX_COMMAND_LENGTH, 'x');
+    checkTokenize(longest);
+    longest.push_back('x');
+    checkTokenize(longest);
+
+    std::vector<uint8_t> with_nul = bytes("mock on");
+    with_nul[4] = '\0';
+    checkTokenize(with_nul);
+}
+
+static void test_tokenize_matches_reference_on_random_payloads() {
+    for (int i = 0; i < 50000; i++) {
+        checkTokenize(randomPayload());
+    }
+}
+
+static void test_every_seed_command_succeeds() {
+    for (int i = 0; i < SEED_COUNT; i++) {
+        if (!run(SEEDS[i])) TEST_FAIL_MESSAGE(SEEDS[i]);
+    }
+    TEST_ASSERT_EQUAL(SCREEN_HOUSE_INFO, screen_shown);
+}
+
+static void test_verbs_must_match_whole() {
+    TEST_ASSERT_FALSE(run("hel"));
+    TEST_ASSERT_FALSE(run("helpx"));
+    TEST_ASSERT_FALSE(run("HELP"));
+    TEST_ASSERT_FALSE(run("set peak"));
+    TEST_ASSERT_FALSE(run("set peak_resetx 00:00"));
+    TEST_ASSERT_FALSE(run("screen 4"));
+    TEST_ASSERT_FALSE(run("channels resets"));
+    TEST_ASSERT_FALSE(run("brightness 1000001"));
+    TEST_ASSERT_FALSE(run("set export_price nan"));
+}
+
+static void test_random_payloads_get_well_formed_replies() {
+    for (int i = 0; i < 20000; i++) {
+        checkExecute(randomPayload());
+    }
+}
+
+static void test_mutated_commands_get_well_formed_replies() {
+    for (int i = 0; i < 20000; i++) {
+        std::vector<uint8_t> payload = mutatedPayload();
+        checkTokenize(payload);
+        checkExecute(payload);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tokenize_edges);
+    RUN_TEST(test_tokenize_matches_reference_on_random_payloads);
+    RUN_TEST(test_every_seed_command_succeeds);
+    RUN_TEST(test_verbs_must_match_whole);
+    RUN_TEST(test_random_payloads_get_well_formed_replies);
+    RUN_TEST(test_mutated_commands_get_well_formed_replies);
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+// Visible disc spans used by DisplayFlush: the compile-time table against
+// the runtime rowSpan() and a floating point reference - and DisplayFlush
+// itself, pushing areas to the recording TFT_eSPI in test/host.
+#include <unity.h>
+#include <math.h>
+#include "../../src/core/hardware/display_flush.cpp"
+
+static constexpr DiscSpanTable spans = buildDiscSpanTable(MakeRowList<DiscGeometry::HEIGHT>::type());
+
+// A running transition's revealed disc, or -1 for none
+static int16_t transition_radius = -1;
+static uint32_t transition_sent = 0;
+static uint32_t transition_skipped = 0;
+
+void PowerManager::notifyFrame() {}
+void TraceReplay::notifyFrame() {}
+bool ScreenTransition::isClipping() { return transition_radius >= 0; }
+bool ScreenTransition::getRowSpan(int16_t y, int16_t& x1, int16_t& x2) {
+    return DiscGeometry::rowSpan(y, transition_radius, x1, x2);
+}
+void ScreenTransition::recordFlush(uint32_t pixels_sent, uint32_t pixels_skipped, uint32_t) {
+    transition_sent += pixels_sent;
+    transition_skipped += pixels_skipped;
+}
+
+static TFT_eSPI tft;
+static lv_color_t pixels[DiscGeometry::WIDTH * DiscGeometry::HEIGHT];
+static lv_disp_drv_t disp;
+
+void setUp() {
+    tft = TFT_eSPI();
+    DisplayFlush::begin(&tft);
+    transition_radius = -1;
+    transition_sent = 0;
+    transition_skipped = 0;
+}
+
+void tearDown() {}
+
+// Never 0, so an unwritten panel pixel can't pass for a sent one
+static uint16_t colorAt(int x, int y) {
+    return (uint16_t)(1 + x * 181 + y * 7);
+}
+
+// Renders the area as LVGL would (row-major, area-sized) and flushes it
+static void flush(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    lv_area_t area = {x1, y1, x2, y2};
+    int w = x2 - x1 + 1;
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            pixels[(y - y1) * w + (x - x1)].full = colorAt(x, y);
+        }
+    }
+    disp.flushing = true;
+    DisplayFlush::flush(&disp, &area, pixels);
+    TEST_ASSERT_FALSE(disp.flushing);
+    TEST_ASSERT_EQUAL(0, tft.writing);
+    TEST_ASSERT_EQUAL_UINT32(0, tft.stray);
+}
+
+// Row y of the area as it should reach the panel: the disc (and transition)
+// span clipped to the area
+static bool expectedSpan(int16_t y, const lv_area_t& area, int16_t& x1, int16_t& x2) {
+    if (!DiscGeometry::rowSpan(y, DiscGeometry::RADIUS, x1, x2)) return false;
+    int16_t tx1, tx2;
+    if (transition_radius >= 0) {
+        if (!DiscGeometry::rowSpan(y, transition_radius, tx1, tx2)) return false;
+        if (tx1 > x1) x1 = tx1;
+        if (tx2 < x2) x2 = tx2;
+    }
+    if (x1 < area.x1) x1 = area.x1;
+    if (x2 > area.x2) x2 = area.x2;
+    return y >= area.y1 && y <= area.y2 && x1 <= x2;
+}
+
+// Every panel pixel: the rendered colour where visible, untouched elsewhere.
+// Returns the pixels that should have been sent.
+static uint32_t checkPanel(const lv_area_t& area) {
+    uint32_t visible = 0;
+    for (int16_t y = 0; y < DiscGeometry::HEIGHT; y++) {
+        int16_t x1 = 0, x2 = -1;
+        if (!expectedSpan(y, area, x1, x2)) x2 = -1;
+        for (int16_t x = 0; x < DiscGeometry::WIDTH; x++) {
+            bool shown = x >= x1 && x <= x2;
+            TEST_ASSERT_EQUAL_UINT16(shown ? colorAt(x, y) : 0, tft.pixel(x, y));
+            if (shown) visible++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(visible, tft.pushed);
+    TEST_ASSERT_EQUAL_UINT32(visible, DisplayFlush::getStats().pixels_sent);
+    TEST_ASSERT_EQUAL_UINT32(tft.windows.size(), DisplayFlush::getStats().address_windows);
+    return visible;
+}
+
+// Rows whose span fills the area's width share one window; every other
+// visible row gets a window of its own, exactly its span
+static void checkWindows(const lv_area_t& area) {
+    size_t next = 0;
+    for (int16_t y = area.y1; y <= area.y2; y++) {
+        int16_t x1, x2;
+        if (!expectedSpan(y, area, x1, x2)) continue;
+        TEST_ASSERT_TRUE(next < tft.windows.size());
+        const TFT_eSPI::Window& window = tft.windows[next++];
+        TEST_ASSERT_EQUAL_INT32(y, window.y);
+        TEST_ASSERT_EQUAL_INT32(x1, window.x);
+        TEST_ASSERT_EQUAL_INT32(x2 - x1 + 1, window.w);
+        if (x1 == area.x1 && x2 == area.x2) {
+            for (int16_t row = y + 1; row < y + window.h; row++) {
+                int16_t r1, r2;
+                TEST_ASSERT_TRUE(expectedSpan(row, area, r1, r2));
+                TEST_ASSERT_TRUE(r1 == area.x1 && r2 == area.x2);
+            }
+            y += window.h - 1;
+        } else {
+            TEST_ASSERT_EQUAL_INT32(1, window.h);
+        }
+    }
+    TEST_ASSERT_EQUAL(next, tft.windows.size());
+}
+
+static void test_full_screen_sends_101780_pixels() {
+    uint32_t total = 0;
+    for (int y = 0; y < DiscGeometry::HEIGHT; y++) {
+        total += DiscGeometry::WIDTH - 2 * spans.start[y];
+    }
+    TEST_ASSERT_EQUAL_UINT32(101780, total);
+}
+
+static void test_table_matches_row_span() {
+    for (int16_t y = 0; y < DiscGeometry::HEIGHT; y++) {
+        int16_t x1, x2;
+        TEST_ASSERT_TRUE(DiscGeometry::rowSpan(y, DiscGeometry::RADIUS, x1, x2));
+        TEST_ASSERT_EQUAL_INT(x1, spans.start[y]);
+        TEST_ASSERT_EQUAL_INT(x2, DiscGeometry::WIDTH - 1 - spans.start[y]);
+    }
+}
+
+// A pixel is visible when its centre lies within the radius
+static void test_spans_hold_exactly_the_pixels_inside_the_circle() {
+    const double r = DiscGeometry::RADIUS;
+    for (int y = 0; y < DiscGeometry::HEIGHT; y++) {
+        double dy = y + 0.5 - DiscGeometry::CENTER_Y;
+        int start = spans.start[y];
+        int end = DiscGeometry::WIDTH - 1 - start;
+        for (int x = 0; x < DiscGeometry::WIDTH; x++) {
+            double dx = x + 0.5 - DiscGeometry::CENTER_X;
+            bool inside = dx * dx + dy * dy <= r * r;
+            TEST_ASSERT_EQUAL(inside, x >= start && x <= end);
+        }
+    }
+}
+
+static void test_known_rows() {
+    TEST_ASSERT_EQUAL_INT(167, spans.start[0]);                              // 26 pixels
+    TEST_ASSERT_EQUAL_INT(0, spans.start[DiscGeometry::CENTER_Y]);
+    TEST_ASSERT_EQUAL_INT(0, spans.start[DiscGeometry::CENTER_Y - 1]);
+    for (int y = 0; y < DiscGeometry::HEIGHT / 2; y++) {
+        TEST_ASSERT_EQUAL_INT(spans.start[y], spans.start[DiscGeometry::HEIGHT - 1 - y]);
+        TEST_ASSERT_TRUE(spans.start[y + 1] <= spans.start[y]);
+    }
+}
+
+static void test_flush_full_screen() {
+    flush(0, 0, DiscGeometry::WIDTH - 1, DiscGeometry::HEIGHT - 1);
+    lv_area_t area = {0, 0, DiscGeometry::WIDTH - 1, DiscGeometry::HEIGHT - 1};
+    TEST_ASSERT_EQUAL_UINT32(101780, checkPanel(area));
+    checkWindows(area);
+
+    // The full-width rows round the centre go in one window
+    int full_rows = 0;
+    for (int y = 0; y < DiscGeometry::HEIGHT; y++) {
+        if (spans.start[y] == 0) full_rows++;
+    }
+    TEST_ASSERT_TRUE(full_rows > 1);
+    TEST_ASSERT_EQUAL(DiscGeometry::HEIGHT - full_rows + 1, (int)tft.windows.size());
+    TEST_ASSERT_EQUAL_UINT32(1, DisplayFlush::getStats().flushes);
+    TEST_ASSERT_EQUAL_UINT32(DiscGeometry::WIDTH * DiscGeometry::HEIGHT, DisplayFlush::getStats().pixels_rendered);
+}
+
+static void test_flush_partial_areas() {
+    // Straddles the edge of the disc: trimmed rows above, a batch below
+    lv_area_t edge = {20, 60, 119, 219};
+    flush(edge.x1, edge.y1, edge.x2, edge.y2);
+    checkPanel(edge);
+    checkWindows(edge);
+    TEST_ASSERT_TRUE(tft.windows.back().h > 1);
+    TEST_ASSERT_TRUE(tft.windows.front().h == 1);
+
+    // Wholly inside: the area is one window, whatever the row spans are
+    setUp();
+    lv_area_t inside = {150, 150, 209, 179};
+    flush(inside.x1, inside.y1, inside.x2, inside.y2);
+    TEST_ASSERT_EQUAL_UINT32(60 * 30, checkPanel(inside));
+    TEST_ASSERT_EQUAL(1, (int)tft.windows.size());
+
+    // A corner off the disc sends nothing, but still completes the flush
+    setUp();
+    lv_area_t corner = {0, 0, 29, 29};
+    flush(corner.x1, corner.y1, corner.x2, corner.y2);
+    TEST_ASSERT_EQUAL_UINT32(0, checkPanel(corner));
+    TEST_ASSERT_EQUAL(0, (int)tft.windows.size());
+    TEST_ASSERT_EQUAL_UINT32(900, DisplayFlush::getStats().pixels_rendered);
+}
+
+static void test_flush_clips_to_the_transition() {
+    // A circular wipe a third of the way out: no row fills the screen
+    transition_radius = 60;
+    lv_area_t area = {0, 0, DiscGeometry::WIDTH - 1, DiscGeometry::HEIGHT - 1};
+    flush(area.x1, area.y1, area.x2, area.y2);
+    uint32_t sent = checkPanel(area);
+    checkWindows(area);
+    TEST_ASSERT_EQUAL(2 * transition_radius, (int)tft.windows.size());
+    TEST_ASSERT_EQUAL_UINT32(sent, transition_sent);
+    TEST_ASSERT_EQUAL_UINT32(DiscGeometry::WIDTH * DiscGeometry::HEIGHT - sent, transition_skipped);
+
+    // Within the revealed disc, an area is batched as usual
+    setUp();
+    transition_radius = 60;
+    lv_area_t inside = {160, 160, 199, 199};
+    flush(inside.x1, inside.y1, inside.x2, inside.y2);
+    TEST_ASSERT_EQUAL_UINT32(40 * 40, checkPanel(inside));
+    TEST_ASSERT_EQUAL(1, (int)tft.windows.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_screen_sends_101780_pixels);
+    RUN_TEST(test_table_matches_row_span);
+    RUN_TEST(test_spans_hold_exactly_the_pixels_inside_the_circle);
+    RUN_TEST(test_known_rows);
+    RUN_TEST(test_flush_full_screen);
+    RUN_TEST(test_flush_partial_areas);
+    RUN_TEST(test_flush_clips_to_the_transition);
+    return UNITY_END();
+}
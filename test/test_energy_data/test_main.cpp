@@ -0,0 +1,198 @@
+// EnergyData_Manager on a simulated clock: combined frames against the
+// per-feed filters, and the published snapshot read from another thread.
+// The energy sources build as on the knob; the hardware and UI they report
+// to are faked below.
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "../../src/features/energy/energy_data.cpp"
+#include "../../src/features/energy/energy_channels.cpp"
+#include "../../src/features/energy/energy_history.cpp"
+#include "../../src/features/energy/energy_integrator.cpp"
+#include "../../src/features/energy/feed_freshness.cpp"
+#include "../../src/features/energy/mock_scenario.cpp"
+#include "../../src/features/energy/peak_reset_scheduler.cpp"
+#include "../../src/features/energy/power_filter.cpp"
+#include "../../src/core/network/command_interpreter.cpp"
+#include "../../src/core/network/energy_frame.cpp"
+#include "../../src/core/network/time_sync.cpp"
+#include "../../src/core/network/trace_replay.cpp"
+#include "../../src/core/system/telemetry_kernels.cpp"
+#include "../../src/core/system/telemetry_store.cpp"
+#include "../../src/core/system/timer_wheel.cpp"
+
+// Reached through the command interpreter, which channel parsing shares
+void HapticFeedback::peakReached() {}
+void HapticFeedback::setEnabled(bool) {}
+void PowerManager::setActiveBrightness(uint8_t) {}
+PowerState PowerManager::getState() { return POWER_ACTIVE; }
+const char* PowerManager::getStateName(PowerState) { return "active"; }
+void MemoryMonitor::sample(MemorySample&) {}
+bool MemoryMonitor::isLeakSuspected() { return false; }
+uint32_t RefreshGovernor::getRefreshPeriod() { return 30; }
+uint8_t MQTTManager::getQueueDepth() { return 0; }
+bool MQTTManager::publish(const char*, const char*, bool, bool) { return true; }
+void MQTTManager::injectMessage(char*, byte*, unsigned int) {}
+void MQTTManager::resetChannels() { EnergyData_Manager::resetChannels(); }
+
+void setUp() {
+    HostTime::set(1000);
+    Preferences::reset();
+    EnergyData_Manager::begin();
+}
+
+void tearDown() {}
+
+// Power feeds without smoothing, so the displayed values are the inputs
+static void holdBackOnly() {
+    FilterConfig config;
+    config.mode = FILTER_NONE;
+    config.glitch_threshold = 6000.0f;
+    config.glitch_confirm = 2;
+    config.decimate_ms = 250;
+    EnergyData_Manager::configureFilter(FEED_BALANCE, config);
+    EnergyData_Manager::configureFilter(FEED_SOLAR, config);
+    EnergyData_Manager::configureFilter(FEED_USED, config);
+}
+
+static EnergyFrame frame(float balance, float solar, float used, float vrms) {
+    EnergyFrame f;
+    f.fields = ENERGY_FRAME_BALANCE | ENERGY_FRAME_SOLAR | ENERGY_FRAME_USED | ENERGY_FRAME_VRMS;
+    f.balance = balance;
+    f.solar = solar;
+    f.used = used;
+    f.vrms = vrms;
+    return f;
+}
+
+static void assertShows(float balance, float solar, float used) {
+    EnergySnapshot snapshot = EnergyData_Manager::getSnapshot();
+    TEST_ASSERT_EQUAL_FLOAT(balance, snapshot.data.balance);
+    TEST_ASSERT_EQUAL_FLOAT(solar, snapshot.data.solar);
+    TEST_ASSERT_EQUAL_FLOAT(used, snapshot.data.used);
+}
+
+static void test_frame_is_published_as_a_unit() {
+    holdBackOnly();
+    EnergyData_Manager::applyFrame(frame(500.0f, 1000.0f, 1500.0f, 240.0f));
+    assertShows(500.0f, 1000.0f, 1500.0f);
+
+    // 100ms later, inside the decimation interval, and balance and used
+    // jump by more than the glitch threshold - a kettle, in one frame
+    HostTime::advance(100);
+    uint32_t generation = EnergyData_Manager::getGeneration();
+    EnergyData_Manager::applyFrame(frame(7500.0f, 1000.0f, 8500.0f, 241.0f));
+    assertShows(7500.0f, 1000.0f, 8500.0f);
+    TEST_ASSERT_EQUAL(generation + 1, EnergyData_Manager::getGeneration());
+}
+
+static void test_separate_feeds_are_still_held_back() {
+    holdBackOnly();
+    EnergyData_Manager::updateBalance(500.0f);
+    HostTime::advance(100);
+    EnergyData_Manager::updateBalance(600.0f);      // Decimated
+    assertShows(500.0f, 0.0f, 0.0f);
+    HostTime::advance(200);
+    EnergyData_Manager::update();
+    assertShows(600.0f, 0.0f, 0.0f);
+
+    HostTime::advance(300);
+    EnergyData_Manager::updateBalance(7000.0f);     // Lone jump - a glitch
+    HostTime::advance(300);
+    EnergyData_Manager::update();
+    assertShows(600.0f, 0.0f, 0.0f);
+}
+
+static void test_frame_supersedes_held_samples() {
+    holdBackOnly();
+    EnergyData_Manager::updateBalance(500.0f);
+    HostTime::advance(100);
+    EnergyData_Manager::updateBalance(600.0f);      // Held by decimation
+    HostTime::advance(50);
+    EnergyData_Manager::applyFrame(frame(700.0f, 200.0f, 900.0f, 240.0f));
+    assertShows(700.0f, 200.0f, 900.0f);
+
+    // The older held sample must not be flushed over the frame
+    HostTime::advance(500);
+    EnergyData_Manager::update();
+    assertShows(700.0f, 200.0f, 900.0f);
+}
+
+static void test_frame_fields_share_one_snapshot_with_default_filters() {
+    // Median of 3 - the third frame of a step shows it on every feed at once
+    EnergyData_Manager::applyFrame(frame(500.0f, 1000.0f, 1500.0f, 240.0f));
+    for (int i = 0; i < 2; i++) {
+        HostTime::advance(20);
+        EnergyData_Manager::applyFrame(frame(-300.0f, 2000.0f, 1700.0f, 240.0f));
+    }
+    assertShows(-300.0f, 2000.0f, 1700.0f);
+}
+
+static void test_history_gets_the_raw_samples() {
+    holdBackOnly();
+    uint32_t bucket = EnergyHistory::getCount();
+    EnergyData_Manager::updateBalance(500.0f);
+    HostTime::advance(100);
+    EnergyData_Manager::updateBalance(600.0f);      // Decimated
+    HostTime::advance(300);
+    EnergyData_Manager::updateBalance(7000.0f);     // Held as a glitch
+    assertShows(500.0f, 0.0f, 0.0f);
+
+    HostTime::advance(EnergyHistory::BUCKET_MS);
+    EnergyData_Manager::update();
+    TEST_ASSERT_EQUAL(bucket + 1, EnergyHistory::getCount());
+    TEST_ASSERT_EQUAL(2700, EnergyHistory::get(FEED_BALANCE, bucket));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_SOLAR, bucket));
+}
+
+// A reader on another thread against a writer publishing as fast as it
+// can: every copy must be one whole frame (all three feeds equal)
+static void test_snapshot_is_never_torn() {
+    FilterConfig config;
+    config.mode = FILTER_NONE;
+    EnergyData_Manager::configureFilter(FEED_BALANCE, config);
+    EnergyData_Manager::configureFilter(FEED_SOLAR, config);
+    EnergyData_Manager::configureFilter(FEED_USED, config);
+    EnergyData_Manager::applyFrame(frame(1.0f, 1.0f, 1.0f, 240.0f));
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> reads(0);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backwards(0);
+    std::thread reader([&]() {
+        uint32_t last_generation = 0;
+        while (!done.load()) {
+            EnergySnapshot s = EnergyData_Manager::getSnapshot();
+            if (s.data.balance != s.data.solar || s.data.solar != s.data.used) torn++;
+            if (s.generation < last_generation) backwards++;
+            last_generation = s.generation;
+            reads++;
+        }
+    });
+
+    for (int i = 2; i < 200000; i++) {
+        float v = (float)i;
+        EnergyData_Manager::applyFrame(frame(v, v, v, 240.0f));
+    }
+    while (reads.load() < 1000) {
+        std::this_thread::yield();
+    }
+    done = true;
+    reader.join();
+
+    TEST_ASSERT_EQUAL(0, (int)torn.load());
+    TEST_ASSERT_EQUAL(0, (int)backwards.load());
+    // And the last publish is what a reader now sees
+    assertShows(199999.0f, 199999.0f, 199999.0f);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_is_published_as_a_unit);
+    RUN_TEST(test_separate_feeds_are_still_held_back);
+    RUN_TEST(test_frame_supersedes_held_samples);
+    RUN_TEST(test_frame_fields_share_one_snapshot_with_default_filters);
+    RUN_TEST(test_history_gets_the_raw_samples);
+    RUN_TEST(test_snapshot_is_never_torn);
+    return UNITY_END();
+}
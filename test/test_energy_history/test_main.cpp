@@ -0,0 +1,127 @@
+// EnergyHistory against the host clock: bucket averages, gaps, the ring
+// and catch-up after the knob slept through many buckets.
+#include <unity.h>
+#include "../../src/features/energy/energy_history.cpp"
+
+static const unsigned long BUCKET = EnergyHistory::BUCKET_MS;
+
+void setUp() {
+    HostTime::set(1000);
+    EnergyHistory::begin();
+}
+
+void tearDown() {}
+
+static bool advance(unsigned long ms) {
+    HostTime::advance(ms);
+    return EnergyHistory::update(millis());
+}
+
+static void test_bucket_closes_with_the_average() {
+    EnergyHistory::addSample(FEED_BALANCE, 100.0f);
+    EnergyHistory::addSample(FEED_BALANCE, 201.0f);
+    EnergyHistory::addSample(FEED_SOLAR, -0.4f);
+    EnergyHistory::addChannelSample(2, 239.6f);
+    TEST_ASSERT_FALSE(advance(BUCKET - 1));
+    TEST_ASSERT_EQUAL(0, (int)EnergyHistory::getCount());
+
+    TEST_ASSERT_TRUE(advance(1));
+    TEST_ASSERT_EQUAL(1, (int)EnergyHistory::getCount());
+    TEST_ASSERT_EQUAL(151, EnergyHistory::get(FEED_BALANCE, 0));       // 150.5 rounds away from 0
+    TEST_ASSERT_EQUAL(0, EnergyHistory::get(FEED_SOLAR, 0));
+    TEST_ASSERT_EQUAL(240, EnergyHistory::getChannel(2, 0));
+    TEST_ASSERT_EQUAL(4, (int)EnergyHistory::getStats().samples);
+
+    // The next bucket starts empty
+    EnergyHistory::addSample(FEED_BALANCE, -50.0f);
+    TEST_ASSERT_TRUE(advance(BUCKET));
+    TEST_ASSERT_EQUAL(-50, EnergyHistory::get(FEED_BALANCE, 1));
+    TEST_ASSERT_EQUAL(151, EnergyHistory::get(FEED_BALANCE, 0));
+}
+
+static void test_bucket_without_samples_is_a_gap() {
+    EnergyHistory::addSample(FEED_USED, 800.0f);
+    advance(BUCKET);
+    advance(BUCKET);        // Nothing arrived
+
+    TEST_ASSERT_EQUAL(800, EnergyHistory::get(FEED_USED, 0));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_USED, 1));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_BALANCE, 0));
+    // Every series but used in the first bucket, all of them in the second
+    TEST_ASSERT_EQUAL(2 * EnergyHistory::SERIES - 1, (int)EnergyHistory::getStats().gaps);
+    // Not closed yet, and invalid arguments
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_USED, 2));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_VRMS, 0));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::getChannel(EnergyData::MAX_CHANNELS, 0));
+}
+
+static void test_ring_keeps_the_newest_buckets() {
+    for (int i = 0; i < EnergyHistory::BUCKETS + 10; i++) {
+        EnergyHistory::addSample(FEED_BALANCE, (float)i);
+        advance(BUCKET);
+    }
+    uint32_t count = EnergyHistory::getCount();
+    TEST_ASSERT_EQUAL(EnergyHistory::BUCKETS + 10, (int)count);
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_BALANCE, count - EnergyHistory::BUCKETS - 1));
+    TEST_ASSERT_EQUAL(10, EnergyHistory::get(FEED_BALANCE, count - EnergyHistory::BUCKETS));
+    TEST_ASSERT_EQUAL(EnergyHistory::BUCKETS + 9, EnergyHistory::get(FEED_BALANCE, count - 1));
+}
+
+static void test_short_stall_closes_every_bucket() {
+    EnergyHistory::addSample(FEED_SOLAR, 1200.0f);
+    TEST_ASSERT_TRUE(advance(5 * BUCKET + BUCKET / 2));
+    TEST_ASSERT_EQUAL(5, (int)EnergyHistory::getCount());
+    TEST_ASSERT_EQUAL(1200, EnergyHistory::get(FEED_SOLAR, 0));
+    for (uint32_t bucket = 1; bucket < 5; bucket++) {
+        TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_SOLAR, bucket));
+    }
+
+    // The half bucket left over still counts towards the next one
+    TEST_ASSERT_FALSE(advance(BUCKET / 2 - 1));
+    TEST_ASSERT_TRUE(advance(1));
+    TEST_ASSERT_EQUAL(6, (int)EnergyHistory::getCount());
+}
+
+static void test_long_stall_catches_up_in_one_ring() {
+    // A sample from before light sleep, then ten rings of silence
+    EnergyHistory::addSample(FEED_BALANCE, 3000.0f);
+    const uint32_t stalled = 10 * EnergyHistory::BUCKETS + 3;
+    TEST_ASSERT_TRUE(advance(stalled * BUCKET + 100));
+
+    TEST_ASSERT_EQUAL(stalled, EnergyHistory::getCount());
+    TEST_ASSERT_EQUAL(EnergyHistory::BUCKETS, (int)EnergyHistory::getStats().buckets);
+    // The old sample fell out with its bucket - nothing in the ring is live
+    for (uint32_t bucket = stalled - EnergyHistory::BUCKETS; bucket < stalled; bucket++) {
+        TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::get(FEED_BALANCE, bucket));
+    }
+
+    // And the bucket grid is kept
+    EnergyHistory::addSample(FEED_BALANCE, -700.0f);
+    TEST_ASSERT_FALSE(advance(BUCKET - 101));
+    TEST_ASSERT_TRUE(advance(1));
+    TEST_ASSERT_EQUAL(-700, EnergyHistory::get(FEED_BALANCE, stalled));
+}
+
+static void test_clear_channels_keeps_the_feeds() {
+    EnergyHistory::addSample(FEED_BALANCE, 10.0f);
+    EnergyHistory::addChannelSample(0, 20.0f);
+    advance(BUCKET);
+    EnergyHistory::addChannelSample(0, 30.0f);      // Pending when the set changes
+    EnergyHistory::clearChannels();
+    advance(BUCKET);
+
+    TEST_ASSERT_EQUAL(10, EnergyHistory::get(FEED_BALANCE, 0));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::getChannel(0, 0));
+    TEST_ASSERT_EQUAL(EnergyHistory::NO_DATA, EnergyHistory::getChannel(0, 1));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bucket_closes_with_the_average);
+    RUN_TEST(test_bucket_without_samples_is_a_gap);
+    RUN_TEST(test_ring_keeps_the_newest_buckets);
+    RUN_TEST(test_short_stall_closes_every_bucket);
+    RUN_TEST(test_long_stall_catches_up_in_one_ring);
+    RUN_TEST(test_clear_channels_keeps_the_feeds);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+// EnergyIntegrator against reference kWh totals: a synthetic day of 1s
+// EmonTX3 samples, integrated and compared with a fine numeric integral of
+// the same power curves.
+#include <unity.h>
+#include <math.h>
+#include "../../src/features/energy/energy_integrator.cpp"
+
+static const double HOUR = 3600.0;
+static const double DAY = 24 * HOUR;
+static const double CHEAP_UNTIL = 7 * HOUR;     // Band 0 (off-peak) before 07:00, then band 1
+static const float PRICE[2] = {0.10f, 0.30f};
+static const float EXPORT_PRICE = 0.15f;
+
+// Power curves [W] at t seconds into the day
+static double solar(double t) {
+    if (t <= 6 * HOUR || t >= 18 * HOUR) return 0.0;
+    return 4000.0 * sin(M_PI * (t - 6 * HOUR) / (12 * HOUR));
+}
+static double used(double t) {
+    return 600.0 + 300.0 * cos(2 * M_PI * (t - 19 * HOUR) / DAY);
+}
+static double balance(double t) {
+    return used(t) - solar(t);
+}
+
+struct Reference {
+    double import_kwh[2] = {};
+    double export_kwh[2] = {};
+    double solar_kwh = 0.0;
+    double used_kwh = 0.0;
+};
+
+// Midpoint rule at 0.1s, in W x s
+static Reference integrate(double from, double to) {
+    Reference r;
+    const double step = 0.1;
+    for (double t = from + step / 2; t < to; t += step) {
+        int band = t < CHEAP_UNTIL ? 0 : 1;
+        double b = balance(t);
+        if (b > 0) r.import_kwh[band] += b * step;
+        else r.export_kwh[band] -= b * step;
+        r.solar_kwh += solar(t) * step;
+        r.used_kwh += used(t) * step;
+    }
+    for (int i = 0; i < 2; i++) {
+        r.import_kwh[i] /= 3.6e6;
+        r.export_kwh[i] /= 3.6e6;
+    }
+    r.solar_kwh /= 3.6e6;
+    r.used_kwh /= 3.6e6;
+    return r;
+}
+
+// One sample per feed at second s, as delivered over MQTT (float payloads)
+static void deliver(EnergyIntegrator& integrator, unsigned long s, unsigned long offset_ms = 0) {
+    unsigned long ms = s * 1000UL + offset_ms;
+    int band = s <= CHEAP_UNTIL ? 0 : 1;     // The band when the sample closing the interval arrives
+    integrator.addBalance((float)balance(s), ms, band);
+    integrator.addSolar((float)solar(s), ms, band);
+    integrator.addUsed((float)used(s), ms, band);
+}
+
+static EnergyIntegrator priced() {
+    EnergyIntegrator integrator;
+    integrator.setImportPrice(0, PRICE[0]);
+    integrator.setImportPrice(1, PRICE[1]);
+    integrator.setExportPrice(EXPORT_PRICE);
+    return integrator;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_day_of_1s_samples_matches_reference() {
+    EnergyIntegrator integrator = priced();
+    for (unsigned long s = 0; s <= (unsigned long)DAY; s++) {
+        deliver(integrator, s);
+    }
+    Reference ref = integrate(0, DAY);
+    const EnergyTotals& t = integrator.getTotals();
+    
+    // Within 0.1 Wh of 5-30 kWh totals
+    const double tolerance = 1e-4;
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.solar_kwh, t.total_solar_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.used_kwh, t.total_used_kwh);
+    for (int band = 0; band < 2; band++) {
+        TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.import_kwh[band], t.import_kwh[band]);
+        TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.export_kwh[band], t.export_kwh[band]);
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.import_kwh[0] + ref.import_kwh[1], t.total_import_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, ref.export_kwh[0] + ref.export_kwh[1], t.total_export_kwh);
+    
+    double cost = ref.import_kwh[0] * PRICE[0] + ref.import_kwh[1] * PRICE[1] -
+                  (ref.export_kwh[0] + ref.export_kwh[1]) * EXPORT_PRICE;
+    TEST_ASSERT_DOUBLE_WITHIN(1e-4, cost, t.cost);
+    
+    // Energy balance: import - export = used - solar
+    TEST_ASSERT_DOUBLE_WITHIN(tolerance, t.total_used_kwh - t.total_solar_kwh,
+                              t.total_import_kwh - t.total_export_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-4, 1.0 - t.total_export_kwh / t.total_solar_kwh,
+                              integrator.getSelfConsumptionRatio());
+    TEST_ASSERT_EQUAL(0, t.gaps);
+    TEST_ASSERT_EQUAL(0, t.duplicates);
+}
+
+// 28 uWh steps onto a 2.4 kWh total - a float sum ends ~1.5 Wh high
+static void test_standby_load_over_a_day_is_exact() {
+    EnergyIntegrator integrator;
+    for (unsigned long s = 0; s <= (unsigned long)DAY; s++) {
+        integrator.addUsed(100.0f, s * 1000UL, 1);
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 2.4, integrator.getTotals().total_used_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 2.4, integrator.getTotals().used_kwh[1]);
+}
+
+// QoS1 may deliver a message twice - the second copy adds nothing
+static void test_redelivered_samples_add_nothing() {
+    EnergyIntegrator once = priced();
+    EnergyIntegrator twice = priced();
+    for (unsigned long s = 10 * 3600; s <= 11 * 3600; s += 10) {
+        deliver(once, s);
+        deliver(twice, s);
+        deliver(twice, s, 20);
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, once.getTotals().total_import_kwh, twice.getTotals().total_import_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, once.getTotals().total_export_kwh, twice.getTotals().total_export_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, once.getTotals().total_solar_kwh, twice.getTotals().total_solar_kwh);
+    TEST_ASSERT_EQUAL(3 * 361, twice.getTotals().duplicates);
+}
+
+// A silence longer than MAX_GAP_MS is left out rather than guessed
+// A backlog drained after a short outage arrives milliseconds apart: it
+// can't be told from redelivery, so only the first interval counts
+static void test_backlog_burst_is_merged() {
+    EnergyIntegrator integrator;
+    integrator.addUsed(1000.0f, 0, 0);
+    integrator.addUsed(1000.0f, 10000, 0);
+    // Outage; three 10s samples queued by the broker, delivered 5ms apart at 40s
+    integrator.addUsed(2000.0f, 40000, 0);
+    integrator.addUsed(2000.0f, 40005, 0);
+    integrator.addUsed(3000.0f, 40010, 0);
+    integrator.addUsed(3000.0f, 50010, 0);
+    // 10s at 1kW, the 30s ramp to 2kW, then 3kW (the newest value) from the
+    // first sample of the burst - the interval is 10.01s, the 2kW row is lost
+    double expected = (10000.0 * 1000.0 + 30000.0 * 1500.0 + 10010.0 * 3000.0) / 3.6e9;
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, expected, integrator.getTotals().total_used_kwh);
+    TEST_ASSERT_EQUAL(1, (int)integrator.getTotals().duplicates);
+}
+
+static void test_dropout_is_not_integrated() {
+    EnergyIntegrator integrator = priced();
+    unsigned long dropout_from = 12 * 3600;
+    unsigned long dropout_to = dropout_from + 300;
+    for (unsigned long s = 11 * 3600; s <= 13 * 3600; s += 10) {
+        if (s > dropout_from && s < dropout_to) continue;
+        deliver(integrator, s);
+    }
+    Reference before = integrate(11 * HOUR, dropout_from);
+    Reference after = integrate(dropout_to, 13 * HOUR);
+    const EnergyTotals& t = integrator.getTotals();
+    TEST_ASSERT_EQUAL(3, t.gaps);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, before.solar_kwh + after.solar_kwh, t.total_solar_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, before.export_kwh[1] + after.export_kwh[1], t.total_export_kwh);
+}
+
+// The zero crossing splits an interval between import and export
+static void test_crossing_interval_is_split() {
+    EnergyIntegrator integrator = priced();
+    integrator.addBalance(1000.0f, 0, 1);
+    integrator.addBalance(-3000.0f, 10000, 1);
+    // Crosses at 2.5s: 1000W x 2.5s / 2 imported, 3000W x 7.5s / 2 exported
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1250.0 / 3.6e6, integrator.getTotals().total_import_kwh);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 11250.0 / 3.6e6, integrator.getTotals().total_export_kwh);
+}
+
+static void test_reset_keeps_feeds_primed() {
+    EnergyIntegrator integrator = priced();
+    integrator.addSolar(3600.0f, 0, 1);
+    integrator.addSolar(3600.0f, 30000, 1);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.03, integrator.getTotals().total_solar_kwh);
+    
+    // Midnight: the interval that straddles it counts towards the new day
+    integrator.resetTotals();
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, integrator.getTotals().total_solar_kwh);
+    integrator.addSolar(3600.0f, 40000, 1);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.01, integrator.getTotals().total_solar_kwh);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_day_of_1s_samples_matches_reference);
+    RUN_TEST(test_standby_load_over_a_day_is_exact);
+    RUN_TEST(test_redelivered_samples_add_nothing);
+    RUN_TEST(test_backlog_burst_is_merged);
+    RUN_TEST(test_dropout_is_not_integrated);
+    RUN_TEST(test_crossing_interval_is_split);
+    RUN_TEST(test_reset_keeps_feeds_primed);
+    return UNITY_END();
+}
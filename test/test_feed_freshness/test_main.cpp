@@ -0,0 +1,230 @@
+// TimerWheel and FeedFreshness against the host clock: re-arming, timers
+// that re-arm from their own callback, catch-up after light sleep, and the
+// fresh -> late -> stale deadlines learned from the publish interval.
+#include <unity.h>
+#include "../../src/core/system/timer_wheel.cpp"
+#include "../../src/features/energy/feed_freshness.cpp"
+
+static const unsigned long TICK = 10;
+static TimerWheel wheel(TICK);
+
+struct Counter {
+    int fired = 0;
+    unsigned long last_ms = 0;
+};
+
+static void count(void* context) {
+    Counter* counter = static_cast<Counter*>(context);
+    counter->fired++;
+    counter->last_ms = millis();
+}
+
+static WheelTimer timerFor(Counter& counter) {
+    WheelTimer timer;
+    timer.callback = count;
+    timer.context = &counter;
+    return timer;
+}
+
+void setUp() {
+    HostTime::set(1000);
+    wheel.begin(millis());
+    FeedFreshness::begin();
+}
+
+void tearDown() {}
+
+// loop() every tick for ms
+static void runWheel(unsigned long ms) {
+    for (unsigned long t = 0; t < ms; t += TICK) {
+        HostTime::advance(TICK);
+        wheel.advance(millis());
+    }
+}
+
+static void test_timer_fires_once_after_its_delay() {
+    Counter counter;
+    WheelTimer timer = timerFor(counter);
+    wheel.schedule(timer, 25);              // Rounded up to 3 ticks
+    runWheel(20);
+    TEST_ASSERT_EQUAL(0, counter.fired);
+    runWheel(10);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+    TEST_ASSERT_FALSE(timer.armed);
+    runWheel(10 * TimerWheel::SLOTS * TICK);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+}
+
+static void test_rearm_replaces_the_deadline() {
+    Counter counter;
+    WheelTimer timer = timerFor(counter);
+    // Re-armed on every sample, as FeedFreshness does - it never fires
+    for (int i = 0; i < 500; i++) {
+        wheel.schedule(timer, 50);
+        runWheel(30);
+    }
+    TEST_ASSERT_EQUAL(0, counter.fired);
+    TEST_ASSERT_EQUAL(0, (int)wheel.getStats().fired);
+
+    runWheel(50);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+
+    // Cancelled, and further out than one rotation
+    wheel.schedule(timer, 20);
+    wheel.cancel(timer);
+    WheelTimer far = timerFor(counter);
+    wheel.schedule(far, 3 * TimerWheel::SLOTS * TICK);
+    runWheel(3 * TimerWheel::SLOTS * TICK - TICK);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+    runWheel(TICK);
+    TEST_ASSERT_EQUAL(2, counter.fired);
+}
+
+// Re-arms itself one rotation later - into the slot being run
+struct Periodic {
+    WheelTimer timer;
+    int fired = 0;
+};
+
+static void rearm(void* context) {
+    Periodic* periodic = static_cast<Periodic*>(context);
+    periodic->fired++;
+    wheel.schedule(periodic->timer, TimerWheel::SLOTS * TICK);
+}
+
+static void test_callback_can_rearm_into_its_own_slot() {
+    Periodic periodic;
+    periodic.timer.callback = rearm;
+    periodic.timer.context = &periodic;
+    Counter counter;
+    WheelTimer neighbour = timerFor(counter);   // Shares the slot
+    wheel.schedule(periodic.timer, TimerWheel::SLOTS * TICK);
+    wheel.schedule(neighbour, TimerWheel::SLOTS * TICK);
+
+    runWheel(TimerWheel::SLOTS * TICK);
+    TEST_ASSERT_EQUAL(1, periodic.fired);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+    TEST_ASSERT_TRUE(periodic.timer.armed);
+
+    runWheel(4 * TimerWheel::SLOTS * TICK);
+    TEST_ASSERT_EQUAL(5, periodic.fired);
+    TEST_ASSERT_EQUAL(1, counter.fired);
+}
+
+static void test_stall_over_many_rotations_catches_up_in_one_pass() {
+    Counter early, late, after;
+    WheelTimer t1 = timerFor(early);
+    WheelTimer t2 = timerFor(late);
+    WheelTimer t3 = timerFor(after);
+    wheel.schedule(t1, 5 * TICK);
+    wheel.schedule(t2, 7 * TimerWheel::SLOTS * TICK + 3 * TICK);
+    wheel.schedule(t3, 12 * TimerWheel::SLOTS * TICK);
+    uint32_t ticks = wheel.getStats().ticks;
+
+    // Light sleep for ten rotations, then one loop pass
+    HostTime::advance(10 * TimerWheel::SLOTS * TICK + 5);
+    wheel.advance(millis());
+    TEST_ASSERT_EQUAL(TimerWheel::SLOTS, (int)(wheel.getStats().ticks - ticks));
+    TEST_ASSERT_EQUAL(1, early.fired);
+    TEST_ASSERT_EQUAL(1, late.fired);
+    TEST_ASSERT_EQUAL(0, after.fired);
+
+    // The wheel is back on the clock: the third fires on time
+    unsigned long due = 1000 + 12 * TimerWheel::SLOTS * TICK;
+    runWheel(due - millis() - 5);
+    TEST_ASSERT_EQUAL(0, after.fired);
+    runWheel(TICK);
+    TEST_ASSERT_EQUAL(1, after.fired);
+}
+
+// loop(): FeedFreshness::update() every 50ms for ms
+static void runFeeds(unsigned long ms) {
+    for (unsigned long t = 0; t < ms; t += 50) {
+        HostTime::advance(50);
+        FeedFreshness::update();
+    }
+}
+
+// Samples every interval_ms, count times
+static void publish(PowerFeed feed, unsigned long interval_ms, int count) {
+    for (int i = 0; i < count; i++) {
+        runFeeds(interval_ms);
+        FeedFreshness::notifyUpdate(feed, millis());
+    }
+}
+
+static void test_arrivals_keep_a_feed_fresh() {
+    TEST_ASSERT_EQUAL(FEED_STATE_NONE, FeedFreshness::getState(FEED_SOLAR));
+    publish(FEED_SOLAR, 10000, 30);
+    TEST_ASSERT_EQUAL(FEED_STATE_FRESH, FeedFreshness::getState(FEED_SOLAR));
+    TEST_ASSERT_EQUAL(0, (int)FeedFreshness::getInfo(FEED_SOLAR).late_count);
+    TEST_ASSERT_EQUAL_FLOAT(10000.0f, FeedFreshness::getInfo(FEED_SOLAR).interval_ms);
+    TEST_ASSERT_EQUAL(FEED_STATE_NONE, FeedFreshness::getState(FEED_USED));
+}
+
+static void test_deadlines_follow_the_learned_interval() {
+    publish(FEED_BALANCE, 2000, 40);
+    const FeedInfo& info = FeedFreshness::getInfo(FEED_BALANCE);
+    TEST_ASSERT_FLOAT_WITHIN(100.0f, 2000.0f, info.interval_ms);
+    unsigned long late = (unsigned long)(info.interval_ms * 1.5f + info.jitter_ms * 2.0f);
+    unsigned long stale = (unsigned long)(info.interval_ms * 3.0f + info.jitter_ms * 4.0f);
+    TEST_ASSERT_TRUE(stale > 5000);         // Learned, not the MIN_STALE_MS floor
+    FeedFreshness::hasStateChanged();
+
+    runFeeds(late - 300);
+    TEST_ASSERT_EQUAL(FEED_STATE_FRESH, FeedFreshness::getState(FEED_BALANCE));
+    runFeeds(600);
+    TEST_ASSERT_EQUAL(FEED_STATE_LATE, FeedFreshness::getState(FEED_BALANCE));
+    TEST_ASSERT_TRUE(FeedFreshness::hasStateChanged());
+    TEST_ASSERT_TRUE(FeedFreshness::anyLive());
+    runFeeds(stale - late - 600);
+    TEST_ASSERT_EQUAL(FEED_STATE_LATE, FeedFreshness::getState(FEED_BALANCE));
+    runFeeds(600);
+    TEST_ASSERT_EQUAL(FEED_STATE_STALE, FeedFreshness::getState(FEED_BALANCE));
+    TEST_ASSERT_FALSE(FeedFreshness::anyLive());
+
+    // One sample brings it back, and the outage did not count as an interval
+    float interval = info.interval_ms;
+    FeedFreshness::notifyUpdate(FEED_BALANCE, millis());
+    TEST_ASSERT_EQUAL(FEED_STATE_FRESH, FeedFreshness::getState(FEED_BALANCE));
+    TEST_ASSERT_EQUAL_FLOAT(interval, info.interval_ms);
+    TEST_ASSERT_EQUAL(1, (int)info.late_count);
+    TEST_ASSERT_EQUAL(1, (int)info.stale_count);
+}
+
+static void test_feed_is_stale_straight_after_light_sleep() {
+    publish(FEED_USED, 10000, 5);
+    HostTime::advance(10 * 60 * 1000UL);
+    FeedFreshness::update();
+    TEST_ASSERT_EQUAL(FEED_STATE_STALE, FeedFreshness::getState(FEED_USED));
+    TEST_ASSERT_EQUAL(1, (int)FeedFreshness::getInfo(FEED_USED).late_count);
+    TEST_ASSERT_EQUAL(1, (int)FeedFreshness::getInfo(FEED_USED).stale_count);
+}
+
+static void test_reset_channels_forgets_them() {
+    FeedFreshness::notifyChannel(3, millis());
+    FeedFreshness::notifyUpdate(FEED_VRMS, millis());
+    FeedFreshness::hasStateChanged();
+    FeedFreshness::resetChannels();
+    TEST_ASSERT_TRUE(FeedFreshness::hasStateChanged());
+    TEST_ASSERT_EQUAL(FEED_STATE_NONE, FeedFreshness::getChannelState(3));
+    TEST_ASSERT_EQUAL(FEED_STATE_FRESH, FeedFreshness::getState(FEED_VRMS));
+
+    // Its cancelled timer must not fire
+    runFeeds(60000);
+    TEST_ASSERT_EQUAL(FEED_STATE_NONE, FeedFreshness::getChannelState(3));
+    TEST_ASSERT_EQUAL(FEED_STATE_STALE, FeedFreshness::getState(FEED_VRMS));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_timer_fires_once_after_its_delay);
+    RUN_TEST(test_rearm_replaces_the_deadline);
+    RUN_TEST(test_callback_can_rearm_into_its_own_slot);
+    RUN_TEST(test_stall_over_many_rotations_catches_up_in_one_pass);
+    RUN_TEST(test_arrivals_keep_a_feed_fresh);
+    RUN_TEST(test_deadlines_follow_the_learned_interval);
+    RUN_TEST(test_feed_is_stale_straight_after_light_sleep);
+    RUN_TEST(test_reset_channels_forgets_them);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+// MemoryMonitor against the counting LVGL pool in test/host/lvgl.h:
+// a million rebuilds in the order main.cpp makes them, and a leak charged
+// to the screen that leaked it rather than the one built after it.
+#include <unity.h>
+#include "../../src/ui_common/memory_monitor.cpp"
+
+bool MQTTManager::publish(const char*, const char*, bool, bool) { return true; }
+
+static std::vector<lv_obj_t*> leaked;
+
+void setUp() {
+    lv_obj_clean(lv_scr_act());
+    MemoryMonitor::begin();
+}
+
+void tearDown() {
+    lv_obj_clean(lv_scr_act());
+    for (size_t i = 0; i < leaked.size(); i++) {
+        lv_obj_del(leaked[i]);
+    }
+    leaked.clear();
+}
+
+// update_current_screen(): clean, bracket, and a screen's worth of widgets -
+// containers with labels, a different count per screen and per pass
+static void rebuild(int screen, uint32_t pass, int leak_from = -1) {
+    lv_obj_clean(lv_scr_act());
+    MemoryMonitor::beginScreenBuild();
+
+    int rows = 4 + screen * 3 + (int)(pass % 5);
+    for (int i = 0; i < rows; i++) {
+        lv_obj_t* row = lv_obj_create(lv_scr_act());
+        lv_label_create(row);
+        lv_label_create(row);
+    }
+    if (screen == leak_from) {
+        leaked.push_back(lv_obj_create(nullptr));   // Never attached - survives the clean
+    }
+    lv_label_create(lv_scr_act());                  // Screen indicator
+
+    MemoryMonitor::endScreenBuild(screen);
+}
+
+static void test_million_rebuilds_hold_no_residue() {
+    const uint32_t REBUILDS = 1000000;
+    uint32_t peak = 0;
+    for (uint32_t pass = 0; pass < REBUILDS; pass++) {
+        rebuild((int)(pass % SCREEN_COUNT), pass / SCREEN_COUNT);
+        if (pass == SCREEN_COUNT * 5) {
+            peak = HostLvgl::pool().max_used;       // Every screen at its largest
+        }
+    }
+    lv_obj_clean(lv_scr_act());
+
+    TEST_ASSERT_FALSE(MemoryMonitor::isLeakSuspected());
+    TEST_ASSERT_EQUAL(0, (int)HostLvgl::pool().used);
+    TEST_ASSERT_EQUAL(peak, HostLvgl::pool().max_used);
+    for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+        const ScreenMemoryStats& stats = MemoryMonitor::getScreenStats(screen);
+        TEST_ASSERT_EQUAL(REBUILDS / SCREEN_COUNT, stats.builds);
+        TEST_ASSERT_EQUAL(0, stats.baseline);
+        TEST_ASSERT_EQUAL(0, stats.residue);
+        TEST_ASSERT_EQUAL(0, stats.growth_streak);
+    }
+}
+
+static void test_leak_is_charged_to_the_screen_that_leaked() {
+    for (uint32_t pass = 0; pass < 200; pass++) {
+        rebuild((int)(pass % SCREEN_COUNT), pass / SCREEN_COUNT, SCREEN_HOUSE_INFO);
+    }
+
+    TEST_ASSERT_TRUE(MemoryMonitor::isLeakSuspected());
+    const ScreenMemoryStats& leaking = MemoryMonitor::getScreenStats(SCREEN_HOUSE_INFO);
+    // 50 builds, 49 cleans after the first
+    TEST_ASSERT_EQUAL(49 * (int)HostLvgl::OBJ_SIZE, leaking.residue);
+    // Settings is built straight after each leak and must stay clean
+    for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+        if (screen == SCREEN_HOUSE_INFO) continue;
+        TEST_ASSERT_EQUAL(0, MemoryMonitor::getScreenStats(screen).residue);
+        TEST_ASSERT_EQUAL(0, MemoryMonitor::getScreenStats(screen).growth_streak);
+    }
+}
+
+static void test_build_cost_is_measured_per_screen() {
+    rebuild(SCREEN_WEATHER, 0);
+    rebuild(SCREEN_ENERGY, 0);
+
+    // 7 rows of a container and two labels, plus the indicator
+    const ScreenMemoryStats& weather = MemoryMonitor::getScreenStats(SCREEN_WEATHER);
+    TEST_ASSERT_EQUAL(22, weather.blocks);
+    TEST_ASSERT_EQUAL(22 * HostLvgl::OBJ_SIZE, weather.bytes);
+    TEST_ASSERT_EQUAL(13 * HostLvgl::OBJ_SIZE, MemoryMonitor::getScreenStats(SCREEN_ENERGY).bytes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_million_rebuilds_hold_no_residue);
+    RUN_TEST(test_leak_is_charged_to_the_screen_that_leaked);
+    RUN_TEST(test_build_cost_is_measured_per_screen);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+// MockScenario scripts: the same script and seed replay the same day, events
+// and tariff steps wrap midnight, and a script that doesn't parse leaves the
+// previous scenario in use.
+#include <unity.h>
+#include "../../src/features/energy/mock_scenario.cpp"
+
+static const uint32_t DAY = 86400;
+
+static const char* const SCRIPT =
+    "seed 42\n"
+    "noise 100\n"
+    "vrms 240 5\n"
+    "cloud 11:00 20m 0.3\n"
+    "spike 23:30 1h 3000      # runs past midnight\n"
+    "sag 19:00 5m 225\n"
+    "tariff 06:00 2\n"
+    "tariff 22:00 1\n";
+
+struct Run {
+    EnergyData samples[2 * DAY / MockScenario::SAMPLE_INTERVAL];
+    bool delivered[2 * DAY / MockScenario::SAMPLE_INTERVAL];
+};
+
+static Run first, second;
+
+void setUp() {
+    MockScenario::load(MockScenario::DEFAULT_SCRIPT);
+}
+
+void tearDown() {}
+
+// Two simulated days from midnight, as generateMockData steps through them
+static void runDays(Run& run) {
+    MockScenario::reset();
+    EnergyData data;
+    for (uint32_t i = 0; i < 2 * DAY / MockScenario::SAMPLE_INTERVAL; i++) {
+        run.delivered[i] = MockScenario::sample((i + 1) * MockScenario::SAMPLE_INTERVAL, data);
+        run.samples[i] = data;
+    }
+}
+
+static bool sameSample(const EnergyData& a, const EnergyData& b) {
+    return a.solar == b.solar && a.used == b.used && a.balance == b.balance &&
+           a.vrms == b.vrms && a.tariff == b.tariff;
+}
+
+static int countDifferent(const Run& a, const Run& b) {
+    int different = 0;
+    for (uint32_t i = 0; i < 2 * DAY / MockScenario::SAMPLE_INTERVAL; i++) {
+        if (a.delivered[i] != b.delivered[i] || !sameSample(a.samples[i], b.samples[i])) different++;
+    }
+    return different;
+}
+
+static void test_same_script_and_seed_replay_the_same_day() {
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));
+    runDays(first);
+    MockScenario::load(MockScenario::DEFAULT_SCRIPT);
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));       // Compiled again from scratch
+    runDays(second);
+    TEST_ASSERT_EQUAL(0, countDifferent(first, second));
+
+    // Another seed changes the noise on every sample
+    String reseeded = String("seed 43\n") + (SCRIPT + strlen("seed 42\n"));
+    TEST_ASSERT_TRUE(MockScenario::load(reseeded.c_str()));
+    runDays(second);
+    TEST_ASSERT_EQUAL((int)(2 * DAY / MockScenario::SAMPLE_INTERVAL), countDifferent(first, second));
+}
+
+static void test_dropout_withholds_samples_without_shifting_the_sequence() {
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));
+    runDays(first);
+    String with_dropout = String(SCRIPT) + "dropout 14:00 10m\n";
+    TEST_ASSERT_TRUE(MockScenario::load(with_dropout.c_str()));
+    runDays(second);
+
+    // Both days, 14:00 up to but not including 14:10
+    int withheld = 0;
+    for (uint32_t i = 0; i < 2 * DAY / MockScenario::SAMPLE_INTERVAL; i++) {
+        uint32_t time_of_day = ((i + 1) * MockScenario::SAMPLE_INTERVAL) % DAY;
+        bool in_dropout = time_of_day >= 14 * 3600 && time_of_day < 14 * 3600 + 600;
+        TEST_ASSERT_EQUAL(!in_dropout, second.delivered[i]);
+        if (in_dropout) {
+            withheld++;
+        } else {
+            TEST_ASSERT_TRUE(sameSample(first.samples[i], second.samples[i]));
+        }
+    }
+    TEST_ASSERT_EQUAL(2 * 600 / (int)MockScenario::SAMPLE_INTERVAL, withheld);
+}
+
+static void test_events_and_tariff_wrap_midnight() {
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));
+    runDays(first);
+    TEST_ASSERT_TRUE(MockScenario::load("seed 42\nnoise 100\nvrms 240 5\n"));
+    runDays(second);
+
+    // The spike from 23:30 runs until 00:30 - on both sides of midnight
+    const uint32_t times[] = {23 * 3600 + 20 * 60, 23 * 3600 + 45 * 60, DAY + 15 * 60, DAY + 45 * 60};
+    const float extra[] = {0.0f, 3000.0f, 3000.0f, 0.0f};
+    for (int i = 0; i < 4; i++) {
+        uint32_t index = times[i] / MockScenario::SAMPLE_INTERVAL - 1;
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, extra[i], first.samples[index].used - second.samples[index].used);
+    }
+
+    // After midnight the tariff is the last step of the day before
+    TEST_ASSERT_EQUAL(1, first.samples[DAY / MockScenario::SAMPLE_INTERVAL + 10].tariff);
+    TEST_ASSERT_EQUAL(1, first.samples[0].tariff);
+    TEST_ASSERT_EQUAL(2, first.samples[(6 * 3600) / MockScenario::SAMPLE_INTERVAL].tariff);
+}
+
+static void assertRejected(const char* script) {
+    TEST_ASSERT_FALSE(MockScenario::load(script));
+    TEST_ASSERT_EQUAL(42, (int)MockScenario::getSeed());
+    TEST_ASSERT_EQUAL(5, MockScenario::getEventCount());
+}
+
+static void test_bad_script_keeps_the_previous_scenario() {
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));
+    runDays(first);
+
+    assertRejected("seed 7\nbreeze 11:00 20m\n");           // Unknown keyword
+    assertRejected("seed 7\ncloud 25:00 20m 0.3\n");        // Bad time
+    assertRejected("seed 7\nspike 07:30 3x 3000\n");        // Bad duration
+    assertRejected("seed 7\ncloud 11:00 20m 0.3 0.5\n");    // Extra argument
+    assertRejected("seed 7\nsag 19:00 5m\n");               // Missing argument
+    assertRejected("seed 7\nscale 0\n");
+
+    // A line one character over the limit, even if it is only a comment
+    char line[MockScenario::MAX_LINE + 2];
+    memset(line, 'x', sizeof(line) - 1);
+    memcpy(line, "seed 7 #", 8);
+    line[MockScenario::MAX_LINE + 1] = '\0';
+    assertRejected(line);
+    line[MockScenario::MAX_LINE] = '\0';
+    TEST_ASSERT_TRUE(MockScenario::load(line));
+    TEST_ASSERT_EQUAL(7, (int)MockScenario::getSeed());
+    TEST_ASSERT_TRUE(MockScenario::load(SCRIPT));
+
+    String crowded = "seed 7\n";
+    for (int i = 0; i <= MockScenario::MAX_EVENTS; i++) crowded += "spike 07:30 3m 3000\n";
+    assertRejected(crowded.c_str());
+
+    // Still the same day
+    runDays(second);
+    TEST_ASSERT_EQUAL(0, countDifferent(first, second));
+}
+
+static void test_script_from_a_buffer_stops_at_its_length() {
+    // As from the MQTT receive buffer: no terminator, more bytes after it
+    const char buffer[] = "seed 9\ntariff 06:00 3\nseed 11";
+    TEST_ASSERT_TRUE(MockScenario::load((const uint8_t*)buffer, strlen("seed 9\ntariff 06:00 3")));
+    TEST_ASSERT_EQUAL(9, (int)MockScenario::getSeed());
+    TEST_ASSERT_EQUAL(1, MockScenario::getEventCount());
+
+    // Empty is a valid script: every setting at its default
+    TEST_ASSERT_TRUE(MockScenario::load((const uint8_t*)buffer, 0));
+    TEST_ASSERT_EQUAL(1, (int)MockScenario::getSeed());
+    TEST_ASSERT_EQUAL(0, MockScenario::getEventCount());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_same_script_and_seed_replay_the_same_day);
+    RUN_TEST(test_dropout_withholds_samples_without_shifting_the_sequence);
+    RUN_TEST(test_events_and_tariff_wrap_midnight);
+    RUN_TEST(test_bad_script_keeps_the_previous_scenario);
+    RUN_TEST(test_script_from_a_buffer_stops_at_its_length);
+    return UNITY_END();
+}
@@ -0,0 +1,372 @@
+// MQTTManager's outbound queue against the PubSubClient fake in test/host:
+// retries, drops and size checks - and the channel subscriptions it keeps.
+// Inbound weather, scenario and frame messages go through defaultCallback.
+// The message handlers build as on the knob; the hardware and UI they
+// report to are faked below.
+#include <unity.h>
+#include <algorithm>
+#include "../../src/core/network/mqtt_manager.cpp"
+#include "../../src/core/network/command_interpreter.cpp"
+#include "../../src/core/network/energy_frame.cpp"
+#include "../../src/core/network/time_sync.cpp"
+#include "../../src/core/network/trace_replay.cpp"
+#include "../../src/features/energy/energy_data.cpp"
+#include "../../src/features/energy/energy_channels.cpp"
+#include "../../src/features/energy/energy_history.cpp"
+#include "../../src/features/energy/energy_integrator.cpp"
+#include "../../src/features/energy/feed_freshness.cpp"
+#include "../../src/features/energy/mock_scenario.cpp"
+#include "../../src/features/energy/peak_reset_scheduler.cpp"
+#include "../../src/features/energy/power_filter.cpp"
+#include "../../src/features/weather/weather_data.cpp"
+#include "../../src/core/system/telemetry_kernels.cpp"
+#include "../../src/core/system/telemetry_store.cpp"
+#include "../../src/core/system/timer_wheel.cpp"
+
+void DiagnosticsData_Manager::recordError(const char*, int) {}
+void HapticFeedback::peakReached() {}
+void HapticFeedback::setEnabled(bool) {}
+void PowerManager::setActiveBrightness(uint8_t) {}
+PowerState PowerManager::getState() { return POWER_ACTIVE; }
+const char* PowerManager::getStateName(PowerState) { return "active"; }
+void MemoryMonitor::sample(MemorySample&) {}
+bool MemoryMonitor::isLeakSuspected() { return false; }
+uint32_t RefreshGovernor::getRefreshPeriod() { return 30; }
+
+static bool begun = false;
+
+void setUp() {
+    HostTime::set(1000);
+    HostMqtt::reset();
+    Preferences::reset();
+    if (!begun) {
+        EnergyData_Manager::begin();
+        MQTTManager::begin();
+        begun = true;
+    }
+    MQTTManager::connect();
+    // Let the retained status from connect() go out, then start counting
+    for (int i = 0; i < 4 && MQTTManager::getQueueDepth() > 0; i++) {
+        HostTime::advance(100);
+        MQTTManager::process();
+    }
+    HostMqtt::state().published.clear();
+}
+
+void tearDown() {}
+
+// loop() passes, 100ms apart - one batch window each
+static void runFor(int passes) {
+    for (int i = 0; i < passes; i++) {
+        HostTime::advance(100);
+        MQTTManager::process();
+    }
+}
+
+static void test_refused_message_is_dropped_after_max_attempts() {
+    PublishStats before = MQTTManager::getPublishStats();
+    HostMqtt::state().refuse_topic = "home/knob/bench";
+    TEST_ASSERT_TRUE(MQTTManager::publish("home/knob/bench", "{\"case\":\"x\"}", false, false));
+    TEST_ASSERT_TRUE(MQTTManager::publish("home/knob/response", "{\"ok\":true}", false, false));
+
+    runFor(10);
+
+    const PublishStats& after = MQTTManager::getPublishStats();
+    TEST_ASSERT_EQUAL(0, MQTTManager::getQueueDepth());
+    TEST_ASSERT_EQUAL(1, (int)(after.dropped - before.dropped));
+    TEST_ASSERT_EQUAL(5, (int)(after.failed - before.failed));
+    // The message behind it was not held up for good
+    TEST_ASSERT_EQUAL(1, (int)HostMqtt::state().published.size());
+    TEST_ASSERT_EQUAL_STRING("home/knob/response", HostMqtt::state().published[0].topic.c_str());
+}
+
+static void test_transient_refusal_is_retried_in_order() {
+    PublishStats before = MQTTManager::getPublishStats();
+    HostMqtt::state().refuse_next = 2;
+    MQTTManager::publish("home/knob/a", "1", false, false);
+    MQTTManager::publish("home/knob/b", "2", false, false);
+
+    runFor(5);
+
+    const PublishStats& after = MQTTManager::getPublishStats();
+    TEST_ASSERT_EQUAL(0, (int)(after.dropped - before.dropped));
+    TEST_ASSERT_EQUAL(2, (int)(after.failed - before.failed));
+    TEST_ASSERT_EQUAL(2, (int)HostMqtt::state().published.size());
+    TEST_ASSERT_EQUAL_STRING("home/knob/a", HostMqtt::state().published[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("home/knob/b", HostMqtt::state().published[1].topic.c_str());
+}
+
+static void test_coalesced_payload_gets_fresh_attempts() {
+    PublishStats before = MQTTManager::getPublishStats();
+    HostMqtt::state().refuse_next = 4;
+    MQTTManager::publish("home/knob/state", "old");
+    runFor(4);      // Four refusals - one short of the limit
+    MQTTManager::publish("home/knob/state", "new");
+    HostMqtt::state().refuse_next = 4;
+    runFor(6);
+
+    const PublishStats& after = MQTTManager::getPublishStats();
+    TEST_ASSERT_EQUAL(0, (int)(after.dropped - before.dropped));
+    TEST_ASSERT_EQUAL(1, (int)HostMqtt::state().published.size());
+    TEST_ASSERT_EQUAL_STRING("new", HostMqtt::state().published[0].payload.c_str());
+}
+
+static void test_packet_larger_than_client_buffer_is_refused_at_queue_time() {
+    PublishStats before = MQTTManager::getPublishStats();
+    uint16_t buffer = HostMqtt::state().buffer_size;
+    HostMqtt::state().buffer_size = 64;
+
+    // 5 header + 2 length + 13 topic + 44 payload = 64 fits, one more doesn't
+    std::string fits(44, 'x');
+    std::string too_long(45, 'x');
+    TEST_ASSERT_TRUE(MQTTManager::publish("home/knob/big", fits.c_str(), false, false));
+    TEST_ASSERT_FALSE(MQTTManager::publish("home/knob/big", too_long.c_str(), false, false));
+    TEST_ASSERT_EQUAL(1, MQTTManager::getQueueDepth());
+    runFor(2);
+    HostMqtt::state().buffer_size = buffer;
+
+    const PublishStats& after = MQTTManager::getPublishStats();
+    TEST_ASSERT_EQUAL(1, (int)(after.dropped - before.dropped));
+    TEST_ASSERT_EQUAL(0, (int)(after.failed - before.failed));
+    TEST_ASSERT_EQUAL(1, (int)HostMqtt::state().published.size());
+}
+
+// A message arriving from the broker
+static void receive(const char* topic, const char* payload) {
+    std::string topic_copy(topic);
+    std::string payload_copy(payload);
+    MQTTManager::injectMessage(&topic_copy[0], (byte*)&payload_copy[0], (unsigned int)payload_copy.size());
+}
+
+static bool isSubscribed(const char* topic) {
+    const std::vector<std::string>& subscribed = HostMqtt::state().subscribed;
+    return std::find(subscribed.begin(), subscribed.end(), topic) != subscribed.end();
+}
+
+static void test_knob_topics_are_rejected_as_channels() {
+    const char* reserved[] = {
+        CHANNEL_CONFIG_TOPIC, MOCK_SCENARIO_TOPIC, "home/knob/config/peak_reset", "home/knob/config/timezone",
+        "home/knob/command", "home/weather/temperature", "home/weather/forecast",
+        TARIFF_TOPIC, ENERGY_FRAME_TOPIC,
+    };
+    for (size_t i = 0; i < sizeof(reserved) / sizeof(reserved[0]); i++) {
+        std::string config = std::string("Grid balance ") + reserved[i] + " W 1 8000 #f44336\n";
+        char error[64];
+        if (EnergyChannels::configure((const uint8_t*)config.c_str(), config.size(), error, sizeof(error))) {
+            TEST_FAIL_MESSAGE(reserved[i]);
+        }
+        TEST_ASSERT_NOT_NULL(strstr(error, "own topic"));
+    }
+    // Near misses are ordinary topics
+    const char* config = "Grid balance home/knobs/balance W 1 8000 #f44336\n"
+                         "Solar solar home/weatherstation/solar W 1 5000 #ffeb3b\n";
+    char error[64];
+    TEST_ASSERT_TRUE(EnergyChannels::configure((const uint8_t*)config, strlen(config), error, sizeof(error)));
+    EnergyData_Manager::resetChannels();
+}
+
+static void test_channels_reset_restores_defaults_and_subscriptions() {
+    receive(CHANNEL_CONFIG_TOPIC, "Grid balance site/grid W 1 8000 #f44336\n"
+                                  "Solar solar site/pv W 1 5000 #ffeb3b\n");
+    TEST_ASSERT_EQUAL(2, EnergyChannels::getCount());
+    TEST_ASSERT_TRUE(isSubscribed("site/pv"));
+    TEST_ASSERT_FALSE(isSubscribed("emon/emontx3/solar"));
+
+    receive("home/knob/command", "channels reset");
+    runFor(2);
+
+    TEST_ASSERT_EQUAL(4, EnergyChannels::getCount());
+    TEST_ASSERT_EQUAL_STRING("emon/emontx3/balance", EnergyChannels::getConfig(0).topic);
+    TEST_ASSERT_FALSE(isSubscribed("site/grid"));
+    TEST_ASSERT_FALSE(isSubscribed("site/pv"));
+    TEST_ASSERT_TRUE(isSubscribed("emon/emontx3/solar"));
+    TEST_ASSERT_TRUE(isSubscribed(CHANNEL_CONFIG_TOPIC));
+    Preferences prefs;
+    prefs.begin("channels", true);
+    TEST_ASSERT_FALSE(prefs.isKey("config"));
+    prefs.end();
+
+    TEST_ASSERT_EQUAL(1, (int)HostMqtt::state().published.size());
+    TEST_ASSERT_NOT_NULL(strstr(HostMqtt::state().published[0].payload.c_str(), "\"ok\":true"));
+}
+
+static void receiveFrame(uint16_t sequence, float balance) {
+    EnergyFrame frame;
+    frame.fields = ENERGY_FRAME_BALANCE;
+    frame.sequence = sequence;
+    frame.balance = balance;
+    uint8_t payload[EnergyFrameCodec::FRAME_SIZE];
+    unsigned int length = EnergyFrameCodec::encode(frame, payload, sizeof(payload));
+    char topic[] = ENERGY_FRAME_TOPIC;
+    MQTTManager::injectMessage(topic, payload, length);
+}
+
+static void test_frame_redelivered_after_reconnect_is_a_duplicate() {
+    FrameStats before = EnergyFrameCodec::getStats();
+    receiveFrame(500, -1200.0f);
+
+    // The session resumes and the broker sends the unacked frame again
+    HostMqtt::state().connected = false;
+    TEST_ASSERT_TRUE(MQTTManager::connect());
+    receiveFrame(500, -1200.0f);
+    receiveFrame(501, -900.0f);
+
+    const FrameStats& after = EnergyFrameCodec::getStats();
+    TEST_ASSERT_EQUAL(2, (int)(after.frames - before.frames));
+    TEST_ASSERT_EQUAL(1, (int)(after.duplicates - before.duplicates));
+    TEST_ASSERT_EQUAL(0, (int)(after.missed - before.missed));
+}
+
+static void test_scenario_topic_replaces_the_mock_script() {
+    TEST_ASSERT_TRUE(isSubscribed(MOCK_SCENARIO_TOPIC));
+    receive(MOCK_SCENARIO_TOPIC, "seed 5\nspike 18:00 2h 7000\n");
+    TEST_ASSERT_EQUAL(5, (int)MockScenario::getSeed());
+    TEST_ASSERT_EQUAL(1, MockScenario::getEventCount());
+
+    receive(MOCK_SCENARIO_TOPIC, "seed 6\nspike 18:00 2h\n");
+    TEST_ASSERT_EQUAL(5, (int)MockScenario::getSeed());
+
+    // Cleared retained message - back to the built-in day
+    receive(MOCK_SCENARIO_TOPIC, "");
+    TEST_ASSERT_EQUAL(1, (int)MockScenario::getSeed());
+    TEST_ASSERT_EQUAL(3, MockScenario::getEventCount());
+}
+
+static void test_weather_payloads_are_parsed_in_place() {
+    WeatherData_Manager::begin();
+    const WeatherData& data = WeatherData_Manager::getCurrentData();
+    receive("home/weather/temperature", " 21.5\r\n");
+    receive("home/weather/humidity", "45");
+    receive("home/weather/condition", "Scattered Clouds");
+    receive("home/weather/forecast", "24,12,partly-cloudy");
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, data.temperature);
+    TEST_ASSERT_EQUAL_FLOAT(45.0f, data.humidity);
+    TEST_ASSERT_EQUAL(WEATHER_PARTLY_CLOUDY, data.condition);
+    TEST_ASSERT_EQUAL_FLOAT(24.0f, data.forecast_high);
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, data.forecast_low);
+    TEST_ASSERT_EQUAL(WEATHER_PARTLY_CLOUDY, data.forecast_condition);
+    TEST_ASSERT_TRUE(data.valid);
+
+    // Each of these is dropped and leaves the values alone
+    const char* rejected[][2] = {
+        {"home/weather/temperature", "warm"},
+        {"home/weather/temperature", "75"},
+        {"home/weather/humidity", "101"},
+        {"home/weather/forecast", "12,24,rainy"},         // Low above high
+        {"home/weather/forecast", "24"},
+        {"home/weather/pressure", "1013"},
+        {"home/weather/condition", "rain rain rain rain rain rain rain rain rain rain"},   // Over MAX_PAYLOAD
+    };
+    for (size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+        receive(rejected[i][0], rejected[i][1]);
+    }
+    TEST_ASSERT_EQUAL(7, (int)WeatherData_Manager::getStats().rejected);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, data.temperature);
+    TEST_ASSERT_EQUAL_FLOAT(45.0f, data.humidity);
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, data.forecast_low);
+    TEST_ASSERT_EQUAL(WEATHER_PARTLY_CLOUDY, data.condition);
+
+    // Unknown names are accepted and shown without an icon
+    receive("home/weather/condition", "volcanic ash");
+    receive("home/weather/forecast", "24,12");
+    TEST_ASSERT_EQUAL(WEATHER_UNKNOWN, data.condition);
+    TEST_ASSERT_EQUAL(WEATHER_UNKNOWN, data.forecast_condition);
+    TEST_ASSERT_EQUAL(1, (int)WeatherData_Manager::getStats().unknown_conditions);
+}
+
+// Weather update() from loop(), once a minute
+static void runWeather(unsigned long minutes) {
+    for (unsigned long i = 0; i < minutes; i++) {
+        HostTime::advance(60 * 1000UL);
+        WeatherData_Manager::update();
+    }
+}
+
+static void test_weather_fields_expire_on_their_own() {
+    WeatherData_Manager::begin();
+    const WeatherData& data = WeatherData_Manager::getCurrentData();
+    receive("home/weather/temperature", "18");
+    receive("home/weather/condition", "rainy");
+    receive("home/weather/forecast", "20,9,rainy");
+    runWeather(60);
+    receive("home/weather/humidity", "80");
+    WeatherData_Manager::hasDataChanged();
+
+    // Two hours on the first three - humidity is only an hour old
+    runWeather(60);
+    TEST_ASSERT_TRUE(WeatherData_Manager::hasDataChanged());
+    TEST_ASSERT_FALSE(data.has_temperature);
+    TEST_ASSERT_FALSE(data.has_forecast);
+    TEST_ASSERT_EQUAL(WEATHER_UNKNOWN, data.condition);
+    TEST_ASSERT_TRUE(data.has_humidity);
+    TEST_ASSERT_TRUE(data.valid);
+    TEST_ASSERT_FALSE(data.stale);
+
+    // A fresh humidity brings nothing old back
+    runWeather(30);
+    receive("home/weather/humidity", "82");
+    TEST_ASSERT_FALSE(data.has_temperature);
+    TEST_ASSERT_FALSE(data.has_forecast);
+    TEST_ASSERT_EQUAL_FLOAT(82.0f, data.humidity);
+
+    // Then humidity expires as well and the set is stale
+    runWeather(119);
+    TEST_ASSERT_TRUE(data.valid);
+    runWeather(1);
+    TEST_ASSERT_FALSE(data.has_humidity);
+    TEST_ASSERT_TRUE(data.stale);
+    TEST_ASSERT_FALSE(data.valid);
+    TEST_ASSERT_EQUAL(4, (int)WeatherData_Manager::getStats().expired);
+    TEST_ASSERT_EQUAL(1, (int)WeatherData_Manager::getStats().stale_count);
+
+    // One field is live again, on its own
+    receive("home/weather/temperature", "16");
+    TEST_ASSERT_TRUE(data.valid);
+    TEST_ASSERT_FALSE(data.stale);
+    TEST_ASSERT_TRUE(data.has_temperature);
+    TEST_ASSERT_FALSE(data.has_humidity);
+    TEST_ASSERT_FALSE(data.has_forecast);
+}
+
+// The built-in trace at its recorded spacing, through defaultCallback
+static void test_trace_replay_reaches_the_energy_state() {
+    EnergyData_Manager::resetChannels();
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_REALTIME));
+    while (TraceReplay::isRunning()) {
+        HostTime::advance(10);
+        TraceReplay::update();
+    }
+    TEST_ASSERT_EQUAL(121, (int)TraceReplay::getStats().messages);
+    TEST_ASSERT_EQUAL(0, (int)TraceReplay::getStats().parse_errors);
+
+    // Each feed at the median of its last three samples, the voltage smoothed
+    EnergySnapshot snapshot = EnergyData_Manager::getSnapshot();
+    TEST_ASSERT_TRUE(snapshot.data.valid);
+    TEST_ASSERT_EQUAL_FLOAT(17.0f, snapshot.data.balance);
+    TEST_ASSERT_EQUAL_FLOAT(595.0f, snapshot.data.solar);
+    TEST_ASSERT_EQUAL_FLOAT(629.0f, snapshot.data.used);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 240.2f, snapshot.data.vrms);
+    TEST_ASSERT_EQUAL(FEED_STATE_FRESH, FeedFreshness::getState(FEED_VRMS));
+    TEST_ASSERT_FLOAT_WITHIN(50.0f, 10000.0f, FeedFreshness::getInfo(FEED_BALANCE).interval_ms);
+
+    runFor(2);
+    TEST_ASSERT_NOT_NULL(strstr(HostMqtt::state().published.back().payload.c_str(),
+                                "\"case\":\"replay\",\"n\":121,"));
+    TEST_ASSERT_NOT_NULL(strstr(HostMqtt::state().published.back().payload.c_str(), "\"sustained\":true"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_refused_message_is_dropped_after_max_attempts);
+    RUN_TEST(test_transient_refusal_is_retried_in_order);
+    RUN_TEST(test_coalesced_payload_gets_fresh_attempts);
+    RUN_TEST(test_packet_larger_than_client_buffer_is_refused_at_queue_time);
+    RUN_TEST(test_frame_redelivered_after_reconnect_is_a_duplicate);
+    RUN_TEST(test_knob_topics_are_rejected_as_channels);
+    RUN_TEST(test_channels_reset_restores_defaults_and_subscriptions);
+    RUN_TEST(test_scenario_topic_replaces_the_mock_script);
+    RUN_TEST(test_weather_payloads_are_parsed_in_place);
+    RUN_TEST(test_weather_fields_expire_on_their_own);
+    RUN_TEST(test_trace_replay_reaches_the_energy_state);
+    return UNITY_END();
+}
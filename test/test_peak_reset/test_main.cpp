@@ -0,0 +1,191 @@
+// PeakResetScheduler and TimeSync against a stand-in NTP server
+// (test/host/esp_sntp.h): first sync, DST, catch-up after a reboot, clock
+// steps, and NVS writes for redelivered settings.
+#include <unity.h>
+#include "../../src/core/network/time_sync.cpp"
+#include "../../src/features/energy/peak_reset_scheduler.cpp"
+
+static const char* UK = "GMT0BST,M3.5.0/1,M10.5.0";
+static const char* CET = "CET-1CEST,M3.5.0,M10.5.0/3";
+
+// Times below are UTC
+static const time_t MAR20_1000 = 1774000800;
+static const time_t MAR20_1200 = 1774008000;
+static const time_t MAR27_1200 = 1774612800;
+static const time_t MAR28_1300 = 1774702800;
+static const time_t MAR28_2300 = 1774738800;
+static const time_t MAR29_1100 = 1774782000;   // Noon BST - the clocks went forward at 01:00
+static const time_t MAR30_1100 = 1774868400;
+
+static int resets = 0;
+void EnergyData_Manager::resetDailyPeaks() { resets++; }
+void EnergyData_Manager::resetDailyTotals() {}
+
+void setUp() {
+    HostTime::set(5000);
+    HostSntp::reset();
+    
+    // Back to the defaults, then an empty NVS
+    TimeSync::configure("pool.ntp.org", UK);
+    PeakResetScheduler::setResetTime(12, 0);
+    Preferences::reset();
+    
+    TimeSync::setClock(HostSntp::now);
+    TimeSync::begin();
+    TimeSync::hasTimeChanged();
+    PeakResetScheduler::begin();
+    resets = 0;
+}
+
+void tearDown() {}
+
+// loop() for s seconds, once per simulated second
+static void runFor(unsigned long s) {
+    for (unsigned long i = 0; i < s; i++) {
+        HostTime::advance(1000);
+        PeakResetScheduler::update();
+    }
+}
+
+static void test_waits_for_ntp() {
+    runFor(600);
+    TEST_ASSERT_EQUAL(0, resets);
+    TEST_ASSERT_EQUAL(0, PeakResetScheduler::getNextReset());
+    TEST_ASSERT_FALSE(TimeSync::isSynced());
+    TEST_ASSERT_EQUAL_STRING("pool.ntp.org", HostSntp::state().server.c_str());
+}
+
+static void test_first_sync_schedules_local_noon_across_dst() {
+    HostSntp::answer(MAR28_2300);
+    PeakResetScheduler::update();
+    TEST_ASSERT_TRUE(TimeSync::isSynced());
+    TEST_ASSERT_EQUAL(MAR29_1100, PeakResetScheduler::getNextReset());
+    
+    runFor(12 * 3600 - 1);
+    TEST_ASSERT_EQUAL(0, resets);
+    runFor(1);
+    TEST_ASSERT_EQUAL(1, resets);
+    TEST_ASSERT_EQUAL(MAR30_1100, PeakResetScheduler::getNextReset());
+    
+    Preferences prefs;
+    prefs.begin("peaks", true);
+    TEST_ASSERT_EQUAL_UINT32(MAR29_1100, prefs.getUInt("last_reset"));
+}
+
+static void test_catches_up_on_a_missed_reset() {
+    Preferences prefs;
+    prefs.begin("peaks", false);
+    prefs.putUInt("last_reset", (uint32_t)MAR27_1200);
+    PeakResetScheduler::begin();
+    
+    // Powered off over noon on the 28th
+    HostSntp::answer(MAR28_1300);
+    PeakResetScheduler::update();
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(1, resets);
+    TEST_ASSERT_EQUAL(MAR29_1100, PeakResetScheduler::getNextReset());
+    
+    // Already done today - a later reboot must not repeat it
+    PeakResetScheduler::begin();
+    HostSntp::answer(MAR28_1300 + 60);
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(1, resets);
+}
+
+static void test_follows_a_clock_step() {
+    HostSntp::answer(MAR20_1000);
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(MAR20_1200, PeakResetScheduler::getNextReset());
+    
+    // The server steps the clock back an hour after the first 30 minutes
+    runFor(1800);
+    HostSntp::answer(MAR20_1000 - 1800);
+    runFor(2 * 3600 - 1);
+    TEST_ASSERT_EQUAL(0, resets);
+    runFor(1801);
+    TEST_ASSERT_EQUAL(1, resets);
+}
+
+static void test_redelivered_timezone_writes_nothing() {
+    HostSntp::answer(MAR20_1000);
+    PeakResetScheduler::update();
+    uint32_t writes = Preferences::writes();
+    
+    // Retained config topic, delivered on every reconnect
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(TimeSync::setTimezone(UK));
+        PeakResetScheduler::update();
+    }
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes());
+    TEST_ASSERT_FALSE(TimeSync::hasTimeChanged());
+    
+    // A new rule is stored once and moves the reset to noon CET
+    TEST_ASSERT_TRUE(TimeSync::setTimezone(CET));
+    TEST_ASSERT_TRUE(TimeSync::setTimezone(CET));
+    TEST_ASSERT_EQUAL_UINT32(writes + 1, Preferences::writes());
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(MAR20_1200 - 3600, PeakResetScheduler::getNextReset());
+    TEST_ASSERT_FALSE(TimeSync::setTimezone(""));
+}
+
+static void test_redelivered_reset_time_writes_nothing() {
+    HostSntp::answer(MAR20_1000);
+    PeakResetScheduler::update();
+    uint32_t writes = Preferences::writes();
+    
+    // Asleep over noon, then the reconnect redelivers the retained time
+    // before the loop gets to the deadline
+    HostTime::advance(3 * 3600 * 1000UL);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(PeakResetScheduler::setResetTime("12:00"));
+    }
+    TEST_ASSERT_EQUAL_UINT32(writes, Preferences::writes());
+    
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(1, resets);
+    TEST_ASSERT_EQUAL(MAR20_1200 + 24 * 3600, PeakResetScheduler::getNextReset());
+}
+
+static void test_configure_restarts_sntp_only_on_change() {
+    uint32_t starts = HostSntp::state().starts;
+    TEST_ASSERT_TRUE(TimeSync::configure("pool.ntp.org", UK));
+    TEST_ASSERT_EQUAL_UINT32(starts, HostSntp::state().starts);
+    TEST_ASSERT_EQUAL_UINT32(0, Preferences::writes());
+    
+    // Both keys go to the empty NVS, then only the one that changed
+    TEST_ASSERT_TRUE(TimeSync::configure("192.168.1.1", UK));
+    TEST_ASSERT_EQUAL_UINT32(2, Preferences::writes());
+    TEST_ASSERT_TRUE(TimeSync::configure("192.168.1.2", UK));
+    TEST_ASSERT_EQUAL_UINT32(starts + 2, HostSntp::state().starts);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.2", HostSntp::state().server.c_str());
+    TEST_ASSERT_EQUAL_UINT32(3, Preferences::writes());
+    TEST_ASSERT_FALSE(TimeSync::configure("", UK));
+    
+    // Survives a reboot
+    TimeSync::begin();
+    TEST_ASSERT_EQUAL_STRING("192.168.1.2", TimeSync::getServer().c_str());
+}
+
+static void test_reset_time_change_is_not_a_missed_reset() {
+    HostSntp::answer(MAR20_1000);
+    PeakResetScheduler::update();
+    TEST_ASSERT_TRUE(PeakResetScheduler::setResetTime("09:30"));
+    PeakResetScheduler::update();
+    TEST_ASSERT_EQUAL(0, resets);
+    TEST_ASSERT_EQUAL(MAR20_1000 + 23 * 3600 + 1800, PeakResetScheduler::getNextReset());
+    TEST_ASSERT_FALSE(PeakResetScheduler::setResetTime("24:00"));
+    TEST_ASSERT_FALSE(PeakResetScheduler::setResetTime("noon"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_waits_for_ntp);
+    RUN_TEST(test_first_sync_schedules_local_noon_across_dst);
+    RUN_TEST(test_catches_up_on_a_missed_reset);
+    RUN_TEST(test_follows_a_clock_step);
+    RUN_TEST(test_redelivered_timezone_writes_nothing);
+    RUN_TEST(test_redelivered_reset_time_writes_nothing);
+    RUN_TEST(test_configure_restarts_sntp_only_on_change);
+    RUN_TEST(test_reset_time_change_is_not_a_missed_reset);
+    return UNITY_END();
+}
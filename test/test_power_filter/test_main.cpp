@@ -0,0 +1,101 @@
+// PowerFilter: median (odd and even windows), glitch hold-back and decimation.
+#include <unity.h>
+#include "../../src/features/energy/power_filter.cpp"
+
+static PowerFilter filter;
+
+void setUp() {
+    HostTime::set(0);
+}
+
+void tearDown() {}
+
+static FilterConfig medianOf(uint8_t window) {
+    FilterConfig config;
+    config.mode = FILTER_MEDIAN;
+    config.median_window = window;
+    return config;
+}
+
+static float push(float raw, unsigned long now = 0) {
+    float filtered = -1.0f;
+    filter.push(raw, now, filtered);
+    return filtered;
+}
+
+static void test_odd_window_takes_the_middle() {
+    filter.configure(medianOf(3));
+    push(100.0f);
+    push(900.0f);
+    TEST_ASSERT_EQUAL_FLOAT(200.0f, push(200.0f));
+    TEST_ASSERT_EQUAL_FLOAT(200.0f, push(50.0f));       // {900, 200, 50}
+}
+
+static void test_even_count_averages_the_middle_two() {
+    filter.configure(medianOf(4));
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, push(100.0f));
+    // Filling up - two samples
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, push(900.0f));
+    TEST_ASSERT_EQUAL_FLOAT(200.0f, push(200.0f));
+    // {100, 900, 200, 300}: middle two 200 and 300
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, push(300.0f));
+    // {400, 900, 200, 300} once the oldest is replaced
+    TEST_ASSERT_EQUAL_FLOAT(350.0f, push(400.0f));
+}
+
+static void test_glitch_is_held_back_until_confirmed() {
+    FilterConfig config = medianOf(1);
+    config.glitch_threshold = 1000.0f;
+    config.glitch_confirm = 2;
+    filter.configure(config);
+
+    float filtered;
+    TEST_ASSERT_TRUE(filter.push(500.0f, 0, filtered));
+    TEST_ASSERT_FALSE(filter.push(9000.0f, 0, filtered));   // Lone spike
+    TEST_ASSERT_TRUE(filter.push(520.0f, 0, filtered));
+    TEST_ASSERT_FALSE(filter.push(3000.0f, 0, filtered));   // Kettle on...
+    TEST_ASSERT_TRUE(filter.push(3010.0f, 0, filtered));    // ...and still on
+    TEST_ASSERT_EQUAL_FLOAT(3010.0f, filtered);
+    TEST_ASSERT_EQUAL(2, (int)filter.getStats().rejected);
+}
+
+static void test_decimation_holds_the_latest_value() {
+    FilterConfig config = medianOf(1);
+    config.decimate_ms = 250;
+    filter.configure(config);
+
+    float filtered;
+    TEST_ASSERT_TRUE(filter.push(1.0f, 1000, filtered));
+    TEST_ASSERT_FALSE(filter.push(2.0f, 1100, filtered));
+    TEST_ASSERT_FALSE(filter.push(3.0f, 1200, filtered));
+    TEST_ASSERT_FALSE(filter.flush(1249, filtered));
+    TEST_ASSERT_TRUE(filter.flush(1250, filtered));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, filtered);
+    TEST_ASSERT_FALSE(filter.flush(2000, filtered));         // Nothing new held
+}
+
+static void test_unheld_sample_skips_hold_back_and_decimation() {
+    FilterConfig config = medianOf(1);
+    config.glitch_threshold = 1000.0f;
+    config.decimate_ms = 250;
+    filter.configure(config);
+
+    float filtered;
+    TEST_ASSERT_TRUE(filter.push(500.0f, 1000, filtered));
+    TEST_ASSERT_FALSE(filter.push(600.0f, 1100, filtered));     // Held
+    TEST_ASSERT_EQUAL_FLOAT(9000.0f, filter.pushUnheld(9000.0f, 1150));
+    // The held sample is older - nothing left to flush
+    TEST_ASSERT_FALSE(filter.flush(2000, filtered));
+    // And 9000 is now the reference for glitches
+    TEST_ASSERT_TRUE(filter.push(9100.0f, 2000, filtered));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_odd_window_takes_the_middle);
+    RUN_TEST(test_even_count_averages_the_middle_two);
+    RUN_TEST(test_glitch_is_held_back_until_confirmed);
+    RUN_TEST(test_decimation_holds_the_latest_value);
+    RUN_TEST(test_unheld_sample_skips_hold_back_and_decimation);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+// PowerManager idle states and light sleep cycles on a simulated clock
+// (PowerManager::setClock), with the encoder's wake pins on fake GPIO.
+#include <unity.h>
+#include "../../src/core/hardware/power_manager.cpp"
+#include "../../src/core/hardware/rotary_encoder.cpp"
+
+static const int PIN_A = 8;
+static const int PIN_B = 7;
+
+// Backlight and haptics are only observed
+static uint8_t backlight_level = 255;
+void Backlight::setBrightness(uint8_t level) { backlight_level = level; }
+uint8_t Backlight::getBrightness() { return backlight_level; }
+void HapticFeedback::click() {}
+
+static int display_on = -1;     // Last display/network callback argument
+static int network_on = -1;
+static int network_calls = 0;
+
+static unsigned long simulatedClock() {
+    return millis();
+}
+
+void setUp() {
+    HostTime::set(0);
+    HostGpio::reset();
+    HostSleep::reset();
+    backlight_level = 255;
+    display_on = -1;
+    network_on = -1;
+    network_calls = 0;
+    
+    RotaryEncoder::begin();
+    PowerManager::setClock(simulatedClock);
+    PowerManager::setDisplayPowerCallback([](bool on) { display_on = on; });
+    PowerManager::setNetworkPowerCallback([](bool on) {
+        network_on = on;
+        network_calls++;
+    });
+    PowerManager::begin();
+}
+
+void tearDown() {}
+
+// Loop iterations until ms of simulated time have passed
+static void idleFor(unsigned long ms) {
+    unsigned long end = millis() + ms;
+    while (millis() < end) {
+        PowerManager::update();
+        HostTime::advance(10);
+    }
+    PowerManager::update();
+}
+
+static void assertEncoderInterrupts() {
+    TEST_ASSERT_EQUAL(CHANGE, HostGpio::pin(PIN_A).interrupt_type);
+    TEST_ASSERT_EQUAL(CHANGE, HostGpio::pin(PIN_B).interrupt_type);
+    TEST_ASSERT_FALSE(HostGpio::pin(PIN_A).wakeup);
+    TEST_ASSERT_FALSE(HostGpio::pin(PIN_B).wakeup);
+}
+
+static void test_idle_steps_through_states() {
+    idleFor(29990);
+    TEST_ASSERT_EQUAL(POWER_ACTIVE, PowerManager::getState());
+    idleFor(10);
+    TEST_ASSERT_EQUAL(POWER_DIMMED, PowerManager::getState());
+    TEST_ASSERT_EQUAL_UINT8(255 / 4, backlight_level);
+    
+    idleFor(90000);
+    TEST_ASSERT_EQUAL(POWER_SCREEN_OFF, PowerManager::getState());
+    TEST_ASSERT_EQUAL_UINT8(0, backlight_level);
+    TEST_ASSERT_EQUAL(0, display_on);
+    TEST_ASSERT_EQUAL(0, network_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, HostSleep::state().sleeps);
+    
+    idleFor(180000);
+    TEST_ASSERT_EQUAL(POWER_LIGHT_SLEEP, PowerManager::getState());
+    TEST_ASSERT_EQUAL(0, network_on);
+    TEST_ASSERT_EQUAL(1, network_calls);
+    TEST_ASSERT_EQUAL_UINT32(1, HostSleep::state().sleeps);
+}
+
+static void test_timer_wake_restores_encoder_interrupts() {
+    idleFor(300000);
+    TEST_ASSERT_EQUAL(POWER_LIGHT_SLEEP, PowerManager::getState());
+    
+    // Both pins were level wake sources during the sleep - opposite of the pull-up
+    uint64_t encoder_pins = (1ULL << PIN_A) | (1ULL << PIN_B);
+    TEST_ASSERT_TRUE((HostSleep::state().armed_pins & encoder_pins) == encoder_pins);
+    TEST_ASSERT_TRUE(HostSleep::state().gpio_enabled);
+    assertEncoderInterrupts();
+    
+    // Timer wakes a minute apart keep it asleep, with WiFi off
+    unsigned long before = millis();
+    PowerManager::update();
+    PowerManager::update();
+    TEST_ASSERT_EQUAL(POWER_LIGHT_SLEEP, PowerManager::getState());
+    TEST_ASSERT_EQUAL(ESP_SLEEP_WAKEUP_TIMER, esp_sleep_get_wakeup_cause());
+    TEST_ASSERT_EQUAL_UINT32(120000, millis() - before);
+    TEST_ASSERT_EQUAL(1, network_calls);
+    assertEncoderInterrupts();
+}
+
+static void test_encoder_wake_turns_everything_back_on() {
+    idleFor(300000);
+    HostSleep::scheduleGpioWake(1500);
+    PowerManager::update();
+    
+    TEST_ASSERT_EQUAL(ESP_SLEEP_WAKEUP_GPIO, esp_sleep_get_wakeup_cause());
+    TEST_ASSERT_EQUAL(POWER_ACTIVE, PowerManager::getState());
+    TEST_ASSERT_EQUAL(1, display_on);
+    TEST_ASSERT_EQUAL(1, network_on);
+    TEST_ASSERT_EQUAL(2, network_calls);
+    TEST_ASSERT_EQUAL_UINT8(255, backlight_level);
+    TEST_ASSERT_TRUE(PowerManager::hasWoken());
+    TEST_ASSERT_FALSE(PowerManager::hasWoken());
+    assertEncoderInterrupts();
+    
+    // Wake latency runs until the first flushed frame
+    HostTime::advance(120);
+    PowerManager::notifyFrame();
+    PowerManager::notifyFrame();
+    TEST_ASSERT_EQUAL_UINT32(120, PowerManager::getStats().last_wake_to_frame);
+    TEST_ASSERT_EQUAL_UINT32(1, PowerManager::getStats().wakes);
+}
+
+static void test_wake_edges_are_not_steps() {
+    idleFor(300000);
+    HostGpio::pin(PIN_A).level = LOW;
+    HostSleep::scheduleGpioWake(100);
+    PowerManager::update();
+    TEST_ASSERT_EQUAL(0, RotaryEncoder::getPositionChange());
+    
+    // The restored interrupt sees the next edge
+    HostTime::advance(10);
+    HostGpio::pin(PIN_A).level = HIGH;
+    HostGpio::pin(PIN_A).isr();
+    TEST_ASSERT_EQUAL(1, abs(RotaryEncoder::getPositionChange()));
+}
+
+static void test_activity_swallowed_only_when_dark() {
+    idleFor(30000);
+    TEST_ASSERT_EQUAL(POWER_DIMMED, PowerManager::getState());
+    TEST_ASSERT_FALSE(PowerManager::notifyActivity());
+    TEST_ASSERT_EQUAL(POWER_ACTIVE, PowerManager::getState());
+    
+    idleFor(120000);
+    TEST_ASSERT_EQUAL(POWER_SCREEN_OFF, PowerManager::getState());
+    TEST_ASSERT_TRUE(PowerManager::notifyActivity());
+    TEST_ASSERT_EQUAL(1, display_on);
+    TEST_ASSERT_EQUAL(0, network_calls);
+}
+
+static void test_duty_cycle_covers_uptime() {
+    idleFor(300000);
+    PowerManager::update();
+    float total = 0.0f;
+    for (int s = 0; s < POWER_STATE_COUNT; s++) {
+        total += PowerManager::getDutyCycle((PowerState)s);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, total);
+    // Dimmed from 30s to 120s, of 300s plus two minute-long sleeps
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f * 90 / 420, PowerManager::getDutyCycle(POWER_DIMMED));
+    TEST_ASSERT_TRUE(PowerManager::stateForIdleTime(299999) == POWER_SCREEN_OFF);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_steps_through_states);
+    RUN_TEST(test_timer_wake_restores_encoder_interrupts);
+    RUN_TEST(test_encoder_wake_turns_everything_back_on);
+    RUN_TEST(test_wake_edges_are_not_steps);
+    RUN_TEST(test_activity_swallowed_only_when_dark);
+    RUN_TEST(test_duty_cycle_covers_uptime);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+// RefreshGovernor states and LVGL timer periods on a simulated clock,
+// against the fake LVGL in test/host.
+#include <unity.h>
+#include "../../src/ui_common/refresh_governor.cpp"
+#include "../../src/core/system/latency_histogram.cpp"
+
+// The governor counts a pass that flushed as a frame
+static FlushStats flush_stats;
+const FlushStats& DisplayFlush::getStats() { return flush_stats; }
+
+static lv_disp_t disp;
+static lv_indev_t indev;
+static uint32_t pass_us = 0;
+
+static void renderPass() {
+    HostTime::advanceMicros(pass_us);
+    if (disp.inv_p > 0) {
+        flush_stats.flushes++;
+        disp.inv_p = 0;
+    }
+}
+
+void setUp() {
+    HostTime::set(1000);
+    HostLvgl::runningAnimations() = 0;
+    HostLvgl::timerHandler() = renderPass;
+    disp = lv_disp_t();
+    indev = lv_indev_t();
+    flush_stats = FlushStats();
+    pass_us = 0;
+    RefreshGovernor::begin(&disp, &indev);
+    RefreshGovernor::resetStats();
+}
+
+void tearDown() {}
+
+// One loop() iteration, then ms of simulated time
+static void loopFor(unsigned long ms) {
+    RefreshGovernor::handleTimers();
+    HostTime::advance(ms);
+}
+
+static void test_starts_active() {
+    TEST_ASSERT_EQUAL(REFRESH_ACTIVE, RefreshGovernor::getState());
+    TEST_ASSERT_EQUAL_UINT32(15, disp.refr_timer.period);
+    TEST_ASSERT_EQUAL_UINT32(10, indev.read_timer.period);
+    TEST_ASSERT_EQUAL_UINT32(15, RefreshGovernor::getRefreshPeriod());
+}
+
+static void test_idles_after_input_hold() {
+    loopFor(1999);
+    loopFor(1);
+    TEST_ASSERT_EQUAL(REFRESH_ACTIVE, RefreshGovernor::getState());
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_IDLE, RefreshGovernor::getState());
+    TEST_ASSERT_EQUAL_UINT32(500, disp.refr_timer.period);
+    TEST_ASSERT_EQUAL_UINT32(100, indev.read_timer.period);
+}
+
+static void test_data_holds_slow_tick() {
+    HostTime::advance(3000);
+    RefreshGovernor::notifyDataChanged();
+    loopFor(4999);
+    TEST_ASSERT_EQUAL(REFRESH_DATA, RefreshGovernor::getState());
+    TEST_ASSERT_EQUAL_UINT32(200, disp.refr_timer.period);
+    TEST_ASSERT_EQUAL_UINT32(50, indev.read_timer.period);
+    loopFor(1);
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_IDLE, RefreshGovernor::getState());
+}
+
+static void test_input_and_animation_force_active() {
+    HostTime::advance(3000);
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_IDLE, RefreshGovernor::getState());
+    
+    RefreshGovernor::notifyInput();
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_ACTIVE, RefreshGovernor::getState());
+    
+    // A running animation outlasts the input hold
+    HostLvgl::runningAnimations() = 1;
+    loopFor(10000);
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_ACTIVE, RefreshGovernor::getState());
+    HostLvgl::runningAnimations() = 0;
+    loopFor(0);
+    TEST_ASSERT_EQUAL(REFRESH_IDLE, RefreshGovernor::getState());
+    TEST_ASSERT_EQUAL_UINT32(3, RefreshGovernor::getStats().state_changes);
+}
+
+static void test_refresh_timer_paused_while_clean() {
+    loopFor(10);
+    TEST_ASSERT_TRUE(disp.refr_timer.paused);
+    
+    disp.inv_p = 1;
+    loopFor(10);
+    TEST_ASSERT_FALSE(disp.refr_timer.paused);
+    loopFor(10);
+    TEST_ASSERT_TRUE(disp.refr_timer.paused);
+    
+    // Animations keep it running with nothing invalidated yet
+    HostLvgl::runningAnimations() = 1;
+    loopFor(10);
+    TEST_ASSERT_FALSE(disp.refr_timer.paused);
+    TEST_ASSERT_EQUAL_UINT32(2, RefreshGovernor::getStats().refresh_paused);
+}
+
+// Started again with the timer still paused from the last idle spell
+static void test_begin_again_resumes_the_refresh_timer() {
+    loopFor(10);
+    TEST_ASSERT_TRUE(disp.refr_timer.paused);
+    RefreshGovernor::begin(&disp, &indev);
+    TEST_ASSERT_FALSE(disp.refr_timer.paused);
+    disp.inv_p = 1;
+    loopFor(10);
+    TEST_ASSERT_FALSE(disp.refr_timer.paused);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_stats.flushes);
+}
+
+static void test_only_flushing_passes_are_frames() {
+    pass_us = 4000;
+    loopFor(10);
+    disp.inv_p = 1;
+    loopFor(10);
+    loopFor(10);
+    TEST_ASSERT_EQUAL_UINT32(1, RefreshGovernor::getFrameTimes().getCount());
+    TEST_ASSERT_GREATER_OR_EQUAL(4000, RefreshGovernor::getFrameTimes().getMax());
+    TEST_ASSERT_EQUAL_UINT32(3, RefreshGovernor::getStats().loops[REFRESH_ACTIVE]);
+    TEST_ASSERT_EQUAL_UINT32(12000, RefreshGovernor::getStats().lvgl_us[REFRESH_ACTIVE]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_active);
+    RUN_TEST(test_idles_after_input_hold);
+    RUN_TEST(test_data_holds_slow_tick);
+    RUN_TEST(test_input_and_animation_force_active);
+    RUN_TEST(test_refresh_timer_paused_while_clean);
+    RUN_TEST(test_begin_again_resumes_the_refresh_timer);
+    RUN_TEST(test_only_flushing_passes_are_frames);
+    return UNITY_END();
+}
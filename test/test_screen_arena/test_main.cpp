@@ -0,0 +1,170 @@
+// ScreenArena through simulated build/clean cycles, without LVGL: blocks
+// the size of LVGL's objects and strings, grown like label text, freed in
+// scattered order by the clean. Under the sanitizer build
+// (pio test -e native_asan) every byte handed out is written, and freed or
+// rewound blocks must be poisoned.
+#include <unity.h>
+#include <vector>
+#include <algorithm>
+#include "../../src/ui_common/screen_arena.cpp"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ASSERT_POISONED(ptr) TEST_ASSERT_TRUE(__asan_address_is_poisoned(ptr))
+#else
+#define ASSERT_POISONED(ptr) ((void)(ptr))
+#endif
+
+struct Block {
+    uint8_t* ptr;
+    size_t size;
+    uint8_t fill;
+};
+
+static uint32_t seed;
+static uint32_t nextRandom() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+void setUp() {
+    seed = 7;
+}
+
+void tearDown() {}
+
+static Block allocate(size_t size) {
+    Block block;
+    block.ptr = (uint8_t*)ScreenArena::alloc(size);
+    block.size = size;
+    block.fill = (uint8_t)nextRandom();
+    TEST_ASSERT_NOT_NULL(block.ptr);
+    TEST_ASSERT_EQUAL(0, (int)((uintptr_t)block.ptr % 8));
+    memset(block.ptr, block.fill, size);
+    return block;
+}
+
+static void checkIntact(const Block& block) {
+    for (size_t i = 0; i < block.size; i++) {
+        if (block.ptr[i] != block.fill) TEST_FAIL_MESSAGE("block overwritten");
+    }
+}
+
+// One screen build: objects, styles and strings of LVGL-like sizes, and
+// label text set more than once
+static void build(std::vector<Block>& blocks, int count) {
+    ScreenArena::beginScreen();
+    for (int i = 0; i < count; i++) {
+        blocks.push_back(allocate(8 + nextRandom() % 300));
+        if (nextRandom() % 4 == 0) {
+            Block& text = blocks.back();
+            size_t grown = text.size + 1 + nextRandom() % 64;
+            text.ptr = (uint8_t*)ScreenArena::realloc(text.ptr, grown);
+            TEST_ASSERT_NOT_NULL(text.ptr);
+            for (size_t b = 0; b < text.size; b++) {
+                if (text.ptr[b] != text.fill) TEST_FAIL_MESSAGE("realloc lost contents");
+            }
+            text.size = grown;
+            memset(text.ptr, text.fill, grown);
+        }
+    }
+    ScreenArena::endScreen();
+}
+
+// lv_obj_clean(): everything freed, in no particular order
+static void clean(std::vector<Block>& blocks) {
+    for (size_t i = blocks.size(); i > 1; i--) {
+        std::swap(blocks[i - 1], blocks[nextRandom() % i]);
+    }
+    for (size_t i = 0; i < blocks.size(); i++) {
+        checkIntact(blocks[i]);
+        ScreenArena::free(blocks[i].ptr);
+        ASSERT_POISONED(blocks[i].ptr);
+    }
+    blocks.clear();
+}
+
+static void test_build_clean_cycles_rewind_the_arena() {
+    const ArenaStats& stats = ScreenArena::getStats();
+    uint32_t resets = stats.resets;
+    uint32_t general = stats.general_allocs;
+    std::vector<Block> blocks;
+    for (int cycle = 0; cycle < 20000; cycle++) {
+        build(blocks, 20 + (int)(nextRandom() % 80));
+        TEST_ASSERT_TRUE(ScreenArena::contains(blocks[0].ptr));
+        uint8_t* first = blocks[0].ptr;
+        clean(blocks);
+        TEST_ASSERT_EQUAL(0, (int)stats.arena_live);
+        TEST_ASSERT_EQUAL(0, (int)stats.arena_used);
+        ASSERT_POISONED(first);
+    }
+    TEST_ASSERT_EQUAL(20000, (int)(stats.resets - resets));
+    TEST_ASSERT_EQUAL(general, stats.general_allocs);
+    TEST_ASSERT_TRUE(stats.arena_peak <= ScreenArena::ARENA_SIZE);
+}
+
+static void test_allocations_outside_a_build_use_the_general_heap() {
+    const ArenaStats& stats = ScreenArena::getStats();
+    std::vector<Block> blocks;
+    Block style = allocate(64);             // Before any build - lives on
+    TEST_ASSERT_FALSE(ScreenArena::contains(style.ptr));
+
+    for (int cycle = 0; cycle < 100; cycle++) {
+        build(blocks, 50);
+        clean(blocks);
+    }
+    checkIntact(style);
+    ScreenArena::free(style.ptr);
+    TEST_ASSERT_EQUAL(0, (int)stats.general_live);
+}
+
+static void test_survivor_pins_the_arena_until_freed() {
+    const ArenaStats& stats = ScreenArena::getStats();
+    uint32_t pinned = stats.pinned;
+    std::vector<Block> blocks;
+    build(blocks, 30);
+    Block survivor = blocks[5];
+    blocks.erase(blocks.begin() + 5);
+    clean(blocks);
+    TEST_ASSERT_EQUAL(1, (int)stats.arena_live);
+
+    // The next screens keep bumping past it
+    for (int cycle = 0; cycle < 3; cycle++) {
+        build(blocks, 30);
+        TEST_ASSERT_TRUE(blocks[0].ptr > survivor.ptr);
+        clean(blocks);
+    }
+    TEST_ASSERT_EQUAL(3, (int)(stats.pinned - pinned));
+    checkIntact(survivor);
+
+    ScreenArena::free(survivor.ptr);
+    TEST_ASSERT_EQUAL(0, (int)stats.arena_used);
+}
+
+static void test_full_arena_falls_back_and_recovers() {
+    const ArenaStats& stats = ScreenArena::getStats();
+    uint32_t fallbacks = stats.fallbacks;
+    std::vector<Block> blocks;
+    ScreenArena::beginScreen();
+    for (int i = 0; i < 200; i++) {
+        blocks.push_back(allocate(256));    // 52KB - more than the arena holds
+    }
+    ScreenArena::endScreen();
+    TEST_ASSERT_TRUE(stats.fallbacks > fallbacks);
+    TEST_ASSERT_FALSE(ScreenArena::contains(blocks.back().ptr));
+
+    clean(blocks);
+    TEST_ASSERT_EQUAL(0, (int)stats.arena_live);
+    TEST_ASSERT_EQUAL(0, (int)stats.general_live);
+    build(blocks, 10);
+    TEST_ASSERT_TRUE(ScreenArena::contains(blocks[0].ptr));
+    clean(blocks);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_build_clean_cycles_rewind_the_arena);
+    RUN_TEST(test_allocations_outside_a_build_use_the_general_heap);
+    RUN_TEST(test_survivor_pins_the_arena_until_freed);
+    RUN_TEST(test_full_arena_falls_back_and_recovers);
+    return UNITY_END();
+}
@@ -0,0 +1,256 @@
+// The four screen builders on real LVGL, rebuilt, refreshed and rendered as
+// main.cpp does through the MemoryMonitor bracket: once every layout has been
+// seen, a clean must give back all that its build took and the pool peak
+// must not grow. The managers the builders read are faked below.
+// Real LVGL with a dummy flush - run with: pio test -e native_ui
+// The UI sources are built by the env (build_src_filter) - their file-local
+// layout constants share names.
+#include <unity.h>
+#include "../../src/ui_common/memory_monitor.h"
+#include "../../src/ui_common/ui_fonts.h"
+#include "../../src/core/network/mqtt_manager.h"
+#include "../../src/features/energy/energy_history.h"
+#include "../../src/features/energy/energy_ui.h"
+#include "../../src/features/weather/weather_ui.h"
+#include "../../src/features/house_info/house_info_ui.h"
+#include "../../src/features/house_info/diagnostics_data.h"
+#include "../../src/features/settings/settings_ui.h"
+
+static bool mqtt_connected = true;
+static FeedState feed_state = FEED_STATE_FRESH;
+static bool haptic_enabled = true;
+static uint8_t rssi_count = 0;
+
+// Balance and vrms on the arc, six gauges around it
+static const int CHANNELS = 8;
+static ChannelConfig channel_configs[CHANNELS];
+
+bool MQTTManager::isConnected() { return mqtt_connected; }
+uint8_t MQTTManager::getQueueDepth() { return 0; }
+bool MQTTManager::publish(const char*, const char*, bool, bool) { return true; }
+FeedState EnergyData_Manager::getFeedState(PowerFeed) { return feed_state; }
+FeedState EnergyData_Manager::getChannelState(int) { return feed_state; }
+uint8_t EnergyChannels::getCount() { return CHANNELS; }
+const ChannelConfig& EnergyChannels::getConfig(int channel) { return channel_configs[channel]; }
+uint32_t EnergyChannels::getGeneration() { return 1; }
+uint8_t DiagnosticsData_Manager::getRssiCount() { return rssi_count; }
+int8_t DiagnosticsData_Manager::getRssi(uint8_t index) { return (int8_t)(-45 - index % 40); }
+void DiagnosticsData_Manager::addOverhead(uint32_t) {}
+bool HapticFeedback::isEnabled() { return haptic_enabled; }
+void HapticFeedback::setEnabled(bool enabled) { haptic_enabled = enabled; }
+void HapticFeedback::click() {}
+void HapticFeedback::error() {}
+void HapticFeedback::confirmation() {}
+
+static const uint16_t SCREEN_SIZE = 360;
+static lv_color_t draw_pixels[SCREEN_SIZE * 10];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t flushes = 0;
+
+static void dummyFlush(lv_disp_drv_t* drv, const lv_area_t*, lv_color_t*) {
+    flushes++;
+    lv_disp_flush_ready(drv);
+}
+
+// Every layout bit of every screen comes round within this many passes
+static const uint32_t VARIANTS = 16;
+
+static EnergyData energyData(uint32_t pass) {
+    EnergyData data;
+    data.balance = (pass % 3 == 0) ? -1850.0f + pass % 7 : 2400.0f - pass % 11;
+    data.solar = 3100.0f;
+    data.used = 1250.0f + pass % 13;
+    data.vrms = (pass % 4 == 1) ? 0.0f : 239.0f + pass % 3;
+    data.tariff = (pass % 2) ? 1 : 2;
+    data.valid = pass % 8 != 7;
+    for (int channel = 0; channel < CHANNELS; channel++) {
+        // Gauges come and go with their channel's value
+        data.channels[channel] = ((pass + channel) % 5 == 0) ? 0.0f : 100.0f * channel + pass % 9;
+    }
+    return data;
+}
+
+static PeakData peakData(uint32_t pass) {
+    PeakData peaks;
+    peaks.daily_export_peak = (pass % 4 < 2) ? -2200.0f : 0.0f;
+    peaks.daily_import_peak = (pass % 8 < 4) ? 5400.0f : 0.0f;
+    return peaks;
+}
+
+static WeatherData weatherData(uint32_t pass) {
+    WeatherData data;
+    data.has_temperature = pass % 4 != 3;
+    data.has_humidity = pass % 8 != 5;
+    data.has_forecast = pass % 16 != 9;
+    data.temperature = -8.0f + (float)(pass % 37);
+    data.humidity = 30.0f + (float)(pass % 60);
+    data.condition = (WeatherCondition)(pass % WEATHER_CONDITION_COUNT);
+    data.forecast_high = data.temperature + 4.0f;
+    data.forecast_low = data.temperature - 6.0f;
+    data.forecast_condition = (WeatherCondition)((pass + 3) % WEATHER_CONDITION_COUNT);
+    data.valid = data.has_temperature || data.has_humidity || data.has_forecast;
+    data.stale = !data.valid && pass % 2;
+    return data;
+}
+
+static DiagnosticsSample diagnosticsSample(uint32_t pass) {
+    DiagnosticsSample sample;
+    sample.uptime_s = 3600 + pass * 17;
+    sample.wifi_connected = pass % 8 != 6;
+    sample.mqtt_connected = mqtt_connected;
+    sample.rssi = sample.wifi_connected ? (int8_t)(-50 - pass % 30) : 0;
+    sample.mqtt_rate = 0.4f * (pass % 10);
+    sample.loop_p50_us = 900 + pass % 100;
+    sample.loop_p95_us = 4000 + pass % 1000;
+    sample.loop_p99_us = 12000 + pass % 5000;
+    sample.frame_p50_us = 7000 + pass % 700;
+    sample.frame_p95_us = 15000;
+    sample.frame_p99_us = 21000;
+    sample.heap_free = 180000 - pass % 4096;
+    sample.heap_min_free = 150000;
+    sample.lvgl_used = 21000 + pass % 2048;
+    sample.lvgl_total = LV_MEM_SIZE;
+    sample.lvgl_frag_pct = pass % 30;
+    sample.last_error = (pass % 16 < 8) ? nullptr : "MQTT publish refused";
+    sample.last_error_code = (int)(pass % 16);
+    sample.last_error_ms = pass * 1000;
+    return sample;
+}
+
+// A few loop() passes of lv_timer_handler(), 33ms apart: renders the build
+static void runFrames(int frames) {
+    for (int i = 0; i < frames; i++) {
+        lv_tick_inc(33);
+        lv_timer_handler();
+    }
+}
+
+// update_current_screen(), then the in-place updates main.cpp makes until
+// the layout changes
+static void build(int screen, uint32_t pass) {
+    mqtt_connected = pass % 16 != 15;
+    feed_state = (pass % 8 == 3) ? FEED_STATE_STALE : FEED_STATE_FRESH;
+    rssi_count = (uint8_t)(pass % (DiagnosticsData_Manager::RSSI_HISTORY + 1));
+
+    lv_obj_clean(lv_scr_act());
+    MemoryMonitor::beginScreenBuild();
+    switch (screen) {
+        case SCREEN_ENERGY:
+            EnergyUI::updateScreen(energyData(pass), peakData(pass));
+            break;
+        case SCREEN_WEATHER:
+            WeatherUI::updateScreen(weatherData(pass));
+            break;
+        case SCREEN_HOUSE_INFO:
+            HouseInfoUI::updateScreen(diagnosticsSample(pass));
+            break;
+        case SCREEN_SETTINGS:
+            if (pass % 3 == 0) SettingsUI::handleEncoderRotation(1);
+            SettingsUI::updateScreen();
+            break;
+    }
+    lv_obj_t* indicator = lv_label_create(lv_scr_act());
+    String indicator_text = String((long)(screen + 1)) + "/" + String((long)SCREEN_COUNT) + " - Rotate to change";
+    lv_label_set_text(indicator, indicator_text.c_str());
+    lv_obj_set_style_text_font(indicator, UI_FONT_10, 0);
+    lv_obj_align(indicator, LV_ALIGN_TOP_MID, 0, 5);
+    MemoryMonitor::endScreenBuild(screen);
+    runFrames(2);
+
+    // New values on the same layout
+    switch (screen) {
+        case SCREEN_ENERGY: {
+            EnergyData data = energyData(pass);
+            data.balance += 37.0f;
+            data.channels[1] += 12.0f;
+            EnergyUI::refresh(data, peakData(pass));
+            break;
+        }
+        case SCREEN_WEATHER: {
+            WeatherData data = weatherData(pass);
+            data.temperature += 1.0f;
+            data.humidity -= 3.0f;
+            WeatherUI::refresh(data);
+            break;
+        }
+        case SCREEN_HOUSE_INFO:
+            HouseInfoUI::refresh(diagnosticsSample(pass + 1));
+            break;
+    }
+    runFrames(2);
+}
+
+static void cycle(uint32_t first_pass, uint32_t passes) {
+    for (uint32_t pass = first_pass; pass < first_pass + passes; pass++) {
+        for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+            build(screen, pass);
+        }
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_rebuilds_leave_nothing_behind() {
+    MemoryMonitor::begin();
+
+    // Every variant twice: first-use caches (glyph buffers, layer buffers)
+    // are taken here and charged as each screen's baseline or residue
+    cycle(0, 2 * VARIANTS);
+    lv_obj_clean(lv_scr_act());
+    runFrames(2);
+    lv_mem_monitor_t warm;
+    lv_mem_monitor(&warm);
+    int32_t residue[SCREEN_COUNT];
+    for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+        residue[screen] = MemoryMonitor::getScreenStats(screen).residue;
+    }
+
+    const uint32_t SOAK_PASSES = 100 * VARIANTS;
+    cycle(2 * VARIANTS, SOAK_PASSES);
+    lv_obj_clean(lv_scr_act());
+    runFrames(2);
+    lv_mem_monitor_t soaked;
+    lv_mem_monitor(&soaked);
+
+    TEST_ASSERT_TRUE(flushes > 0);
+    TEST_ASSERT_FALSE(MemoryMonitor::isLeakSuspected());
+    TEST_ASSERT_EQUAL_UINT32(warm.total_size - warm.free_size, soaked.total_size - soaked.free_size);
+    TEST_ASSERT_EQUAL_UINT32(warm.used_cnt, soaked.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(warm.max_used, soaked.max_used);
+    for (int screen = 0; screen < SCREEN_COUNT; screen++) {
+        const ScreenMemoryStats& stats = MemoryMonitor::getScreenStats(screen);
+        TEST_ASSERT_EQUAL_UINT32(2 * VARIANTS + SOAK_PASSES, stats.builds);
+        TEST_ASSERT_TRUE(stats.blocks > 0);
+        TEST_ASSERT_EQUAL_INT32(residue[screen], stats.residue);
+        TEST_ASSERT_EQUAL(0, stats.growth_streak);
+    }
+}
+
+int main() {
+    lv_init();
+    lv_disp_draw_buf_init(&draw_buf, draw_pixels, NULL, SCREEN_SIZE * 10);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = SCREEN_SIZE;
+    disp_drv.ver_res = SCREEN_SIZE;
+    disp_drv.flush_cb = dummyFlush;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+    EnergyHistory::begin();
+    SettingsUI::begin();
+    SettingsUI::setMenuActive(true);     // Rotation moves the selection
+
+    for (int channel = 0; channel < CHANNELS; channel++) {
+        ChannelConfig& config = channel_configs[channel];
+        snprintf(config.name, sizeof(config.name), "Ch%d", channel);
+        snprintf(config.topic, sizeof(config.topic), "site/ch%d", channel);
+        config.role = (channel == 0) ? CHANNEL_BALANCE : (channel == 1) ? CHANNEL_VRMS :
+                      (channel == 2) ? CHANNEL_SOLAR : (channel == 3) ? CHANNEL_USED : CHANNEL_LOAD;
+        config.color = 0x203040u * (uint32_t)channel;
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_rebuilds_leave_nothing_behind);
+    return UNITY_END();
+}
@@ -0,0 +1,181 @@
+// TelemetryKernels paths against the reference, and TelemetryStore windows
+// against a row-at-a-time reference on a store whose ring and millis() have
+// both wrapped. No Arduino dependency, so it also runs on the knob - that is
+// the only place the PIE path (-D TELEMETRY_PIE=1) is built:
+//   pio test -e esp32s3-knob -f test_telemetry_store
+#include <unity.h>
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "../../src/core/system/telemetry_kernels.cpp"
+#include "../../src/core/system/telemetry_store.cpp"
+
+static const uint32_t SAMPLES = TelemetryStore::CAPACITY;
+
+struct Samples {
+    alignas(16) int16_t values[SAMPLES];
+    alignas(16) int16_t extremes[SAMPLES];      // Full scale - overflows narrow lanes
+    alignas(16) uint32_t times[SAMPLES];
+};
+
+// Power-like values at irregular ~1s spacing
+static Samples s;
+
+// Rows past the capacity, so the held window straddles the end of the ring
+static const uint32_t STORE_ROWS = TelemetryStore::CAPACITY + TelemetryStore::CAPACITY / 2 + 3;
+static const uint32_t STORE_START_MS = 0xFFFFFFFFu - 200000;
+static TelemetryStore store;
+
+static uint32_t rowTime(uint32_t row) {
+    return STORE_START_MS + s.times[row % SAMPLES] + (row / SAMPLES) * s.times[SAMPLES - 1];
+}
+
+void setUp() {
+    uint32_t seed = 12345;
+    uint32_t t = 0;
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        s.values[i] = (int16_t)((int32_t)(seed >> 16) % 8001 - 4000);
+        s.extremes[i] = (i % 3 == 0) ? INT16_MIN : INT16_MAX;
+        t += 500 + (seed >> 8) % 1000;
+        s.times[i] = t;
+    }
+
+    // Column 0 gets the power-like values, column 1 the full-scale ones
+    const float lsb[2] = {1.0f, 1.0f};
+    store.begin(2, lsb);
+    for (uint32_t row = 0; row < STORE_ROWS; row++) {
+        uint8_t column = row % 2;
+        const int16_t* v = column ? s.extremes : s.values;
+        store.append(rowTime(row), column, v[row % SAMPLES]);
+    }
+}
+
+void tearDown() {}
+
+static void checkKernels(const int16_t* v, const uint32_t* t, uint32_t n) {
+    KernelResult expected = TelemetryKernels::minMaxSumReference(v, n);
+    KernelResult portable = TelemetryKernels::minMaxSumPortable(v, n);
+    TEST_ASSERT_EQUAL_INT32(expected.min, portable.min);
+    TEST_ASSERT_EQUAL_INT32(expected.max, portable.max);
+    TEST_ASSERT_TRUE(expected.sum == portable.sum);
+#if TELEMETRY_PIE
+    KernelResult pie = TelemetryKernels::minMaxSumPie(v, n);
+    TEST_ASSERT_EQUAL_INT32(expected.min, pie.min);
+    TEST_ASSERT_EQUAL_INT32(expected.max, pie.max);
+    TEST_ASSERT_TRUE(expected.sum == pie.sum);
+#endif
+    TEST_ASSERT_TRUE(TelemetryKernels::trapezoidPortable(v, t, n) == TelemetryKernels::trapezoidReference(v, t, n));
+}
+
+static void test_short_lengths_at_every_alignment() {
+    for (uint32_t offset = 0; offset < TelemetryKernels::LANES; offset++) {
+        for (uint32_t n = 1; n <= 4 * TelemetryKernels::LANES + 1; n++) {
+            checkKernels(s.values + offset, s.times + offset, n);
+            checkKernels(s.extremes + offset, s.times + offset, n);
+        }
+    }
+}
+
+static void test_whole_column() {
+    checkKernels(s.values, s.times, SAMPLES);
+    checkKernels(s.values + 3, s.times + 3, SAMPLES - 3);
+    checkKernels(s.extremes, s.times, SAMPLES);
+}
+
+static void assertWindow(const TelemetryWindow& expected, const TelemetryWindow& actual) {
+    TEST_ASSERT_EQUAL_UINT32(expected.count, actual.count);
+    TEST_ASSERT_TRUE(expected.min == actual.min);
+    TEST_ASSERT_TRUE(expected.max == actual.max);
+    TEST_ASSERT_TRUE(expected.mean == actual.mean);
+    TEST_ASSERT_TRUE(expected.integral == actual.integral);
+}
+
+// Every window that ends at the newest row - most span the seam - against
+// a reference grown one row at a time from that end, in the same arithmetic
+static void test_store_windows_across_the_wrap() {
+    TEST_ASSERT_TRUE(store.getFirst() % TelemetryStore::CAPACITY != 0);
+    for (uint8_t column = 0; column < 2; column++) {
+        int32_t lo = INT32_MAX;
+        int32_t hi = INT32_MIN;
+        int64_t sum = 0;
+        int64_t twice_area = 0;
+        for (uint32_t first = store.getEnd(); first-- > store.getFirst();) {
+            int32_t v = (int32_t)store.get(column, first);
+            if (v < lo) lo = v;
+            if (v > hi) hi = v;
+            sum += v;
+            if (first + 1 < store.getEnd()) {
+                twice_area += (int64_t)(v + (int32_t)store.get(column, first + 1)) *
+                              (int64_t)(uint32_t)(rowTime(first + 1) - rowTime(first));
+            }
+
+            TelemetryWindow expected;
+            expected.count = store.getEnd() - first;
+            expected.min = (float)lo;
+            expected.max = (float)hi;
+            expected.mean = (float)((double)sum / expected.count);
+            expected.integral = (float)((double)twice_area * 0.5 / 1000.0);
+            TelemetryWindow actual;
+            TEST_ASSERT_TRUE(store.aggregate(column, first, store.getEnd(), actual));
+            assertWindow(expected, actual);
+        }
+    }
+}
+
+// By age, against the oldest row in the window found by a linear scan
+static void test_store_windows_by_age() {
+    uint32_t now = rowTime(store.getEnd() - 1);
+    for (uint8_t column = 0; column < 2; column++) {
+        uint32_t first = store.getEnd();
+        for (uint32_t age = 0; age < now - rowTime(store.getFirst()) + 2000; age += 997) {
+            while (first > store.getFirst() && now - rowTime(first - 1) <= age) first--;
+            TelemetryWindow expected;
+            TelemetryWindow actual;
+            TEST_ASSERT_TRUE(store.aggregate(column, first, store.getEnd(), expected));
+            TEST_ASSERT_TRUE(store.aggregateSince(column, now - age, now, actual));
+            assertWindow(expected, actual);
+        }
+    }
+}
+
+static void test_store_clips_and_holds() {
+    TelemetryWindow w;
+    TEST_ASSERT_FALSE(store.aggregate(2, store.getFirst(), store.getEnd(), w));     // No such column
+    TEST_ASSERT_FALSE(store.aggregate(0, store.getEnd(), store.getEnd() + 10, w));
+    TEST_ASSERT_TRUE(store.aggregate(0, 0, store.getEnd(), w));
+    TEST_ASSERT_EQUAL_UINT32(TelemetryStore::CAPACITY, w.count);
+
+    // Each row holds the other column at its last value; out of range saturates
+    static TelemetryStore t;        // 6KB - not on the loop task stack
+    const float lsb[2] = {1.0f, 0.5f};
+    t.begin(2, lsb);
+    t.append(0, 0, 40000.0f);
+    t.append(1000, 1, 10.2f);
+    TEST_ASSERT_EQUAL_FLOAT(32767.0f, t.get(0, 1));
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, t.get(1, 1));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, t.get(1, 0));
+}
+
+static int runAll() {
+    UNITY_BEGIN();
+    RUN_TEST(test_short_lengths_at_every_alignment);
+    RUN_TEST(test_whole_column);
+    RUN_TEST(test_store_windows_across_the_wrap);
+    RUN_TEST(test_store_windows_by_age);
+    RUN_TEST(test_store_clips_and_holds);
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);        // Let the monitor attach
+    runAll();
+}
+void loop() {}
+#else
+int main() {
+    return runAll();
+}
+#endif
@@ -0,0 +1,173 @@
+// TraceReplay on a simulated clock: the built-in trace (src/emon_trace.h)
+// and hand-written CSV and binary traces, dispatched to a recording
+// MQTTManager in place of the broker handler. The trace through the real
+// handler is covered by test/test_mqtt_queue and the replay_state host bench.
+#include <unity.h>
+#include <vector>
+#include "../../src/core/network/trace_replay.cpp"
+
+struct Dispatched {
+    std::string topic;
+    std::string payload;
+    unsigned long at_ms;
+};
+
+static std::vector<Dispatched> dispatched;
+static std::string bench_result;
+static unsigned long handler_us = 0;
+
+void MQTTManager::injectMessage(char* topic, byte* payload, unsigned int length) {
+    dispatched.push_back({topic, std::string((const char*)payload, length), millis()});
+    HostTime::advanceMicros(handler_us);
+}
+
+bool MQTTManager::publish(const char* topic, const char* payload, bool, bool) {
+    if (strcmp(topic, "home/knob/bench") == 0) {
+        bench_result = payload;
+    }
+    return true;
+}
+
+void setUp() {
+    HostTime::set(1000);
+    dispatched.clear();
+    bench_result.clear();
+    handler_us = 0;
+}
+
+void tearDown() {
+    TraceReplay::stop();
+}
+
+static const uint8_t* bytes(const char* text) {
+    return (const uint8_t*)text;
+}
+
+// loop() until the replay ends, ms of simulated time per pass
+static void runLoop(unsigned long ms) {
+    for (int pass = 0; pass < 1000000 && TraceReplay::isRunning(); pass++) {
+        TraceReplay::update();
+        HostTime::advance(ms);
+    }
+}
+
+static void test_builtin_trace_replays_every_record() {
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_MAX_THROUGHPUT));
+    runLoop(1);
+
+    // emon_trace.py sample: the tariff, then 30 intervals of four feeds
+    TEST_ASSERT_EQUAL(121, (int)dispatched.size());
+    TEST_ASSERT_EQUAL_STRING("emon/emontx3/tariff", dispatched[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("emon/emontx3/balance", dispatched[1].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("-550", dispatched[1].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("emon/emontx3/vrms", dispatched[120].topic.c_str());
+    TEST_ASSERT_EQUAL(121, (int)TraceReplay::getStats().messages);
+    TEST_ASSERT_EQUAL(0, (int)TraceReplay::getStats().parse_errors);
+
+    // One message per loop pass
+    TEST_ASSERT_EQUAL(120, (int)(dispatched[120].at_ms - dispatched[0].at_ms));
+    TEST_ASSERT_NOT_NULL(strstr(bench_result.c_str(), "\"case\":\"replay\",\"n\":121,"));
+}
+
+static void test_realtime_keeps_the_recorded_spacing() {
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_REALTIME));
+    runLoop(5);
+
+    TEST_ASSERT_EQUAL(121, (int)dispatched.size());
+    // Last record at 290022ms; dispatched on the first pass at or after it
+    unsigned long span = dispatched[120].at_ms - dispatched[0].at_ms;
+    TEST_ASSERT_TRUE(span >= 290022 && span < 290022 + 5);
+    TEST_ASSERT_TRUE(TraceReplay::getStats().max_lag_ms < 5);
+    TEST_ASSERT_NOT_NULL(strstr(bench_result.c_str(), "\"sustained\":true"));
+}
+
+static void test_accelerated_divides_the_spacing() {
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_ACCELERATED, 10.0f));
+    runLoop(1);
+
+    unsigned long span = dispatched[120].at_ms - dispatched[0].at_ms;
+    TEST_ASSERT_TRUE(span >= 29002 && span <= 29003);
+    // Records 4 ms apart in the trace fall due in the same pass
+    TEST_ASSERT_EQUAL(dispatched[1].at_ms, dispatched[2].at_ms);
+}
+
+static void test_slow_handler_is_reported_as_lag() {
+    handler_us = 3000000;       // 3s per message - slower than the 10s/4 feeds arrive
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_REALTIME));
+    runLoop(5);
+
+    TEST_ASSERT_EQUAL(121, (int)dispatched.size());
+    TEST_ASSERT_EQUAL(3000000, (int)TraceReplay::getStats().state_us_max);
+    TEST_ASSERT_TRUE(TraceReplay::getStats().max_lag_ms > 1000);
+    TEST_ASSERT_NOT_NULL(strstr(bench_result.c_str(), "\"sustained\":false"));
+}
+
+static void test_csv_comments_crlf_and_bad_lines() {
+    static const char trace[] =
+        "# comment\r\n"
+        "100,emon/emontx3/balance,250\r\n"
+        "\n"
+        "x1,emon/emontx3/solar,1\n"            // Bad timestamp
+        "200,emon/emontx3/used\n"              // No payload field
+        "300,,5\n"                              // Empty topic
+        "400,home/knob/command,set timezone CET-1,M3.5.0\n"
+        "500,emon/emontx3/vrms,";               // Empty payload, no newline
+    TEST_ASSERT_TRUE(TraceReplay::start(bytes(trace), sizeof(trace) - 1, TRACE_CSV, REPLAY_MAX_THROUGHPUT));
+    runLoop(1);
+
+    TEST_ASSERT_EQUAL(3, (int)dispatched.size());
+    TEST_ASSERT_EQUAL_STRING("250", dispatched[0].payload.c_str());
+    // The payload keeps its commas
+    TEST_ASSERT_EQUAL_STRING("set timezone CET-1,M3.5.0", dispatched[1].payload.c_str());
+    TEST_ASSERT_EQUAL_STRING("emon/emontx3/vrms", dispatched[2].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("", dispatched[2].payload.c_str());
+    TEST_ASSERT_EQUAL(3, (int)TraceReplay::getStats().parse_errors);
+}
+
+static void test_binary_header_and_truncation() {
+    static const uint8_t bad[] = {'E', 'M', 'T', 'R', 2};
+    TEST_ASSERT_FALSE(TraceReplay::start(bad, sizeof(bad), TRACE_BINARY, REPLAY_MAX_THROUGHPUT));
+    TEST_ASSERT_FALSE(TraceReplay::isRunning());
+
+    // One whole record, then one cut short
+    static const uint8_t trace[] = {
+        'E', 'M', 'T', 'R', 1,
+        0x10, 0x00, 0x00, 0x00, 1, 2, 'a', '4', '2',
+        0x20, 0x00, 0x00, 0x00, 1, 9, 'b', '1'
+    };
+    TEST_ASSERT_TRUE(TraceReplay::start(trace, sizeof(trace), TRACE_BINARY, REPLAY_MAX_THROUGHPUT));
+    runLoop(1);
+
+    TEST_ASSERT_EQUAL(1, (int)dispatched.size());
+    TEST_ASSERT_EQUAL_STRING("a", dispatched[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("42", dispatched[0].payload.c_str());
+    TEST_ASSERT_EQUAL(1, (int)TraceReplay::getStats().parse_errors);
+}
+
+static void test_frame_closes_pixel_latency() {
+    TEST_ASSERT_TRUE(TraceReplay::startRecorded(REPLAY_MAX_THROUGHPUT));
+    TraceReplay::update();
+    HostTime::advanceMicros(700);
+    TraceReplay::notifyFrame();
+    // No message since - nothing to close
+    HostTime::advanceMicros(5000);
+    TraceReplay::notifyFrame();
+
+    TEST_ASSERT_EQUAL(1, (int)TraceReplay::getStats().frames);
+    TEST_ASSERT_EQUAL(700, (int)TraceReplay::getStats().pixel_us_max);
+    TraceReplay::stop();
+    TEST_ASSERT_FALSE(TraceReplay::isRunning());
+    TEST_ASSERT_EQUAL(1, (int)TraceReplay::getStats().messages);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_builtin_trace_replays_every_record);
+    RUN_TEST(test_realtime_keeps_the_recorded_spacing);
+    RUN_TEST(test_accelerated_divides_the_spacing);
+    RUN_TEST(test_slow_handler_is_reported_as_lag);
+    RUN_TEST(test_csv_comments_crlf_and_bad_lines);
+    RUN_TEST(test_binary_header_and_truncation);
+    RUN_TEST(test_frame_closes_pixel_latency);
+    return UNITY_END();
+}
@@ -0,0 +1,97 @@
+// Every UI_ICON_* and every string literal of the UI sources, rendered
+// through the fonts this build uses: the subsets from scripts/font_subset.py,
+// or LVGL's built-in Montserrat without lv_font_conv. The list comes from
+// src/ui_common/fonts/ui_text.h, which font_subset.py writes before the build.
+// Real LVGL - run with: pio test -e native_fonts
+#include <unity.h>
+#include <stdio.h>
+#include "../../src/ui_common/ui_fonts.h"
+#include "../../src/ui_common/fonts/ui_text.h"
+
+static const lv_font_t* const FONTS[] = {UI_TEXT_FONTS};
+static const int FONT_COUNT = sizeof(FONTS) / sizeof(FONTS[0]);
+
+void setUp() {}
+void tearDown() {}
+
+// The font has the glyph and sets at least one pixel of it (a space only
+// has to advance)
+static bool renders(const lv_font_t* font, uint32_t letter) {
+    lv_font_glyph_dsc_t dsc;
+    if (!lv_font_get_glyph_dsc(font, &dsc, letter, 0)) return false;
+    if (letter == ' ') return dsc.adv_w > 0;
+    if (dsc.box_w == 0 || dsc.box_h == 0) return false;
+
+    const uint8_t* bitmap = lv_font_get_glyph_bitmap(font, letter);
+    if (!bitmap) return false;
+    uint32_t bytes = ((uint32_t)dsc.box_w * dsc.box_h * dsc.bpp + 7) / 8;
+    for (uint32_t i = 0; i < bytes; i++) {
+        if (bitmap[i]) return true;
+    }
+    return false;
+}
+
+// Letters of a string that do not render, as "U+XXXX in <text>"
+static bool checkText(const char* what, const char* text, bool ascii_only, char* failure, size_t size) {
+    for (int f = 0; f < FONT_COUNT; f++) {
+        uint32_t i = 0;
+        uint32_t letter;
+        while ((letter = _lv_txt_encoded_next(text, &i)) != 0) {
+            if (letter < 0x20) continue;            // Newlines and tabs
+            if (ascii_only && letter > 0x7E) continue;
+            if (!renders(FONTS[f], letter)) {
+                snprintf(failure, size, "U+%04X in %s \"%s\" (line height %d)",
+                         (unsigned)letter, what, text, (int)FONTS[f]->line_height);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void test_every_icon_renders() {
+    char failure[160];
+    for (size_t i = 0; i < sizeof(UI_TEXT_ICONS) / sizeof(UI_TEXT_ICONS[0]); i++) {
+#ifdef UI_FONTS_SUBSET
+        if (!UI_TEXT_ICONS[i].used) continue;      // Not merged into the subsets
+#endif
+        if (!checkText(UI_TEXT_ICONS[i].name, UI_TEXT_ICONS[i].text, false, failure, sizeof(failure))) {
+            TEST_FAIL_MESSAGE(failure);
+        }
+    }
+}
+
+static void test_every_ui_string_renders() {
+#ifdef UI_FONTS_SUBSET
+    const bool ascii_only = false;
+#else
+    const bool ascii_only = true;                  // The built-ins have no Latin-1
+#endif
+    char failure[160];
+    for (size_t i = 0; i < sizeof(UI_TEXT_LITERALS) / sizeof(UI_TEXT_LITERALS[0]); i++) {
+        if (!checkText("literal", UI_TEXT_LITERALS[i], ascii_only, failure, sizeof(failure))) {
+            TEST_FAIL_MESSAGE(failure);
+        }
+    }
+}
+
+static void test_icons_are_distinct_on_the_weather_screen() {
+    // conditionIcon() is the only cue on the forecast line
+    const char* icons[] = {UI_ICON_SUN, UI_ICON_WEATHER, UI_ICON_CLOUD, UI_ICON_FOG,
+                           UI_ICON_RAIN, UI_ICON_STORM, UI_ICON_SNOW};
+    const int count = sizeof(icons) / sizeof(icons[0]);
+    for (int a = 0; a < count; a++) {
+        for (int b = a + 1; b < count; b++) {
+            TEST_ASSERT_TRUE(strcmp(icons[a], icons[b]) != 0);
+        }
+    }
+}
+
+int main() {
+    lv_init();      // Compressed glyphs are unpacked into the LVGL heap
+    UNITY_BEGIN();
+    RUN_TEST(test_every_icon_renders);
+    RUN_TEST(test_every_ui_string_renders);
+    RUN_TEST(test_icons_are_distinct_on_the_weather_screen);
+    return UNITY_END();
+}